@@ -1,15 +1,20 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <chrono>
+#include <thread>
 
 #include "audio_core/adsp/apps/audio_renderer/audio_renderer.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_command_executor.h"
 #include "audio_core/audio_core.h"
 #include "audio_core/common/common.h"
+#include "audio_core/renderer/command/data_source/adpcm_lookahead.h"
 #include "audio_core/sink/sink.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -134,6 +139,7 @@ void AudioRenderer::Main(std::stop_token stop_token) {
     MicroProfileOnThreadCreate(name);
     Common::SetCurrentThreadName(name);
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
 
     // TODO: Create buffer map/unmap thread + mailbox
     // TODO: Create gMix devices, initialize them here
@@ -149,6 +155,10 @@ void AudioRenderer::Main(std::stop_token stop_token) {
     // 0.12 seconds (2,304,000 / 19,200,000)
     constexpr u64 max_process_time{2'304'000ULL};
 
+    // Created on first use, so the worker threads only exist when parallel voices are enabled
+    std::unique_ptr<VoiceCommandExecutor> voice_executor;
+    std::array<Renderer::AdpcmLookaheadCache, MaxRendererSessions> adpcm_lookaheads;
+
     while (!stop_token.stop_requested()) {
         auto msg{mailbox.Receive(Direction::DSP)};
         switch (msg) {
@@ -166,6 +176,13 @@ void AudioRenderer::Main(std::stop_token stop_token) {
             std::array<u64, MaxRendererSessions> render_times_taken{};
             const auto start_time{system.CoreTiming().GetGlobalTimeUs().count()};
 
+            if (Settings::values.audio_parallel_voices && !voice_executor) {
+                // Leave most of the host to the emulated CPU cores and the GPU
+                const auto num_workers{
+                    std::clamp<size_t>(std::thread::hardware_concurrency() / 4, 1, 3)};
+                voice_executor = std::make_unique<VoiceCommandExecutor>(num_workers);
+            }
+
             for (u32 index = 0; index < MaxRendererSessions; index++) {
                 auto& command_buffer{command_buffers[index]};
                 auto& command_list_processor{command_list_processors[index]};
@@ -180,8 +197,10 @@ void AudioRenderer::Main(std::stop_token stop_token) {
                                                           command_buffer.size, streams[index]);
                     }
 
+                    // The first command buffer of a newly initialized session
                     if (command_buffer.reset_buffer && !buffers_reset[index]) {
                         streams[index]->ClearQueue();
+                        adpcm_lookaheads[index].Clear();
                         buffers_reset[index] = true;
                     }
 
@@ -196,6 +215,8 @@ void AudioRenderer::Main(std::stop_token stop_token) {
 
                     max_time = std::min(command_buffer.time_limit, max_time);
                     command_list_processor.SetProcessTimeMax(max_time);
+                    command_list_processor.voice_executor = voice_executor.get();
+                    command_list_processor.adpcm_lookahead = &adpcm_lookaheads[index];
 
                     if (index == 0) {
                         streams[index]->WaitFreeSpace(stop_token);
@@ -1,9 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <chrono>
 #include <string>
+#include <vector>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_command_executor.h"
 #include "audio_core/renderer/command/command_list_header.h"
 #include "audio_core/renderer/command/commands.h"
 #include "common/settings.h"
@@ -16,8 +20,13 @@ namespace AudioCore::ADSP::AudioRenderer {
 
 void CommandListProcessor::Initialize(Core::System& system_, Kernel::KProcess& process,
                                       CpuAddr buffer, u64 size, Sink::SinkStream* stream_) {
+    Initialize(system_, &process.GetMemory(), buffer, size, stream_);
+}
+
+void CommandListProcessor::Initialize(Core::System& system_, Core::Memory::Memory* memory_,
+                                      CpuAddr buffer, u64 size, Sink::SinkStream* stream_) {
     system = &system_;
-    memory = &process.GetMemory();
+    memory = memory_;
     stream = stream_;
     header = reinterpret_cast<Renderer::CommandListHeader*>(buffer);
     commands = reinterpret_cast<u8*>(buffer + sizeof(Renderer::CommandListHeader));
@@ -54,6 +63,8 @@ u64 CommandListProcessor::Process(u32 session_id) {
     }
 
     std::string dump{fmt::format("\nSession {}\n", session_id)};
+    // Voice commands before this index already failed to run in parallel
+    u32 sequential_until{0};
 
     for (u32 index = 0; index < command_count; index++) {
         auto& command{*reinterpret_cast<Renderer::ICommand*>(commands)};
@@ -74,6 +85,16 @@ u64 CommandListProcessor::Process(u32 session_id) {
             return system->CoreTiming().GetGlobalTimeUs().count() - start_time_;
         }
 
+        if (voice_executor && Settings::values.audio_parallel_voices && index >= sequential_until &&
+            VoiceCommandExecutor::IsVoiceCommand(command)) {
+            u32 count{};
+            if (ProcessVoiceCommands(command_base, start_time_, index, dump, count)) {
+                index += count - 1;
+                continue;
+            }
+            sequential_until = index + std::max(count, 1U);
+        }
+
         if (Settings::values.dump_audio_commands) {
             command.Dump(*this, dump);
         }
@@ -82,7 +103,13 @@ u64 CommandListProcessor::Process(u32 session_id) {
             break;
         }
 
-        if (command.enabled) {
+        if (command.enabled && command_host_times) {
+            const auto begin{std::chrono::steady_clock::now()};
+            command.Process(*this);
+            const auto end{std::chrono::steady_clock::now()};
+            (*command_host_times)[static_cast<size_t>(command.type)] +=
+                std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+        } else if (command.enabled) {
             command.Process(*this);
         } else {
             dump += fmt::format("\tDisabled!\n");
@@ -101,4 +128,53 @@ u64 CommandListProcessor::Process(u32 session_id) {
     return end_time - start_time_;
 }
 
+bool CommandListProcessor::ProcessVoiceCommands(CpuAddr command_base, u64 process_start,
+                                                u32 index, std::string& dump, u32& count) {
+    std::vector<Renderer::ICommand*> voice_commands;
+    std::string voice_dump;
+    u8* next_command{commands};
+
+    for (; index < command_count; index++) {
+        auto& command{*reinterpret_cast<Renderer::ICommand*>(next_command)};
+        if (command.magic != 0xCAFEBABE ||
+            CpuAddr(next_command) - command_base + command.size > commands_buffer_size ||
+            !VoiceCommandExecutor::IsVoiceCommand(command)) {
+            break;
+        }
+
+        const auto dump_size{voice_dump.size()};
+        if (Settings::values.dump_audio_commands) {
+            command.Dump(*this, voice_dump);
+        }
+        if (!command.Verify(*this)) {
+            voice_dump.resize(dump_size);
+            break;
+        }
+        if (!command.enabled) {
+            voice_dump += fmt::format("\tDisabled!\n");
+        }
+
+        voice_commands.push_back(&command);
+        next_command += command.size;
+    }
+
+    count = static_cast<u32>(voice_commands.size());
+
+    // Spent budget is left to the sequential path, which runs the list a command at a time
+    const u64 elapsed{current_processing_time +
+                      (system->CoreTiming().GetGlobalTimeUs().count() - process_start)};
+    if (elapsed >= max_process_time) {
+        return false;
+    }
+
+    if (!voice_executor->Execute(*this, voice_commands)) {
+        return false;
+    }
+
+    dump += voice_dump;
+    processed_command_count += count;
+    commands = next_command;
+    return true;
+}
+
 } // namespace AudioCore::ADSP::AudioRenderer
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <array>
 #include <span>
+#include <string>
 
 #include "audio_core/common/common.h"
 #include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/icommand.h"
 #include "common/common_types.h"
 
 namespace Core {
@@ -26,10 +29,12 @@ class SinkStream;
 }
 
 namespace Renderer {
+class AdpcmLookaheadCache;
 struct CommandListHeader;
-}
+} // namespace Renderer
 
 namespace ADSP::AudioRenderer {
+class VoiceCommandExecutor;
 
 /**
  * A processor for command lists given to the AudioRenderer.
@@ -47,6 +52,20 @@ public:
     void Initialize(Core::System& system, Kernel::KProcess& process, CpuAddr buffer, u64 size,
                     Sink::SinkStream* stream);
 
+    /**
+     * Initialize the processor with the given memory, such as the captured guest memory of a
+     * command list replayed offline. It may be null for command lists that don't access guest
+     * memory.
+     *
+     * @param system - The core system.
+     * @param memory - Guest memory accessed by the commands, or null.
+     * @param buffer - The command buffer to process.
+     * @param size   - The size of the buffer.
+     * @param stream - The stream to be used for sending the samples.
+     */
+    void Initialize(Core::System& system, Core::Memory::Memory* memory, CpuAddr buffer, u64 size,
+                    Sink::SinkStream* stream);
+
     /**
      * Set the maximum processing time for this command list.
      *
@@ -77,6 +96,20 @@ public:
      */
     u64 Process(u32 session_id);
 
+    /**
+     * Run the voice commands starting at the current command in parallel.
+     *
+     * @param command_base  - Start of the commands processed by this call to Process.
+     * @param process_start - Time this call to Process started.
+     * @param index         - Index of the current command.
+     * @param dump          - Dump of the processed commands, appended to if they were run.
+     * @param count         - Returns the number of voice commands found.
+     * @return True if the voice commands were run, false if they must be run sequentially,
+     *         either because they can't run in parallel or the processing time is used up.
+     */
+    bool ProcessVoiceCommands(CpuAddr command_base, u64 process_start, u32 index,
+                              std::string& dump, u32& count);
+
     /// Core system
     Core::System* system{};
     /// Core memory
@@ -111,6 +144,12 @@ public:
     u64 end_time{};
     /// Last command list string generated, used for dumping audio commands to console
     std::string last_dump{};
+    /// Runs voice commands in parallel, if enabled
+    VoiceCommandExecutor* voice_executor{};
+    /// ADPCM samples decoded ahead of the voices playing them
+    Renderer::AdpcmLookaheadCache* adpcm_lookahead{};
+    /// Host time spent processing each command type in nanoseconds, accumulated if set
+    std::array<u64, Renderer::CommandIdCount>* command_host_times{};
 };
 
 } // namespace ADSP::AudioRenderer
@@ -0,0 +1,235 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "audio_core/adsp/apps/audio_renderer/voice_command_executor.h"
+#include "audio_core/renderer/command/commands.h"
+
+namespace AudioCore::ADSP::AudioRenderer {
+namespace {
+
+using Renderer::CommandId;
+using Renderer::ICommand;
+
+/// Node type in the top bits of the node id of commands generated for a voice
+constexpr u32 VoiceNodeType = 1;
+
+template <typename T>
+const T& As(const ICommand& command) {
+    return static_cast<const T&>(command);
+}
+
+/**
+ * Collect the mix buffers a voice command uses.
+ *
+ * @param command - The command to check.
+ * @param scratch - Buffers the command reads or overwrites, which must belong to its voice.
+ * @param mixed   - Buffers the command adds its output to.
+ * @return False if the command can't run apart from the other voices.
+ */
+bool CollectBuffers(const ICommand& command, std::vector<s16>& scratch, std::vector<s16>& mixed) {
+    switch (command.type) {
+    case CommandId::DataSourcePcmInt16Version1:
+        scratch.push_back(As<Renderer::PcmInt16DataSourceVersion1Command>(command).output_index);
+        return true;
+    case CommandId::DataSourcePcmInt16Version2:
+        scratch.push_back(As<Renderer::PcmInt16DataSourceVersion2Command>(command).output_index);
+        return true;
+    case CommandId::DataSourcePcmFloatVersion1:
+        scratch.push_back(As<Renderer::PcmFloatDataSourceVersion1Command>(command).output_index);
+        return true;
+    case CommandId::DataSourcePcmFloatVersion2:
+        scratch.push_back(As<Renderer::PcmFloatDataSourceVersion2Command>(command).output_index);
+        return true;
+    case CommandId::DataSourceAdpcmVersion1:
+        scratch.push_back(As<Renderer::AdpcmDataSourceVersion1Command>(command).output_index);
+        return true;
+    case CommandId::DataSourceAdpcmVersion2:
+        scratch.push_back(As<Renderer::AdpcmDataSourceVersion2Command>(command).output_index);
+        return true;
+    case CommandId::BiquadFilter: {
+        const auto& biquad{As<Renderer::BiquadFilterCommand>(command)};
+        scratch.push_back(biquad.input);
+        scratch.push_back(biquad.output);
+        return true;
+    }
+    case CommandId::MultiTapBiquadFilter: {
+        const auto& biquad{As<Renderer::MultiTapBiquadFilterCommand>(command)};
+        scratch.push_back(biquad.input);
+        scratch.push_back(biquad.output);
+        return true;
+    }
+    case CommandId::VolumeRamp: {
+        const auto& volume_ramp{As<Renderer::VolumeRampCommand>(command)};
+        scratch.push_back(volume_ramp.input_index);
+        scratch.push_back(volume_ramp.output_index);
+        return true;
+    }
+    case CommandId::MixRamp: {
+        const auto& mix_ramp{As<Renderer::MixRampCommand>(command)};
+        scratch.push_back(mix_ramp.input_index);
+        mixed.push_back(mix_ramp.output_index);
+        return true;
+    }
+    case CommandId::MixRampGrouped: {
+        const auto& mix_ramp{As<Renderer::MixRampGroupedCommand>(command)};
+        if (mix_ramp.buffer_count > mix_ramp.inputs.size()) {
+            return false;
+        }
+        for (u32 i = 0; i < mix_ramp.buffer_count; i++) {
+            scratch.push_back(mix_ramp.inputs[i]);
+            mixed.push_back(mix_ramp.outputs[i]);
+        }
+        return true;
+    }
+    case CommandId::Performance:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // Anonymous namespace
+
+VoiceCommandExecutor::VoiceCommandExecutor(size_t num_workers)
+    : workers{num_workers, "AudioRendererVoices"} {
+    slots.resize(num_workers + 1);
+    for (auto& slot : slots) {
+        slot = std::make_unique<Slot>();
+    }
+}
+
+VoiceCommandExecutor::~VoiceCommandExecutor() = default;
+
+bool VoiceCommandExecutor::IsVoiceCommand(const ICommand& command) {
+    return (command.node_id >> 28) == VoiceNodeType;
+}
+
+bool VoiceCommandExecutor::Execute(const CommandListProcessor& processor,
+                                   std::span<ICommand* const> commands) {
+    if (!Partition(commands, processor.buffer_count) || chains.size() < 2) {
+        return false;
+    }
+
+    // Depop preparation accumulates into a buffer shared by every voice. It only reads the
+    // previous samples of its own voice, before the voice is mixed, so it can run ahead.
+    for (ICommand* const command : commands) {
+        if (command->enabled && command->type == CommandId::DepopPrepare) {
+            command->Process(processor);
+        }
+    }
+
+    for (auto& slot : slots) {
+        BindSlot(*slot, processor);
+    }
+    next_chain = 0;
+    for (size_t index = 1; index < slots.size(); index++) {
+        workers.QueueWork([this, index] { RunSlot(*slots[index]); });
+    }
+    RunSlot(*slots[0]);
+    workers.WaitForRequests();
+
+    // Mixing wraps around like the scalar fixed point code, keep the sums unsigned
+    const u32 sample_count{processor.sample_count};
+    for (const auto& slot : slots) {
+        if (!slot->has_mixed) {
+            continue;
+        }
+        for (const s16 buffer : output_buffers) {
+            s32* const output{&processor.mix_buffers[buffer * sample_count]};
+            const s32* const input{&slot->buffers[buffer * sample_count]};
+            for (u32 i = 0; i < sample_count; i++) {
+                output[i] = static_cast<s32>(static_cast<u32>(output[i]) +
+                                             static_cast<u32>(input[i]));
+            }
+        }
+    }
+    return true;
+}
+
+void VoiceCommandExecutor::BindSlot(Slot& slot, const CommandListProcessor& processor) {
+    // Only the fields voice commands read, the rest of the processor belongs to the list walk
+    CommandListProcessor& context{slot.context};
+    context.system = processor.system;
+    context.memory = processor.memory;
+    context.sample_count = processor.sample_count;
+    context.target_sample_rate = processor.target_sample_rate;
+    context.buffer_count = processor.buffer_count;
+    context.start_time = processor.start_time;
+    context.current_processing_time = processor.current_processing_time;
+    context.adpcm_lookahead = processor.adpcm_lookahead;
+    slot.buffers.resize(processor.mix_buffers.size());
+    context.mix_buffers = slot.buffers;
+    slot.has_mixed = false;
+}
+
+bool VoiceCommandExecutor::Partition(std::span<ICommand* const> commands, u32 buffer_count) {
+    chains.clear();
+    chain_commands.clear();
+    output_buffers.clear();
+
+    std::vector<s16> scratch;
+    std::vector<u32> node_ids;
+    for (ICommand* const command : commands) {
+        if (!command->enabled || command->type == CommandId::DepopPrepare) {
+            continue;
+        }
+        if (!CollectBuffers(*command, scratch, output_buffers)) {
+            return false;
+        }
+        if (chains.empty() || node_ids.back() != command->node_id) {
+            chains.push_back({chain_commands.size(), chain_commands.size()});
+            node_ids.push_back(command->node_id);
+        }
+        chain_commands.push_back(command);
+        chains.back().end = chain_commands.size();
+    }
+
+    // Each voice must show up once, and never touch the buffers another voice mixes into
+    std::ranges::sort(node_ids);
+    if (std::ranges::adjacent_find(node_ids) != node_ids.end()) {
+        return false;
+    }
+    std::ranges::sort(output_buffers);
+    output_buffers.erase(std::ranges::unique(output_buffers).begin(), output_buffers.end());
+    std::ranges::sort(scratch);
+    const auto is_valid = [buffer_count](s16 buffer) {
+        return buffer >= 0 && static_cast<u32>(buffer) < buffer_count;
+    };
+    if (!std::ranges::all_of(output_buffers, is_valid) || !std::ranges::all_of(scratch, is_valid)) {
+        return false;
+    }
+    for (const s16 buffer : output_buffers) {
+        if (std::ranges::binary_search(scratch, buffer)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void VoiceCommandExecutor::RunSlot(Slot& slot) {
+    const u32 sample_count{slot.context.sample_count};
+    for (size_t index = next_chain.fetch_add(1, std::memory_order_relaxed); index < chains.size();
+         index = next_chain.fetch_add(1, std::memory_order_relaxed)) {
+        if (!slot.has_mixed) {
+            // Only the buffers voices mix into start from silence, the rest is scratch space
+            for (const s16 buffer : output_buffers) {
+                std::memset(&slot.buffers[buffer * sample_count], 0, sample_count * sizeof(s32));
+            }
+            slot.has_mixed = true;
+        }
+        for (size_t i = chains[index].begin; i < chains[index].end; i++) {
+            ICommand& command{*chain_commands[i]};
+            if (command.type == CommandId::Performance) {
+                std::scoped_lock lock{performance_mutex};
+                command.Process(slot.context);
+            } else {
+                command.Process(slot.context);
+            }
+        }
+    }
+}
+
+} // namespace AudioCore::ADSP::AudioRenderer
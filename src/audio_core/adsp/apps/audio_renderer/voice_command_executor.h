@@ -0,0 +1,96 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+
+namespace AudioCore::Renderer {
+struct ICommand;
+}
+
+namespace AudioCore::ADSP::AudioRenderer {
+
+/**
+ * Runs the voice commands of a command list over a pool of worker threads.
+ *
+ * Voices only meet in the mix buffers they are mixed into. The commands of each voice are run in
+ * order on one thread, into that thread's private copy of the mix buffers, and the private mixes
+ * are summed into the shared buffers afterwards. Mixing adds the rounded contribution of a voice
+ * to the output buffer, so the sum is the same whichever thread ran a voice, and the result is
+ * bit identical to running the commands sequentially.
+ */
+class VoiceCommandExecutor {
+public:
+    /**
+     * @param num_workers - Number of worker threads, the calling thread also runs voices.
+     */
+    explicit VoiceCommandExecutor(size_t num_workers);
+    ~VoiceCommandExecutor();
+
+    /**
+     * Run a range of voice commands.
+     *
+     * @param processor - The processor of the command list.
+     * @param commands  - The commands to run, generated for voices and verified, in list order.
+     * @return True if the commands were run, false if they can't be run in parallel and
+     *         nothing was run.
+     */
+    bool Execute(const CommandListProcessor& processor,
+                 std::span<Renderer::ICommand* const> commands);
+
+    /**
+     * Check if a command was generated for a voice.
+     *
+     * @param command - The command to check.
+     * @return True if the command belongs to a voice.
+     */
+    static bool IsVoiceCommand(const Renderer::ICommand& command);
+
+private:
+    /// Commands of one voice, as a range of chain_commands.
+    struct Chain {
+        size_t begin;
+        size_t end;
+    };
+
+    /// State private to one of the threads running voices.
+    struct Slot {
+        std::vector<s32> buffers;
+        /// What the voice commands read of the processor, mixing into the buffers of the slot
+        CommandListProcessor context;
+        bool has_mixed;
+    };
+
+    /// Point the context of a slot at the current command list.
+    static void BindSlot(Slot& slot, const CommandListProcessor& processor);
+
+    /**
+     * Split the commands into voices and collect the mix buffers they output to.
+     *
+     * @return False if the voices don't keep to their own buffers.
+     */
+    bool Partition(std::span<Renderer::ICommand* const> commands, u32 buffer_count);
+
+    /// Run voices on a slot until none are left.
+    void RunSlot(Slot& slot);
+
+    Common::ThreadWorker workers;
+    std::vector<std::unique_ptr<Slot>> slots;
+    std::vector<Chain> chains;
+    std::vector<Renderer::ICommand*> chain_commands;
+    std::vector<s16> output_buffers;
+    std::atomic<size_t> next_chain{};
+    /// Performance commands of different voices share the entry count of their header
+    std::mutex performance_mutex;
+};
+
+} // namespace AudioCore::ADSP::AudioRenderer
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "audio_core/adsp/apps/opus/decode_streams.h"
+
+namespace AudioCore::ADSP::OpusDecoder {
+namespace {
+
+template <typename Duration>
+u64 ToMicroseconds(Duration duration) {
+    return static_cast<u64>(
+        std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+} // Anonymous namespace
+
+std::optional<DecodeStreams::StreamMetrics> DecodeStreams::RemoveStream(u64 stream_id) {
+    std::shared_ptr<Stream> stream;
+    {
+        std::scoped_lock lock{streams_mutex};
+        const auto it{streams.find(stream_id)};
+        if (it == streams.end()) {
+            return std::nullopt;
+        }
+        stream = std::move(it->second);
+        streams.erase(it);
+    }
+
+    // Wait for a packet of the stream which is still running
+    std::scoped_lock run_lock{stream->run_mutex};
+    std::scoped_lock lock{streams_mutex};
+    const StreamMetrics metrics{stream->metrics};
+    if (metrics.jobs == 0) {
+        return std::nullopt;
+    }
+    return metrics;
+}
+
+std::optional<DecodeStreams::StreamMetrics> DecodeStreams::GetStreamMetrics(
+    u64 stream_id) const {
+    std::scoped_lock lock{streams_mutex};
+    const auto it{streams.find(stream_id)};
+    if (it == streams.end() || it->second->metrics.jobs == 0) {
+        return std::nullopt;
+    }
+    return it->second->metrics;
+}
+
+std::shared_ptr<DecodeStreams::Stream> DecodeStreams::GetStream(u64 stream_id) {
+    std::scoped_lock lock{streams_mutex};
+    auto& stream{streams[stream_id]};
+    if (!stream) {
+        stream = std::make_shared<Stream>();
+    }
+    return stream;
+}
+
+void DecodeStreams::RecordJob(Stream& stream, Clock::duration wait, Clock::duration run) {
+    const u64 wait_us{ToMicroseconds(wait)};
+    const u64 run_us{ToMicroseconds(run)};
+    std::scoped_lock lock{streams_mutex};
+    auto& metrics{stream.metrics};
+    metrics.jobs++;
+    metrics.total_wait_us += wait_us;
+    metrics.max_wait_us = std::max(metrics.max_wait_us, wait_us);
+    metrics.total_run_us += run_us;
+    metrics.max_run_us = std::max(metrics.max_run_us, run_us);
+}
+
+} // namespace AudioCore::ADSP::OpusDecoder
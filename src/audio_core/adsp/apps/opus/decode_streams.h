@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "common/common_types.h"
+
+namespace AudioCore::ADSP::OpusDecoder {
+
+/**
+ * Runs the packets of many decode streams on the threads submitting them.
+ *
+ * A packet is decoded on the thread asking for it, an IPC thread of the hwopus service, so the
+ * request is answered without waking another thread. The packets of a stream run one at a time,
+ * while the packets of other streams run at the same time on the other threads of the service.
+ *
+ * Run may be called from any number of threads. Removing a stream waits for its running packet.
+ */
+class DecodeStreams {
+public:
+    /// Latency of the jobs run for a stream, in microseconds
+    struct StreamMetrics {
+        /// Number of jobs run
+        u64 jobs;
+        /// Time spent waiting for another job of the stream to finish
+        u64 total_wait_us;
+        u64 max_wait_us;
+        /// Time spent running
+        u64 total_run_us;
+        u64 max_run_us;
+    };
+
+    /**
+     * Run a job of a stream on the calling thread, once no other job of the stream is running.
+     *
+     * @param stream_id - Identifier of the stream, the address of its decode object.
+     * @param job       - The job to run.
+     */
+    template <typename Func>
+    void Run(u64 stream_id, Func&& job) {
+        const auto stream{GetStream(stream_id)};
+        const auto queued{Clock::now()};
+        std::scoped_lock run_lock{stream->run_mutex};
+        const auto started{Clock::now()};
+        job();
+        RecordJob(*stream, started - queued, Clock::now() - started);
+    }
+
+    /**
+     * Remove a stream, once its running job has finished.
+     *
+     * @param stream_id - Identifier of the stream.
+     * @return The metrics of the stream, or nothing if it never ran a job.
+     */
+    std::optional<StreamMetrics> RemoveStream(u64 stream_id);
+
+    /**
+     * Get the metrics of a stream.
+     *
+     * @param stream_id - Identifier of the stream.
+     * @return The metrics of the stream, or nothing if it never ran a job.
+     */
+    std::optional<StreamMetrics> GetStreamMetrics(u64 stream_id) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Stream {
+        /// Keeps the jobs of the stream one at a time, if the caller doesn't
+        std::mutex run_mutex;
+        StreamMetrics metrics{};
+    };
+
+    /// Find a stream, adding it if it's new.
+    std::shared_ptr<Stream> GetStream(u64 stream_id);
+
+    /// Add a finished job to the metrics of its stream.
+    void RecordJob(Stream& stream, Clock::duration wait, Clock::duration run);
+
+    mutable std::mutex streams_mutex;
+    /// Shared with the runs of a stream, which keep it alive if it's removed meanwhile
+    std::unordered_map<u64, std::shared_ptr<Stream>> streams;
+};
+
+} // namespace AudioCore::ADSP::OpusDecoder
@@ -34,6 +34,28 @@ bool IsValidMultiStreamStreamCounts(s32 total_stream_count, s32 stereo_stream_co
     return IsValidMultiStreamChannelCount(total_stream_count) && total_stream_count > 0 &&
            stereo_stream_count >= 0 && stereo_stream_count <= total_stream_count;
 }
+
+template <typename DecodeObject>
+s32 DecodePacket(const OpusDecoder::DecodeRequest& request, u32& decoded_samples) {
+    auto& decoder_object = DecodeObject::Initialize(request.buffer, request.buffer);
+    s32 error_code{OPUS_OK};
+    if (request.reset) {
+        error_code = decoder_object.ResetDecoder();
+    }
+
+    if (error_code == OPUS_OK) {
+        error_code =
+            decoder_object.Decode(decoded_samples, request.output_data, request.output_data_size,
+                                  request.input_data, request.input_data_size);
+    }
+
+    if (error_code == OPUS_OK) {
+        if (request.final_range && decoder_object.GetFinalRange() != request.final_range) {
+            error_code = OPUS_INVALID_PACKET;
+        }
+    }
+    return error_code;
+}
 } // namespace
 
 OpusDecoder::OpusDecoder(Core::System& system_) : system{system_} {
@@ -64,6 +86,33 @@ u32 OpusDecoder::Receive(Direction dir, std::stop_token stop_token) {
     return mailbox.Receive(dir, stop_token);
 }
 
+OpusDecoder::DecodeResult OpusDecoder::Decode(const DecodeRequest& request) {
+    DecodeResult result{};
+    decode_streams.Run(request.buffer, [this, &request, &result] {
+        MICROPROFILE_SCOPE(OpusDecoder);
+        const auto start_time = system.CoreTiming().GetGlobalTimeUs();
+        result.error_code =
+            request.multi_stream
+                ? DecodePacket<OpusMultiStreamDecodeObject>(request, result.decoded_samples)
+                : DecodePacket<OpusDecodeObject>(request, result.decoded_samples);
+        const auto end_time = system.CoreTiming().GetGlobalTimeUs();
+        result.time_taken_us = static_cast<u64>((end_time - start_time).count());
+    });
+    return result;
+}
+
+void OpusDecoder::RemoveStream(u64 buffer) {
+    const auto metrics = decode_streams.RemoveStream(buffer);
+    if (!metrics) {
+        return;
+    }
+    LOG_DEBUG(Service_Audio,
+              "Opus decode object {:#x}: {} packets, queued {} us avg {} us max, "
+              "decoded {} us avg {} us max",
+              buffer, metrics->jobs, metrics->total_wait_us / metrics->jobs, metrics->max_wait_us,
+              metrics->total_run_us / metrics->jobs, metrics->max_run_us);
+}
+
 void OpusDecoder::Init(std::stop_token stop_token) {
     Common::SetCurrentThreadName("DSP_OpusDecoder_Init");
 
@@ -124,39 +173,19 @@ void OpusDecoder::Main(std::stop_token stop_token) {
         } break;
 
         case DecodeInterleaved: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
-
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
-
-            u32 decoded_samples{0};
-
-            auto& decoder_object = OpusDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
+            const auto result = Decode({
+                .buffer = shared_memory->host_send_data[0],
+                .input_data = shared_memory->host_send_data[1],
+                .input_data_size = shared_memory->host_send_data[2],
+                .output_data = shared_memory->host_send_data[3],
+                .output_data_size = shared_memory->host_send_data[4],
+                .final_range = static_cast<u32>(shared_memory->host_send_data[5]),
+                .reset = shared_memory->host_send_data[6] != 0,
+                .multi_stream = false,
+            });
+            shared_memory->dsp_return_data[0] = result.error_code;
+            shared_memory->dsp_return_data[1] = result.decoded_samples;
+            shared_memory->dsp_return_data[2] = result.time_taken_us;
 
             Send(Direction::Host, Message::DecodeInterleavedOK);
         } break;
@@ -222,39 +251,19 @@ void OpusDecoder::Main(std::stop_token stop_token) {
         } break;
 
         case DecodeInterleavedForMultiStream: {
-            auto start_time = system.CoreTiming().GetGlobalTimeUs();
-
-            auto buffer = shared_memory->host_send_data[0];
-            auto input_data = shared_memory->host_send_data[1];
-            auto input_data_size = shared_memory->host_send_data[2];
-            auto output_data = shared_memory->host_send_data[3];
-            auto output_data_size = shared_memory->host_send_data[4];
-            auto final_range = static_cast<u32>(shared_memory->host_send_data[5]);
-            auto reset_requested = shared_memory->host_send_data[6];
-
-            u32 decoded_samples{0};
-
-            auto& decoder_object = OpusMultiStreamDecodeObject::Initialize(buffer, buffer);
-            s32 error_code{OPUS_OK};
-            if (reset_requested) {
-                error_code = decoder_object.ResetDecoder();
-            }
-
-            if (error_code == OPUS_OK) {
-                error_code = decoder_object.Decode(decoded_samples, output_data, output_data_size,
-                                                   input_data, input_data_size);
-            }
-
-            if (error_code == OPUS_OK) {
-                if (final_range && decoder_object.GetFinalRange() != final_range) {
-                    error_code = OPUS_INVALID_PACKET;
-                }
-            }
-
-            auto end_time = system.CoreTiming().GetGlobalTimeUs();
-            shared_memory->dsp_return_data[0] = error_code;
-            shared_memory->dsp_return_data[1] = decoded_samples;
-            shared_memory->dsp_return_data[2] = (end_time - start_time).count();
+            const auto result = Decode({
+                .buffer = shared_memory->host_send_data[0],
+                .input_data = shared_memory->host_send_data[1],
+                .input_data_size = shared_memory->host_send_data[2],
+                .output_data = shared_memory->host_send_data[3],
+                .output_data_size = shared_memory->host_send_data[4],
+                .final_range = static_cast<u32>(shared_memory->host_send_data[5]),
+                .reset = shared_memory->host_send_data[6] != 0,
+                .multi_stream = true,
+            });
+            shared_memory->dsp_return_data[0] = result.error_code;
+            shared_memory->dsp_return_data[1] = result.decoded_samples;
+            shared_memory->dsp_return_data[2] = result.time_taken_us;
 
             Send(Direction::Host, Message::DecodeInterleavedForMultiStreamOK);
         } break;
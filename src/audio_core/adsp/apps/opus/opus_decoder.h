@@ -6,6 +6,7 @@
 #include <memory>
 #include <thread>
 
+#include "audio_core/adsp/apps/opus/decode_streams.h"
 #include "audio_core/adsp/apps/opus/shared_memory.h"
 #include "audio_core/adsp/mailbox.h"
 #include "common/common_types.h"
@@ -50,6 +51,25 @@ enum Message : u32 {
  */
 class OpusDecoder {
 public:
+    /// A packet to decode, the arguments of the DecodeInterleaved messages
+    struct DecodeRequest {
+        u64 buffer;
+        u64 input_data;
+        u64 input_data_size;
+        u64 output_data;
+        u64 output_data_size;
+        u32 final_range;
+        bool reset;
+        bool multi_stream;
+    };
+
+    /// The returns of the DecodeInterleaved messages
+    struct DecodeResult {
+        s32 error_code;
+        u32 decoded_samples;
+        u64 time_taken_us;
+    };
+
     explicit OpusDecoder(Core::System& system);
     ~OpusDecoder();
 
@@ -64,6 +84,24 @@ public:
         shared_memory = &shared_memory_;
     }
 
+    /**
+     * Decode a packet on the calling thread. Unlike the mailbox, which takes one message at a
+     * time, packets from different decode objects can be decoded concurrently, so any number of
+     * host threads may call this.
+     *
+     * @param request - The packet to decode.
+     * @return The decode result.
+     */
+    DecodeResult Decode(const DecodeRequest& request);
+
+    /**
+     * Forget a decode object when it's destroyed, logging its decode latency.
+     * Waits for a packet of the decode object which is still being decoded.
+     *
+     * @param buffer - Address of the decode object.
+     */
+    void RemoveStream(u64 buffer);
+
 private:
     /**
      * Initializing thread, launched at audio_core boot to avoid blocking the main emu boot thread.
@@ -87,6 +125,8 @@ private:
     /// Structure shared with the host, input data set by the host before sending a mailbox message,
     /// and the responses are written back by the OpusDecoder.
     SharedMemory* shared_memory{};
+    /// Keeps the packets of each decode object one at a time
+    DecodeStreams decode_streams;
 };
 
 } // namespace AudioCore::ADSP::OpusDecoder
@@ -108,8 +108,9 @@ void DeviceSession::AppendBuffers(std::span<const AudioBuffer> buffers) {
 
 void DeviceSession::ReleaseBuffer(const AudioBuffer& buffer) const {
     if (type == Sink::StreamType::In) {
-        auto samples{stream->ReleaseBuffer(buffer.size / sizeof(s16))};
-        handle->GetMemory().WriteBlockUnsafe(buffer.samples, samples.data(), buffer.size);
+        released_samples.resize_destructive(buffer.size / sizeof(s16));
+        stream->ReleaseBuffer(released_samples);
+        handle->GetMemory().WriteBlockUnsafe(buffer.samples, released_samples.data(), buffer.size);
     }
 }
 
@@ -153,6 +153,8 @@ private:
     bool initialized{};
     /// Temporary sample buffer
     Common::ScratchBuffer<s16> tmp_samples{};
+    /// Samples recorded by an audio in stream, written back to the released buffer
+    mutable Common::ScratchBuffer<s16> released_samples{};
 };
 
 } // namespace AudioCore
@@ -26,6 +26,9 @@ OpusDecoder::~OpusDecoder() {
     if (decode_object_initialized) {
         hardware_opus.ShutdownDecodeObject(shared_buffer.get(), shared_buffer_size);
     }
+    if (shared_buffer) {
+        hardware_opus.ReleaseDecodeObject(shared_buffer.get());
+    }
 }
 
 Result OpusDecoder::Initialize(const OpusParametersEx& params,
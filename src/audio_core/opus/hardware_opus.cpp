@@ -149,31 +149,31 @@ Result HardwareOpus::ShutdownMultiStreamDecodeObject(void* buffer, u64 buffer_si
     R_RETURN(ResultCodeFromLibOpusErrorCode(shared_memory.dsp_return_data[0]));
 }
 
+void HardwareOpus::ReleaseDecodeObject(void* buffer) {
+    // The decode object's memory is about to be freed, so its stream must not outlive it
+    opus_decoder.RemoveStream(reinterpret_cast<u64>(buffer));
+}
+
 Result HardwareOpus::DecodeInterleaved(u32& out_sample_count, void* output_data,
                                        u64 output_data_size, u32 channel_count, void* input_data,
                                        u64 input_data_size, void* buffer, u64& out_time_taken,
                                        bool reset) {
-    std::scoped_lock l{mutex};
-    shared_memory.host_send_data[0] = (u64)buffer;
-    shared_memory.host_send_data[1] = (u64)input_data;
-    shared_memory.host_send_data[2] = input_data_size;
-    shared_memory.host_send_data[3] = (u64)output_data;
-    shared_memory.host_send_data[4] = output_data_size;
-    shared_memory.host_send_data[5] = 0;
-    shared_memory.host_send_data[6] = reset;
-
-    opus_decoder.Send(ADSP::Direction::DSP, ADSP::OpusDecoder::Message::DecodeInterleaved);
-    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
-    if (msg != ADSP::OpusDecoder::Message::DecodeInterleavedOK) {
-        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
-                  ADSP::OpusDecoder::Message::DecodeInterleavedOK, msg);
-        R_THROW(ResultInvalidOpusDSPReturnCode);
-    }
-
-    auto error_code{static_cast<s32>(shared_memory.dsp_return_data[0])};
+    // Decodes skip the mailbox, so sessions with their own decode objects don't wait on each other
+    const auto result = opus_decoder.Decode({
+        .buffer = reinterpret_cast<u64>(buffer),
+        .input_data = reinterpret_cast<u64>(input_data),
+        .input_data_size = input_data_size,
+        .output_data = reinterpret_cast<u64>(output_data),
+        .output_data_size = output_data_size,
+        .final_range = 0,
+        .reset = reset,
+        .multi_stream = false,
+    });
+
+    const auto error_code{result.error_code};
     if (error_code == OPUS_OK) {
-        out_sample_count = static_cast<u32>(shared_memory.dsp_return_data[1]);
-        out_time_taken = 1000 * shared_memory.dsp_return_data[2];
+        out_sample_count = result.decoded_samples;
+        out_time_taken = 1000 * result.time_taken_us;
     }
     R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
 }
@@ -183,28 +183,21 @@ Result HardwareOpus::DecodeInterleavedForMultiStream(u32& out_sample_count, void
                                                      void* input_data, u64 input_data_size,
                                                      void* buffer, u64& out_time_taken,
                                                      bool reset) {
-    std::scoped_lock l{mutex};
-    shared_memory.host_send_data[0] = (u64)buffer;
-    shared_memory.host_send_data[1] = (u64)input_data;
-    shared_memory.host_send_data[2] = input_data_size;
-    shared_memory.host_send_data[3] = (u64)output_data;
-    shared_memory.host_send_data[4] = output_data_size;
-    shared_memory.host_send_data[5] = 0;
-    shared_memory.host_send_data[6] = reset;
-
-    opus_decoder.Send(ADSP::Direction::DSP,
-                      ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStream);
-    auto msg = opus_decoder.Receive(ADSP::Direction::Host);
-    if (msg != ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamOK) {
-        LOG_ERROR(Service_Audio, "OpusDecoder returned invalid message. Expected {} got {}",
-                  ADSP::OpusDecoder::Message::DecodeInterleavedForMultiStreamOK, msg);
-        R_THROW(ResultInvalidOpusDSPReturnCode);
-    }
-
-    auto error_code{static_cast<s32>(shared_memory.dsp_return_data[0])};
+    const auto result = opus_decoder.Decode({
+        .buffer = reinterpret_cast<u64>(buffer),
+        .input_data = reinterpret_cast<u64>(input_data),
+        .input_data_size = input_data_size,
+        .output_data = reinterpret_cast<u64>(output_data),
+        .output_data_size = output_data_size,
+        .final_range = 0,
+        .reset = reset,
+        .multi_stream = true,
+    });
+
+    const auto error_code{result.error_code};
     if (error_code == OPUS_OK) {
-        out_sample_count = static_cast<u32>(shared_memory.dsp_return_data[1]);
-        out_time_taken = 1000 * shared_memory.dsp_return_data[2];
+        out_sample_count = result.decoded_samples;
+        out_time_taken = 1000 * result.time_taken_us;
     }
     R_RETURN(ResultCodeFromLibOpusErrorCode(error_code));
 }
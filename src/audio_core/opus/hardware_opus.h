@@ -26,6 +26,7 @@ public:
                                              const void* mappings, void* buffer, u64 buffer_size);
     Result ShutdownDecodeObject(void* buffer, u64 buffer_size);
     Result ShutdownMultiStreamDecodeObject(void* buffer, u64 buffer_size);
+    void ReleaseDecodeObject(void* buffer);
     Result DecodeInterleaved(u32& out_sample_count, void* output_data, u64 output_data_size,
                              u32 channel_count, void* input_data, u64 input_data_size, void* buffer,
                              u64& out_time_taken, bool reset);
@@ -0,0 +1,761 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "audio_core/renderer/command/command_list_capture.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/commands.h"
+#include "audio_core/renderer/effect/aux_.h"
+#include "audio_core/renderer/upsampler/upsampler_info.h"
+#include "common/fs/file.h"
+#include "common/fs/fs.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/memory.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+/// A command type, with the id it is generated with.
+template <CommandId Id, typename T>
+struct CapturedCommand {
+    static constexpr CommandId Type{Id};
+    using Command = T;
+};
+
+/// Every command which can be captured.
+using CapturedCommands = std::tuple<
+    CapturedCommand<CommandId::DataSourcePcmInt16Version1, PcmInt16DataSourceVersion1Command>,
+    CapturedCommand<CommandId::DataSourcePcmInt16Version2, PcmInt16DataSourceVersion2Command>,
+    CapturedCommand<CommandId::DataSourcePcmFloatVersion1, PcmFloatDataSourceVersion1Command>,
+    CapturedCommand<CommandId::DataSourcePcmFloatVersion2, PcmFloatDataSourceVersion2Command>,
+    CapturedCommand<CommandId::DataSourceAdpcmVersion1, AdpcmDataSourceVersion1Command>,
+    CapturedCommand<CommandId::DataSourceAdpcmVersion2, AdpcmDataSourceVersion2Command>,
+    CapturedCommand<CommandId::Volume, VolumeCommand>,
+    CapturedCommand<CommandId::VolumeRamp, VolumeRampCommand>,
+    CapturedCommand<CommandId::BiquadFilter, BiquadFilterCommand>,
+    CapturedCommand<CommandId::Mix, MixCommand>,
+    CapturedCommand<CommandId::MixRamp, MixRampCommand>,
+    CapturedCommand<CommandId::MixRampGrouped, MixRampGroupedCommand>,
+    CapturedCommand<CommandId::DepopPrepare, DepopPrepareCommand>,
+    CapturedCommand<CommandId::DepopForMixBuffers, DepopForMixBuffersCommand>,
+    CapturedCommand<CommandId::Delay, DelayCommand>,
+    CapturedCommand<CommandId::Upsample, UpsampleCommand>,
+    CapturedCommand<CommandId::DownMix6chTo2ch, DownMix6chTo2chCommand>,
+    CapturedCommand<CommandId::Aux, AuxCommand>,
+    CapturedCommand<CommandId::DeviceSink, DeviceSinkCommand>,
+    CapturedCommand<CommandId::CircularBufferSink, CircularBufferSinkCommand>,
+    CapturedCommand<CommandId::Reverb, ReverbCommand>,
+    CapturedCommand<CommandId::I3dl2Reverb, I3dl2ReverbCommand>,
+    CapturedCommand<CommandId::Performance, PerformanceCommand>,
+    CapturedCommand<CommandId::ClearMixBuffer, ClearMixBufferCommand>,
+    CapturedCommand<CommandId::CopyMixBuffer, CopyMixBufferCommand>,
+    CapturedCommand<CommandId::LightLimiterVersion1, LightLimiterVersion1Command>,
+    CapturedCommand<CommandId::LightLimiterVersion2, LightLimiterVersion2Command>,
+    CapturedCommand<CommandId::MultiTapBiquadFilter, MultiTapBiquadFilterCommand>,
+    CapturedCommand<CommandId::Capture, CaptureCommand>,
+    CapturedCommand<CommandId::Compressor, CompressorCommand>>;
+
+/**
+ * Call a function with the type of the command generated with the given id.
+ *
+ * @param type - Id of the command.
+ * @param func - Function to call with a std::type_identity of the command type.
+ * @return True if the id is of a command which can be captured, otherwise false.
+ */
+template <typename F>
+bool VisitCommandType(CommandId type, F&& func) {
+    return std::apply(
+        [&]<typename... Entries>(Entries...) {
+            return ((Entries::Type == type &&
+                     (func(std::type_identity<typename Entries::Command>{}), true)) ||
+                    ...);
+        },
+        CapturedCommands{});
+}
+
+/// Fields every command starts with.
+constexpr std::tuple CommonFields{&ICommand::magic,
+                                  &ICommand::enabled,
+                                  &ICommand::type,
+                                  &ICommand::size,
+                                  &ICommand::estimated_process_time,
+                                  &ICommand::node_id};
+
+/// Fields of each command type written to a capture after the common ones, in order.
+template <typename T>
+struct CommandFields;
+
+template <typename T>
+    requires std::is_same_v<T, PcmInt16DataSourceVersion1Command> ||
+             std::is_same_v<T, PcmInt16DataSourceVersion2Command> ||
+             std::is_same_v<T, PcmFloatDataSourceVersion1Command> ||
+             std::is_same_v<T, PcmFloatDataSourceVersion2Command>
+struct CommandFields<T> {
+    static constexpr std::tuple Members{&T::src_quality, &T::output_index, &T::flags,
+                                        &T::sample_rate, &T::pitch, &T::channel_index,
+                                        &T::channel_count, &T::wave_buffers, &T::voice_state};
+};
+
+template <>
+struct CommandFields<AdpcmDataSourceVersion1Command> {
+    using T = AdpcmDataSourceVersion1Command;
+    static constexpr std::tuple Members{&T::src_quality, &T::output_index, &T::flags,
+                                        &T::sample_rate, &T::pitch, &T::wave_buffers,
+                                        &T::voice_state, &T::data_address, &T::data_size};
+};
+
+template <>
+struct CommandFields<AdpcmDataSourceVersion2Command> {
+    using T = AdpcmDataSourceVersion2Command;
+    static constexpr std::tuple Members{&T::src_quality, &T::output_index, &T::flags,
+                                        &T::sample_rate, &T::pitch, &T::channel_index,
+                                        &T::channel_count, &T::wave_buffers, &T::voice_state,
+                                        &T::data_address, &T::data_size};
+};
+
+template <typename T>
+    requires std::is_same_v<T, VolumeCommand> || std::is_same_v<T, MixCommand>
+struct CommandFields<T> {
+    static constexpr std::tuple Members{&T::precision, &T::input_index, &T::output_index,
+                                        &T::volume};
+};
+
+template <>
+struct CommandFields<VolumeRampCommand> {
+    using T = VolumeRampCommand;
+    static constexpr std::tuple Members{&T::precision, &T::input_index, &T::output_index,
+                                        &T::prev_volume, &T::volume};
+};
+
+template <>
+struct CommandFields<BiquadFilterCommand> {
+    using T = BiquadFilterCommand;
+    static constexpr std::tuple Members{&T::input, &T::output, &T::biquad, &T::state,
+                                        &T::needs_init, &T::use_float_processing};
+};
+
+template <>
+struct CommandFields<MixRampCommand> {
+    using T = MixRampCommand;
+    static constexpr std::tuple Members{&T::precision, &T::input_index, &T::output_index,
+                                        &T::prev_volume, &T::volume, &T::previous_sample};
+};
+
+template <>
+struct CommandFields<MixRampGroupedCommand> {
+    using T = MixRampGroupedCommand;
+    static constexpr std::tuple Members{&T::precision, &T::buffer_count, &T::inputs, &T::outputs,
+                                        &T::prev_volumes, &T::volumes, &T::previous_samples};
+};
+
+template <>
+struct CommandFields<DepopPrepareCommand> {
+    using T = DepopPrepareCommand;
+    static constexpr std::tuple Members{&T::inputs, &T::previous_samples, &T::buffer_count,
+                                        &T::depop_buffer};
+};
+
+template <>
+struct CommandFields<DepopForMixBuffersCommand> {
+    using T = DepopForMixBuffersCommand;
+    static constexpr std::tuple Members{&T::input, &T::count, &T::decay, &T::depop_buffer};
+};
+
+template <typename T>
+    requires std::is_same_v<T, DelayCommand> || std::is_same_v<T, I3dl2ReverbCommand> ||
+             std::is_same_v<T, LightLimiterVersion1Command> ||
+             std::is_same_v<T, CompressorCommand>
+struct CommandFields<T> {
+    static constexpr std::tuple Members{&T::inputs, &T::outputs, &T::parameter, &T::state,
+                                        &T::workbuffer, &T::effect_enabled};
+};
+
+template <>
+struct CommandFields<ReverbCommand> {
+    using T = ReverbCommand;
+    static constexpr std::tuple Members{&T::inputs, &T::outputs, &T::parameter, &T::state,
+                                        &T::workbuffer, &T::effect_enabled,
+                                        &T::long_size_pre_delay_supported};
+};
+
+template <>
+struct CommandFields<LightLimiterVersion2Command> {
+    using T = LightLimiterVersion2Command;
+    static constexpr std::tuple Members{&T::inputs, &T::outputs, &T::parameter, &T::state,
+                                        &T::workbuffer, &T::result_state, &T::effect_enabled};
+};
+
+template <>
+struct CommandFields<UpsampleCommand> {
+    using T = UpsampleCommand;
+    static constexpr std::tuple Members{&T::samples_buffer, &T::inputs, &T::buffer_count,
+                                        &T::unk_20, &T::source_sample_count, &T::source_sample_rate,
+                                        &T::upsampler_info};
+};
+
+template <>
+struct CommandFields<DownMix6chTo2chCommand> {
+    using T = DownMix6chTo2chCommand;
+    static constexpr std::tuple Members{&T::inputs, &T::outputs, &T::down_mix_coeff};
+};
+
+template <>
+struct CommandFields<AuxCommand> {
+    using T = AuxCommand;
+    static constexpr std::tuple Members{&T::input, &T::output, &T::send_buffer_info,
+                                        &T::return_buffer_info, &T::send_buffer, &T::return_buffer,
+                                        &T::count_max, &T::write_offset, &T::update_count,
+                                        &T::effect_enabled};
+};
+
+template <>
+struct CommandFields<DeviceSinkCommand> {
+    using T = DeviceSinkCommand;
+    static constexpr std::tuple Members{&T::name, &T::session_id, &T::sample_buffer,
+                                        &T::input_count, &T::inputs};
+};
+
+template <>
+struct CommandFields<CircularBufferSinkCommand> {
+    using T = CircularBufferSinkCommand;
+    static constexpr std::tuple Members{&T::input_count, &T::inputs, &T::address, &T::size,
+                                        &T::pos};
+};
+
+template <>
+struct CommandFields<PerformanceCommand> {
+    using T = PerformanceCommand;
+    static constexpr std::tuple Members{&T::state, &T::entry_address};
+};
+
+template <>
+struct CommandFields<ClearMixBufferCommand> {
+    static constexpr std::tuple<> Members{};
+};
+
+template <>
+struct CommandFields<CopyMixBufferCommand> {
+    using T = CopyMixBufferCommand;
+    static constexpr std::tuple Members{&T::input_index, &T::output_index};
+};
+
+template <>
+struct CommandFields<MultiTapBiquadFilterCommand> {
+    using T = MultiTapBiquadFilterCommand;
+    static constexpr std::tuple Members{&T::input, &T::output, &T::biquads, &T::states,
+                                        &T::needs_init, &T::filter_tap_count};
+};
+
+template <>
+struct CommandFields<CaptureCommand> {
+    using T = CaptureCommand;
+    static constexpr std::tuple Members{&T::input, &T::output, &T::send_buffer_info,
+                                        &T::send_buffer, &T::count_max, &T::write_offset,
+                                        &T::update_count, &T::effect_enabled};
+};
+
+/// All fields of a command written to a capture, in order.
+template <typename T>
+constexpr auto AllFields() {
+    return std::tuple_cat(CommonFields, CommandFields<T>::Members);
+}
+
+template <typename C, typename V>
+constexpr u64 FieldSize(V C::*) {
+    return sizeof(V);
+}
+
+template <typename V>
+void AppendField(std::vector<u8>& out, const V& value) {
+    static_assert(std::is_trivially_copyable_v<V>, "Captured fields must be trivially copyable");
+    const auto bytes{reinterpret_cast<const u8*>(&value)};
+    out.insert(out.end(), bytes, bytes + sizeof(V));
+}
+
+template <typename V>
+bool ReadField(std::span<const u8>& in, V& value) {
+    if (in.size() < sizeof(V)) {
+        return false;
+    }
+    std::memcpy(&value, in.data(), sizeof(V));
+    in = in.subspan(sizeof(V));
+    return true;
+}
+
+template <typename T>
+void WriteFields(const T& command, std::vector<u8>& out) {
+    std::apply([&](auto... members) { (AppendField(out, command.*members), ...); },
+               AllFields<T>());
+}
+
+template <typename T>
+bool ReadFields(T& command, std::span<const u8>& in) {
+    return std::apply([&](auto... members) { return (ReadField(in, command.*members) && ...); },
+                      AllFields<T>());
+}
+
+/// Mix a size into an FNV-1a hash.
+constexpr u64 HashSize(u64 hash, u64 size) {
+    for (u32 i = 0; i < sizeof(u64); i++) {
+        hash ^= (size >> (i * 8)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+constexpr u64 ComputeLayoutHash() {
+    u64 hash{0xCBF29CE484222325ULL};
+    std::apply(
+        [&]<typename... Entries>(Entries...) {
+            const auto hash_command{[&]<typename T>(CommandId type, std::type_identity<T>) {
+                hash = HashSize(hash, static_cast<u64>(type));
+                hash = HashSize(hash, sizeof(T));
+                std::apply(
+                    [&](auto... members) { ((hash = HashSize(hash, FieldSize(members))), ...); },
+                    AllFields<T>());
+            }};
+            (hash_command(Entries::Type, std::type_identity<typename Entries::Command>{}), ...);
+        },
+        CapturedCommands{});
+
+    // States the commands point to are replayed from the raw workbuffer
+    for (const u64 size :
+         {sizeof(CommandListHeader), sizeof(VoiceState), sizeof(UpsamplerInfo),
+          sizeof(DelayInfo::State), sizeof(ReverbInfo::State), sizeof(I3dl2ReverbInfo::State),
+          sizeof(LightLimiterInfo::State), sizeof(CompressorInfo::State)}) {
+        hash = HashSize(hash, size);
+    }
+    return hash;
+}
+
+/// Address space covered by the page table of a replayed capture.
+constexpr size_t MaxGuestAddressSpaceBits{39};
+
+/// Guest memory ranges accessed by the commands, as address and size.
+using GuestRanges = std::vector<std::pair<CpuAddr, u64>>;
+
+template <typename T>
+void AddGuestRanges(const T& command, GuestRanges& ranges) {
+    if constexpr (requires { command.wave_buffers; }) {
+        for (const auto& wave_buffer : command.wave_buffers) {
+            ranges.emplace_back(wave_buffer.buffer, wave_buffer.buffer_size);
+            ranges.emplace_back(wave_buffer.context, wave_buffer.context_size);
+        }
+    }
+    if constexpr (requires { command.data_address; }) {
+        ranges.emplace_back(command.data_address, command.data_size);
+    }
+}
+
+void AddGuestRanges(const AuxCommand& command, GuestRanges& ranges) {
+    ranges.emplace_back(command.send_buffer_info, sizeof(AuxInfo::AuxBufferInfo));
+    ranges.emplace_back(command.return_buffer_info, sizeof(AuxInfo::AuxBufferInfo));
+    ranges.emplace_back(command.send_buffer, u64{command.count_max} * sizeof(s32));
+    ranges.emplace_back(command.return_buffer, u64{command.count_max} * sizeof(s32));
+}
+
+void AddGuestRanges(const CaptureCommand& command, GuestRanges& ranges) {
+    ranges.emplace_back(command.send_buffer_info, sizeof(AuxInfo::AuxBufferInfo));
+    ranges.emplace_back(command.send_buffer, u64{command.count_max} * sizeof(s32));
+}
+
+void AddGuestRanges(const CircularBufferSinkCommand& command, GuestRanges& ranges) {
+    ranges.emplace_back(command.address, command.size);
+}
+
+/**
+ * Round guest ranges out to whole pages, and merge the ones which touch.
+ *
+ * @param ranges - Ranges to merge, as address and size.
+ * @return Sorted page aligned regions, as address and size.
+ */
+GuestRanges MergeGuestRanges(GuestRanges ranges) {
+    using Core::Memory::CITRON_PAGEMASK;
+    std::erase_if(ranges, [](const auto& range) {
+        return range.first == 0 || range.second == 0 ||
+               range.first + range.second > (1ULL << MaxGuestAddressSpaceBits);
+    });
+    for (auto& [address, size] : ranges) {
+        const auto end{(address + size + CITRON_PAGEMASK) & ~CITRON_PAGEMASK};
+        address &= ~CITRON_PAGEMASK;
+        size = end - address;
+    }
+    std::ranges::sort(ranges);
+
+    GuestRanges regions;
+    for (const auto& [address, size] : ranges) {
+        if (!regions.empty() && address <= regions.back().first + regions.back().second) {
+            auto& region{regions.back()};
+            region.second = std::max(region.second, address + size - region.first);
+        } else {
+            regions.emplace_back(address, size);
+        }
+    }
+    return regions;
+}
+
+} // Anonymous namespace
+
+const u64 CommandListCapture::LayoutHash{ComputeLayoutHash()};
+
+bool CommandListCapture::Write(const std::filesystem::path& path,
+                               const AudioRendererParameterInternal& parameters,
+                               std::span<const u8> workbuffer, std::span<const u8> command_list,
+                               Core::Memory::Memory& memory) {
+    if (command_list.data() < workbuffer.data() ||
+        command_list.data() + command_list.size() > workbuffer.data() + workbuffer.size() ||
+        command_list.size() < sizeof(CommandListHeader)) {
+        LOG_ERROR(Service_Audio, "Command list is not inside of the workbuffer");
+        return false;
+    }
+
+    const auto& list_header{*reinterpret_cast<const CommandListHeader*>(command_list.data())};
+    std::vector<u8> command_fields;
+    GuestRanges guest_ranges;
+    u64 offset{sizeof(CommandListHeader)};
+    for (u32 index = 0; index < list_header.command_count; index++) {
+        if (offset + sizeof(ICommand) > command_list.size()) {
+            LOG_ERROR(Service_Audio, "Command {} exceeds the command list", index);
+            return false;
+        }
+        const auto& command{*reinterpret_cast<const ICommand*>(command_list.data() + offset)};
+        const auto known{VisitCommandType(command.type, [&]<typename T>(std::type_identity<T>) {
+            const auto& typed{static_cast<const T&>(command)};
+            AppendField(command_fields, command.type);
+            WriteFields(typed, command_fields);
+            AddGuestRanges(typed, guest_ranges);
+        })};
+        if (!known || command.size < static_cast<s16>(sizeof(ICommand)) ||
+            offset + command.size > command_list.size()) {
+            LOG_ERROR(Service_Audio, "Command {} has an unknown type {} or size {:04X}", index,
+                      static_cast<u32>(command.type), command.size);
+            return false;
+        }
+        offset += command.size;
+    }
+
+    const auto guest_regions{MergeGuestRanges(std::move(guest_ranges))};
+    u64 guest_memory_size{};
+    for (const auto& [address, size] : guest_regions) {
+        guest_memory_size += size;
+    }
+
+    if (!Common::FS::CreateParentDirs(path)) {
+        LOG_ERROR(Service_Audio, "Failed to create the directory for {}",
+                  Common::FS::PathToUTF8String(path));
+        return false;
+    }
+
+    const Header header{
+        .magic = Magic,
+        .version = Version,
+        .parameters = parameters,
+        .padding = 0,
+        .layout_hash = LayoutHash,
+        .workbuffer_address = CpuAddr(workbuffer.data()),
+        .workbuffer_size = workbuffer.size(),
+        .command_list_offset = static_cast<u64>(command_list.data() - workbuffer.data()),
+        .command_list_size = command_list.size(),
+        .commands_size = command_fields.size(),
+        .guest_region_count = guest_regions.size(),
+        .guest_memory_size = guest_memory_size,
+    };
+
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write,
+                            Common::FS::FileType::BinaryFile};
+    bool written{file.WriteObject(header) && file.WriteSpan(workbuffer) == workbuffer.size() &&
+                 file.WriteSpan(std::span<const u8>{command_fields}) == command_fields.size()};
+    std::vector<u8> data;
+    for (const auto& [address, size] : guest_regions) {
+        if (!written) {
+            break;
+        }
+        data.resize(size);
+        memory.ReadBlockUnsafe(address, data.data(), size);
+        written = file.WriteObject(address) && file.WriteObject(size) &&
+                  file.WriteSpan(std::span<const u8>{data}) == size;
+    }
+    if (!written) {
+        LOG_ERROR(Service_Audio, "Failed to write {}", Common::FS::PathToUTF8String(path));
+        return false;
+    }
+    return true;
+}
+
+std::optional<CommandListCapture> CommandListCapture::Read(const std::filesystem::path& path) {
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read,
+                                  Common::FS::FileType::BinaryFile};
+    CommandListCapture capture{};
+    auto& header{capture.header};
+    if (!file.ReadObject(header)) {
+        LOG_ERROR(Service_Audio, "Failed to read {}", Common::FS::PathToUTF8String(path));
+        return std::nullopt;
+    }
+
+    if (header.magic != Magic || header.version != Version) {
+        LOG_ERROR(Service_Audio, "{} is not a command list capture, magic {:08X} version {}",
+                  Common::FS::PathToUTF8String(path), header.magic, header.version);
+        return std::nullopt;
+    }
+
+    if (header.layout_hash != LayoutHash) {
+        LOG_ERROR(Service_Audio,
+                  "{} was captured by a build with other command layouts, hash {:016X} "
+                  "expected {:016X}",
+                  Common::FS::PathToUTF8String(path), header.layout_hash, LayoutHash);
+        return std::nullopt;
+    }
+
+    const auto expected_size{sizeof(Header) + header.workbuffer_size + header.commands_size +
+                             header.guest_region_count * 2 * sizeof(u64) +
+                             header.guest_memory_size};
+    if (file.GetSize() != expected_size ||
+        header.command_list_size < sizeof(CommandListHeader) ||
+        header.command_list_offset > header.workbuffer_size ||
+        header.command_list_size > header.workbuffer_size - header.command_list_offset) {
+        LOG_ERROR(Service_Audio, "{} is truncated or has an invalid command list",
+                  Common::FS::PathToUTF8String(path));
+        return std::nullopt;
+    }
+
+    capture.workbuffer = std::make_unique<u8[]>(header.workbuffer_size);
+    capture.command_fields.resize(header.commands_size);
+    bool read{file.ReadSpan(std::span<u8>{capture.workbuffer.get(), header.workbuffer_size}) ==
+                  header.workbuffer_size &&
+              file.ReadSpan(std::span<u8>{capture.command_fields}) == header.commands_size};
+    for (u64 index = 0; read && index < header.guest_region_count; index++) {
+        u64 address{};
+        u64 size{};
+        if (!file.ReadObject(address) || !file.ReadObject(size) ||
+            (address & Core::Memory::CITRON_PAGEMASK) != 0 ||
+            (size & Core::Memory::CITRON_PAGEMASK) != 0 ||
+            address + size > (1ULL << MaxGuestAddressSpaceBits) ||
+            size > header.guest_memory_size) {
+            read = false;
+            break;
+        }
+        auto& region{capture.guest_regions.emplace_back(address, std::vector<u8>(size))};
+        read = file.ReadSpan(std::span<u8>{region.data}) == size;
+    }
+    if (!read) {
+        LOG_ERROR(Service_Audio, "Failed to read {}", Common::FS::PathToUTF8String(path));
+        return std::nullopt;
+    }
+    return capture;
+}
+
+bool CommandListCapture::PrepareReplay() {
+    auto& list_header{*reinterpret_cast<CommandListHeader*>(GetCommandList())};
+    auto samples_buffer{CpuAddr(list_header.samples_buffer.data())};
+    if (!Relocate(samples_buffer)) {
+        LOG_ERROR(Service_Audio, "Mix buffers are not inside of the workbuffer");
+        return false;
+    }
+    list_header.samples_buffer = {reinterpret_cast<s32*>(samples_buffer),
+                                  list_header.samples_buffer.size()};
+
+    std::span<const u8> fields{command_fields};
+    u64 offset{sizeof(CommandListHeader)};
+    for (u32 index = 0; index < list_header.command_count; index++) {
+        auto* command{
+            RestoreCommand(GetCommandList() + offset, header.command_list_size - offset, fields)};
+        if (command == nullptr) {
+            LOG_ERROR(Service_Audio, "Command {} is invalid", index);
+            return false;
+        }
+
+        if (!RelocateCommand(*command)) {
+            if (command->enabled) {
+                disabled_command_count++;
+            }
+            command->enabled = false;
+        }
+        commands.push_back(command);
+        offset += command->size;
+    }
+
+    if (!fields.empty()) {
+        LOG_ERROR(Service_Audio, "Capture has {} bytes of fields past the last command",
+                  fields.size());
+        return false;
+    }
+
+    MapGuestMemory();
+    return true;
+}
+
+CpuAddr CommandListCapture::GetCommandList() const {
+    return CpuAddr(workbuffer.get() + header.command_list_offset);
+}
+
+bool CommandListCapture::Relocate(CpuAddr& address) const {
+    if (address == 0) {
+        return true;
+    }
+    if (address < header.workbuffer_address ||
+        address - header.workbuffer_address >= header.workbuffer_size) {
+        return false;
+    }
+    address = CpuAddr(workbuffer.get()) + (address - header.workbuffer_address);
+    return true;
+}
+
+void CommandListCapture::MarkEffectsInitialized() {
+    for (auto* state : effect_parameter_states) {
+        *state = EffectInfoBase::ParameterState::Updated;
+    }
+}
+
+void CommandListCapture::ResetVoices() {
+    for (auto& [voice_state, captured] : voice_states) {
+        *voice_state = captured;
+    }
+}
+
+ICommand* CommandListCapture::RestoreCommand(CpuAddr address, u64 space,
+                                             std::span<const u8>& fields) {
+    CommandId type{};
+    if (!ReadField(fields, type)) {
+        return nullptr;
+    }
+
+    ICommand* restored{};
+    VisitCommandType(type, [&]<typename T>(std::type_identity<T>) {
+        if (sizeof(T) > space) {
+            return;
+        }
+        auto* command{std::construct_at(reinterpret_cast<T*>(address))};
+        if (ReadFields(*command, fields) && command->magic == CommandMagic &&
+            command->type == type && command->size == static_cast<s16>(sizeof(T))) {
+            restored = command;
+        }
+    });
+    return restored;
+}
+
+bool CommandListCapture::RelocateCommand(ICommand& command) {
+    const auto relocate_voice{[&](auto& restored) {
+        if (!Relocate(restored.voice_state) || restored.voice_state == 0) {
+            return false;
+        }
+        auto* voice_state{reinterpret_cast<VoiceState*>(restored.voice_state)};
+        voice_states.emplace_back(voice_state, *voice_state);
+        return true;
+    }};
+    const auto relocate_state{[&](auto& restored) { return Relocate(restored.state); }};
+    // Effect states hold host allocations of the process that captured them, so they are set up
+    // again on the first run
+    const auto reset_effect{[&]<typename Info>(std::type_identity<Info>) {
+        return [this](auto& restored) {
+            if (!Relocate(restored.state)) {
+                return false;
+            }
+            std::construct_at(reinterpret_cast<typename Info::State*>(restored.state));
+            restored.parameter.state = EffectInfoBase::ParameterState::Initialized;
+            effect_parameter_states.push_back(&restored.parameter.state);
+            return true;
+        };
+    }};
+
+    switch (command.type) {
+    case CommandId::DataSourcePcmInt16Version1:
+        return relocate_voice(static_cast<PcmInt16DataSourceVersion1Command&>(command));
+    case CommandId::DataSourcePcmInt16Version2:
+        return relocate_voice(static_cast<PcmInt16DataSourceVersion2Command&>(command));
+    case CommandId::DataSourcePcmFloatVersion1:
+        return relocate_voice(static_cast<PcmFloatDataSourceVersion1Command&>(command));
+    case CommandId::DataSourcePcmFloatVersion2:
+        return relocate_voice(static_cast<PcmFloatDataSourceVersion2Command&>(command));
+    case CommandId::DataSourceAdpcmVersion1:
+        return relocate_voice(static_cast<AdpcmDataSourceVersion1Command&>(command));
+    case CommandId::DataSourceAdpcmVersion2:
+        return relocate_voice(static_cast<AdpcmDataSourceVersion2Command&>(command));
+    case CommandId::BiquadFilter:
+        return relocate_state(static_cast<BiquadFilterCommand&>(command));
+    case CommandId::MixRamp:
+        return Relocate(static_cast<MixRampCommand&>(command).previous_sample);
+    case CommandId::MixRampGrouped:
+        return Relocate(static_cast<MixRampGroupedCommand&>(command).previous_samples);
+    case CommandId::DepopPrepare: {
+        auto& restored{static_cast<DepopPrepareCommand&>(command)};
+        return Relocate(restored.previous_samples) && Relocate(restored.depop_buffer);
+    }
+    case CommandId::DepopForMixBuffers:
+        return Relocate(static_cast<DepopForMixBuffersCommand&>(command).depop_buffer);
+    case CommandId::Delay:
+        return reset_effect(std::type_identity<DelayInfo>{})(static_cast<DelayCommand&>(command));
+    case CommandId::Upsample: {
+        auto& restored{static_cast<UpsampleCommand&>(command)};
+        return Relocate(restored.samples_buffer) && Relocate(restored.inputs) &&
+               Relocate(restored.upsampler_info) && restored.upsampler_info != 0;
+    }
+    case CommandId::DeviceSink: {
+        auto& restored{static_cast<DeviceSinkCommand&>(command)};
+        auto sample_buffer{CpuAddr(restored.sample_buffer.data())};
+        if (!Relocate(sample_buffer)) {
+            return false;
+        }
+        restored.sample_buffer = {reinterpret_cast<s32*>(sample_buffer),
+                                  restored.sample_buffer.size()};
+        return true;
+    }
+    case CommandId::Reverb:
+        return reset_effect(std::type_identity<ReverbInfo>{})(static_cast<ReverbCommand&>(command));
+    case CommandId::I3dl2Reverb:
+        return reset_effect(std::type_identity<I3dl2ReverbInfo>{})(
+            static_cast<I3dl2ReverbCommand&>(command));
+    case CommandId::Performance: {
+        auto& restored{static_cast<PerformanceCommand&>(command)};
+        return Relocate(restored.entry_address.translated_address) &&
+               restored.entry_address.translated_address != 0;
+    }
+    case CommandId::LightLimiterVersion1:
+        return reset_effect(std::type_identity<LightLimiterInfo>{})(
+            static_cast<LightLimiterVersion1Command&>(command));
+    case CommandId::LightLimiterVersion2: {
+        auto& restored{static_cast<LightLimiterVersion2Command&>(command)};
+        return Relocate(restored.result_state) &&
+               reset_effect(std::type_identity<LightLimiterInfo>{})(restored);
+    }
+    case CommandId::MultiTapBiquadFilter:
+        return std::ranges::all_of(static_cast<MultiTapBiquadFilterCommand&>(command).states,
+                                   [&](CpuAddr& state) { return Relocate(state); });
+    case CommandId::Compressor:
+        return reset_effect(std::type_identity<CompressorInfo>{})(
+            static_cast<CompressorCommand&>(command));
+    default:
+        // Other commands only hold mix buffer indexes, or guest addresses which are mapped by
+        // MapGuestMemory
+        return true;
+    }
+}
+
+void CommandListCapture::MapGuestMemory() {
+    using Core::Memory::CITRON_PAGEBITS;
+    u64 end{1ULL << (CITRON_PAGEBITS + 1)};
+    for (const auto& region : guest_regions) {
+        end = std::max<u64>(end, region.address + region.data.size());
+    }
+
+    guest_page_table = std::make_unique<Common::PageTable>();
+    guest_page_table->Resize(std::bit_width(end - 1), CITRON_PAGEBITS);
+    for (auto& region : guest_regions) {
+        // Pages of a region are backed by consecutive host memory, so they store the same pointer
+        const auto pointer{reinterpret_cast<uintptr_t>(region.data.data()) - region.address};
+        const u64 first_page{region.address >> CITRON_PAGEBITS};
+        const u64 page_count{region.data.size() >> CITRON_PAGEBITS};
+        for (u64 page = first_page; page < first_page + page_count; page++) {
+            guest_page_table->pointers[page].Store(pointer, Common::PageType::Memory);
+            guest_page_table->blocks[page] = region.address;
+        }
+    }
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,180 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "audio_core/common/audio_renderer_parameter.h"
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/effect/effect_info_base.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "common/page_table.h"
+
+namespace Core::Memory {
+class Memory;
+}
+
+namespace AudioCore::Renderer {
+struct ICommand;
+
+/**
+ * A command list captured from a running renderer, which can be run again offline.
+ *
+ * The capture holds the renderer parameters, the whole renderer workbuffer with the voice, mix and
+ * effect states the commands point to, the fields of every command, and the guest memory read or
+ * written by the commands, such as wave buffers and aux buffers. Commands point into the
+ * workbuffer with host addresses of the process that captured it, they are moved to wherever the
+ * workbuffer is loaded before replaying. Guest memory is mapped at its captured addresses in a page
+ * table of its own.
+ */
+class CommandListCapture {
+public:
+    static constexpr u32 Magic{Common::MakeMagic('A', 'C', 'L', 'C')};
+    static constexpr u32 Version{2};
+
+    struct Header {
+        /* 0x00 */ u32 magic;
+        /* 0x04 */ u32 version;
+        /* 0x08 */ AudioRendererParameterInternal parameters;
+        /* 0x3C */ u32 padding;
+        /* 0x40 */ u64 layout_hash;
+        /* 0x48 */ u64 workbuffer_address;
+        /* 0x50 */ u64 workbuffer_size;
+        /* 0x58 */ u64 command_list_offset;
+        /* 0x60 */ u64 command_list_size;
+        /* 0x68 */ u64 commands_size;
+        /* 0x70 */ u64 guest_region_count;
+        /* 0x78 */ u64 guest_memory_size;
+    };
+    static_assert(sizeof(Header) == 0x80, "CommandListCapture::Header has the wrong size!");
+
+    /**
+     * Hash of the layout of the commands and of the workbuffer states they point to. Captures are
+     * only replayed by builds with the same layout.
+     */
+    static const u64 LayoutHash;
+
+    /**
+     * Write a command list, the workbuffer it was generated in, and the guest memory its commands
+     * access to a file.
+     *
+     * @param path         - File to write the capture to.
+     * @param parameters   - Parameters the renderer was opened with.
+     * @param workbuffer   - Renderer workbuffer.
+     * @param command_list - Command list to capture, including its header, inside the workbuffer.
+     * @param memory       - Guest memory of the process the command list was generated for.
+     * @return True if the capture was written, otherwise false.
+     */
+    static bool Write(const std::filesystem::path& path,
+                      const AudioRendererParameterInternal& parameters,
+                      std::span<const u8> workbuffer, std::span<const u8> command_list,
+                      Core::Memory::Memory& memory);
+
+    /**
+     * Read a capture written by Write.
+     *
+     * @param path - File to read the capture from.
+     * @return The capture, or nullopt if the file could not be read or is not a capture.
+     */
+    static std::optional<CommandListCapture> Read(const std::filesystem::path& path);
+
+    /**
+     * Make the command list runnable in this process. Commands are constructed from their captured
+     * fields, their addresses are moved into the loaded workbuffer, the captured guest memory is
+     * mapped, and effect states holding host allocations are set up again on the first run.
+     * Commands pointing outside of the workbuffer are disabled.
+     *
+     * Must only be called once.
+     *
+     * @return True if the command list is valid, otherwise false.
+     */
+    bool PrepareReplay();
+
+    /// Let the effects set up by the first run of the list update, as they do on later frames.
+    void MarkEffectsInitialized();
+
+    /// Rewind the voices of the data source commands, so every run plays the same samples.
+    void ResetVoices();
+
+    const AudioRendererParameterInternal& GetParameters() const {
+        return header.parameters;
+    }
+
+    /// Address of the command list, including its header.
+    CpuAddr GetCommandList() const;
+
+    u64 GetCommandListSize() const {
+        return header.command_list_size;
+    }
+
+    /// Commands of the list, valid once prepared.
+    std::span<ICommand* const> GetCommands() const {
+        return commands;
+    }
+
+    /// Number of commands disabled because they cannot run offline.
+    u32 GetDisabledCommandCount() const {
+        return disabled_command_count;
+    }
+
+    /// Page table mapping the captured guest memory, valid once prepared.
+    Common::PageTable& GetGuestPageTable() {
+        return *guest_page_table;
+    }
+
+private:
+    /// Guest memory accessed by the commands, covering whole pages.
+    struct GuestRegion {
+        u64 address;
+        std::vector<u8> data;
+    };
+
+    /**
+     * Move an address pointing into the captured workbuffer to the loaded one.
+     *
+     * @param address - Address to move, null addresses are left alone.
+     * @return True if the address was moved, false if it points outside of the workbuffer.
+     */
+    bool Relocate(CpuAddr& address) const;
+
+    /**
+     * Construct the next command of the list from its captured fields.
+     *
+     * @param address - Address in the command list to construct the command at.
+     * @param space   - Bytes left in the command list at address.
+     * @param fields  - Captured fields, advanced past the ones of this command.
+     * @return The command, or nullptr if the fields are not those of a known command.
+     */
+    ICommand* RestoreCommand(CpuAddr address, u64 space, std::span<const u8>& fields);
+
+    /**
+     * Move a restored command's workbuffer addresses, and set up the state it needs offline.
+     *
+     * @param command - Command to relocate.
+     * @return True if the command can run offline, otherwise false.
+     */
+    bool RelocateCommand(ICommand& command);
+
+    /// Map the captured guest memory into guest_page_table.
+    void MapGuestMemory();
+
+    Header header{};
+    std::unique_ptr<u8[]> workbuffer{};
+    std::vector<u8> command_fields{};
+    std::vector<GuestRegion> guest_regions{};
+    std::unique_ptr<Common::PageTable> guest_page_table{};
+    std::vector<ICommand*> commands{};
+    std::vector<EffectInfoBase::ParameterState*> effect_parameter_states{};
+    std::vector<std::pair<VoiceState*, VoiceState>> voice_states{};
+    u32 disabled_command_count{};
+};
+
+} // namespace AudioCore::Renderer
@@ -5,6 +5,7 @@
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/data_source/adpcm.h"
+#include "audio_core/renderer/command/data_source/adpcm_lookahead.h"
 #include "audio_core/renderer/command/data_source/decode.h"
 
 namespace AudioCore::Renderer {
@@ -42,6 +43,9 @@ void AdpcmDataSourceVersion1Command::Process(const AudioRenderer::CommandListPro
         .data_size{data_size},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
+        .adpcm_lookahead{processor.adpcm_lookahead != nullptr
+                             ? processor.adpcm_lookahead->Get(voice_state)
+                             : nullptr},
     };
 
     DecodeFromWaveBuffers(*processor.memory, args);
@@ -78,6 +82,9 @@ void AdpcmDataSourceVersion2Command::Process(const AudioRenderer::CommandListPro
         .data_size{data_size},
         .IsVoicePlayedSampleCountResetAtLoopPointSupported{(flags & 1) != 0},
         .IsVoicePitchAndSrcSkippedSupported{(flags & 2) != 0},
+        .adpcm_lookahead{processor.adpcm_lookahead != nullptr
+                             ? processor.adpcm_lookahead->Get(voice_state)
+                             : nullptr},
     };
 
     DecodeFromWaveBuffers(*processor.memory, args);
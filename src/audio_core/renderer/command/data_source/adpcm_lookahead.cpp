@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "audio_core/renderer/command/data_source/adpcm_lookahead.h"
+#include "audio_core/renderer/command/data_source/decode_kernels.h"
+
+namespace AudioCore::Renderer {
+
+u32 AdpcmLookahead::Read(CpuAddr buffer, u32 position, const std::array<s16, 16>& coefficients,
+                         VoiceState::AdpcmContext& context, std::span<const u8> frames,
+                         std::span<s16> output) {
+    for (auto& window : windows) {
+        const auto sample_count{static_cast<u32>(window.samples.size())};
+        if (window.buffer != buffer || position < window.position ||
+            position >= window.position + sample_count || window.coefficients != coefficients) {
+            continue;
+        }
+
+        // The header of the context is only used to decode from the middle of a frame
+        const auto expected{ContextAt(window, position)};
+        if (expected.yn0 != context.yn0 || expected.yn1 != context.yn1 ||
+            (position % AdpcmSamplesPerFrame != 0 && expected.header != context.header)) {
+            continue;
+        }
+
+        const u32 offset{position - window.position};
+        const u32 first_frame{offset / AdpcmSamplesPerFrame};
+        u32 count{std::min(sample_count - offset, static_cast<u32>(output.size()))};
+        const u32 available_frames{static_cast<u32>(frames.size() / AdpcmFrameSize)};
+        const u32 needed_frames{(offset + count - 1) / AdpcmSamplesPerFrame - first_frame + 1};
+        if (needed_frames > available_frames) {
+            count = (first_frame + available_frames) * AdpcmSamplesPerFrame - offset;
+            if (available_frames == 0) {
+                return 0;
+            }
+        }
+
+        // Samples decoded from frames the guest has since rewritten are dropped
+        const u32 frames_size{((offset + count - 1) / AdpcmSamplesPerFrame - first_frame + 1) *
+                              AdpcmFrameSize};
+        if (std::memcmp(frames.data(), &window.frames[first_frame * AdpcmFrameSize],
+                        frames_size) != 0) {
+            window = {};
+            return 0;
+        }
+
+        std::memcpy(output.data(), &window.samples[offset], count * sizeof(s16));
+        context = ContextAt(window, position + count);
+        window.last_use = ++use_count;
+        return count;
+    }
+    return 0;
+}
+
+void AdpcmLookahead::Decode(CpuAddr buffer, u32 position, const std::array<s16, 16>& coefficients,
+                            const VoiceState::AdpcmContext& context,
+                            std::span<const u8> frames) {
+    const size_t frame_count{std::min<size_t>(frames.size() / AdpcmFrameSize, WindowFrames)};
+    auto& window{*std::ranges::min_element(windows, {}, &Window::last_use)};
+    window.buffer = buffer;
+    window.position = position;
+    window.coefficients = coefficients;
+    window.context = context;
+    window.frames.assign(frames.begin(), frames.begin() + frame_count * AdpcmFrameSize);
+    window.samples.resize(frame_count * AdpcmSamplesPerFrame);
+    window.last_use = ++use_count;
+
+    auto end_context{context};
+    DecodeAdpcmFrames(window.samples, window.frames, coefficients, end_context);
+}
+
+bool AdpcmLookahead::Contains(CpuAddr buffer, u32 position,
+                              const std::array<s16, 16>& coefficients,
+                              const VoiceState::AdpcmContext& context) const {
+    return std::ranges::any_of(windows, [&](const Window& window) {
+        return window.buffer == buffer && window.position == position && !window.samples.empty() &&
+               window.coefficients == coefficients && window.context.yn0 == context.yn0 &&
+               window.context.yn1 == context.yn1;
+    });
+}
+
+VoiceState::AdpcmContext AdpcmLookahead::ContextAt(const Window& window, u32 position) {
+    if (position == window.position) {
+        return window.context;
+    }
+    const u32 offset{position - window.position};
+    const u32 frame{(offset - 1) / AdpcmSamplesPerFrame};
+    return {
+        .header{window.frames[frame * AdpcmFrameSize]},
+        .yn0{window.samples[offset - 1]},
+        .yn1{offset >= 2 ? window.samples[offset - 2] : window.context.yn0},
+    };
+}
+
+AdpcmLookahead* AdpcmLookaheadCache::Get(CpuAddr voice_state) {
+    std::scoped_lock lock{mutex};
+    auto it{lookaheads.find(voice_state)};
+    if (it == lookaheads.end()) {
+        if (lookaheads.size() >= MaxVoices) {
+            return nullptr;
+        }
+        it = lookaheads.emplace(voice_state, std::make_unique<AdpcmLookahead>()).first;
+    }
+    return it->second.get();
+}
+
+void AdpcmLookaheadCache::Clear() {
+    std::scoped_lock lock{mutex};
+    lookaheads.clear();
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "audio_core/common/common.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/**
+ * Samples of the ADPCM wave buffers of a voice, decoded in whole frames ahead of the render
+ * passes which play them.
+ *
+ * Each window holds the samples decoded from a frame of a wave buffer onwards, along with the
+ * context and coefficients they were decoded with, and a copy of the frames they were decoded
+ * from. Samples are only reused when playback continues from the same context with the same
+ * coefficients, and the frames in guest memory still match the copy, so a guest rewriting a wave
+ * buffer never plays stale samples.
+ *
+ * Only the commands of its voice use a lookahead, which run one at a time.
+ */
+class AdpcmLookahead {
+public:
+    /// Number of frames decoded into a window at once
+    static constexpr u32 WindowFrames = 64;
+    /// Number of windows kept, enough for a short loop and the buffers around it
+    static constexpr size_t NumWindows = 3;
+
+    /**
+     * Copy decoded samples from a position of a wave buffer.
+     *
+     * @param buffer       - Address of the wave buffer.
+     * @param position     - Sample position in the wave buffer.
+     * @param coefficients - Prediction coefficients of the wave buffer.
+     * @param context      - Decoder context at the position, updated past the copied samples.
+     * @param frames       - Frames of the wave buffer in guest memory, from the frame of the
+     *                       position onwards.
+     * @param output       - Output samples.
+     * @return Number of samples copied, 0 if no window holds the position for this context.
+     */
+    u32 Read(CpuAddr buffer, u32 position, const std::array<s16, 16>& coefficients,
+             VoiceState::AdpcmContext& context, std::span<const u8> frames,
+             std::span<s16> output);
+
+    /**
+     * Decode frames of a wave buffer into a window, replacing the least recently used one.
+     *
+     * @param buffer       - Address of the wave buffer.
+     * @param position     - Sample position to decode from, must be at the start of a frame.
+     * @param coefficients - Prediction coefficients of the wave buffer.
+     * @param context      - Decoder context at the position.
+     * @param frames       - Frames to decode, up to WindowFrames are decoded.
+     */
+    void Decode(CpuAddr buffer, u32 position, const std::array<s16, 16>& coefficients,
+                const VoiceState::AdpcmContext& context, std::span<const u8> frames);
+
+    /**
+     * Check if a window starts at a position of a wave buffer, with the given context.
+     *
+     * @param buffer       - Address of the wave buffer.
+     * @param position     - Sample position in the wave buffer.
+     * @param coefficients - Prediction coefficients of the wave buffer.
+     * @param context      - Decoder context at the position.
+     * @return True if the samples from the position are already decoded.
+     */
+    bool Contains(CpuAddr buffer, u32 position, const std::array<s16, 16>& coefficients,
+                  const VoiceState::AdpcmContext& context) const;
+
+private:
+    struct Window {
+        CpuAddr buffer{};
+        /// Sample position of the first sample, at the start of a frame
+        u32 position{};
+        std::array<s16, 16> coefficients{};
+        VoiceState::AdpcmContext context{};
+        std::vector<u8> frames;
+        std::vector<s16> samples;
+        u64 last_use{};
+    };
+
+    /// Get the context the decoder would have at a position inside a window.
+    static VoiceState::AdpcmContext ContextAt(const Window& window, u32 position);
+
+    std::array<Window, NumWindows> windows{};
+    u64 use_count{};
+};
+
+/**
+ * Lookaheads of the voices of an audio renderer session, by the address of their voice state.
+ */
+class AdpcmLookaheadCache {
+public:
+    /// Voices past this many are decoded without a lookahead
+    static constexpr size_t MaxVoices = 512;
+
+    /**
+     * Get the lookahead of a voice, creating it if needed.
+     *
+     * @param voice_state - Address of the state of the voice.
+     * @return The lookahead of the voice, or nullptr if too many voices have one.
+     */
+    AdpcmLookahead* Get(CpuAddr voice_state);
+
+    /**
+     * Drop the lookaheads of every voice. Called when the session is initialized again, as the
+     * voice states of the new session are elsewhere and the old ones would count to the limit.
+     */
+    void Clear();
+
+private:
+    std::mutex mutex;
+    std::unordered_map<CpuAddr, std::unique_ptr<AdpcmLookahead>> lookaheads;
+};
+
+} // namespace AudioCore::Renderer
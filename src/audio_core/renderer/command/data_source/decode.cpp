@@ -1,10 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <vector>
 
+#include "audio_core/renderer/command/data_source/adpcm_lookahead.h"
 #include "audio_core/renderer/command/data_source/decode.h"
+#include "audio_core/renderer/command/data_source/decode_kernels.h"
 #include "audio_core/renderer/command/resample/resample.h"
 #include "common/fixed_point.h"
 #include "common/logging/log.h"
@@ -29,9 +32,6 @@ constexpr std::array<u8, 3> PitchBySrcQuality = {4, 8, 4};
 template <typename T>
 static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
                      const DecodeArg& req) {
-    constexpr s32 min{std::numeric_limits<s16>::min()};
-    constexpr s32 max{std::numeric_limits<s16>::max()};
-
     if (req.buffer == 0 || req.buffer_size == 0) {
         return 0;
     }
@@ -44,53 +44,113 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         std::min(req.samples_to_read, req.end_offset - req.start_offset - req.offset)};
     u32 channel_count{static_cast<u32>(req.channel_count)};
 
-    switch (req.channel_count) {
-    default: {
-        const VAddr source{req.buffer +
-                           (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
-        const u64 size{channel_count * samples_to_decode};
-
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, size);
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                out_buffer[i] = samples[i * channel_count + req.target_channel];
-            }
-        }
-    } break;
+    if (req.target_channel < 0 || req.target_channel >= req.channel_count) {
+        LOG_ERROR(Service_Audio, "Invalid target channel, expected below {}, got {}",
+                  req.channel_count, req.target_channel);
+        return 0;
+    }
 
-    case 1:
-        if (req.target_channel != 0) {
-            LOG_ERROR(Service_Audio, "Invalid target channel, expected 0, got {}",
-                      req.target_channel);
-            return 0;
-        }
+    const VAddr source{req.buffer +
+                       (((req.start_offset + req.offset) * channel_count) * sizeof(T))};
+    const u64 size{channel_count * samples_to_decode};
 
-        const VAddr source{req.buffer + ((req.start_offset + req.offset) * sizeof(T))};
-        Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
-            memory, source, samples_to_decode);
+    Core::Memory::CpuGuestMemory<T, Core::Memory::GuestMemoryFlags::UnsafeRead> samples(
+        memory, source, size);
+    const std::span<const T> input{samples.data(), samples.size()};
+    const auto output{out_buffer.first(samples_to_decode)};
 
-        if constexpr (std::is_floating_point_v<T>) {
-            for (u32 i = 0; i < samples_to_decode; i++) {
-                auto sample{static_cast<s32>(samples[i * channel_count + req.target_channel] *
-                                             std::numeric_limits<s16>::max())};
-                out_buffer[i] = static_cast<s16>(std::clamp(sample, min, max));
-            }
-        } else {
-            std::memcpy(out_buffer.data(), samples.data(), samples_to_decode * sizeof(s16));
-        }
-        break;
+    if constexpr (std::is_floating_point_v<T>) {
+        ConvertPcmFloat(output, input, channel_count, static_cast<u32>(req.target_channel));
+    } else {
+        ConvertPcmInt16(output, input, channel_count, static_cast<u32>(req.target_channel));
     }
 
     return samples_to_decode;
 }
 
+/**
+ * Decode ADPCM samples from the middle of a frame, one at a time.
+ *
+ * @param frame        - The frame to decode from.
+ * @param first_sample - Index of the first sample to decode in the frame.
+ * @param coefficients - Prediction coefficients of the wave buffer.
+ * @param context      - Decoder context at the first sample, updated past the decoded samples.
+ * @param output       - Output samples, no more than the rest of the frame.
+ */
+static void DecodeAdpcmSamples(std::span<const u8> frame, u32 first_sample,
+                               const std::array<s16, 16>& coefficients,
+                               VoiceState::AdpcmContext& context, std::span<s16> output) {
+    static constexpr std::array<s32, 16> Steps{
+        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
+    };
+
+    // The header is only read at the start of a frame, otherwise the context's is used
+    if (first_sample == 0) {
+        context.header = frame[0];
+    }
+    const u8 coeff_index{static_cast<u8>((context.header >> 4U) & 0xFU)};
+    const u8 scale{static_cast<u8>(context.header & 0xFU)};
+    const s32 coeff0{coefficients[coeff_index * 2 + 0]};
+    const s32 coeff1{coefficients[coeff_index * 2 + 1]};
+
+    s32 yn0{context.yn0};
+    s32 yn1{context.yn1};
+    for (u32 i = 0; i < output.size(); i++) {
+        const u32 nibble{first_sample + i};
+        const u8 byte{frame[1 + nibble / 2]};
+        const s32 code{Steps[(nibble & 1) ? (byte & 0xF) : (byte >> 4)]};
+
+        const auto xn = code * (1 << scale);
+        const auto prediction = coeff0 * yn0 + coeff1 * yn1;
+        const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
+        yn1 = yn0;
+        yn0 = std::clamp<s32>(sample, -0x8000, 0x7FFF);
+        output[i] = static_cast<s16>(yn0);
+    }
+
+    context.yn0 = static_cast<s16>(yn0);
+    context.yn1 = static_cast<s16>(yn1);
+}
+
+/**
+ * Copy ADPCM samples decoded ahead, decoding the next window of frames if playback reached a
+ * frame no window holds.
+ *
+ * @param lookahead - Lookahead of the voice.
+ * @param req       - Information for how to decode.
+ * @param position  - Sample position in the wave buffer.
+ * @param frames    - Frames of the wave buffer, from the frame of the position onwards.
+ * @param context   - Decoder context at the position, updated past the copied samples.
+ * @param output    - Output samples.
+ * @return Number of samples copied, 0 if they must be decoded without the lookahead.
+ */
+static u32 ReadAdpcmLookahead(AdpcmLookahead& lookahead, const DecodeArg& req, u32 position,
+                              std::span<const u8> frames, VoiceState::AdpcmContext& context,
+                              std::span<s16> output) {
+    auto samples_read{
+        lookahead.Read(req.buffer, position, req.coefficients, context, frames, output)};
+    if (samples_read == 0 && position % AdpcmSamplesPerFrame == 0) {
+        lookahead.Decode(req.buffer, position, req.coefficients, context, frames);
+        samples_read = lookahead.Read(req.buffer, position, req.coefficients, context, frames,
+                                      output);
+    }
+    return samples_read;
+}
+
+/**
+ * Get the number of ADPCM frames from the start of a wave buffer which can be decoded ahead,
+ * those the wave buffer plays which are inside its buffer.
+ *
+ * @param buffer_size - Size of the wave buffer in bytes.
+ * @param end_offset  - Sample position the wave buffer ends at.
+ * @return Number of frames.
+ */
+static u32 GetAdpcmFrameCount(u64 buffer_size, u32 end_offset) {
+    const u64 end_frame{(static_cast<u64>(end_offset) + AdpcmSamplesPerFrame - 1) /
+                        AdpcmSamplesPerFrame};
+    return static_cast<u32>(std::min<u64>(buffer_size / AdpcmFrameSize, end_frame));
+}
+
 /**
  * Decode ADPCM data.
  *
@@ -101,7 +161,7 @@ static u32 DecodePcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
  */
 static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
                        const DecodeArg& req) {
-    constexpr u32 SamplesPerFrame{14};
+    constexpr u32 SamplesPerFrame{AdpcmSamplesPerFrame};
     constexpr u32 NibblesPerFrame{16};
 
     if (req.buffer == 0 || req.buffer_size == 0) {
@@ -130,94 +190,119 @@ static u32 DecodeAdpcm(Core::Memory::Memory& memory, std::span<s16> out_buffer,
         return 0;
     }
 
-    auto samples_to_read{samples_to_process};
-    auto samples_remaining_in_frame{start_pos % SamplesPerFrame};
-    auto position_in_frame{(start_pos / SamplesPerFrame) * NibblesPerFrame +
-                           samples_remaining_in_frame};
-
-    if (samples_remaining_in_frame) {
-        position_in_frame += 2;
+    // Read the frames to play, and with a lookahead, enough after them to fill a window
+    const u32 first_frame{start_pos / SamplesPerFrame};
+    const u32 played_frames{(start_pos + samples_to_process - 1) / SamplesPerFrame -
+                            first_frame + 1};
+    u32 frame_count{played_frames};
+    if (req.adpcm_lookahead != nullptr) {
+        const u32 last_frame{GetAdpcmFrameCount(req.buffer_size, req.end_offset)};
+        if (last_frame > first_frame) {
+            frame_count = std::max(frame_count, std::min(AdpcmLookahead::WindowFrames,
+                                                         last_frame - first_frame));
+        }
     }
 
-    const auto size{std::max((samples_to_process / 8U) * SamplesPerFrame, 8U)};
     Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> wavebuffer(
-        memory, req.buffer + position_in_frame / 2, size);
-
-    auto context{req.adpcm_context};
-    auto header{context->header};
-    u8 coeff_index{static_cast<u8>((header >> 4U) & 0xFU)};
-    u8 scale{static_cast<u8>(header & 0xFU)};
-    s32 coeff0{req.coefficients[coeff_index * 2 + 0]};
-    s32 coeff1{req.coefficients[coeff_index * 2 + 1]};
-
-    auto yn0{context->yn0};
-    auto yn1{context->yn1};
+        memory, req.buffer + first_frame * AdpcmFrameSize, frame_count * AdpcmFrameSize);
+    const std::span<const u8> frames{wavebuffer.data(), wavebuffer.size()};
 
-    static constexpr std::array<s32, 16> Steps{
-        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
-    };
-
-    const auto decode_sample = [&](const s32 code) -> s16 {
-        const auto xn = code * (1 << scale);
-        const auto prediction = coeff0 * yn0 + coeff1 * yn1;
-        const auto sample = ((xn << 11) + 0x400 + prediction) >> 11;
-        const auto saturated = std::clamp<s32>(sample, -0x8000, 0x7FFF);
-        yn1 = yn0;
-        yn0 = static_cast<s16>(saturated);
-        return yn0;
-    };
-
-    u32 read_index{0};
+    auto& context{*req.adpcm_context};
+    auto position{start_pos};
+    auto samples_to_read{samples_to_process};
     u32 write_index{0};
 
     while (samples_to_read > 0) {
-        // Are we at a new frame?
-        if ((position_in_frame % NibblesPerFrame) == 0) {
-            header = wavebuffer[read_index++];
-            coeff_index = (header >> 4) & 0xF;
-            scale = header & 0xF;
-            coeff0 = req.coefficients[coeff_index * 2 + 0];
-            coeff1 = req.coefficients[coeff_index * 2 + 1];
-            position_in_frame += 2;
-
-            // Can we consume all of this frame's samples?
-            if (samples_to_read >= SamplesPerFrame) {
-                // Can grab all samples until the next header
-                for (u32 i = 0; i < SamplesPerFrame / 2; i++) {
-                    auto code0{Steps[(wavebuffer[read_index] >> 4) & 0xF]};
-                    auto code1{Steps[wavebuffer[read_index] & 0xF]};
-                    read_index++;
-
-                    out_buffer[write_index++] = decode_sample(code0);
-                    out_buffer[write_index++] = decode_sample(code1);
-                }
+        const auto frame{frames.subspan((position / SamplesPerFrame - first_frame) *
+                                        AdpcmFrameSize)};
+        const auto output{out_buffer.subspan(write_index, samples_to_read)};
+        const auto sample_in_frame{position % SamplesPerFrame};
+
+        u32 samples_decoded{0};
+        if (req.adpcm_lookahead != nullptr) {
+            samples_decoded =
+                ReadAdpcmLookahead(*req.adpcm_lookahead, req, position, frame, context, output);
+        }
 
-                position_in_frame += SamplesPerFrame;
-                samples_to_read -= SamplesPerFrame;
-                continue;
+        if (samples_decoded == 0) {
+            if (sample_in_frame == 0 && samples_to_read >= SamplesPerFrame) {
+                // Decode all of the whole frames in one go
+                samples_decoded = samples_to_read - samples_to_read % SamplesPerFrame;
+                DecodeAdpcmFrames(output.first(samples_decoded),
+                                  frame.first(samples_decoded / SamplesPerFrame * AdpcmFrameSize),
+                                  req.coefficients, context);
+            } else {
+                samples_decoded = std::min(samples_to_read, SamplesPerFrame - sample_in_frame);
+                DecodeAdpcmSamples(frame, sample_in_frame, req.coefficients, context,
+                                   output.first(samples_decoded));
             }
         }
 
-        // Decode a single sample
-        auto code{wavebuffer[read_index]};
-        if (position_in_frame & 1) {
-            code &= 0xF;
-            read_index++;
-        } else {
-            code >>= 4;
-        }
+        position += samples_decoded;
+        write_index += samples_decoded;
+        samples_to_read -= samples_decoded;
+    }
 
-        out_buffer[write_index++] = decode_sample(Steps[code]);
+    return samples_to_process;
+}
 
-        position_in_frame++;
-        samples_to_read--;
+/**
+ * Decode the first window of a wave buffer before the voice starts playing it, so the samples are
+ * ready when a render pass reaches them. Only done when the context at the start of the wave
+ * buffer is already known.
+ *
+ * @param memory       - Core memory to read data from.
+ * @param args         - The wavebuffer data, and information for how to decode it.
+ * @param coefficients - Prediction coefficients of the wave buffers.
+ * @param index        - Index of the wave buffer to decode.
+ * @param is_next      - If the wave buffer follows the one currently playing, rather than being
+ *                       the current one, about to be started.
+ */
+static void PrefetchAdpcmWaveBuffer(Core::Memory::Memory& memory,
+                                    const DecodeFromWaveBuffersArgs& args,
+                                    const std::array<s16, 16>& coefficients, u32 index,
+                                    bool is_next) {
+    const auto& voice_state{*args.voice_state};
+    if (index >= MaxWaveBuffers || !voice_state.wave_buffer_valid[index]) {
+        return;
+    }
+
+    const auto& wavebuffer{args.wave_buffers[index]};
+    if (wavebuffer.buffer == 0 || (is_next && wavebuffer.context == 0)) {
+        return;
     }
 
-    context->header = header;
-    context->yn0 = yn0;
-    context->yn1 = yn1;
+    auto context{voice_state.adpcm_context};
+    if (wavebuffer.context != 0) {
+        memory.ReadBlockUnsafe(wavebuffer.context, &context,
+                               std::min<u64>(wavebuffer.context_size, sizeof(context)));
+    }
 
-    return samples_to_process;
+    auto start_offset{wavebuffer.start_offset};
+    auto end_offset{wavebuffer.end_offset};
+    if (wavebuffer.loop && voice_state.loop_count > 0 && !is_next &&
+        wavebuffer.loop_start_offset <= wavebuffer.loop_end_offset) {
+        start_offset = wavebuffer.loop_start_offset;
+        end_offset = wavebuffer.loop_end_offset;
+    }
+
+    auto& lookahead{*args.adpcm_lookahead};
+    if (start_offset >= end_offset || start_offset % AdpcmSamplesPerFrame != 0 ||
+        lookahead.Contains(wavebuffer.buffer, start_offset, coefficients, context)) {
+        return;
+    }
+
+    const u32 first_frame{start_offset / AdpcmSamplesPerFrame};
+    const u32 last_frame{GetAdpcmFrameCount(wavebuffer.buffer_size, end_offset)};
+    if (last_frame <= first_frame) {
+        return;
+    }
+
+    const u32 frame_count{std::min(AdpcmLookahead::WindowFrames, last_frame - first_frame)};
+    Core::Memory::CpuGuestMemory<u8, Core::Memory::GuestMemoryFlags::UnsafeRead> frames(
+        memory, wavebuffer.buffer + first_frame * AdpcmFrameSize, frame_count * AdpcmFrameSize);
+    lookahead.Decode(wavebuffer.buffer, start_offset, coefficients, context,
+                     {frames.data(), frames.size()});
 }
 
 /**
@@ -248,12 +333,15 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
         (f32)args.source_sample_rate / (f32)args.target_sample_rate * (f32)args.pitch)};
     const auto size_required{fraction + remaining_sample_count * sample_rate_ratio};
 
+    // Samples which aren't decoded are silent, rather than left over from another voice
     if (size_required < 0) {
+        std::ranges::fill(args.output, 0);
         return;
     }
 
     auto pitch{PitchBySrcQuality[static_cast<u32>(args.src_quality)]};
     if (static_cast<u32>(pitch + size_required.to_int_floor()) > TempBufferSize) {
+        std::ranges::fill(args.output, 0);
         return;
     }
 
@@ -270,7 +358,17 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
     u32 offset{voice_state.offset};
 
     auto output_buffer{args.output};
-    std::array<s16, TempBufferSize> temp_buffer{};
+    // Every sample the resampler reads is written first, so this is left uninitialized
+    std::array<s16, TempBufferSize> temp_buffer;
+
+    std::array<s16, 16> coefficients{};
+    bool coefficients_read{false};
+    const auto read_coefficients = [&] {
+        if (!coefficients_read) {
+            memory.ReadBlockUnsafe(args.data_address, &coefficients, args.data_size);
+            coefficients_read = true;
+        }
+    };
 
     while (remaining_sample_count > 0) {
         const auto samples_to_write{std::min(remaining_sample_count, max_remaining_sample_count)};
@@ -328,6 +426,7 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
                 .target_channel{args.channel},
                 .offset{offset},
                 .samples_to_read{samples_to_read - samples_read},
+                .adpcm_lookahead{args.adpcm_lookahead},
             };
 
             s32 samples_decoded{0};
@@ -346,8 +445,9 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
                 break;
 
             case SampleFormat::Adpcm: {
+                read_coefficients();
                 decode_arg.adpcm_context = &voice_state.adpcm_context;
-                memory.ReadBlockUnsafe(args.data_address, &decode_arg.coefficients, args.data_size);
+                decode_arg.coefficients = coefficients;
                 samples_decoded = DecodeAdpcm(
                     memory, {&temp_buffer[temp_buffer_pos], TempBufferSize - temp_buffer_pos},
                     decode_arg);
@@ -399,6 +499,9 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
             for (u32 i = 0; i < samples_read; i++) {
                 output_buffer[i] = temp_buffer[i];
             }
+            for (u32 i = samples_read; i < samples_to_write; i++) {
+                output_buffer[i] = 0;
+            }
         } else {
             std::memset(&temp_buffer[temp_buffer_pos], 0,
                         (samples_to_read - samples_read) * sizeof(s16));
@@ -411,12 +514,27 @@ void DecodeFromWaveBuffers(Core::Memory::Memory& memory, const DecodeFromWaveBuf
         }
 
         remaining_sample_count -= samples_to_write;
+        output_buffer = output_buffer.subspan(samples_to_write);
         if (remaining_sample_count != 0 && is_buffer_starved) {
             LOG_ERROR(Service_Audio, "Samples remaining but buffer is starving??");
             break;
         }
-
-        output_buffer = output_buffer.subspan(samples_to_write);
+    }
+    std::fill_n(output_buffer.begin(), remaining_sample_count, 0);
+
+    if (args.sample_format == SampleFormat::Adpcm && args.adpcm_lookahead != nullptr &&
+        wavebuffer_index < MaxWaveBuffers && voice_state.wave_buffer_valid[wavebuffer_index]) {
+        read_coefficients();
+        const auto& wavebuffer{args.wave_buffers[wavebuffer_index]};
+        const auto remaining{wavebuffer.end_offset - wavebuffer.start_offset - offset};
+        if (offset == 0) {
+            PrefetchAdpcmWaveBuffer(memory, args, coefficients, wavebuffer_index, false);
+        } else if (!wavebuffer.loop &&
+                   remaining <= AdpcmLookahead::WindowFrames * AdpcmSamplesPerFrame) {
+            // Only once the current wave buffer is nearly played, so its windows are not evicted
+            PrefetchAdpcmWaveBuffer(memory, args, coefficients,
+                                    (wavebuffer_index + 1) % MaxWaveBuffers, true);
+        }
     }
 
     voice_state.wave_buffers_consumed = wavebuffers_consumed;
@@ -16,6 +16,7 @@ class Memory;
 }
 
 namespace AudioCore::Renderer {
+class AdpcmLookahead;
 
 struct DecodeFromWaveBuffersArgs {
     SampleFormat sample_format;
@@ -33,6 +34,8 @@ struct DecodeFromWaveBuffersArgs {
     u64 data_size;
     bool IsVoicePlayedSampleCountResetAtLoopPointSupported;
     bool IsVoicePitchAndSrcSkippedSupported;
+    /// Samples decoded ahead for ADPCM voices, nullptr to decode only what is played
+    AdpcmLookahead* adpcm_lookahead;
 };
 
 struct DecodeArg {
@@ -46,6 +49,7 @@ struct DecodeArg {
     s8 target_channel;
     u32 offset;
     u32 samples_to_read;
+    AdpcmLookahead* adpcm_lookahead;
 };
 
 /**
@@ -0,0 +1,352 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#include "audio_core/renderer/command/data_source/decode_kernels.h"
+#include "common/assert.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+/// Scaled residuals of the samples of one frame, with room for the two unused nibbles
+using AdpcmResiduals = std::array<s32, 16>;
+
+/// Unpack the nibbles of a frame and scale them, as (nibble << scale) << 11, plus rounding.
+void UnpackAdpcmFrameScalar(AdpcmResiduals& residuals, const u8* frame) {
+    static constexpr std::array<s32, 16> Steps{
+        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
+    };
+    const u32 scale{frame[0] & 0xFU};
+    for (u32 i = 0; i < AdpcmSamplesPerFrame / 2; i++) {
+        const u8 codes{frame[1 + i]};
+        residuals[i * 2 + 0] = ((Steps[codes >> 4] * (1 << scale)) << 11) + 0x400;
+        residuals[i * 2 + 1] = ((Steps[codes & 0xF] * (1 << scale)) << 11) + 0x400;
+    }
+}
+
+#if defined(ARCHITECTURE_x86_64)
+
+/// Scale the low 4 nibbles, as 16-bit lanes, into residuals.
+MIX_KERNEL_TARGET("sse4.1")
+__m128i ScaleNibblesSSE41(__m128i nibbles, __m128i shift) {
+    return _mm_add_epi32(_mm_sll_epi32(_mm_cvtepi16_epi32(nibbles), shift),
+                         _mm_set1_epi32(0x400));
+}
+
+MIX_KERNEL_TARGET("sse4.1")
+void UnpackAdpcmFrameSSE41(AdpcmResiduals& residuals, const u8* frame) {
+    // Bytes 1-7 as 16-bit lanes, the last lane is zero
+    const __m128i codes = _mm_cvtepu8_epi16(
+        _mm_srli_si128(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(frame)), 1));
+    const __m128i high = _mm_srli_epi16(codes, 4);
+    const __m128i low = _mm_and_si128(codes, _mm_set1_epi16(0xF));
+
+    // Nibbles in sample order, sign extended from 4 bits
+    const __m128i first = _mm_srai_epi16(_mm_slli_epi16(_mm_unpacklo_epi16(high, low), 12), 12);
+    const __m128i second = _mm_srai_epi16(_mm_slli_epi16(_mm_unpackhi_epi16(high, low), 12), 12);
+
+    const __m128i shift = _mm_cvtsi32_si128((frame[0] & 0xF) + 11);
+    auto* out = reinterpret_cast<__m128i*>(residuals.data());
+    _mm_storeu_si128(out + 0, ScaleNibblesSSE41(first, shift));
+    _mm_storeu_si128(out + 1, ScaleNibblesSSE41(_mm_srli_si128(first, 8), shift));
+    _mm_storeu_si128(out + 2, ScaleNibblesSSE41(second, shift));
+    _mm_storeu_si128(out + 3, ScaleNibblesSSE41(_mm_srli_si128(second, 8), shift));
+}
+
+MIX_KERNEL_TARGET("sse4.1")
+u32 ConvertPcmInt16StereoSSE41(s16* output, const s16* input, u32 channel, u32 sample_count) {
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        __m128i first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2));
+        __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i * 2 + 8));
+        if (channel == 0) {
+            first = _mm_slli_epi32(first, 16);
+            second = _mm_slli_epi32(second, 16);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         _mm_packs_epi32(_mm_srai_epi32(first, 16), _mm_srai_epi32(second, 16)));
+    }
+    return i;
+}
+
+/// Load 4 samples of a channel of mono or stereo float samples.
+MIX_KERNEL_TARGET("sse4.1")
+__m128 LoadPcmFloatSSE41(const f32* input, u32 channel_count, u32 channel) {
+    if (channel_count == 1) {
+        return _mm_loadu_ps(input);
+    }
+    const __m128 first = _mm_loadu_ps(input);
+    const __m128 second = _mm_loadu_ps(input + 4);
+    return channel == 0 ? _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0))
+                        : _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+}
+
+MIX_KERNEL_TARGET("sse4.1")
+u32 ConvertPcmFloatSSE41(s16* output, const f32* input, u32 channel_count, u32 channel,
+                         u32 sample_count) {
+    const __m128 scale = _mm_set1_ps(static_cast<f32>(std::numeric_limits<s16>::max()));
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m128i first = _mm_cvttps_epi32(
+            _mm_mul_ps(LoadPcmFloatSSE41(input + i * channel_count, channel_count, channel),
+                       scale));
+        const __m128i second = _mm_cvttps_epi32(_mm_mul_ps(
+            LoadPcmFloatSSE41(input + (i + 4) * channel_count, channel_count, channel), scale));
+        // Saturating to 16 bits is the same as clamping
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), _mm_packs_epi32(first, second));
+    }
+    return i;
+}
+
+MIX_KERNEL_TARGET("avx2")
+u32 ConvertPcmInt16StereoAVX2(s16* output, const s16* input, u32 channel, u32 sample_count) {
+    u32 i = 0;
+    for (; i + 16 <= sample_count; i += 16) {
+        __m256i first = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 2));
+        __m256i second = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i * 2 + 16));
+        if (channel == 0) {
+            first = _mm256_slli_epi32(first, 16);
+            second = _mm256_slli_epi32(second, 16);
+        }
+        const __m256i packed =
+            _mm256_packs_epi32(_mm256_srai_epi32(first, 16), _mm256_srai_epi32(second, 16));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    return i;
+}
+
+/// Load 8 samples of a channel of mono or stereo float samples.
+MIX_KERNEL_TARGET("avx2")
+__m256 LoadPcmFloatAVX2(const f32* input, u32 channel_count, u32 channel) {
+    if (channel_count == 1) {
+        return _mm256_loadu_ps(input);
+    }
+    const __m256 first = _mm256_loadu_ps(input);
+    const __m256 second = _mm256_loadu_ps(input + 8);
+    const __m256 shuffled = channel == 0
+                                ? _mm256_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0))
+                                : _mm256_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm256_castpd_ps(
+        _mm256_permute4x64_pd(_mm256_castps_pd(shuffled), _MM_SHUFFLE(3, 1, 2, 0)));
+}
+
+MIX_KERNEL_TARGET("avx2")
+u32 ConvertPcmFloatAVX2(s16* output, const f32* input, u32 channel_count, u32 channel,
+                        u32 sample_count) {
+    const __m256 scale = _mm256_set1_ps(static_cast<f32>(std::numeric_limits<s16>::max()));
+    u32 i = 0;
+    for (; i + 16 <= sample_count; i += 16) {
+        const __m256i first = _mm256_cvttps_epi32(
+            _mm256_mul_ps(LoadPcmFloatAVX2(input + i * channel_count, channel_count, channel),
+                          scale));
+        const __m256i second = _mm256_cvttps_epi32(_mm256_mul_ps(
+            LoadPcmFloatAVX2(input + (i + 8) * channel_count, channel_count, channel), scale));
+        const __m256i packed = _mm256_packs_epi32(first, second);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    return i;
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+void UnpackAdpcmFrameNEON(AdpcmResiduals& residuals, const u8* frame) {
+    // Bytes 1-7 as 16-bit lanes, the last lane is the header and left unused
+    const uint16x8_t codes = vmovl_u8(vext_u8(vld1_u8(frame), vld1_u8(frame), 1));
+    const uint16x8x2_t nibbles =
+        vzipq_u16(vshrq_n_u16(codes, 4), vandq_u16(codes, vdupq_n_u16(0xF)));
+
+    // Nibbles in sample order, sign extended from 4 bits
+    const int16x8_t first =
+        vshrq_n_s16(vshlq_n_s16(vreinterpretq_s16_u16(nibbles.val[0]), 12), 12);
+    const int16x8_t second =
+        vshrq_n_s16(vshlq_n_s16(vreinterpretq_s16_u16(nibbles.val[1]), 12), 12);
+
+    const int32x4_t shift = vdupq_n_s32((frame[0] & 0xF) + 11);
+    const int32x4_t rounding = vdupq_n_s32(0x400);
+    s32* out = residuals.data();
+    vst1q_s32(out + 0, vaddq_s32(vshlq_s32(vmovl_s16(vget_low_s16(first)), shift), rounding));
+    vst1q_s32(out + 4, vaddq_s32(vshlq_s32(vmovl_s16(vget_high_s16(first)), shift), rounding));
+    vst1q_s32(out + 8, vaddq_s32(vshlq_s32(vmovl_s16(vget_low_s16(second)), shift), rounding));
+    vst1q_s32(out + 12, vaddq_s32(vshlq_s32(vmovl_s16(vget_high_s16(second)), shift), rounding));
+}
+
+u32 ConvertPcmInt16StereoNEON(s16* output, const s16* input, u32 channel, u32 sample_count) {
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        vst1q_s16(output + i, vld2q_s16(input + i * 2).val[channel]);
+    }
+    return i;
+}
+
+u32 ConvertPcmFloatNEON(s16* output, const f32* input, u32 channel_count, u32 channel,
+                        u32 sample_count) {
+    const auto load = [&](u32 index) {
+        if (channel_count == 1) {
+            return vld1q_f32(input + index);
+        }
+        return vld2q_f32(input + index * 2).val[channel];
+    };
+    const f32 scale = static_cast<f32>(std::numeric_limits<s16>::max());
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        // Saturating to 16 bits is the same as clamping
+        const int16x4_t first = vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(load(i), scale)));
+        const int16x4_t second = vqmovn_s32(vcvtq_s32_f32(vmulq_n_f32(load(i + 4), scale)));
+        vst1q_s16(output + i, vcombine_s16(first, second));
+    }
+    return i;
+}
+
+#endif
+
+} // Anonymous namespace
+
+void DecodeAdpcmFrames(MixKernel kernel, std::span<s16> output, std::span<const u8> frames,
+                       const std::array<s16, 16>& coefficients,
+                       VoiceState::AdpcmContext& context) {
+    const size_t frame_count{frames.size() / AdpcmFrameSize};
+    ASSERT(frames.size() % AdpcmFrameSize == 0 &&
+           output.size() >= frame_count * AdpcmSamplesPerFrame);
+
+    s32 yn0{context.yn0};
+    s32 yn1{context.yn1};
+    AdpcmResiduals residuals{};
+    for (size_t frame = 0; frame < frame_count; frame++) {
+        const u8* data{&frames[frame * AdpcmFrameSize]};
+        switch (kernel) {
+#if defined(ARCHITECTURE_x86_64)
+        case MixKernel::SSE41:
+        case MixKernel::AVX2:
+            UnpackAdpcmFrameSSE41(residuals, data);
+            break;
+#elif defined(ARCHITECTURE_arm64)
+        case MixKernel::NEON:
+            UnpackAdpcmFrameNEON(residuals, data);
+            break;
+#endif
+        default:
+            UnpackAdpcmFrameScalar(residuals, data);
+            break;
+        }
+
+        // Each sample is predicted from the previous two, which leaves this part serial
+        const u32 coeff_index{(data[0] >> 4U) & 0xFU};
+        const s32 coeff0{coefficients[coeff_index * 2 + 0]};
+        const s32 coeff1{coefficients[coeff_index * 2 + 1]};
+        s16* out{&output[frame * AdpcmSamplesPerFrame]};
+        for (u32 i = 0; i < AdpcmSamplesPerFrame; i++) {
+            const s32 prediction{coeff0 * yn0 + coeff1 * yn1};
+            const s32 sample{(residuals[i] + prediction) >> 11};
+            yn1 = yn0;
+            yn0 = std::clamp<s32>(sample, -0x8000, 0x7FFF);
+            out[i] = static_cast<s16>(yn0);
+        }
+        context.header = data[0];
+    }
+    context.yn0 = static_cast<s16>(yn0);
+    context.yn1 = static_cast<s16>(yn1);
+}
+
+void DecodeAdpcmFrames(std::span<s16> output, std::span<const u8> frames,
+                       const std::array<s16, 16>& coefficients,
+                       VoiceState::AdpcmContext& context) {
+    static const MixKernel kernel = GetSupportedMixKernels().back();
+    DecodeAdpcmFrames(kernel, output, frames, coefficients, context);
+}
+
+void ConvertPcmInt16(MixKernel kernel, std::span<s16> output, std::span<const s16> input,
+                     u32 channel_count, u32 channel) {
+    const u32 sample_count{static_cast<u32>(output.size())};
+    ASSERT(channel < channel_count && input.size() >= size_t{sample_count} * channel_count);
+
+    if (channel_count == 1) {
+        std::ranges::copy(input.first(sample_count), output.begin());
+        return;
+    }
+
+    u32 processed = 0;
+    if (channel_count == 2) {
+        switch (kernel) {
+#if defined(ARCHITECTURE_x86_64)
+        case MixKernel::SSE41:
+            processed =
+                ConvertPcmInt16StereoSSE41(output.data(), input.data(), channel, sample_count);
+            break;
+        case MixKernel::AVX2:
+            processed =
+                ConvertPcmInt16StereoAVX2(output.data(), input.data(), channel, sample_count);
+            break;
+#elif defined(ARCHITECTURE_arm64)
+        case MixKernel::NEON:
+            processed =
+                ConvertPcmInt16StereoNEON(output.data(), input.data(), channel, sample_count);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+    for (u32 i = processed; i < sample_count; i++) {
+        output[i] = input[i * channel_count + channel];
+    }
+}
+
+void ConvertPcmInt16(std::span<s16> output, std::span<const s16> input, u32 channel_count,
+                     u32 channel) {
+    static const MixKernel kernel = GetSupportedMixKernels().back();
+    ConvertPcmInt16(kernel, output, input, channel_count, channel);
+}
+
+void ConvertPcmFloat(MixKernel kernel, std::span<s16> output, std::span<const f32> input,
+                     u32 channel_count, u32 channel) {
+    constexpr s32 min{std::numeric_limits<s16>::min()};
+    constexpr s32 max{std::numeric_limits<s16>::max()};
+    const u32 sample_count{static_cast<u32>(output.size())};
+    ASSERT(channel < channel_count && input.size() >= size_t{sample_count} * channel_count);
+
+    u32 processed = 0;
+    if (channel_count <= 2) {
+        switch (kernel) {
+#if defined(ARCHITECTURE_x86_64)
+        case MixKernel::SSE41:
+            processed = ConvertPcmFloatSSE41(output.data(), input.data(), channel_count, channel,
+                                             sample_count);
+            break;
+        case MixKernel::AVX2:
+            processed = ConvertPcmFloatAVX2(output.data(), input.data(), channel_count, channel,
+                                            sample_count);
+            break;
+#elif defined(ARCHITECTURE_arm64)
+        case MixKernel::NEON:
+            processed = ConvertPcmFloatNEON(output.data(), input.data(), channel_count, channel,
+                                            sample_count);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+    for (u32 i = processed; i < sample_count; i++) {
+        const auto sample{static_cast<s32>(input[i * channel_count + channel] *
+                                           std::numeric_limits<s16>::max())};
+        output[i] = static_cast<s16>(std::clamp(sample, min, max));
+    }
+}
+
+void ConvertPcmFloat(std::span<s16> output, std::span<const f32> input, u32 channel_count,
+                     u32 channel) {
+    static const MixKernel kernel = GetSupportedMixKernels().back();
+    ConvertPcmFloat(kernel, output, input, channel_count, channel);
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <span>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "audio_core/renderer/voice/voice_state.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/// Number of samples in each frame of ADPCM data
+constexpr u32 AdpcmSamplesPerFrame = 14;
+/// Size of each frame of ADPCM data in bytes, a header byte followed by the sample nibbles
+constexpr u32 AdpcmFrameSize = 8;
+
+/**
+ * Decode whole frames of ADPCM data. The vector kernels unpack and scale the nibbles of each
+ * frame, the prediction of each sample from the previous two is the same for every kernel, so
+ * the samples match the scalar decoder bit for bit.
+ *
+ * @param kernel       - Kernel to decode with, must be supported by the host.
+ * @param output       - Output samples, AdpcmSamplesPerFrame for each frame.
+ * @param frames       - ADPCM frames to decode, a multiple of AdpcmFrameSize bytes.
+ * @param coefficients - Prediction coefficients of the wave buffer.
+ * @param context      - Decoder context, updated to the end of the last frame.
+ */
+void DecodeAdpcmFrames(MixKernel kernel, std::span<s16> output, std::span<const u8> frames,
+                       const std::array<s16, 16>& coefficients,
+                       VoiceState::AdpcmContext& context);
+
+/**
+ * Decode whole frames of ADPCM data with the fastest kernel the host supports.
+ * See the overload above for the parameters.
+ */
+void DecodeAdpcmFrames(std::span<s16> output, std::span<const u8> frames,
+                       const std::array<s16, 16>& coefficients,
+                       VoiceState::AdpcmContext& context);
+
+/**
+ * Copy one channel of interleaved PCM16 samples.
+ *
+ * @param kernel        - Kernel to convert with, must be supported by the host.
+ * @param output        - Output samples.
+ * @param input         - Interleaved input samples, channel_count for each output sample.
+ * @param channel_count - Number of interleaved channels.
+ * @param channel       - Channel to copy.
+ */
+void ConvertPcmInt16(MixKernel kernel, std::span<s16> output, std::span<const s16> input,
+                     u32 channel_count, u32 channel);
+
+/**
+ * Copy one channel of interleaved PCM16 samples with the fastest kernel the host supports.
+ * See the overload above for the parameters.
+ */
+void ConvertPcmInt16(std::span<s16> output, std::span<const s16> input, u32 channel_count,
+                     u32 channel);
+
+/**
+ * Convert one channel of interleaved float samples to PCM16, scaling them by the largest s16 and
+ * saturating, the same way for every kernel.
+ *
+ * @param kernel        - Kernel to convert with, must be supported by the host.
+ * @param output        - Output samples.
+ * @param input         - Interleaved input samples, channel_count for each output sample.
+ * @param channel_count - Number of interleaved channels.
+ * @param channel       - Channel to convert.
+ */
+void ConvertPcmFloat(MixKernel kernel, std::span<s16> output, std::span<const f32> input,
+                     u32 channel_count, u32 channel);
+
+/**
+ * Convert one channel of interleaved float samples with the fastest kernel the host supports.
+ * See the overload above for the parameters.
+ */
+void ConvertPcmFloat(std::span<s16> output, std::span<const f32> input, u32 channel_count,
+                     u32 channel);
+
+} // namespace AudioCore::Renderer
@@ -1,10 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <numbers>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/effect/i3dl2_reverb.h"
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
 #include "common/polyfill_ranges.h"
 
 namespace AudioCore::Renderer {
@@ -268,85 +270,114 @@ static void ApplyI3dl2ReverbEffect(I3dl2ReverbInfo::State& state,
         tap_indexes = OutTapIndexes6Ch;
     }
 
-    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
-        Common::FixedPoint<50, 14> early_to_late_tap{
-            state.early_delay_line.TapOut(state.early_to_late_taps)};
-        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
-
-        for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
-            output_samples[tap_indexes[early_tap]] +=
-                state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
-                EarlyGains[early_tap];
-            if constexpr (NumChannels == 6) {
-                output_samples[static_cast<u32>(Channels::LFE)] +=
-                    state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
-                    EarlyGains[early_tap];
+    std::array<s64, I3dl2ReverbInfo::MaxDelayTaps> early_gains{};
+    for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
+        early_gains[early_tap] = Common::FixedPoint<50, 14>(EarlyGains[early_tap]).to_raw();
+    }
+    const auto early_gain{Common::FixedPoint<50, 14>(state.early_gain).to_raw()};
+    const auto late_gain{Common::FixedPoint<50, 14>(state.late_gain).to_raw()};
+
+    // Processed in blocks, like the standard reverb. The early delay line taps are read into
+    // contiguous tap-major arrays one sample at a time, in the same order as its writes, and are
+    // then scaled with the vector kernels. The feedback network runs one sample at a time.
+    for (u32 block_start = 0; block_start < sample_count; block_start += ReverbBlockSize) {
+        const u32 block_size{std::min(ReverbBlockSize, sample_count - block_start)};
+        std::array<std::array<s64, ReverbBlockSize>, I3dl2ReverbInfo::MaxDelayTaps> early_taps;
+        std::array<s64, ReverbBlockSize> late_taps;
+        std::array<std::array<s64, ReverbBlockSize>, NumChannels> early_samples{};
+
+        for (u32 i = 0; i < block_size; i++) {
+            const u32 sample_index{block_start + i};
+            late_taps[i] = state.early_delay_line.TapOut(state.early_to_late_taps).to_raw();
+            for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
+                early_taps[early_tap][i] =
+                    state.early_delay_line.TapOut(state.early_tap_steps[early_tap]).to_raw();
             }
-        }
-
-        Common::FixedPoint<50, 14> current_sample{};
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            current_sample += inputs[channel][sample_index];
-        }
-
-        state.lowpass_0 =
-            (current_sample * state.lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
-        state.early_delay_line.Tick(state.lowpass_0);
 
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            output_samples[channel] *= state.early_gain;
-        }
+            Common::FixedPoint<50, 14> current_sample{};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                current_sample += inputs[channel][sample_index];
+            }
 
-        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> filtered_samples{};
-        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
-            filtered_samples[delay_line] =
-                state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][0] +
-                state.shelf_filter[delay_line];
-            state.shelf_filter[delay_line] =
-                (filtered_samples[delay_line] * state.lowpass_coeff[delay_line][2] +
-                 state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][1])
-                    .to_float();
+            state.lowpass_0 =
+                (current_sample * state.lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
+            state.early_delay_line.Tick(state.lowpass_0);
         }
 
-        const std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> mix_matrix{
-            filtered_samples[1] + filtered_samples[2] + early_to_late_tap * state.late_gain,
-            -filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
-            filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
-            filtered_samples[1] - filtered_samples[2] + early_to_late_tap * state.late_gain,
-        };
-
-        std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines> allpass_samples{};
-        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
-            allpass_samples[delay_line] = Axfx2AllPassTick(
-                state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
-                state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+        for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
+            MultiplyReverbSamples(
+                std::span(early_samples[tap_indexes[early_tap]]).first(block_size),
+                early_taps[early_tap], early_gains[early_tap], true);
         }
 
         if constexpr (NumChannels == 6) {
-            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
-                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
-                allpass_samples[3], allpass_samples[2], allpass_samples[3],
-            };
-
+            // Every tap is also added to the LFE channel, which no tap maps to
+            auto& lfe_samples{early_samples[static_cast<u32>(Channels::LFE)]};
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                Common::FixedPoint<50, 14> allpass{};
-
-                if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
-                } else {
-                    allpass = allpass_outputs[channel];
+                if (channel != static_cast<u32>(Channels::LFE)) {
+                    for (u32 i = 0; i < block_size; i++) {
+                        lfe_samples[i] += early_samples[channel][i];
+                    }
                 }
+            }
+        }
 
-                auto out_sample{output_samples[channel] + allpass +
-                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            MultiplyReverbSamples(std::span(early_samples[channel]).first(block_size),
+                                  early_samples[channel], early_gain, false);
+        }
+        MultiplyReverbSamples(std::span(late_taps).first(block_size), late_taps, late_gain,
+                              false);
+
+        for (u32 i = 0; i < block_size; i++) {
+            const u32 sample_index{block_start + i};
+            std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines>
+                filtered_samples{};
+            for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+                filtered_samples[delay_line] =
+                    state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][0] +
+                    state.shelf_filter[delay_line];
+                state.shelf_filter[delay_line] =
+                    (filtered_samples[delay_line] * state.lowpass_coeff[delay_line][2] +
+                     state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][1])
+                        .to_float();
+            }
 
-                outputs[channel][sample_index] =
-                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+            const auto late_sample{Common::FixedPoint<50, 14>::from_base(late_taps[i])};
+            const std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines>
+                mix_matrix{
+                    filtered_samples[1] + filtered_samples[2] + late_sample,
+                    -filtered_samples[0] - filtered_samples[3] + late_sample,
+                    filtered_samples[0] - filtered_samples[3] + late_sample,
+                    filtered_samples[1] - filtered_samples[2] + late_sample,
+                };
+
+            std::array<Common::FixedPoint<50, 14>, I3dl2ReverbInfo::MaxDelayLines>
+                allpass_samples{};
+            for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+                allpass_samples[delay_line] = Axfx2AllPassTick(
+                    state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
+                    state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+            }
+
+            std::array<Common::FixedPoint<50, 14>, NumChannels> allpass_outputs{};
+            if constexpr (NumChannels == 6) {
+                allpass_outputs = {
+                    allpass_samples[0], allpass_samples[1],
+                    allpass_samples[2] - allpass_samples[3], allpass_samples[3],
+                    allpass_samples[2], allpass_samples[3],
+                };
+                auto& center{allpass_outputs[static_cast<u32>(Channels::Center)]};
+                center = state.center_delay_line.Tick(center * 0.5f);
+            } else {
+                std::copy_n(allpass_samples.begin(), NumChannels, allpass_outputs.begin());
             }
-        } else {
+
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto out_sample{output_samples[channel] + allpass_samples[channel] +
-                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+                auto out_sample{
+                    Common::FixedPoint<50, 14>::from_base(early_samples[channel][i]) +
+                    allpass_outputs[channel] +
+                    state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
                 outputs[channel][sample_index] =
                     static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
             }
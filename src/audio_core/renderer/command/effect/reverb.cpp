@@ -1,11 +1,13 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <numbers>
 #include <ranges>
 
 #include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
 #include "audio_core/renderer/command/effect/reverb.h"
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
 #include "common/polyfill_ranges.h"
 
 namespace AudioCore::Renderer {
@@ -276,84 +278,111 @@ static void ApplyReverbEffect(const ReverbInfo::ParameterVersion2& params, Rever
         tap_indexes = OutTapIndexes6Ch;
     }
 
-    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
-        std::array<Common::FixedPoint<50, 14>, NumChannels> output_samples{};
+    std::array<s64, ReverbInfo::MaxDelayTaps> early_gains{};
+    for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
+        early_gains[early_tap] = state.early_gains[early_tap].to_raw();
+    }
+    const auto lfe_gain{Common::FixedPoint<50, 14>(0.2f).to_raw()};
+
+    // The samples are processed in blocks. The delay line taps are read one sample at a time,
+    // interleaved with the writes as before, into contiguous tap-major arrays, so the gains can
+    // then be applied to whole taps with the vector kernels. Only the feedback network, which
+    // depends on the previous sample, is left to run one sample at a time.
+    for (u32 block_start = 0; block_start < sample_count; block_start += ReverbBlockSize) {
+        const u32 block_size{std::min(ReverbBlockSize, sample_count - block_start)};
+        std::array<std::array<s64, ReverbBlockSize>, ReverbInfo::MaxDelayTaps> early_taps;
+        std::array<s64, ReverbBlockSize> late_taps;
+        std::array<std::array<s64, ReverbBlockSize>, NumChannels> wet_samples{};
+
+        for (u32 i = 0; i < block_size; i++) {
+            const u32 sample_index{block_start + i};
+            for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
+                early_taps[early_tap][i] =
+                    state.pre_delay_line.TapOut(state.early_delay_times[early_tap]).to_raw();
+            }
 
-        for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
-            const auto sample{state.pre_delay_line.TapOut(state.early_delay_times[early_tap]) *
-                              state.early_gains[early_tap]};
-            output_samples[tap_indexes[early_tap]] += sample;
-            if constexpr (NumChannels == 6) {
-                output_samples[static_cast<u32>(Channels::LFE)] += sample;
+            Common::FixedPoint<50, 14> input_sample{};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                input_sample += inputs[channel][sample_index];
             }
-        }
 
-        if constexpr (NumChannels == 6) {
-            output_samples[static_cast<u32>(Channels::LFE)] *= 0.2f;
-        }
+            input_sample *= 64;
+            input_sample *= Common::FixedPoint<50, 14>::from_base(params.base_gain);
+            state.pre_delay_line.Write(input_sample);
 
-        Common::FixedPoint<50, 14> input_sample{};
-        for (u32 channel = 0; channel < NumChannels; channel++) {
-            input_sample += inputs[channel][sample_index];
+            late_taps[i] = state.pre_delay_line.TapOut(state.pre_delay_time).to_raw();
         }
 
-        input_sample *= 64;
-        input_sample *= Common::FixedPoint<50, 14>::from_base(params.base_gain);
-        state.pre_delay_line.Write(input_sample);
-
-        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
-            state.prev_feedback_output[i] =
-                state.prev_feedback_output[i] * state.hf_decay_prev_gain[i] +
-                state.fdn_delay_lines[i].Read() * state.hf_decay_gain[i];
+        for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
+            MultiplyReverbSamples(std::span(wet_samples[tap_indexes[early_tap]]).first(block_size),
+                                  early_taps[early_tap], early_gains[early_tap], true);
         }
 
-        Common::FixedPoint<50, 14> pre_delay_sample{
-            state.pre_delay_line.TapOut(state.pre_delay_time) *
-            Common::FixedPoint<50, 14>::from_base(params.late_gain)};
-
-        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
-            state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
-            -state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
-            state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
-            state.prev_feedback_output[1] - state.prev_feedback_output[2] + pre_delay_sample,
-        };
-
-        std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> allpass_samples{};
-        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
-            allpass_samples[i] = Axfx2AllPassTick(state.decay_delay_lines[i],
-                                                  state.fdn_delay_lines[i], mix_matrix[i]);
+        if constexpr (NumChannels == 6) {
+            // Every tap is also added to the LFE channel, which no tap maps to
+            auto& lfe_samples{wet_samples[static_cast<u32>(Channels::LFE)]};
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                if (channel != static_cast<u32>(Channels::LFE)) {
+                    for (u32 i = 0; i < block_size; i++) {
+                        lfe_samples[i] += wet_samples[channel][i];
+                    }
+                }
+            }
+            MultiplyReverbSamples(std::span(lfe_samples).first(block_size), lfe_samples, lfe_gain,
+                                  false);
         }
 
-        const auto dry_gain{Common::FixedPoint<50, 14>::from_base(params.dry_gain)};
-        const auto wet_gain{Common::FixedPoint<50, 14>::from_base(params.wet_gain)};
+        MultiplyReverbSamples(std::span(late_taps).first(block_size), late_taps, params.late_gain,
+                              false);
 
-        if constexpr (NumChannels == 6) {
-            const std::array<Common::FixedPoint<50, 14>, MaxChannels> allpass_outputs{
-                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
-                allpass_samples[3], allpass_samples[2], allpass_samples[3],
-            };
+        for (u32 i = 0; i < block_size; i++) {
+            for (u32 delay_line = 0; delay_line < ReverbInfo::MaxDelayLines; delay_line++) {
+                state.prev_feedback_output[delay_line] =
+                    state.prev_feedback_output[delay_line] * state.hf_decay_prev_gain[delay_line] +
+                    state.fdn_delay_lines[delay_line].Read() * state.hf_decay_gain[delay_line];
+            }
 
-            for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
+            const auto pre_delay_sample{Common::FixedPoint<50, 14>::from_base(late_taps[i])};
+            std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> mix_matrix{
+                state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
+                -state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+                state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+                state.prev_feedback_output[1] - state.prev_feedback_output[2] + pre_delay_sample,
+            };
 
-                Common::FixedPoint<50, 14> allpass{};
-                if (channel == static_cast<u32>(Channels::Center)) {
-                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
-                } else {
-                    allpass = allpass_outputs[channel];
-                }
+            std::array<Common::FixedPoint<50, 14>, ReverbInfo::MaxDelayLines> allpass_samples{};
+            for (u32 delay_line = 0; delay_line < ReverbInfo::MaxDelayLines; delay_line++) {
+                allpass_samples[delay_line] =
+                    Axfx2AllPassTick(state.decay_delay_lines[delay_line],
+                                     state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+            }
 
-                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
-                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+            std::array<Common::FixedPoint<50, 14>, NumChannels> allpass_outputs{};
+            if constexpr (NumChannels == 6) {
+                allpass_outputs = {
+                    allpass_samples[0], allpass_samples[1],
+                    allpass_samples[2] - allpass_samples[3], allpass_samples[3],
+                    allpass_samples[2], allpass_samples[3],
+                };
+                auto& center{allpass_outputs[static_cast<u32>(Channels::Center)]};
+                center = state.center_delay_line.Tick(center * 0.5f);
+            } else {
+                std::copy_n(allpass_samples.begin(), NumChannels, allpass_outputs.begin());
             }
-        } else {
+
             for (u32 channel = 0; channel < NumChannels; channel++) {
-                auto in_sample{inputs[channel][sample_index] * dry_gain};
-                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
-                                64};
-                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+                wet_samples[channel][i] =
+                    (Common::FixedPoint<50, 14>::from_base(wet_samples[channel][i]) +
+                     allpass_outputs[channel])
+                        .to_raw();
             }
         }
+
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            MixReverbOutput(outputs[channel].subspan(block_start, block_size),
+                            inputs[channel].subspan(block_start, block_size),
+                            wet_samples[channel], params.dry_gain, params.wet_gain);
+        }
     }
 }
 
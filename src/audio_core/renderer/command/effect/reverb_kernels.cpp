@@ -0,0 +1,324 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
+#include "common/assert.h"
+#include "common/fixed_point.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+using ReverbFixed = Common::FixedPoint<50, 14>;
+
+constexpr int FractionalBits = 14;
+constexpr s64 FractionalMask = (s64{1} << FractionalBits) - 1;
+
+bool FitsInS32(s64 value) {
+    return value >= std::numeric_limits<s32>::min() && value <= std::numeric_limits<s32>::max();
+}
+
+template <bool Accumulate>
+void MultiplyScalar(s64* output, const s64* input, s64 gain, size_t sample_count) {
+    const auto fixed_gain{ReverbFixed::from_base(gain)};
+    for (size_t i = 0; i < sample_count; i++) {
+        const auto product{ReverbFixed::from_base(input[i]) * fixed_gain};
+        output[i] = Accumulate ? (ReverbFixed::from_base(output[i]) + product).to_raw()
+                               : product.to_raw();
+    }
+}
+
+void MixOutputScalar(s32* output, const s32* input, const s64* wet, s64 dry_gain, s64 wet_gain,
+                     size_t sample_count) {
+    const auto fixed_dry_gain{ReverbFixed::from_base(dry_gain)};
+    const auto fixed_wet_gain{ReverbFixed::from_base(wet_gain)};
+    for (size_t i = 0; i < sample_count; i++) {
+        const auto in_sample{input[i] * fixed_dry_gain};
+        // Dividing the raw value is exact, unlike the 128-bit FixedPoint division
+        const auto out_sample{ReverbFixed::from_base(
+            (ReverbFixed::from_base(wet[i]) * fixed_wet_gain).to_raw() / 64)};
+        output[i] = (in_sample + out_sample).to_int();
+    }
+}
+
+// The vector kernels multiply a 64-bit sample by a 32-bit gain as two 32-bit halves. With the
+// high half scaled by 2^32, (sample * gain) >> 14 is (high * gain) << 18 plus the arithmetic shift
+// of the low product, and all of it wraps around like the 128-bit multiplication truncated to 64
+// bits. Each kernel returns the number of samples it processed, the rest are left for the scalar
+// loop.
+
+#if defined(ARCHITECTURE_x86_64)
+
+/// Arithmetic right shift of the 64-bit lanes of value.
+template <int Shift>
+MIX_KERNEL_TARGET("sse4.1")
+__m128i ShiftRightArithmeticSSE41(__m128i value) {
+    const __m128i sign = _mm_shuffle_epi32(_mm_srai_epi32(value, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    return _mm_or_si128(_mm_srli_epi64(value, Shift), _mm_slli_epi64(sign, 64 - Shift));
+}
+
+MIX_KERNEL_TARGET("sse4.1")
+__m128i MultiplySSE41(__m128i sample, __m128i gain, bool negative_gain) {
+    __m128i low = _mm_mul_epu32(sample, gain);
+    if (negative_gain) {
+        low = _mm_sub_epi64(low, _mm_slli_epi64(sample, 32));
+    }
+    const __m128i high = _mm_mul_epi32(_mm_srli_epi64(sample, 32), gain);
+    return _mm_add_epi64(_mm_slli_epi64(high, 32 - FractionalBits),
+                         ShiftRightArithmeticSSE41<FractionalBits>(low));
+}
+
+template <bool Accumulate>
+MIX_KERNEL_TARGET("sse4.1")
+size_t MultiplySSE41(s64* output, const s64* input, s64 gain, size_t sample_count) {
+    const __m128i gains = _mm_set1_epi64x(gain);
+    size_t i = 0;
+    for (; i + 2 <= sample_count; i += 2) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i out = MultiplySSE41(in, gains, gain < 0);
+        if constexpr (Accumulate) {
+            out = _mm_add_epi64(out, _mm_loadu_si128(reinterpret_cast<__m128i*>(output + i)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i), out);
+    }
+    return i;
+}
+
+MIX_KERNEL_TARGET("sse4.1")
+size_t MixOutputSSE41(s32* output, const s32* input, const s64* wet, s64 dry_gain, s64 wet_gain,
+                      size_t sample_count) {
+    const __m128i dry_gains = _mm_set1_epi64x(dry_gain);
+    const __m128i wet_gains = _mm_set1_epi64x(wet_gain);
+    const __m128i divisor_mask = _mm_set1_epi64x(63);
+    const __m128i fraction_mask = _mm_set1_epi64x(FractionalMask);
+    size_t i = 0;
+    for (; i + 2 <= sample_count; i += 2) {
+        const __m128i in = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + i));
+        const __m128i in_sample = _mm_mul_epi32(_mm_cvtepi32_epi64(in), dry_gains);
+
+        // Division by 64 rounding towards zero, negative values are biased by 63 first
+        __m128i out_sample = MultiplySSE41(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(wet + i)), wet_gains, wet_gain < 0);
+        const __m128i sign = _mm_shuffle_epi32(_mm_srai_epi32(out_sample, 31),
+                                               _MM_SHUFFLE(3, 3, 1, 1));
+        out_sample = ShiftRightArithmeticSSE41<6>(
+            _mm_add_epi64(out_sample, _mm_and_si128(sign, divisor_mask)));
+
+        __m128i value = _mm_add_epi64(in_sample, out_sample);
+        value = _mm_add_epi64(value, _mm_srli_epi64(_mm_and_si128(value, fraction_mask), 1));
+        value = _mm_srli_epi64(value, FractionalBits);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output + i),
+                         _mm_shuffle_epi32(value, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+    return i;
+}
+
+/// Arithmetic right shift of the 64-bit lanes of value.
+template <int Shift>
+MIX_KERNEL_TARGET("avx2")
+__m256i ShiftRightArithmeticAVX2(__m256i value) {
+    const __m256i sign =
+        _mm256_shuffle_epi32(_mm256_srai_epi32(value, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    return _mm256_or_si256(_mm256_srli_epi64(value, Shift), _mm256_slli_epi64(sign, 64 - Shift));
+}
+
+MIX_KERNEL_TARGET("avx2")
+__m256i MultiplyAVX2(__m256i sample, __m256i gain, bool negative_gain) {
+    __m256i low = _mm256_mul_epu32(sample, gain);
+    if (negative_gain) {
+        low = _mm256_sub_epi64(low, _mm256_slli_epi64(sample, 32));
+    }
+    const __m256i high = _mm256_mul_epi32(_mm256_srli_epi64(sample, 32), gain);
+    return _mm256_add_epi64(_mm256_slli_epi64(high, 32 - FractionalBits),
+                            ShiftRightArithmeticAVX2<FractionalBits>(low));
+}
+
+template <bool Accumulate>
+MIX_KERNEL_TARGET("avx2")
+size_t MultiplyAVX2(s64* output, const s64* input, s64 gain, size_t sample_count) {
+    const __m256i gains = _mm256_set1_epi64x(gain);
+    size_t i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        __m256i out = MultiplyAVX2(in, gains, gain < 0);
+        if constexpr (Accumulate) {
+            out = _mm256_add_epi64(out,
+                                   _mm256_loadu_si256(reinterpret_cast<__m256i*>(output + i)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i), out);
+    }
+    return i;
+}
+
+MIX_KERNEL_TARGET("avx2")
+size_t MixOutputAVX2(s32* output, const s32* input, const s64* wet, s64 dry_gain, s64 wet_gain,
+                     size_t sample_count) {
+    const __m256i dry_gains = _mm256_set1_epi64x(dry_gain);
+    const __m256i wet_gains = _mm256_set1_epi64x(wet_gain);
+    const __m256i divisor_mask = _mm256_set1_epi64x(63);
+    const __m256i fraction_mask = _mm256_set1_epi64x(FractionalMask);
+    const __m256i pack_low = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    size_t i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        const __m256i in_sample = _mm256_mul_epi32(_mm256_cvtepi32_epi64(in), dry_gains);
+
+        // Division by 64 rounding towards zero, negative values are biased by 63 first
+        __m256i out_sample =
+            MultiplyAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(wet + i)), wet_gains,
+                         wet_gain < 0);
+        const __m256i sign =
+            _mm256_shuffle_epi32(_mm256_srai_epi32(out_sample, 31), _MM_SHUFFLE(3, 3, 1, 1));
+        out_sample = ShiftRightArithmeticAVX2<6>(
+            _mm256_add_epi64(out_sample, _mm256_and_si256(sign, divisor_mask)));
+
+        __m256i value = _mm256_add_epi64(in_sample, out_sample);
+        value =
+            _mm256_add_epi64(value, _mm256_srli_epi64(_mm256_and_si256(value, fraction_mask), 1));
+        value = _mm256_srli_epi64(value, FractionalBits);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(value, pack_low)));
+    }
+    return i;
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+int64x2_t MultiplyNEON(int64x2_t sample, int32x2_t gain, bool negative_gain) {
+    int64x2_t low = vreinterpretq_s64_u64(
+        vmull_u32(vreinterpret_u32_s32(vmovn_s64(sample)), vreinterpret_u32_s32(gain)));
+    if (negative_gain) {
+        low = vsubq_s64(low, vshlq_n_s64(sample, 32));
+    }
+    const int64x2_t high = vmull_s32(vshrn_n_s64(sample, 32), gain);
+    return vaddq_s64(vshlq_n_s64(high, 32 - FractionalBits), vshrq_n_s64(low, FractionalBits));
+}
+
+template <bool Accumulate>
+size_t MultiplyNEON(s64* output, const s64* input, s64 gain, size_t sample_count) {
+    const int32x2_t gains = vdup_n_s32(static_cast<s32>(gain));
+    size_t i = 0;
+    for (; i + 2 <= sample_count; i += 2) {
+        int64x2_t out = MultiplyNEON(vld1q_s64(input + i), gains, gain < 0);
+        if constexpr (Accumulate) {
+            out = vaddq_s64(out, vld1q_s64(output + i));
+        }
+        vst1q_s64(output + i, out);
+    }
+    return i;
+}
+
+size_t MixOutputNEON(s32* output, const s32* input, const s64* wet, s64 dry_gain, s64 wet_gain,
+                     size_t sample_count) {
+    const int32x2_t dry_gains = vdup_n_s32(static_cast<s32>(dry_gain));
+    const int32x2_t wet_gains = vdup_n_s32(static_cast<s32>(wet_gain));
+    size_t i = 0;
+    for (; i + 2 <= sample_count; i += 2) {
+        const int64x2_t in_sample = vmull_s32(vld1_s32(input + i), dry_gains);
+
+        // Division by 64 rounding towards zero, negative values are biased by 63 first
+        int64x2_t out_sample = MultiplyNEON(vld1q_s64(wet + i), wet_gains, wet_gain < 0);
+        out_sample = vaddq_s64(out_sample,
+                               vandq_s64(vshrq_n_s64(out_sample, 63), vdupq_n_s64(63)));
+        out_sample = vshrq_n_s64(out_sample, 6);
+
+        int64x2_t value = vaddq_s64(in_sample, out_sample);
+        const int64x2_t fraction = vandq_s64(value, vdupq_n_s64(FractionalMask));
+        value = vaddq_s64(value, vshrq_n_s64(fraction, 1));
+        vst1_s32(output + i, vshrn_n_s64(value, FractionalBits));
+    }
+    return i;
+}
+
+#endif
+
+template <bool Accumulate>
+void MultiplyImpl(MixKernel kernel, s64* output, const s64* input, s64 gain,
+                  size_t sample_count) {
+    size_t processed = 0;
+    // The vector kernels need the gain to fit in 32 bits, louder gains are left to the scalar
+    // loop.
+    if (FitsInS32(gain)) {
+        switch (kernel) {
+#if defined(ARCHITECTURE_x86_64)
+        case MixKernel::SSE41:
+            processed = MultiplySSE41<Accumulate>(output, input, gain, sample_count);
+            break;
+        case MixKernel::AVX2:
+            processed = MultiplyAVX2<Accumulate>(output, input, gain, sample_count);
+            break;
+#elif defined(ARCHITECTURE_arm64)
+        case MixKernel::NEON:
+            processed = MultiplyNEON<Accumulate>(output, input, gain, sample_count);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+    MultiplyScalar<Accumulate>(output + processed, input + processed, gain,
+                               sample_count - processed);
+}
+
+} // Anonymous namespace
+
+void MultiplyReverbSamples(MixKernel kernel, std::span<s64> output, std::span<const s64> input,
+                           s64 gain, bool accumulate) {
+    ASSERT(input.size() >= output.size());
+    if (accumulate) {
+        MultiplyImpl<true>(kernel, output.data(), input.data(), gain, output.size());
+    } else {
+        MultiplyImpl<false>(kernel, output.data(), input.data(), gain, output.size());
+    }
+}
+
+void MultiplyReverbSamples(std::span<s64> output, std::span<const s64> input, s64 gain,
+                           bool accumulate) {
+    static const MixKernel kernel = GetSupportedMixKernels().back();
+    MultiplyReverbSamples(kernel, output, input, gain, accumulate);
+}
+
+void MixReverbOutput(MixKernel kernel, std::span<s32> output, std::span<const s32> input,
+                     std::span<const s64> wet, s64 dry_gain, s64 wet_gain) {
+    ASSERT(input.size() >= output.size() && wet.size() >= output.size());
+    const size_t sample_count{output.size()};
+    size_t processed = 0;
+    if (FitsInS32(dry_gain) && FitsInS32(wet_gain)) {
+        switch (kernel) {
+#if defined(ARCHITECTURE_x86_64)
+        case MixKernel::SSE41:
+            processed = MixOutputSSE41(output.data(), input.data(), wet.data(), dry_gain,
+                                       wet_gain, sample_count);
+            break;
+        case MixKernel::AVX2:
+            processed = MixOutputAVX2(output.data(), input.data(), wet.data(), dry_gain, wet_gain,
+                                      sample_count);
+            break;
+#elif defined(ARCHITECTURE_arm64)
+        case MixKernel::NEON:
+            processed = MixOutputNEON(output.data(), input.data(), wet.data(), dry_gain, wet_gain,
+                                      sample_count);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+    MixOutputScalar(output.data() + processed, input.data() + processed, wet.data() + processed,
+                    dry_gain, wet_gain, sample_count - processed);
+}
+
+void MixReverbOutput(std::span<s32> output, std::span<const s32> input, std::span<const s64> wet,
+                     s64 dry_gain, s64 wet_gain) {
+    static const MixKernel kernel = GetSupportedMixKernels().back();
+    MixReverbOutput(kernel, output, input, wet, dry_gain, wet_gain);
+}
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Renderer {
+
+/// Number of samples the reverb effects process together in each stage, for the kernels below
+constexpr u32 ReverbBlockSize = 64;
+
+/**
+ * Multiply reverb samples by a gain, and either add the products to the output or replace it.
+ * Samples and gain are raw Common::FixedPoint<50, 14> values, and every kernel matches its
+ * multiplication bit for bit, wrapping around the same way. Output and input may be the same.
+ *
+ * @param kernel     - Kernel to process the samples with, must be supported by the host.
+ * @param output     - Output samples.
+ * @param input      - Input samples, at least as many as the output.
+ * @param gain       - Raw fixed point gain.
+ * @param accumulate - If true, add to the output, otherwise replace it.
+ */
+void MultiplyReverbSamples(MixKernel kernel, std::span<s64> output, std::span<const s64> input,
+                           s64 gain, bool accumulate);
+
+/**
+ * Multiply reverb samples with the fastest kernel the host supports.
+ * See the overload above for the parameters.
+ */
+void MultiplyReverbSamples(std::span<s64> output, std::span<const s64> input, s64 gain,
+                           bool accumulate);
+
+/**
+ * Mix the wet samples of a reverb into its dry input, as input * dry_gain + wet * wet_gain / 64,
+ * rounded the same way as Common::FixedPoint::to_int. The gains are raw
+ * Common::FixedPoint<50, 14> values, and the result matches the fixed point operations bit for
+ * bit. Output and input may be the same buffer.
+ *
+ * @param kernel   - Kernel to process the samples with, must be supported by the host.
+ * @param output   - Output mix buffer.
+ * @param input    - Dry input mix buffer, at least as many samples as the output.
+ * @param wet      - Raw fixed point wet samples, at least as many as the output.
+ * @param dry_gain - Raw fixed point gain of the dry input.
+ * @param wet_gain - Raw fixed point gain of the wet samples.
+ */
+void MixReverbOutput(MixKernel kernel, std::span<s32> output, std::span<const s32> input,
+                     std::span<const s64> wet, s64 dry_gain, s64 wet_gain);
+
+/**
+ * Mix the wet samples of a reverb with the fastest kernel the host supports.
+ * See the overload above for the parameters.
+ */
+void MixReverbOutput(std::span<s32> output, std::span<const s32> input, std::span<const s64> wet,
+                     s64 dry_gain, s64 wet_gain);
+
+} // namespace AudioCore::Renderer
@@ -0,0 +1,245 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <limits>
+#include <vector>
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "common/assert.h"
+
+namespace AudioCore::Renderer {
+namespace {
+
+template <size_t Q>
+constexpr s64 FractionalMask = (s64{1} << Q) - 1;
+
+bool FitsInS32(s64 value) {
+    return value >= std::numeric_limits<s32>::min() && value <= std::numeric_limits<s32>::max();
+}
+
+/// Round a fixed point value to an integer, the same way as Common::FixedPoint::to_int.
+template <size_t Q>
+s32 RoundToInt(s64 value) {
+    value += (value & FractionalMask<Q>) >> 1;
+    return static_cast<s32>(value >> Q);
+}
+
+template <size_t Q, bool Accumulate>
+void ApplyGainRampScalar(s32* output, const s32* input, s64 gain, s64 ramp, u32 sample_count) {
+    for (u32 i = 0; i < sample_count; i++) {
+        const s64 base = Accumulate ? s64{output[i]} * (s64{1} << Q) : 0;
+        output[i] = RoundToInt<Q>(base + input[i] * gain);
+        gain += ramp;
+    }
+}
+
+// The vector kernels multiply with 32-bit gains into 64-bit lanes, and round with logical
+// shifts. Only the low 32 bits of the rounded value are kept, which a logical shift leaves the
+// same as an arithmetic one. Each kernel returns the number of samples it processed, the rest
+// are left for the scalar loop.
+
+#if defined(ARCHITECTURE_x86_64)
+
+template <size_t Q>
+MIX_KERNEL_TARGET("sse4.1")
+__m128i RoundToIntSSE41(__m128i value) {
+    const __m128i fraction = _mm_and_si128(value, _mm_set1_epi64x(FractionalMask<Q>));
+    value = _mm_add_epi64(value, _mm_srli_epi64(fraction, 1));
+    return _mm_srli_epi64(value, static_cast<int>(Q));
+}
+
+/// Pack the low 32 bits of the 64-bit lanes of lo and hi, in order.
+MIX_KERNEL_TARGET("sse4.1")
+__m128i PackLowSSE41(__m128i lo, __m128i hi) {
+    return _mm_castps_si128(
+        _mm_shuffle_ps(_mm_castsi128_ps(lo), _mm_castsi128_ps(hi), _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+template <size_t Q, bool Accumulate>
+MIX_KERNEL_TARGET("sse4.1")
+u32 ApplyGainRampSSE41(s32* output, const s32* input, s64 gain, s64 ramp, u32 sample_count) {
+    const __m128i step = _mm_set1_epi64x(ramp * 4);
+    __m128i gain_lo = _mm_set_epi64x(gain + ramp, gain);
+    __m128i gain_hi = _mm_set_epi64x(gain + ramp * 3, gain + ramp * 2);
+    u32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + i));
+        __m128i lo = _mm_mul_epi32(_mm_cvtepi32_epi64(in), gain_lo);
+        __m128i hi = _mm_mul_epi32(_mm_cvtepi32_epi64(_mm_srli_si128(in, 8)), gain_hi);
+        if constexpr (Accumulate) {
+            const __m128i out = _mm_loadu_si128(reinterpret_cast<const __m128i*>(output + i));
+            lo = _mm_add_epi64(lo, _mm_slli_epi64(_mm_cvtepi32_epi64(out), static_cast<int>(Q)));
+            hi = _mm_add_epi64(hi, _mm_slli_epi64(_mm_cvtepi32_epi64(_mm_srli_si128(out, 8)),
+                                                  static_cast<int>(Q)));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + i),
+                         PackLowSSE41(RoundToIntSSE41<Q>(lo), RoundToIntSSE41<Q>(hi)));
+        gain_lo = _mm_add_epi64(gain_lo, step);
+        gain_hi = _mm_add_epi64(gain_hi, step);
+    }
+    return i;
+}
+
+template <size_t Q>
+MIX_KERNEL_TARGET("avx2")
+__m256i RoundToIntAVX2(__m256i value) {
+    const __m256i fraction = _mm256_and_si256(value, _mm256_set1_epi64x(FractionalMask<Q>));
+    value = _mm256_add_epi64(value, _mm256_srli_epi64(fraction, 1));
+    return _mm256_srli_epi64(value, static_cast<int>(Q));
+}
+
+/// Pack the low 32 bits of the 64-bit lanes of lo and hi, in order.
+MIX_KERNEL_TARGET("avx2")
+__m256i PackLowAVX2(__m256i lo, __m256i hi) {
+    const __m256 packed = _mm256_shuffle_ps(_mm256_castsi256_ps(lo), _mm256_castsi256_ps(hi),
+                                            _MM_SHUFFLE(2, 0, 2, 0));
+    return _mm256_permute4x64_epi64(_mm256_castps_si256(packed), _MM_SHUFFLE(3, 1, 2, 0));
+}
+
+template <size_t Q, bool Accumulate>
+MIX_KERNEL_TARGET("avx2")
+u32 ApplyGainRampAVX2(s32* output, const s32* input, s64 gain, s64 ramp, u32 sample_count) {
+    const __m256i step = _mm256_set1_epi64x(ramp * 8);
+    __m256i gain_lo = _mm256_set_epi64x(gain + ramp * 3, gain + ramp * 2, gain + ramp, gain);
+    __m256i gain_hi = _mm256_set_epi64x(gain + ramp * 7, gain + ramp * 6, gain + ramp * 5,
+                                        gain + ramp * 4);
+    u32 i = 0;
+    for (; i + 8 <= sample_count; i += 8) {
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(input + i));
+        __m256i lo = _mm256_mul_epi32(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(in)), gain_lo);
+        __m256i hi =
+            _mm256_mul_epi32(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(in, 1)), gain_hi);
+        if constexpr (Accumulate) {
+            const __m256i out = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(output + i));
+            lo = _mm256_add_epi64(
+                lo, _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm256_castsi256_si128(out)),
+                                      static_cast<int>(Q)));
+            hi = _mm256_add_epi64(
+                hi, _mm256_slli_epi64(_mm256_cvtepi32_epi64(_mm256_extracti128_si256(out, 1)),
+                                      static_cast<int>(Q)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(output + i),
+                            PackLowAVX2(RoundToIntAVX2<Q>(lo), RoundToIntAVX2<Q>(hi)));
+        gain_lo = _mm256_add_epi64(gain_lo, step);
+        gain_hi = _mm256_add_epi64(gain_hi, step);
+    }
+    return i;
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+template <size_t Q>
+int32x2_t RoundToIntNEON(int64x2_t value) {
+    const int64x2_t fraction = vandq_s64(value, vdupq_n_s64(FractionalMask<Q>));
+    value = vaddq_s64(value, vshrq_n_s64(fraction, 1));
+    return vshrn_n_s64(value, Q);
+}
+
+template <size_t Q, bool Accumulate>
+u32 ApplyGainRampNEON(s32* output, const s32* input, s64 gain, s64 ramp, u32 sample_count) {
+    const int64x2_t step = vdupq_n_s64(ramp * 4);
+    const s64 gains[4]{gain, gain + ramp, gain + ramp * 2, gain + ramp * 3};
+    int64x2_t gain_lo = vld1q_s64(gains);
+    int64x2_t gain_hi = vld1q_s64(gains + 2);
+    u32 i = 0;
+    for (; i + 4 <= sample_count; i += 4) {
+        const int32x4_t in = vld1q_s32(input + i);
+        int64x2_t lo = vmull_s32(vget_low_s32(in), vmovn_s64(gain_lo));
+        int64x2_t hi = vmull_s32(vget_high_s32(in), vmovn_s64(gain_hi));
+        if constexpr (Accumulate) {
+            const int32x4_t out = vld1q_s32(output + i);
+            lo = vaddq_s64(lo, vshll_n_s32(vget_low_s32(out), Q));
+            hi = vaddq_s64(hi, vshll_n_s32(vget_high_s32(out), Q));
+        }
+        vst1q_s32(output + i, vcombine_s32(RoundToIntNEON<Q>(lo), RoundToIntNEON<Q>(hi)));
+        gain_lo = vaddq_s64(gain_lo, step);
+        gain_hi = vaddq_s64(gain_hi, step);
+    }
+    return i;
+}
+
+#endif
+
+template <size_t Q, bool Accumulate>
+void ApplyGainRampImpl(MixKernel kernel, s32* output, const s32* input, s64 gain, s64 ramp,
+                       u32 sample_count) {
+    u32 processed = 0;
+    // The vector kernels need every gain to fit in 32 bits, a ramp is linear so checking both
+    // ends is enough. Louder mixes than that are left to the scalar loop.
+    if (sample_count != 0 && FitsInS32(gain) && FitsInS32(ramp) &&
+        FitsInS32(gain + ramp * (sample_count - 1))) {
+        switch (kernel) {
+#if defined(ARCHITECTURE_x86_64)
+        case MixKernel::SSE41:
+            processed = ApplyGainRampSSE41<Q, Accumulate>(output, input, gain, ramp, sample_count);
+            break;
+        case MixKernel::AVX2:
+            processed = ApplyGainRampAVX2<Q, Accumulate>(output, input, gain, ramp, sample_count);
+            break;
+#elif defined(ARCHITECTURE_arm64)
+        case MixKernel::NEON:
+            processed = ApplyGainRampNEON<Q, Accumulate>(output, input, gain, ramp, sample_count);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+    ApplyGainRampScalar<Q, Accumulate>(output + processed, input + processed,
+                                       gain + ramp * processed, ramp, sample_count - processed);
+}
+
+} // Anonymous namespace
+
+std::span<const MixKernel> GetSupportedMixKernels() {
+    static const std::vector<MixKernel> kernels = [] {
+        std::vector<MixKernel> supported{MixKernel::Scalar};
+#if defined(ARCHITECTURE_x86_64)
+        const auto& caps = Common::GetCPUCaps();
+        if (caps.sse4_1) {
+            supported.push_back(MixKernel::SSE41);
+        }
+        if (caps.avx2) {
+            supported.push_back(MixKernel::AVX2);
+        }
+#elif defined(ARCHITECTURE_arm64)
+        supported.push_back(MixKernel::NEON);
+#endif
+        return supported;
+    }();
+    return kernels;
+}
+
+template <size_t Q>
+void ApplyGainRamp(MixKernel kernel, std::span<s32> output, std::span<const s32> input, s64 gain,
+                   s64 ramp, u32 sample_count, bool accumulate) {
+    ASSERT(output.size() >= sample_count && input.size() >= sample_count);
+    if (accumulate) {
+        ApplyGainRampImpl<Q, true>(kernel, output.data(), input.data(), gain, ramp, sample_count);
+    } else {
+        ApplyGainRampImpl<Q, false>(kernel, output.data(), input.data(), gain, ramp, sample_count);
+    }
+}
+
+template <size_t Q>
+void ApplyGainRamp(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                   u32 sample_count, bool accumulate) {
+    static const MixKernel kernel = GetSupportedMixKernels().back();
+    ApplyGainRamp<Q>(kernel, output, input, gain, ramp, sample_count, accumulate);
+}
+
+template void ApplyGainRamp<15>(MixKernel, std::span<s32>, std::span<const s32>, s64, s64, u32,
+                                bool);
+template void ApplyGainRamp<23>(MixKernel, std::span<s32>, std::span<const s32>, s64, s64, u32,
+                                bool);
+template void ApplyGainRamp<15>(std::span<s32>, std::span<const s32>, s64, s64, u32, bool);
+template void ApplyGainRamp<23>(std::span<s32>, std::span<const s32>, s64, s64, u32, bool);
+
+} // namespace AudioCore::Renderer
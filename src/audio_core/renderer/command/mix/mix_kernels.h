@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+
+#include "common/common_types.h"
+
+// Marks a function as using an instruction set the whole build doesn't target. MSVC allows the
+// intrinsics anywhere.
+#if defined(ARCHITECTURE_x86_64) && !(defined(_MSC_VER) && !defined(__clang__))
+#define MIX_KERNEL_TARGET(isa) __attribute__((target(isa)))
+#else
+#define MIX_KERNEL_TARGET(isa)
+#endif
+
+namespace AudioCore::Renderer {
+
+/// Instruction sets the mix kernels are implemented with.
+enum class MixKernel : u8 {
+    Scalar,
+    SSE41,
+    AVX2,
+    NEON,
+};
+
+/**
+ * Get the mix kernels the host can run.
+ *
+ * @return The supported kernels, the scalar one first and the fastest one last.
+ */
+std::span<const MixKernel> GetSupportedMixKernels();
+
+/**
+ * Apply a gain to the input mix buffer, increasing it by ramp after every sample, and either add
+ * the result to the output mix buffer or replace it. The result is rounded the same way as
+ * Common::FixedPoint::to_int, so every kernel matches the scalar fixed point loops bit for bit.
+ * Input and output may be the same buffer.
+ *
+ * @tparam Q           - Number of bits for fixed point operations.
+ * @param kernel       - Kernel to process the samples with, must be supported by the host.
+ * @param output       - Output mix buffer.
+ * @param input        - Input mix buffer.
+ * @param gain         - Raw fixed point gain applied to the first sample.
+ * @param ramp         - Raw fixed point value added to the gain after every sample.
+ * @param sample_count - Number of samples to process.
+ * @param accumulate   - If true, add to the output, otherwise replace it.
+ */
+template <size_t Q>
+void ApplyGainRamp(MixKernel kernel, std::span<s32> output, std::span<const s32> input, s64 gain,
+                   s64 ramp, u32 sample_count, bool accumulate);
+
+/**
+ * Apply a gain to the input mix buffer with the fastest kernel the host supports.
+ * See the overload above for the parameters.
+ */
+template <size_t Q>
+void ApplyGainRamp(std::span<s32> output, std::span<const s32> input, s64 gain, s64 ramp,
+                   u32 sample_count, bool accumulate);
+
+} // namespace AudioCore::Renderer
@@ -1,10 +1,203 @@
 // SPDX-FileCopyrightText: Copyright 2022 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+
+#if defined(ARCHITECTURE_x86_64)
+#include <immintrin.h>
+#elif defined(ARCHITECTURE_arm64)
+#include <arm_neon.h>
+#endif
+
 #include "audio_core/renderer/command/resample/resample.h"
 
 namespace AudioCore::Renderer {
 
+/// Number of output samples the vector filters produce at once.
+constexpr u32 FilterGroupSize = 4;
+
+/**
+ * Step the read position to the next output sample.
+ *
+ * @param sample_rate_ratio - Ratio for resampling.
+ * @param fraction          - Current read fraction.
+ * @param read_index        - Current read index into the input, advanced by whole samples.
+ */
+static void AdvanceReadPosition(const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                                Common::FixedPoint<49, 15>& fraction, u32& read_index) {
+    fraction += sample_rate_ratio;
+    read_index += static_cast<u32>(fraction.to_int_floor());
+    fraction.clear_int();
+}
+
+/**
+ * Filter one output sample. Each tap is truncated to 8 fractional bits before being summed.
+ *
+ * @tparam NumTaps     - Number of filter taps.
+ * @param input        - Input samples, starting at the first tap.
+ * @param coefficients - Filter coefficients, starting at the first tap.
+ * @return The filtered sample.
+ */
+template <size_t NumTaps>
+static s32 FilterSample(const s16* input, const f32* coefficients) {
+    Common::FixedPoint<56, 8> sum{0};
+    for (size_t tap = 0; tap < NumTaps; tap++) {
+        sum += Common::FixedPoint<56, 8>{input[tap] * coefficients[tap]};
+    }
+    return sum.to_int_floor();
+}
+
+// The vector filters compute the taps of one output sample per vector, with the same single
+// precision multiply and truncation as FilterSample, then sum the vectors of a group of samples
+// horizontally. The products fit in 24 bits, so the sums can't overflow 32-bit lanes.
+
+#if defined(ARCHITECTURE_x86_64)
+
+template <size_t NumTaps>
+MIX_KERNEL_TARGET("sse4.1")
+static __m128i FilterTapsSSE41(const s16* input, const f32* coefficients) {
+    __m128i sum = _mm_setzero_si128();
+    for (size_t tap = 0; tap < NumTaps; tap += 4) {
+        const __m128i samples =
+            _mm_cvtepi16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(input + tap)));
+        const __m128 products =
+            _mm_mul_ps(_mm_cvtepi32_ps(samples), _mm_loadu_ps(coefficients + tap));
+        sum = _mm_add_epi32(sum, _mm_cvttps_epi32(_mm_mul_ps(products, _mm_set1_ps(256.0f))));
+    }
+    return sum;
+}
+
+template <size_t NumTaps>
+MIX_KERNEL_TARGET("sse4.1")
+static void FilterGroupSSE41(s32* output, const s16* input, const f32* lut,
+                             const std::array<u32, FilterGroupSize>& read_indices,
+                             const std::array<u32, FilterGroupSize>& lut_indices) {
+    __m128i taps[FilterGroupSize];
+    for (u32 i = 0; i < FilterGroupSize; i++) {
+        taps[i] = FilterTapsSSE41<NumTaps>(input + read_indices[i], lut + lut_indices[i]);
+    }
+    const __m128i sums =
+        _mm_hadd_epi32(_mm_hadd_epi32(taps[0], taps[1]), _mm_hadd_epi32(taps[2], taps[3]));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_srai_epi32(sums, 8));
+}
+
+/// Eight taps fill a whole AVX2 vector, fewer are left to SSE4.1.
+template <size_t NumTaps>
+MIX_KERNEL_TARGET("avx2")
+static void FilterGroupAVX2(s32* output, const s16* input, const f32* lut,
+                            const std::array<u32, FilterGroupSize>& read_indices,
+                            const std::array<u32, FilterGroupSize>& lut_indices) {
+    if constexpr (NumTaps != 8) {
+        FilterGroupSSE41<NumTaps>(output, input, lut, read_indices, lut_indices);
+    } else {
+        __m128i taps[FilterGroupSize];
+        for (u32 i = 0; i < FilterGroupSize; i++) {
+            const __m256i samples = _mm256_cvtepi16_epi32(
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + read_indices[i])));
+            const __m256 products =
+                _mm256_mul_ps(_mm256_cvtepi32_ps(samples), _mm256_loadu_ps(lut + lut_indices[i]));
+            const __m256i truncated =
+                _mm256_cvttps_epi32(_mm256_mul_ps(products, _mm256_set1_ps(256.0f)));
+            taps[i] = _mm_add_epi32(_mm256_castsi256_si128(truncated),
+                                    _mm256_extracti128_si256(truncated, 1));
+        }
+        const __m128i sums =
+            _mm_hadd_epi32(_mm_hadd_epi32(taps[0], taps[1]), _mm_hadd_epi32(taps[2], taps[3]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm_srai_epi32(sums, 8));
+    }
+}
+
+#elif defined(ARCHITECTURE_arm64)
+
+template <size_t NumTaps>
+static int32x4_t FilterTapsNEON(const s16* input, const f32* coefficients) {
+    int32x4_t sum = vdupq_n_s32(0);
+    for (size_t tap = 0; tap < NumTaps; tap += 4) {
+        const float32x4_t samples = vcvtq_f32_s32(vmovl_s16(vld1_s16(input + tap)));
+        const float32x4_t products = vmulq_f32(samples, vld1q_f32(coefficients + tap));
+        sum = vaddq_s32(sum, vcvtq_s32_f32(vmulq_n_f32(products, 256.0f)));
+    }
+    return sum;
+}
+
+template <size_t NumTaps>
+static void FilterGroupNEON(s32* output, const s16* input, const f32* lut,
+                            const std::array<u32, FilterGroupSize>& read_indices,
+                            const std::array<u32, FilterGroupSize>& lut_indices) {
+    int32x4_t taps[FilterGroupSize];
+    for (u32 i = 0; i < FilterGroupSize; i++) {
+        taps[i] = FilterTapsNEON<NumTaps>(input + read_indices[i], lut + lut_indices[i]);
+    }
+    const int32x4_t sums =
+        vpaddq_s32(vpaddq_s32(taps[0], taps[1]), vpaddq_s32(taps[2], taps[3]));
+    vst1q_s32(output, vshrq_n_s32(sums, 8));
+}
+
+#endif
+
+/**
+ * Resample with a polyphase filter, picking the filter phase from the read fraction.
+ *
+ * @tparam NumTaps          - Number of filter taps.
+ * @param kernel            - Kernel to filter the samples with.
+ * @param output            - Output buffer.
+ * @param input             - Input buffer.
+ * @param lut               - Filter coefficients, NumTaps for each of the 128 phases.
+ * @param sample_rate_ratio - Ratio for resampling.
+ * @param fraction          - Current read fraction, written to and should be passed back in for
+ *                            multiple calls.
+ * @param samples_to_write  - Number of samples to write.
+ */
+template <size_t NumTaps>
+static void ResamplePolyphase(const MixKernel kernel, std::span<s32> output,
+                              std::span<const s16> input, std::span<const f32> lut,
+                              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+                              Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
+    u32 read_index{0};
+    u32 i{0};
+    if (kernel != MixKernel::Scalar) {
+        // Walk the read position over a group of samples first, the filters are independent
+        for (; i + FilterGroupSize <= samples_to_write; i += FilterGroupSize) {
+            std::array<u32, FilterGroupSize> read_indices;
+            std::array<u32, FilterGroupSize> lut_indices;
+            for (u32 j = 0; j < FilterGroupSize; j++) {
+                read_indices[j] = read_index;
+                lut_indices[j] = static_cast<u32>((fraction.get_frac() >> 8) * NumTaps);
+                AdvanceReadPosition(sample_rate_ratio, fraction, read_index);
+            }
+
+            switch (kernel) {
+#if defined(ARCHITECTURE_x86_64)
+            case MixKernel::SSE41:
+                FilterGroupSSE41<NumTaps>(&output[i], input.data(), lut.data(), read_indices,
+                                          lut_indices);
+                break;
+            case MixKernel::AVX2:
+                FilterGroupAVX2<NumTaps>(&output[i], input.data(), lut.data(), read_indices,
+                                         lut_indices);
+                break;
+#elif defined(ARCHITECTURE_arm64)
+            case MixKernel::NEON:
+                FilterGroupNEON<NumTaps>(&output[i], input.data(), lut.data(), read_indices,
+                                         lut_indices);
+                break;
+#endif
+            default:
+                for (u32 j = 0; j < FilterGroupSize; j++) {
+                    output[i + j] = FilterSample<NumTaps>(&input[read_indices[j]],
+                                                          &lut[lut_indices[j]]);
+                }
+                break;
+            }
+        }
+    }
+    for (; i < samples_to_write; i++) {
+        const auto lut_index{(fraction.get_frac() >> 8) * NumTaps};
+        output[i] = FilterSample<NumTaps>(&input[read_index], &lut[lut_index]);
+        AdvanceReadPosition(sample_rate_ratio, fraction, read_index);
+    }
+}
+
 static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input,
                                const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
@@ -23,7 +216,8 @@ static void ResampleLowQuality(std::span<s32> output, std::span<const s16> input
     }
 }
 
-static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> input,
+static void ResampleNormalQuality(const MixKernel kernel, std::span<s32> output,
+                                  std::span<const s16> input,
                                   const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                   Common::FixedPoint<49, 15>& fraction,
                                   const u32 samples_to_write) {
@@ -292,22 +486,12 @@ static void ResampleNormalQuality(std::span<s32> output, std::span<const s16> in
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 4};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        output[i] = (sample0 + sample1 + sample2 + sample3).to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResamplePolyphase<4>(kernel, output, input, get_lut(), sample_rate_ratio, fraction,
+                         samples_to_write);
 }
 
-static void ResampleHighQuality(std::span<s32> output, std::span<const s16> input,
+static void ResampleHighQuality(const MixKernel kernel, std::span<s32> output,
+                                std::span<const s16> input,
                                 const Common::FixedPoint<49, 15>& sample_rate_ratio,
                                 Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write) {
     static constexpr std::array<f32, 1024> lut0 = {
@@ -842,40 +1026,34 @@ static void ResampleHighQuality(std::span<s32> output, std::span<const s16> inpu
         }
     };
 
-    auto lut{get_lut()};
-    u32 read_index{0};
-    for (u32 i = 0; i < samples_to_write; i++) {
-        const auto lut_index{(fraction.get_frac() >> 8) * 8};
-        const Common::FixedPoint<56, 8> sample0{input[read_index + 0] * lut[lut_index + 0]};
-        const Common::FixedPoint<56, 8> sample1{input[read_index + 1] * lut[lut_index + 1]};
-        const Common::FixedPoint<56, 8> sample2{input[read_index + 2] * lut[lut_index + 2]};
-        const Common::FixedPoint<56, 8> sample3{input[read_index + 3] * lut[lut_index + 3]};
-        const Common::FixedPoint<56, 8> sample4{input[read_index + 4] * lut[lut_index + 4]};
-        const Common::FixedPoint<56, 8> sample5{input[read_index + 5] * lut[lut_index + 5]};
-        const Common::FixedPoint<56, 8> sample6{input[read_index + 6] * lut[lut_index + 6]};
-        const Common::FixedPoint<56, 8> sample7{input[read_index + 7] * lut[lut_index + 7]};
-        output[i] = (sample0 + sample1 + sample2 + sample3 + sample4 + sample5 + sample6 + sample7)
-                        .to_int_floor();
-        fraction += sample_rate_ratio;
-        read_index += static_cast<u32>(fraction.to_int_floor());
-        fraction.clear_int();
-    }
+    ResamplePolyphase<8>(kernel, output, input, get_lut(), sample_rate_ratio, fraction,
+                         samples_to_write);
 }
 
 void Resample(std::span<s32> output, std::span<const s16> input,
               const Common::FixedPoint<49, 15>& sample_rate_ratio,
               Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
               const SrcQuality src_quality) {
+    static const MixKernel kernel = GetSupportedMixKernels().back();
+    Resample(kernel, output, input, sample_rate_ratio, fraction, samples_to_write, src_quality);
+}
+
+void Resample(const MixKernel kernel, std::span<s32> output, std::span<const s16> input,
+              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+              Common::FixedPoint<49, 15>& fraction, const u32 samples_to_write,
+              const SrcQuality src_quality) {
 
     switch (src_quality) {
     case SrcQuality::Low:
         ResampleLowQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
         break;
     case SrcQuality::Medium:
-        ResampleNormalQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
+        ResampleNormalQuality(kernel, output, input, sample_rate_ratio, fraction,
+                              samples_to_write);
         break;
     case SrcQuality::High:
-        ResampleHighQuality(output, input, sample_rate_ratio, fraction, samples_to_write);
+        ResampleHighQuality(kernel, output, input, sample_rate_ratio, fraction,
+                            samples_to_write);
         break;
     }
 }
@@ -6,6 +6,7 @@
 #include <span>
 
 #include "audio_core/common/common.h"
+#include "audio_core/renderer/command/mix/mix_kernels.h"
 #include "common/common_types.h"
 #include "common/fixed_point.h"
 
@@ -26,4 +27,14 @@ void Resample(std::span<s32> output, std::span<const s16> input,
               const Common::FixedPoint<49, 15>& sample_rate_ratio,
               Common::FixedPoint<49, 15>& fraction, u32 samples_to_write, SrcQuality src_quality);
 
+/**
+ * Resample an input buffer into an output buffer with the given kernel, see above. Every kernel
+ * gives the same output.
+ *
+ * @param kernel - Kernel to filter the samples with, must be supported by the host.
+ */
+void Resample(MixKernel kernel, std::span<s32> output, std::span<const s16> input,
+              const Common::FixedPoint<49, 15>& sample_rate_ratio,
+              Common::FixedPoint<49, 15>& fraction, u32 samples_to_write, SrcQuality src_quality);
+
 } // namespace AudioCore::Renderer
@@ -14,6 +14,7 @@
 #include "audio_core/renderer/behavior/info_updater.h"
 #include "audio_core/renderer/command/command_buffer.h"
 #include "audio_core/renderer/command/command_generator.h"
+#include "audio_core/renderer/command/command_list_capture.h"
 #include "audio_core/renderer/command/command_list_header.h"
 #include "audio_core/renderer/effect/effect_info_base.h"
 #include "audio_core/renderer/effect/effect_result_state.h"
@@ -29,6 +30,8 @@
 #include "audio_core/renderer/voice/voice_info.h"
 #include "audio_core/renderer/voice/voice_state.h"
 #include "common/alignment.h"
+#include "common/fs/path_util.h"
+#include "common/settings.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/kernel/k_event.h"
@@ -118,6 +121,7 @@ Result System::Initialize(const AudioRendererParameterInternal& params,
 
     behavior.SetUserLibRevision(params.revision);
 
+    parameters = params;
     process_handle = process_handle_;
     applet_resource_user_id = applet_resource_user_id_;
     session_id = session_id_;
@@ -596,6 +600,13 @@ void System::SendCommandToDsp() {
                 command_size = command_buffer_size;
             } else {
                 command_size = GenerateCommand(command_workbuffer, command_workbuffer_size);
+
+                if (!Settings::values.dump_audio_commands) {
+                    is_command_list_captured = false;
+                } else if (!is_command_list_captured) {
+                    CaptureCommandList(command_size);
+                    is_command_list_captured = true;
+                }
             }
 
             auto translated_addr{
@@ -749,6 +760,18 @@ void System::SetVoiceDropParameter(f32 voice_drop_) {
     drop_voice_param = voice_drop_;
 }
 
+void System::CaptureCommandList(u64 command_size) {
+    const auto path{Common::FS::GetCitronPath(Common::FS::CitronPath::DumpDir) / "audio" /
+                    fmt::format("{:016X}_session{}_frame{}.bin", process_handle->GetProgramId(),
+                                session_id, frames_elapsed.load())};
+    if (CommandListCapture::Write(path, parameters, {workbuffer.get(), workbuffer_size},
+                                  command_workbuffer.first(command_size),
+                                  process_handle->GetMemory())) {
+        LOG_INFO(Service_Audio, "Captured the audio command list to {}",
+                 Common::FS::PathToUTF8String(path));
+    }
+}
+
 u32 System::DropVoices(CommandBuffer& command_buffer, u32 estimated_process_time, u32 time_limit) {
     u32 i{0};
     auto command_list{command_buffer.command_list.data() + sizeof(CommandListHeader)};
@@ -190,6 +190,14 @@ public:
      */
     u64 GenerateCommand(std::span<u8> command_buffer, u64 command_buffer_size);
 
+    /**
+     * Write the command list last generated, along with the workbuffer it points into and the
+     * guest memory its commands access, to the dump directory, so it can be replayed offline.
+     *
+     * @param command_size - Size of the command list, including its header.
+     */
+    void CaptureCommandList(u64 command_size);
+
     /**
      * Try to drop some voices if the AudioRenderer fell behind.
      *
@@ -223,6 +231,8 @@ private:
     ::AudioCore::ADSP::AudioRenderer::AudioRenderer& audio_renderer;
     /// Is this system initialized?
     bool initialized{};
+    /// Parameters this system was initialized with
+    AudioRendererParameterInternal parameters{};
     /// Is this system currently active?
     std::atomic<bool> active{};
     /// State of the system
@@ -323,6 +333,8 @@ private:
     u64 render_start_tick{};
     /// Parameter to control the threshold for dropping voices if the audio graph gets too large
     f32 drop_voice_param{1.0f};
+    /// Has a command list been captured since audio command dumping was enabled?
+    bool is_command_list_captured{};
 };
 
 } // namespace Renderer
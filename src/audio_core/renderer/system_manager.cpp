@@ -83,6 +83,7 @@ void SystemManager::ThreadFunc(std::stop_token stop_token) {
     MicroProfileOnThreadCreate(name);
     Common::SetCurrentThreadName(name);
     Common::SetCurrentThreadPriority(Common::ThreadPriority::High);
+    Common::SetCurrentThreadRole(Common::ThreadRole::Audio);
     while (active && !stop_token.stop_requested()) {
         {
             std::scoped_lock l{mutex1};
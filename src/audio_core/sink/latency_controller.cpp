@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "audio_core/sink/latency_controller.h"
+
+namespace AudioCore::Sink {
+
+void LatencyController::Update(u64 frames_requested, u64 frames_missing) {
+    window_requested += frames_requested;
+    window_missing += frames_missing;
+    if (window_requested < WindowFrames) {
+        return;
+    }
+
+    const u64 produced{produced_frames.exchange(0, std::memory_order_relaxed)};
+    const bool slow{produced * 100 < window_requested * SlowSpeedPercent};
+
+    const u32 extra{extra_buffers.load(std::memory_order_relaxed)};
+    if (window_missing == 0) {
+        if (++stable_windows >= StableWindows && extra > 0) {
+            extra_buffers.store(extra - 1, std::memory_order_relaxed);
+            stable_windows = 0;
+        }
+    } else {
+        if (!slow) {
+            extra_buffers.store(std::min(extra + 1, MaxExtraBuffers), std::memory_order_relaxed);
+        }
+        stable_windows = 0;
+    }
+
+    window_requested = 0;
+    window_missing = 0;
+}
+
+} // namespace AudioCore::Sink
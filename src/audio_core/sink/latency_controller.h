@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+
+#include "audio_core/common/common.h"
+#include "common/common_types.h"
+
+namespace AudioCore::Sink {
+
+/**
+ * Chooses how many buffers a stream queues ahead of the backend.
+ *
+ * The backend callback reports how many frames it asked for and how many it had to make up. An
+ * underrun while samples arrive at full speed means the queue is too short for the scheduling
+ * jitter of the host, so a buffer is added. When the emulated system produces samples slower than
+ * they are played, a longer queue would only delay the next underrun, so it's left alone. After a
+ * stretch without underruns the extra buffers are removed again, one at a time.
+ *
+ * Update is called by the backend callback, AddProducedFrames by the thread appending samples,
+ * and GetExtraBuffers by anyone.
+ */
+class LatencyController {
+public:
+    /// Frames between adjustments, half a second at the output rate
+    static constexpr u64 WindowFrames = TargetSampleRate / 2;
+    /// Most buffers queued on top of the ring size of the stream
+    static constexpr u32 MaxExtraBuffers = 8;
+    /// Windows in a row without an underrun before a buffer is removed
+    static constexpr u32 StableWindows = 10;
+    /// Production speed, in percent of the playback speed, below which the system is running slowly
+    static constexpr u64 SlowSpeedPercent = 95;
+
+    /**
+     * Record the frames appended to the stream.
+     *
+     * @param frames - Number of frames appended.
+     */
+    void AddProducedFrames(u64 frames) {
+        produced_frames.fetch_add(frames, std::memory_order_relaxed);
+    }
+
+    /**
+     * Record a backend callback, adjusting the latency at the end of each window.
+     *
+     * @param frames_requested - Number of frames the backend asked for.
+     * @param frames_missing   - Number of those frames which weren't queued in time.
+     */
+    void Update(u64 frames_requested, u64 frames_missing);
+
+    /**
+     * Get the number of buffers to queue on top of the ring size of the stream.
+     *
+     * @return The number of extra buffers.
+     */
+    u32 GetExtraBuffers() const {
+        return extra_buffers.load(std::memory_order_relaxed);
+    }
+
+private:
+    /// Frames appended since the last window ended
+    std::atomic<u64> produced_frames{};
+    /// Buffers queued on top of the ring size
+    std::atomic<u32> extra_buffers{};
+    /// Frames requested by the backend in this window
+    u64 window_requested{};
+    /// Frames the backend had to make up in this window
+    u64 window_missing{};
+    /// Windows in a row without an underrun
+    u32 stable_windows{};
+};
+
+} // namespace AudioCore::Sink
@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2018 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <memory>
@@ -18,6 +19,43 @@
 #include "core/core_timing.h"
 
 namespace AudioCore::Sink {
+namespace {
+
+/// Slowest the queued frames are played when the emulated system isn't keeping up
+constexpr size_t MaxStretch = 2;
+
+/**
+ * Resample interleaved frames to a different length with linear interpolation, keeping the first
+ * and last frames in place.
+ *
+ * @param input        - Frames to stretch.
+ * @param output       - Buffer receiving the stretched frames.
+ * @param num_channels - Number of channels in each frame.
+ */
+void StretchFrames(std::span<const s16> input, std::span<s16> output, size_t num_channels) {
+    const size_t in_frames{input.size() / num_channels};
+    const size_t out_frames{output.size() / num_channels};
+    if (in_frames == 0 || out_frames == 0) {
+        return;
+    }
+
+    // Position in the input as 48.16 fixed point
+    const u64 step{out_frames > 1 ? ((in_frames - 1) << 16) / (out_frames - 1) : 0};
+    for (size_t frame = 0; frame < out_frames; frame++) {
+        const u64 position{frame * step};
+        const size_t index{static_cast<size_t>(position >> 16)};
+        const size_t next{std::min(index + 1, in_frames - 1)};
+        const s64 fraction{static_cast<s64>(position & 0xFFFF)};
+        for (size_t channel = 0; channel < num_channels; channel++) {
+            const s64 a{input[index * num_channels + channel]};
+            const s64 b{input[next * num_channels + channel]};
+            output[frame * num_channels + channel] =
+                static_cast<s16>(a + (((b - a) * fraction) >> 16));
+        }
+    }
+}
+
+} // Anonymous namespace
 
 void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
     SCOPE_EXIT {
@@ -28,6 +66,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
     if (type == StreamType::In) {
         return;
     }
+    latency.AddProducedFrames(buffer.frames);
 
     constexpr s32 min{std::numeric_limits<s16>::min()};
     constexpr s32 max{std::numeric_limits<s16>::max()};
@@ -85,7 +124,8 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
         // We need moar samples! Not all games will provide 6 channel audio.
         // TODO: Implement some upmixing here. Currently just passthrough, with other
         // channels left as silence.
-        std::vector<s16> new_samples(samples.size() / system_channels * device_channels);
+        upmix_buffer.resize_destructive(samples.size() / system_channels * device_channels);
+        std::ranges::fill(upmix_buffer, s16{0});
 
         for (u32 read_index = 0, write_index = 0; read_index < samples.size();
              read_index += system_channels, write_index += device_channels) {
@@ -95,7 +135,7 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
                     volume),
                 min, max))};
 
-            new_samples[write_index + static_cast<u32>(Channels::FrontLeft)] = left_sample;
+            upmix_buffer[write_index + static_cast<u32>(Channels::FrontLeft)] = left_sample;
 
             const auto right_sample{static_cast<s16>(std::clamp(
                 static_cast<s32>(
@@ -103,10 +143,10 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
                     volume),
                 min, max))};
 
-            new_samples[write_index + static_cast<u32>(Channels::FrontRight)] = right_sample;
+            upmix_buffer[write_index + static_cast<u32>(Channels::FrontRight)] = right_sample;
         }
 
-        samples_buffer.Push(new_samples);
+        samples_buffer.Push(std::span<const s16>{upmix_buffer});
         return;
     }
 
@@ -120,11 +160,11 @@ void SinkStream::AppendBuffer(SinkBuffer& buffer, std::span<s16> samples) {
     samples_buffer.Push(samples);
 }
 
-std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
+void SinkStream::ReleaseBuffer(std::span<s16> samples) {
     constexpr s32 min = std::numeric_limits<s16>::min();
     constexpr s32 max = std::numeric_limits<s16>::max();
 
-    auto samples{samples_buffer.Pop(num_samples)};
+    const auto num_recorded{samples_buffer.Pop(samples.data(), samples.size())};
 
     // TODO: Up-mix to 6 channels if the game expects it.
     // For audio input this is unlikely to ever be the case though.
@@ -132,15 +172,12 @@ std::vector<s16> SinkStream::ReleaseBuffer(u64 num_samples) {
     // Incoming mic volume seems to always be very quiet, so multiply by an additional 8 here.
     // TODO: Play with this and find something that works better.
     auto volume{system_volume * device_volume * 8};
-    for (u32 i = 0; i < samples.size(); i++) {
+    for (u32 i = 0; i < num_recorded; i++) {
         samples[i] = static_cast<s16>(
             std::clamp(static_cast<s32>(static_cast<f32>(samples[i]) * volume), min, max));
     }
 
-    if (samples.size() < num_samples) {
-        samples.resize(num_samples, 0);
-    }
-    return samples;
+    std::fill(samples.begin() + num_recorded, samples.end(), s16{0});
 }
 
 void SinkStream::ClearQueue() {
@@ -204,8 +241,6 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
     const std::size_t num_channels = GetDeviceChannels();
     const std::size_t frame_size = num_channels;
     const std::size_t frame_size_bytes = frame_size * sizeof(s16);
-    size_t frames_written{0};
-    size_t actual_frames_written{0};
 
     // If we're paused or going to shut down, we don't want to consume buffers as coretiming is
     // paused and we'll desync, so just play silence.
@@ -219,12 +254,55 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
         }
 
         static constexpr std::array<s16, 6> silence{};
-        for (size_t i = frames_written; i < num_frames; i++) {
+        for (size_t i = 0; i < num_frames; i++) {
             std::memcpy(&output_buffer[i * frame_size], &silence[0], frame_size_bytes);
         }
         return;
     }
 
+    if (num_frames == 0) {
+        return;
+    }
+
+    size_t actual_frames_written{0};
+    const size_t queued_frames{samples_buffer.Size() / frame_size};
+    if (Settings::values.audio_time_stretch && queued_frames > 0 && queued_frames < num_frames) {
+        // The emulated system isn't keeping up. Rather than playing what's queued and holding the
+        // last frame, slow the queued frames down to cover more of the callback.
+        const size_t stretched_frames{std::min(num_frames, queued_frames * MaxStretch)};
+        actual_frames_written = PopFrames(stretch_buffer, queued_frames);
+        StretchFrames(std::span<const s16>{stretch_buffer}.first(queued_frames * frame_size),
+                      output_buffer.first(stretched_frames * frame_size), frame_size);
+        for (size_t i = stretched_frames; i < num_frames; i++) {
+            std::memcpy(&output_buffer[i * frame_size],
+                        &output_buffer[(stretched_frames - 1) * frame_size], frame_size_bytes);
+        }
+    } else {
+        actual_frames_written = PopFrames(output_buffer, num_frames);
+    }
+
+    std::memcpy(&last_frame[0], &output_buffer[(num_frames - 1) * frame_size], frame_size_bytes);
+
+    latency.Update(num_frames, num_frames - actual_frames_written);
+
+    // Only this callback writes the counts, readers retry if they see an update in progress
+    const auto sequence{sample_count_sequence.load(std::memory_order_relaxed)};
+    sample_count_sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    const auto max_played{max_played_sample_count.load(std::memory_order_relaxed)};
+    last_sample_count_update_time.store(system.CoreTiming().GetGlobalTimeNs().count(),
+                                        std::memory_order_relaxed);
+    min_played_sample_count.store(max_played, std::memory_order_relaxed);
+    max_played_sample_count.store(max_played + actual_frames_written, std::memory_order_relaxed);
+    sample_count_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+size_t SinkStream::PopFrames(std::span<s16> output_buffer, size_t num_frames) {
+    const std::size_t frame_size = GetDeviceChannels();
+    const std::size_t frame_size_bytes = frame_size * sizeof(s16);
+    size_t frames_written{0};
+    size_t actual_frames_written{0};
+
     while (frames_written < num_frames) {
         // If the playing buffer has been consumed or has no frames, we need a new one
         if (playing_buffer.consumed || playing_buffer.frames == 0) {
@@ -263,36 +341,43 @@ void SinkStream::ProcessAudioOutAndRender(std::span<s16> output_buffer, std::siz
             playing_buffer.consumed = true;
         }
     }
-
-    std::memcpy(&last_frame[0], &output_buffer[(frames_written - 1) * frame_size],
-                frame_size_bytes);
-
-    {
-        std::scoped_lock lk{sample_count_lock};
-        last_sample_count_update_time = system.CoreTiming().GetGlobalTimeNs();
-        min_played_sample_count = max_played_sample_count;
-        max_played_sample_count += actual_frames_written;
-    }
+    return actual_frames_written;
 }
 
 u64 SinkStream::GetExpectedPlayedSampleCount() {
-    std::scoped_lock lk{sample_count_lock};
+    u64 min_played;
+    u64 max_played;
+    std::chrono::nanoseconds update_time;
+    for (;;) {
+        const auto sequence{sample_count_sequence.load(std::memory_order_acquire)};
+        min_played = min_played_sample_count.load(std::memory_order_relaxed);
+        max_played = max_played_sample_count.load(std::memory_order_relaxed);
+        update_time =
+            std::chrono::nanoseconds{last_sample_count_update_time.load(std::memory_order_relaxed)};
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if ((sequence & 1) == 0 &&
+            sequence == sample_count_sequence.load(std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
     auto cur_time{system.CoreTiming().GetGlobalTimeNs()};
-    auto time_delta{cur_time - last_sample_count_update_time};
-    auto exp_played_sample_count{min_played_sample_count +
+    auto time_delta{cur_time - update_time};
+    auto exp_played_sample_count{min_played +
                                  (TargetSampleRate * time_delta) / std::chrono::seconds{1}};
 
     // Add 15ms of latency in sample reporting to allow for some leeway in scheduler timings
-    return std::min<u64>(exp_played_sample_count, max_played_sample_count) + TargetSampleCount * 3;
+    return std::min<u64>(exp_played_sample_count, max_played) + TargetSampleCount * 3;
 }
 
 void SinkStream::WaitFreeSpace(std::stop_token stop_token) {
     std::unique_lock lk{release_mutex};
+    const auto target_queue_size{GetTargetQueueSize()};
     release_cv.wait_for(lk, std::chrono::milliseconds(5),
-                        [this]() { return paused || queued_buffers < max_queue_size; });
-    if (queued_buffers > max_queue_size + 3) {
+                        [&]() { return paused || queued_buffers < target_queue_size; });
+    if (queued_buffers > target_queue_size + 3) {
         Common::CondvarWait(release_cv, lk, stop_token,
-                            [this] { return paused || queued_buffers < max_queue_size; });
+                            [&] { return paused || queued_buffers < target_queue_size; });
     }
 }
 
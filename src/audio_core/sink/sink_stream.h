@@ -12,10 +12,12 @@
 #include <vector>
 
 #include "audio_core/common/common.h"
+#include "audio_core/sink/latency_controller.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 #include "common/reader_writer_queue.h"
 #include "common/ring_buffer.h"
+#include "common/scratch_buffer.h"
 #include "common/thread.h"
 
 namespace Core {
@@ -52,6 +54,9 @@ struct SinkBuffer {
  *
  * If the buffers appear to be stuck, you can stop and re-open an IAudioIn/IAudioOut service (this
  * is what games do), or call ClearQueue to flush all of the buffers without a full restart.
+ *
+ * The backend callback doesn't allocate or take locks shared with the emulated system, apart
+ * from briefly to wake a thread waiting for free space.
  */
 class SinkStream {
 public:
@@ -175,10 +180,10 @@ public:
     /**
      * Release a buffer. Audio In only, will fill a buffer with recorded samples.
      *
-     * @param num_samples - Maximum number of samples to receive.
-     * @return Vector of recorded samples. May have fewer than num_samples.
+     * @param samples - Buffer to receive the recorded samples, padded with silence if fewer were
+     *                  recorded.
      */
-    virtual std::vector<s16> ReleaseBuffer(u64 num_samples);
+    virtual void ReleaseBuffer(std::span<s16> samples);
 
     /**
      * Empty out the buffer queue.
@@ -213,6 +218,16 @@ public:
      */
     void WaitFreeSpace(std::stop_token stop_token);
 
+    /**
+     * Get the number of buffers queued before waiting for free space, the ring size plus the
+     * buffers added to ride out underruns.
+     *
+     * @return The target number of queued buffers.
+     */
+    u32 GetTargetQueueSize() const {
+        return max_queue_size + latency.GetExtraBuffers();
+    }
+
 protected:
     /**
      * Unblocks the ADSP if the stream is paused.
@@ -234,8 +249,19 @@ protected:
     std::string name{};
 
 private:
+    /**
+     * Move frames from the queued buffers to the output, holding the last frame on underrun.
+     *
+     * @param output_buffer - Output buffer to be filled with samples.
+     * @param num_frames    - Number of frames to be filled.
+     * @return The number of frames taken from the queued buffers.
+     */
+    size_t PopFrames(std::span<s16> output_buffer, size_t num_frames);
+
+    static constexpr size_t SamplesBufferSize = 0x10000;
+
     /// Ring buffer of the samples waiting to be played or consumed
-    Common::RingBuffer<s16, 0x10000> samples_buffer;
+    Common::RingBuffer<s16, SamplesBufferSize> samples_buffer;
     /// Audio buffers queued and waiting to play
     Common::ReaderWriterQueue<SinkBuffer> queue;
     /// The currently-playing audio buffer
@@ -246,14 +272,20 @@ private:
     std::atomic<u32> queued_buffers{};
     /// The ring size for audio out buffers (usually 4, rarely 2 or 8)
     u32 max_queue_size{};
-    /// Locks access to sample count tracking info
-    std::mutex sample_count_lock;
+    /// Odd while the callback updates the sample count tracking info below
+    std::atomic<u64> sample_count_sequence{};
     /// Minimum number of total samples that have been played since the last callback
-    u64 min_played_sample_count{};
+    std::atomic<u64> min_played_sample_count{};
     /// Maximum number of total samples that can be played since the last callback
-    u64 max_played_sample_count{};
-    /// The time the two above tracking variables were last written to
-    std::chrono::nanoseconds last_sample_count_update_time{};
+    std::atomic<u64> max_played_sample_count{};
+    /// The time the two above tracking variables were last written to, in nanoseconds
+    std::atomic<s64> last_sample_count_update_time{};
+    /// Picks the number of buffers queued ahead of the callback
+    LatencyController latency;
+    /// Queued samples, slowed down to cover a callback when running below full speed
+    Common::ScratchBuffer<s16> stretch_buffer{SamplesBufferSize};
+    /// Upmixed samples of the appended buffer
+    Common::ScratchBuffer<s16> upmix_buffer;
     /// Set by the audio render/in/out system which uses this stream
     f32 system_volume{1.0f};
     /// Set via IAudioDevice service calls
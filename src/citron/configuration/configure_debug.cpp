@@ -43,6 +43,8 @@ void ConfigureDebug::SetConfiguration() {
         QString::fromStdString(Settings::values.program_args.GetValue()));
     ui->fs_access_log->setEnabled(runtime_lock);
     ui->fs_access_log->setChecked(Settings::values.enable_fs_access_log.GetValue());
+    ui->enable_guest_profiler->setEnabled(runtime_lock);
+    ui->enable_guest_profiler->setChecked(Settings::values.enable_guest_profiler.GetValue());
     ui->reporting_services->setChecked(Settings::values.reporting_services.GetValue());
     ui->dump_audio_commands->setChecked(Settings::values.dump_audio_commands.GetValue());
     ui->quest_flag->setChecked(Settings::values.quest_flag.GetValue());
@@ -90,6 +92,7 @@ void ConfigureDebug::ApplyConfiguration() {
     Settings::values.log_filter = ui->log_filter_edit->text().toStdString();
     Settings::values.program_args = ui->homebrew_args_edit->text().toStdString();
     Settings::values.enable_fs_access_log = ui->fs_access_log->isChecked();
+    Settings::values.enable_guest_profiler = ui->enable_guest_profiler->isChecked();
     Settings::values.reporting_services = ui->reporting_services->isChecked();
     Settings::values.dump_audio_commands = ui->dump_audio_commands->isChecked();
     Settings::values.quest_flag = ui->quest_flag->isChecked();
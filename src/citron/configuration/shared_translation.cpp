@@ -48,6 +48,12 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     INSERT(Settings, audio_output_device_id, tr("Output Device:"), QStringLiteral());
     INSERT(Settings, audio_input_device_id, tr("Input Device:"), QStringLiteral());
     INSERT(Settings, audio_muted, tr("Mute audio"), QStringLiteral());
+    INSERT(Settings, audio_time_stretch, tr("Stretch audio when running slowly"),
+           tr("Slows down the queued audio when emulation runs below full speed, instead of "
+              "repeating the last sample.\nAvoids crackling at the cost of lowering the pitch."));
+    INSERT(Settings, audio_parallel_voices, tr("Process voices in parallel"),
+           tr("Renders the voices of each audio frame on several threads.\nCan reduce audio "
+              "stutter in games that play many sounds at once, at the cost of more CPU threads."));
     INSERT(Settings, volume, tr("Volume:"), QStringLiteral());
     INSERT(Settings, dump_audio_commands, QStringLiteral(), QStringLiteral());
     INSERT(UISettings, mute_when_in_background, tr("Mute audio when in background"),
@@ -71,6 +77,11 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
               "faster or not.\n200% for a 30 FPS game is 60 FPS, and for a "
               "60 FPS game it will be 120 FPS.\nDisabling it means unlocking the framerate to the "
               "maximum your PC can reach."));
+    INSERT(Settings, use_huge_pages, tr("Use huge pages for emulated memory"),
+           tr("Backs the emulated RAM with 2 MiB pages where the host allows it, reducing TLB "
+              "misses on guest memory accesses.\nRequires transparent huge pages for shared "
+              "memory to be enabled on Linux, and has no effect on other platforms.\nTakes "
+              "effect when the emulation is started."));
 
     // Cpu
     INSERT(Settings, cpu_accuracy, tr("Accuracy:"),
@@ -203,6 +214,15 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
     INSERT(Settings, use_fast_gpu_time, tr("Use Fast GPU Time (Hack)"),
            tr("Enables Fast GPU Time. This option will force most games to run at their highest "
               "native resolution."));
+    INSERT(Settings, use_parallel_command_recording,
+           tr("Record render passes in parallel (Vulkan only)"),
+           tr("Records draws of independent render pass segments on several threads into "
+              "secondary command buffers.\nMay improve performance in draw-heavy scenes. This "
+              "feature is experimental."));
+    INSERT(Settings, use_accurate_query_resolution, tr("Accurate query resolution"),
+           tr("Waits for the GPU whenever a game reads back an occlusion or counter query.\nWhen "
+              "disabled, query results are resolved once per frame and reads are answered with the "
+              "last resolved value, which avoids stalls but can lag one frame behind."));
     INSERT(Settings, use_vulkan_driver_pipeline_cache, tr("Use Vulkan pipeline cache"),
            tr("Enables GPU vendor-specific pipeline cache.\nThis option can improve shader loading "
               "time significantly in cases where the Vulkan driver does not store pipeline cache "
@@ -279,6 +299,11 @@ std::unique_ptr<TranslationMap> InitializeTranslations(QWidget* parent) {
 
     // Linux
     INSERT(Settings, enable_gamemode, tr("Enable Gamemode"), QStringLiteral());
+    INSERT(Settings, pin_host_threads, tr("Pin emulation threads to CPU cores"),
+           tr("Places the emulated CPU cores on distinct physical performance cores, keeps the "
+              "GPU threads on cores sharing a cache and moves background work to the remaining "
+              "cores.\nThe placement is printed in the log. Takes effect when the emulation is "
+              "started."));
 
     // Ui Debugging
 
@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <QCheckBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTimer>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "citron/debugger/call_statistics.h"
+#include "core/core.h"
+#include "core/hle/kernel/call_statistics.h"
+#include "core/hle/kernel/kernel.h"
+
+namespace {
+
+enum Column {
+    Name,
+    Calls,
+    TotalMs,
+    MeanUs,
+    P50Us,
+    P99Us,
+    MaxUs,
+    NumColumns,
+};
+
+void FillItem(QTreeWidgetItem* item, const QString& name,
+              const Kernel::CallStatistics::Histogram& latency) {
+    const auto us = [](u64 ns) { return static_cast<double>(ns) / 1000.0; };
+    const double mean_us = us(latency.total_ns) / static_cast<double>(latency.count);
+    item->setText(Name, name);
+    item->setData(Calls, Qt::DisplayRole, static_cast<qulonglong>(latency.count));
+    item->setData(TotalMs, Qt::DisplayRole, static_cast<double>(latency.total_ns) / 1'000'000.0);
+    item->setData(MeanUs, Qt::DisplayRole, mean_us);
+    item->setData(P50Us, Qt::DisplayRole, us(latency.Percentile(0.5)));
+    item->setData(P99Us, Qt::DisplayRole, us(latency.Percentile(0.99)));
+    item->setData(MaxUs, Qt::DisplayRole, us(latency.max_ns));
+}
+
+} // Anonymous namespace
+
+CallStatisticsWidget::CallStatisticsWidget(Core::System& system_, QWidget* parent)
+    : QDockWidget(tr("&Call Statistics"), parent), system{system_} {
+    setObjectName(QStringLiteral("CallStatisticsWidget"));
+
+    auto& call_statistics = system.Kernel().GetCallStatistics();
+    record_checkbox = new QCheckBox(tr("Record"));
+    record_checkbox->setChecked(call_statistics.IsEnabled());
+    connect(record_checkbox, &QCheckBox::toggled, this,
+            [&call_statistics](bool checked) { call_statistics.SetEnabled(checked); });
+
+    auto* reset_button = new QPushButton(tr("Reset"));
+    connect(reset_button, &QPushButton::clicked, this, &CallStatisticsWidget::Reset);
+    auto* export_button = new QPushButton(tr("Export JSON..."));
+    connect(export_button, &QPushButton::clicked, this, &CallStatisticsWidget::ExportJson);
+
+    auto* buttons = new QHBoxLayout;
+    buttons->addWidget(record_checkbox);
+    buttons->addStretch();
+    buttons->addWidget(reset_button);
+    buttons->addWidget(export_button);
+
+    tree = new QTreeWidget;
+    tree->setColumnCount(NumColumns);
+    tree->setHeaderLabels({tr("Name"), tr("Calls"), tr("Total (ms)"), tr("Mean (us)"),
+                           tr("p50 (us)"), tr("p99 (us)"), tr("Max (us)")});
+    tree->header()->setSectionResizeMode(Name, QHeaderView::Stretch);
+    tree->setSortingEnabled(true);
+    tree->sortByColumn(TotalMs, Qt::DescendingOrder);
+    svc_root = new QTreeWidgetItem(tree, {tr("Supervisor calls")});
+    ipc_root = new QTreeWidgetItem(tree, {tr("IPC commands")});
+    svc_root->setExpanded(true);
+    ipc_root->setExpanded(true);
+
+    auto* layout = new QVBoxLayout;
+    layout->addLayout(buttons);
+    layout->addWidget(tree);
+    auto* contents = new QWidget;
+    contents->setLayout(layout);
+    setWidget(contents);
+
+    // Only refresh while the dock is shown
+    refresh_timer = new QTimer(this);
+    connect(refresh_timer, &QTimer::timeout, this, &CallStatisticsWidget::Refresh);
+    connect(toggleViewAction(), &QAction::toggled, this, [this](bool visible) {
+        if (visible) {
+            Refresh();
+            refresh_timer->start(1000);
+        } else {
+            refresh_timer->stop();
+        }
+    });
+}
+
+CallStatisticsWidget::~CallStatisticsWidget() = default;
+
+void CallStatisticsWidget::Refresh() {
+    const auto snapshot = system.Kernel().GetCallStatistics().Collect();
+
+    tree->setSortingEnabled(false);
+    qDeleteAll(svc_root->takeChildren());
+    qDeleteAll(ipc_root->takeChildren());
+    for (const auto& svc : snapshot.svcs) {
+        const QString name =
+            QStringLiteral("0x%1 %2").arg(svc.id, 2, 16, QLatin1Char('0')).arg(
+                QString::fromUtf8(svc.name));
+        FillItem(new QTreeWidgetItem(svc_root), name, svc.latency);
+    }
+    for (const auto& command : snapshot.commands) {
+        const QString name = QStringLiteral("%1 #%2 %3")
+                                 .arg(QString::fromStdString(command.service))
+                                 .arg(command.command)
+                                 .arg(QString::fromStdString(command.function));
+        FillItem(new QTreeWidgetItem(ipc_root), name, command.latency);
+    }
+    tree->setSortingEnabled(true);
+}
+
+void CallStatisticsWidget::Reset() {
+    system.Kernel().GetCallStatistics().Reset();
+    Refresh();
+}
+
+void CallStatisticsWidget::ExportJson() {
+    const QString path = QFileDialog::getSaveFileName(this, tr("Export Call Statistics"), {},
+                                                      tr("JSON Files (*.json)"));
+    if (path.isEmpty()) {
+        return;
+    }
+    const auto snapshot = system.Kernel().GetCallStatistics().Collect();
+    const std::string json = Kernel::CallStatistics::ToJson(snapshot);
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+        file.write(json.data(), static_cast<qint64>(json.size())) !=
+            static_cast<qint64>(json.size())) {
+        QMessageBox::warning(this, tr("Export Call Statistics"),
+                             tr("Could not write %1").arg(path));
+    }
+}
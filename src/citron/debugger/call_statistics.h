@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <QDockWidget>
+
+class QCheckBox;
+class QTimer;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+namespace Core {
+class System;
+}
+
+/// Shows how often the guest makes each supervisor call and IPC command, and how long they take.
+class CallStatisticsWidget : public QDockWidget {
+    Q_OBJECT
+
+public:
+    explicit CallStatisticsWidget(Core::System& system_, QWidget* parent = nullptr);
+    ~CallStatisticsWidget() override;
+
+private:
+    void Refresh();
+    void Reset();
+    void ExportJson();
+
+    QCheckBox* record_checkbox;
+    QTreeWidget* tree;
+    QTreeWidgetItem* svc_root;
+    QTreeWidgetItem* ipc_root;
+    QTimer* refresh_timer;
+
+    Core::System& system;
+};
@@ -147,6 +147,7 @@ static FileSys::VirtualFile VfsDirectoryCreateFileWrapper(const FileSys::Virtual
 #include "citron/configuration/configure_dialog.h"
 #include "citron/configuration/configure_input_per_game.h"
 #include "citron/configuration/qt_config.h"
+#include "citron/debugger/call_statistics.h"
 #include "citron/debugger/console.h"
 #include "citron/debugger/controller.h"
 #include "citron/debugger/profiler.h"
@@ -1272,6 +1273,11 @@ void GMainWindow::InitializeDebugWidgets() {
     waitTreeWidget->hide();
     debug_menu->addAction(waitTreeWidget->toggleViewAction());
 
+    callStatisticsWidget = new CallStatisticsWidget(*system, this);
+    addDockWidget(Qt::LeftDockWidgetArea, callStatisticsWidget);
+    callStatisticsWidget->hide();
+    debug_menu->addAction(callStatisticsWidget->toggleViewAction());
+
     controller_dialog = new ControllerDialog(system->HIDCore(), input_subsystem, this);
     controller_dialog->hide();
     debug_menu->addAction(controller_dialog->toggleViewAction());
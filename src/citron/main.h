@@ -46,6 +46,7 @@ class QProgressDialog;
 class QSlider;
 class QHBoxLayout;
 class WaitTreeWidget;
+class CallStatisticsWidget;
 enum class GameListOpenTarget;
 enum class GameListRemoveTarget;
 enum class GameListShortcutTarget;
@@ -534,6 +535,7 @@ private:
     ProfilerWidget* profilerWidget;
     MicroProfileDialog* microProfileDialog;
     WaitTreeWidget* waitTreeWidget;
+    CallStatisticsWidget* callStatisticsWidget;
     ControllerDialog* controller_dialog;
 
     QAction* actions_recent_files[max_recent_files_item];
@@ -0,0 +1,142 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// Replays an audio renderer command list captured with "Dump Audio Commands" enabled, and reports
+// the host time taken by each command type against the renderer's estimate.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/command_list_capture.h"
+#include "audio_core/renderer/command/icommand.h"
+#include "audio_core/sink/null_sink.h"
+#include "common/logging/backend.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/memory.h"
+
+namespace {
+
+using AudioCore::ADSP::AudioRenderer::CommandListProcessor;
+using AudioCore::Renderer::CommandIdCount;
+using AudioCore::Renderer::CommandListCapture;
+
+constexpr u32 DefaultIterations = 2000;
+
+struct CommandTiming {
+    std::string name;
+    u32 count{};
+    u64 estimate{};
+    u64 host_ns{};
+};
+
+void PrintUsage(const char* argv0) {
+    std::fprintf(stderr, "Usage: %s <capture> [iterations]\n", argv0);
+}
+
+} // Anonymous namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const u32 iterations{argc == 3 ? static_cast<u32>(std::strtoul(argv[2], nullptr, 10))
+                                   : DefaultIterations};
+    if (iterations == 0) {
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    Common::Log::Initialize();
+    Common::Log::SetColorConsoleBackendEnabled(true);
+    Common::Log::Start();
+
+    auto capture{CommandListCapture::Read(argv[1])};
+    if (!capture || !capture->PrepareReplay()) {
+        std::fprintf(stderr, "Failed to load the capture %s\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    Core::System system;
+    system.CoreTiming().SetMulticore(true);
+    Core::Memory::Memory memory{system};
+    memory.SetCurrentPageTable(capture->GetGuestPageTable());
+    AudioCore::Sink::NullSink sink{""};
+    auto* stream{sink.AcquireSinkStream(system, 2, "citron-audio-replay",
+                                        AudioCore::Sink::StreamType::Render)};
+
+    CommandListProcessor processor{};
+    std::array<u64, CommandIdCount> host_times{};
+    processor.command_host_times = &host_times;
+    processor.Initialize(system, &memory, capture->GetCommandList(),
+                         capture->GetCommandListSize(), stream);
+
+    // Commands are named by the first word of their dump
+    std::array<CommandTiming, CommandIdCount> timings{};
+    for (auto* command : capture->GetCommands()) {
+        if (!command->enabled) {
+            continue;
+        }
+        auto& timing{timings[static_cast<size_t>(command->type)]};
+        if (timing.name.empty()) {
+            std::string dump;
+            command->Dump(processor, dump);
+            timing.name = dump.substr(0, dump.find_first_of(" \n"));
+        }
+        timing.count++;
+        timing.estimate += command->estimated_process_time;
+    }
+
+    // The first run sets up the effects, it isn't measured
+    processor.Process(0);
+    capture->ResetVoices();
+    capture->MarkEffectsInitialized();
+    host_times.fill(0);
+
+    const auto begin{std::chrono::steady_clock::now()};
+    for (u32 iteration = 0; iteration < iterations; iteration++) {
+        capture->ResetVoices();
+        processor.Initialize(system, &memory, capture->GetCommandList(),
+                             capture->GetCommandListSize(), stream);
+        processor.Process(0);
+    }
+    const auto end{std::chrono::steady_clock::now()};
+
+    std::vector<CommandTiming> sorted;
+    u64 total_estimate{};
+    for (size_t type = 0; type < CommandIdCount; type++) {
+        if (timings[type].count > 0) {
+            timings[type].host_ns = host_times[type];
+            total_estimate += timings[type].estimate;
+            sorted.push_back(timings[type]);
+        }
+    }
+    std::ranges::sort(sorted, [](const auto& a, const auto& b) { return a.host_ns > b.host_ns; });
+
+    std::printf("%-28s %6s %14s %14s %12s\n", "Command", "Count", "Host ns/cmd", "Estimate/cmd",
+                "ns/estimate");
+    for (const auto& timing : sorted) {
+        const f64 host_ns{static_cast<f64>(timing.host_ns) / iterations / timing.count};
+        const f64 estimate{static_cast<f64>(timing.estimate) / timing.count};
+        std::printf("%-28s %6u %14.1f %14.1f %12.3f\n", timing.name.c_str(), timing.count,
+                    host_ns, estimate, estimate > 0 ? host_ns / estimate : 0.0);
+    }
+
+    const auto& parameters{capture->GetParameters()};
+    const f64 list_us{std::chrono::duration<f64, std::micro>(end - begin).count() / iterations};
+    std::printf("Command list: %zu commands, %u skipped, %.1f us on the host per %u samples at "
+                "%u Hz, estimate %llu\n",
+                capture->GetCommands().size(), capture->GetDisabledCommandCount(), list_us,
+                parameters.sample_count, parameters.sample_rate,
+                static_cast<unsigned long long>(total_estimate));
+
+    Common::Log::Stop();
+    return EXIT_SUCCESS;
+}
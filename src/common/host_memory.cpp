@@ -15,6 +15,11 @@
 #ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #endif
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
 #include <boost/icl/interval_set.hpp>
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -107,9 +112,13 @@ static void GetFuncAddress(Common::DynamicLibrary& dll, const char* name, T& pfn
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t backing_size_, size_t virtual_size_)
+    explicit Impl(size_t backing_size_, size_t virtual_size_, bool use_huge_pages)
         : backing_size{backing_size_}, virtual_size{virtual_size_}, process{GetCurrentProcess()},
           kernelbase_dll("Kernelbase") {
+        if (use_huge_pages) {
+            // Large pages of file mappings need the lock memory privilege, don't ask for it
+            LOG_WARNING(HW_Memory, "Huge pages are not supported on this platform");
+        }
         if (!kernelbase_dll.IsOpen()) {
             LOG_CRITICAL(HW_Memory, "Failed to load Kernelbase.dll");
             throw std::bad_alloc{};
@@ -226,6 +235,10 @@ public:
         return direct_mapping_enabled;
     }
 
+    HugePageStats GetHugePageStats() const {
+        return {};
+    }
+
     const size_t backing_size; ///< Size of the backing memory in bytes
     const size_t virtual_size; ///< Size of the virtual address placeholder in bytes
 
@@ -394,6 +407,52 @@ private:
 
 #elif defined(__linux__) || defined(__FreeBSD__) // ^^^ Windows ^^^ vvv Linux vvv
 
+#ifdef __linux__
+
+/// Warns when the kernel won't give transparent huge pages to shared memory.
+static void CheckShmemHugePages() {
+    std::ifstream file{"/sys/kernel/mm/transparent_hugepage/shmem_enabled"};
+    std::string modes;
+    if (!std::getline(file, modes)) {
+        LOG_WARNING(HW_Memory, "Transparent huge pages are not available");
+        return;
+    }
+    // The active mode is the one between brackets
+    if (modes.find("[never]") != std::string::npos || modes.find("[deny]") != std::string::npos) {
+        LOG_WARNING(HW_Memory,
+                    "Transparent huge pages are disabled for shared memory ({}), emulated memory "
+                    "will use 4 KiB pages",
+                    modes);
+        return;
+    }
+    LOG_INFO(HW_Memory, "Backing emulated memory with transparent huge pages ({})", modes);
+}
+
+/// Counts the huge pages mapping the given range, as reported by the kernel.
+static size_t CountHugePages(const u8* base, size_t size) {
+    std::ifstream smaps{"/proc/self/smaps"};
+    const uintptr_t range_begin = reinterpret_cast<uintptr_t>(base);
+    const uintptr_t range_end = range_begin + size;
+    static constexpr std::string_view PmdMappedField = "ShmemPmdMapped:";
+    bool in_range = false;
+    size_t huge_kib = 0;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        uintptr_t vma_begin{};
+        uintptr_t vma_end{};
+        if (std::sscanf(line.c_str(), "%" SCNxPTR "-%" SCNxPTR, &vma_begin, &vma_end) == 2) {
+            in_range = vma_begin >= range_begin && vma_end <= range_end;
+            continue;
+        }
+        if (in_range && line.starts_with(PmdMappedField)) {
+            huge_kib += std::strtoull(line.c_str() + PmdMappedField.size(), nullptr, 10);
+        }
+    }
+    return huge_kib * 1024 / HugePageSize;
+}
+
+#endif
+
 #ifdef ARCHITECTURE_arm64
 
 static void* ChooseVirtualBase(size_t virtual_size) {
@@ -455,7 +514,7 @@ static void* ChooseVirtualBase(size_t virtual_size) {
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t backing_size_, size_t virtual_size_)
+    explicit Impl(size_t backing_size_, size_t virtual_size_, bool use_huge_pages_)
         : backing_size{backing_size_}, virtual_size{virtual_size_} {
         bool good = false;
         SCOPE_EXIT {
@@ -497,6 +556,21 @@ public:
             throw std::bad_alloc{};
         }
 
+        if (use_huge_pages_) {
+#if defined(__linux__)
+            // Huge pages of shared memory are allocated when a page of a mapping asking for them
+            // is touched. Explicit hugetlb pages can't be used, they can't be mapped in 4 KiB
+            // pieces as the guest does.
+            CheckShmemHugePages();
+            use_huge_pages = madvise(backing_base, backing_size, MADV_HUGEPAGE) == 0;
+            if (!use_huge_pages) {
+                LOG_WARNING(HW_Memory, "madvise(MADV_HUGEPAGE) failed: {}", strerror(errno));
+            }
+#else
+            LOG_WARNING(HW_Memory, "Huge pages are not supported on this platform");
+#endif
+        }
+
         // Virtual memory initialization
         virtual_base = virtual_map_base = static_cast<u8*>(ChooseVirtualBase(virtual_size));
         if (virtual_base == MAP_FAILED) {
@@ -548,6 +622,14 @@ public:
 
         void* ret = mmap(virtual_base + virtual_offset, length, flags, MAP_SHARED | MAP_FIXED, fd,
                          host_offset);
+#if defined(__linux__)
+        if (use_huge_pages && ret != MAP_FAILED) {
+            // The mapping replaced the placeholder, ask again for huge pages. They are used for
+            // the 2 MiB blocks with the same alignment in the arena and the backing memory, the
+            // rest of the mapping is split in 4 KiB pages.
+            madvise(ret, length, MADV_HUGEPAGE);
+        }
+#endif
         if (ret == MAP_FAILED) {
             LOG_ERROR(HW_Memory, "mmap failed: {}", strerror(errno));
             // Try to restore the placeholder
@@ -637,6 +719,18 @@ public:
         return virtual_base == nullptr;
     }
 
+    HugePageStats GetHugePageStats() const {
+#if defined(__linux__)
+        if (use_huge_pages) {
+            return {
+                .backing_pages = CountHugePages(backing_base, backing_size),
+                .fastmem_pages = CountHugePages(virtual_map_base, virtual_size),
+            };
+        }
+#endif
+        return {};
+    }
+
     const size_t backing_size; ///< Size of the backing memory in bytes
     const size_t virtual_size; ///< Size of the virtual address placeholder in bytes
 
@@ -685,6 +779,7 @@ private:
     }
 
     int fd{-1}; // memfd file descriptor, -1 is the error value of memfd_create
+    bool use_huge_pages{false};
     FreeRegionManager free_manager{};
 };
 
@@ -692,7 +787,7 @@ private:
 
 class HostMemory::Impl {
 public:
-    explicit Impl(size_t /*backing_size */, size_t /* virtual_size */) {
+    explicit Impl(size_t /*backing_size */, size_t /* virtual_size */, bool /* use_huge_pages */) {
         // This is just a place holder.
         // Please implement fastmem in a proper way on your platform.
         throw std::bad_alloc{};
@@ -718,20 +813,25 @@ public:
         return false;
     }
 
+    HugePageStats GetHugePageStats() const {
+        return {};
+    }
+
     u8* backing_base{nullptr};
     u8* virtual_base{nullptr};
 };
 
 #endif // ^^^ Generic ^^^
 
-HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
-    : backing_size(backing_size_), virtual_size(virtual_size_) {
+HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_, bool use_huge_pages_)
+    : backing_size(backing_size_), virtual_size(virtual_size_), use_huge_pages(use_huge_pages_) {
     try {
         // Try to allocate a fastmem arena.
         // The implementation will fail with std::bad_alloc on errors.
         impl =
             std::make_unique<HostMemory::Impl>(AlignUp(backing_size, PageAlignment),
-                                               AlignUp(virtual_size, PageAlignment) + HugePageSize);
+                                               AlignUp(virtual_size, PageAlignment) + HugePageSize,
+                                               use_huge_pages);
         backing_base = impl->backing_base;
         virtual_base = impl->virtual_base;
 
@@ -753,7 +853,13 @@ HostMemory::HostMemory(size_t backing_size_, size_t virtual_size_)
     }
 }
 
-HostMemory::~HostMemory() = default;
+HostMemory::~HostMemory() {
+    if (impl && use_huge_pages) {
+        const HugePageStats stats = impl->GetHugePageStats();
+        LOG_INFO(HW_Memory, "Huge pages obtained: {} for backing memory, {} for fastmem",
+                 stats.backing_pages, stats.fastmem_pages);
+    }
+}
 
 HostMemory::HostMemory(HostMemory&&) noexcept = default;
 
@@ -826,6 +932,13 @@ void HostMemory::Protect(size_t virtual_offset, size_t length, MemoryPermission
     impl->Protect(virtual_offset + virtual_base_offset, length, read, write, execute);
 }
 
+HugePageStats HostMemory::GetHugePageStats() const {
+    if (!impl) {
+        return {};
+    }
+    return impl->GetHugePageStats();
+}
+
 void HostMemory::ClearBackingRegion(size_t physical_offset, size_t length, u32 fill_value) {
     if (!impl || fill_value != 0 || !impl->ClearBackingRegion(physical_offset, length)) {
         std::memset(backing_base + physical_offset, fill_value, length);
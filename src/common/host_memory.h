@@ -19,13 +19,20 @@ enum class MemoryPermission : u32 {
 };
 DECLARE_ENUM_FLAG_OPERATORS(MemoryPermission)
 
+struct HugePageStats {
+    /// Number of 2 MiB pages mapping the backing memory view.
+    size_t backing_pages;
+    /// Number of 2 MiB pages mapping the fastmem arena.
+    size_t fastmem_pages;
+};
+
 /**
  * A low level linear memory buffer, which supports multiple mappings
  * Its purpose is to rebuild a given sparse memory layout, including mirrors.
  */
 class HostMemory {
 public:
-    explicit HostMemory(size_t backing_size_, size_t virtual_size_);
+    explicit HostMemory(size_t backing_size_, size_t virtual_size_, bool use_huge_pages_ = false);
     ~HostMemory();
 
     /**
@@ -77,9 +84,13 @@ public:
         return address >= virtual_base && address < virtual_base + virtual_size;
     }
 
+    /// Returns how many huge pages currently back the memory, when huge pages were requested.
+    [[nodiscard]] HugePageStats GetHugePageStats() const;
+
 private:
     size_t backing_size{};
     size_t virtual_size{};
+    bool use_huge_pages{};
 
     // Low level handler for the platform dependent memory routines
     class Impl;
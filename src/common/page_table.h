@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 
 #include "common/common_types.h"
@@ -118,6 +119,43 @@ struct PageTable {
         return current_address_space_width_in_bits;
     }
 
+    /**
+     * Walks the pages of a block of memory inside the address space. Runs of Memory pages backed
+     * by consecutive host memory store the same pointer, and are handed to on_memory at once with
+     * their host pointer. Every other page is handed to on_page with its type.
+     *
+     * @param addr      Virtual address of the block.
+     * @param size      Size of the block in bytes.
+     * @param on_memory Called with the virtual address, size and host pointer of a run.
+     * @param on_page   Called with the type, virtual address and size of any other page.
+     */
+    template <typename OnMemory, typename OnPage>
+    void WalkBlock(u64 addr, std::size_t size, OnMemory&& on_memory, OnPage&& on_page) const {
+        std::size_t page_index = addr / page_size;
+        std::size_t page_offset = addr % page_size;
+        while (size > 0) {
+            std::size_t amount = std::min(page_size - page_offset, size);
+            const u64 vaddr = page_index * page_size + page_offset;
+            const auto [pointer, type] = pointers[page_index].PointerType();
+            if (type != PageType::Memory) {
+                on_page(type, vaddr, amount);
+            } else {
+                while (amount < size) {
+                    const auto [next_pointer, next_type] = pointers[page_index + 1].PointerType();
+                    if (next_type != PageType::Memory || next_pointer != pointer) {
+                        break;
+                    }
+                    ++page_index;
+                    amount += std::min(page_size, size - amount);
+                }
+                on_memory(vaddr, amount, reinterpret_cast<u8*>(pointer + vaddr));
+            }
+            ++page_index;
+            page_offset = 0;
+            size -= amount;
+        }
+    }
+
     bool GetPhysicalAddress(Common::PhysicalAddress* out_phys_addr,
                             Common::ProcessAddress virt_addr) const {
         if (virt_addr > (1ULL << this->GetAddressSpaceBits())) {
@@ -187,6 +187,11 @@ struct Values {
                                        true};
     Setting<bool, false> audio_muted{
         linkage, false, "audio_muted", Category::Audio, Specialization::Default, true, true};
+    Setting<bool, false> audio_parallel_voices{linkage, false, "audio_parallel_voices",
+                                               Category::Audio, Specialization::Default, true,
+                                               true};
+    Setting<bool, false> audio_time_stretch{
+        linkage, false, "audio_time_stretch", Category::Audio, Specialization::Default, true, true};
     Setting<bool, false> dump_audio_commands{
         linkage, false, "dump_audio_commands", Category::Audio, Specialization::Default, false};
 
@@ -210,6 +215,7 @@ struct Values {
                                              true,
                                              true,
                                              &use_speed_limit};
+    Setting<bool> use_huge_pages{linkage, false, "use_huge_pages", Category::Core};
 
     // Cpu
     SwitchableSetting<CpuBackend, true> cpu_backend{linkage,
@@ -425,6 +431,10 @@ struct Values {
                                                 Category::RendererAdvanced};
     SwitchableSetting<bool> barrier_feedback_loops{linkage, true, "barrier_feedback_loops",
                                                    Category::RendererAdvanced};
+    Setting<bool> use_parallel_command_recording{linkage, false, "use_parallel_command_recording",
+                                                 Category::RendererAdvanced};
+    SwitchableSetting<bool> use_accurate_query_resolution{
+        linkage, false, "use_accurate_query_resolution", Category::RendererAdvanced};
 
     Setting<bool> renderer_debug{linkage, false, "debug", Category::RendererDebug};
     Setting<bool> renderer_shader_feedback{linkage, false, "shader_feedback",
@@ -489,6 +499,7 @@ struct Values {
 
     // Linux
     SwitchableSetting<bool> enable_gamemode{linkage, true, "enable_gamemode", Category::Linux};
+    Setting<bool> pin_host_threads{linkage, false, "pin_host_threads", Category::Linux};
 
     // Controls
     InputSetting<std::array<PlayerInput, 10>> players;
@@ -584,6 +595,8 @@ struct Values {
     Setting<bool> dump_macros{
         linkage, false, "dump_macros", Category::DebuggingGraphics, Specialization::Default, false};
     Setting<bool> enable_fs_access_log{linkage, false, "enable_fs_access_log", Category::Debugging};
+    Setting<bool> enable_guest_profiler{linkage, false, "enable_guest_profiler",
+                                        Category::Debugging};
     Setting<bool> reporting_services{
         linkage, false, "reporting_services", Category::Debugging, Specialization::Default, false};
     Setting<bool> quest_flag{linkage, false, "quest_flag", Category::Debugging};
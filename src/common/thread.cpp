@@ -2,10 +2,16 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "common/error.h"
 #include "common/logging/log.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #ifdef __APPLE__
 #include <mach/mach.h>
@@ -23,6 +29,10 @@
 #ifndef _WIN32
 #include <unistd.h>
 #endif
+#ifdef __linux__
+#include <fstream>
+#include <fmt/ranges.h>
+#endif
 
 #ifdef __FreeBSD__
 #define cpu_set_t cpuset_t
@@ -120,4 +130,257 @@ void SetCurrentThreadName(const char* name) {
 
 #endif
 
+PlacementPlan MakePlacementPlan(const std::vector<HostCpu>& cpus) {
+    PlacementPlan plan;
+    if (cpus.empty()) {
+        return plan;
+    }
+    for (const HostCpu& cpu : cpus) {
+        plan.allowed.push_back(cpu.id);
+    }
+
+    // Physical cores, the fastest first
+    std::vector<const HostCpu*> cores;
+    for (const HostCpu& cpu : cpus) {
+        if (cpu.id == cpu.core) {
+            cores.push_back(&cpu);
+        }
+    }
+    std::ranges::stable_sort(cores, [](const HostCpu* lhs, const HostCpu* rhs) {
+        return lhs->performance > rhs->performance;
+    });
+
+    std::vector<bool> used_cores(cores.size());
+    std::vector<u32> reserved;
+    const auto reserve_core = [&](std::size_t index) {
+        used_cores[index] = true;
+        for (const HostCpu& cpu : cpus) {
+            if (cpu.core == cores[index]->core) {
+                reserved.push_back(cpu.id);
+            }
+        }
+        return cores[index]->id;
+    };
+
+    // One physical core per emulated core, sharing them when there are not enough
+    for (std::size_t core = 0; core < PlacementPlan::NumEmulatedCores; ++core) {
+        const std::size_t index = core % cores.size();
+        plan.emulated_cores[core] = {used_cores[index] ? cores[index]->id : reserve_core(index)};
+    }
+
+    // The GPU thread on the next physical core, and its worker on a CPU sharing its caches
+    std::optional<u32> gpu_l3;
+    const auto gpu_it = std::ranges::find(used_cores, false);
+    if (gpu_it != used_cores.end()) {
+        const std::size_t gpu_index = static_cast<std::size_t>(gpu_it - used_cores.begin());
+        const HostCpu& gpu = *cores[gpu_index];
+        gpu_l3 = gpu.l3;
+        plan.gpu = {reserve_core(gpu_index)};
+
+        const auto sibling = std::ranges::find_if(
+            cpus, [&](const HostCpu& cpu) { return cpu.core == gpu.core && cpu.id != gpu.id; });
+        if (sibling != cpus.end()) {
+            plan.gpu_worker = {sibling->id};
+        } else {
+            std::size_t worker_index = cores.size();
+            for (std::size_t index = 0; index < cores.size(); ++index) {
+                if (used_cores[index]) {
+                    continue;
+                }
+                if (cores[index]->l2 == gpu.l2) {
+                    worker_index = index;
+                    break;
+                }
+                if (cores[index]->l3 == gpu.l3 && worker_index == cores.size()) {
+                    worker_index = index;
+                }
+            }
+            plan.gpu_worker = worker_index != cores.size() ? std::vector{reserve_core(worker_index)}
+                                                           : plan.gpu;
+        }
+    }
+
+    // Everything else goes to the CPUs left, or anywhere when none are left
+    for (const HostCpu& cpu : cpus) {
+        if (std::ranges::find(reserved, cpu.id) == reserved.end()) {
+            plan.others.push_back(cpu.id);
+        }
+    }
+
+    // Render pass recorders run in parallel, so they get every CPU left that shares the L3 of the
+    // GPU thread, or else every CPU left. A single CPU would serialize them, let them run anywhere.
+    if (gpu_l3) {
+        for (const HostCpu& cpu : cpus) {
+            if (cpu.l3 == *gpu_l3 && std::ranges::find(plan.others, cpu.id) != plan.others.end()) {
+                plan.gpu_recorders.push_back(cpu.id);
+            }
+        }
+    }
+    if (plan.gpu_recorders.size() < 2) {
+        plan.gpu_recorders = plan.others;
+    }
+    if (plan.gpu_recorders.size() < 2) {
+        plan.gpu_recorders.clear();
+    }
+    return plan;
+}
+
+const std::vector<u32>& GetRoleCpus(const PlacementPlan& plan, ThreadRole role,
+                                    std::size_t index) {
+    const std::vector<u32>* cpus{&plan.others};
+    switch (role) {
+    case ThreadRole::EmulatedCore:
+        cpus = &plan.emulated_cores[index % PlacementPlan::NumEmulatedCores];
+        break;
+    case ThreadRole::Gpu:
+        cpus = &plan.gpu;
+        break;
+    case ThreadRole::GpuWorker:
+        cpus = &plan.gpu_worker;
+        break;
+    case ThreadRole::GpuRecorder:
+        cpus = &plan.gpu_recorders;
+        break;
+    case ThreadRole::Audio:
+    case ThreadRole::Service:
+    case ThreadRole::Background:
+        cpus = &plan.others;
+        break;
+    }
+    return cpus->empty() ? plan.allowed : *cpus;
+}
+
+#ifdef __linux__
+
+namespace {
+
+std::string ReadSysfs(const std::string& path) {
+    std::ifstream file{path};
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+
+/// Parses a sysfs CPU list such as "0-3,8,10-11".
+std::vector<u32> ParseCpuList(const std::string& list) {
+    std::vector<u32> cpus;
+    std::size_t pos = 0;
+    while (pos < list.size()) {
+        std::size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        const std::string range = list.substr(pos, end - pos);
+        const std::size_t dash = range.find('-');
+        const u32 first = static_cast<u32>(std::strtoul(range.c_str(), nullptr, 10));
+        const u32 last =
+            dash == std::string::npos
+                ? first
+                : static_cast<u32>(std::strtoul(range.c_str() + dash + 1, nullptr, 10));
+        for (u32 cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+u32 FirstCpuOf(const std::string& list, u32 fallback) {
+    const std::vector<u32> cpus = ParseCpuList(list);
+    return cpus.empty() ? fallback : cpus.front();
+}
+
+std::vector<HostCpu> ReadHostTopology() {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+        return {};
+    }
+    std::vector<HostCpu> cpus;
+    for (const u32 id : ParseCpuList(ReadSysfs("/sys/devices/system/cpu/online"))) {
+        if (id >= CPU_SETSIZE || !CPU_ISSET(id, &allowed)) {
+            continue;
+        }
+        const std::string base = fmt::format("/sys/devices/system/cpu/cpu{}/", id);
+        HostCpu cpu{
+            .id = id,
+            .core = FirstCpuOf(ReadSysfs(base + "topology/thread_siblings_list"), id),
+            .l2 = id,
+            .l3 = id,
+            .performance = std::strtoull(ReadSysfs(base + "cpu_capacity").c_str(), nullptr, 10),
+        };
+        if (cpu.performance == 0) {
+            // x86 hybrid parts don't report a capacity, their efficiency cores clock lower
+            cpu.performance =
+                std::strtoull(ReadSysfs(base + "cpufreq/cpuinfo_max_freq").c_str(), nullptr, 10);
+        }
+        for (u32 index = 0;; ++index) {
+            const std::string cache = fmt::format("{}cache/index{}/", base, index);
+            const std::string level = ReadSysfs(cache + "level");
+            if (level.empty()) {
+                break;
+            }
+            if (level == "2") {
+                cpu.l2 = FirstCpuOf(ReadSysfs(cache + "shared_cpu_list"), id);
+            } else if (level == "3") {
+                cpu.l3 = FirstCpuOf(ReadSysfs(cache + "shared_cpu_list"), id);
+            }
+        }
+        cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+std::string FormatCpus(const std::vector<u32>& cpus) {
+    return cpus.empty() ? std::string{"any"} : fmt::format("{}", fmt::join(cpus, ","));
+}
+
+const PlacementPlan& GetPlacementPlan() {
+    static const PlacementPlan plan = [] {
+        PlacementPlan result = MakePlacementPlan(ReadHostTopology());
+        std::vector<std::string> cores;
+        for (const std::vector<u32>& core : result.emulated_cores) {
+            cores.push_back(FormatCpus(core));
+        }
+        LOG_INFO(Common,
+                 "Host thread placement: emulated cores on CPUs [{}], GPU on {}, "
+                 "GPU worker on {}, render pass recorders on {}, other threads on {}",
+                 fmt::join(cores, " "), FormatCpus(result.gpu), FormatCpus(result.gpu_worker),
+                 FormatCpus(result.gpu_recorders), FormatCpus(result.others));
+        return result;
+    }();
+    return plan;
+}
+
+} // Anonymous namespace
+
+void SetCurrentThreadRole(ThreadRole role, std::size_t index) {
+    if (!Settings::values.pin_host_threads.GetValue()) {
+        return;
+    }
+    // Roles without CPUs of their own still reset the affinity, a thread pool may have pinned
+    // the thread for another role before it took this one
+    const std::vector<u32>& cpus = GetRoleCpus(GetPlacementPlan(), role, index);
+    if (cpus.empty()) {
+        return;
+    }
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const u32 cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    if (int e = pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+        errno = e;
+        LOG_WARNING(Common, "Failed to set thread affinity: {}", GetLastErrorMsg());
+    }
+}
+
+#else
+
+void SetCurrentThreadRole(ThreadRole /*role*/, std::size_t /*index*/) {
+    // Topology placement is only implemented on Linux
+}
+
+#endif
+
 } // namespace Common
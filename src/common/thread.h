@@ -4,12 +4,14 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstddef>
 #include <mutex>
 #include <thread>
+#include <vector>
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
 
@@ -106,4 +108,59 @@ void SetCurrentThreadPriority(ThreadPriority new_priority);
 
 void SetCurrentThreadName(const char* name);
 
+enum class ThreadRole : u32 {
+    EmulatedCore, ///< Runs an emulated CPU core
+    Gpu,          ///< Processes the GPU command lists
+    GpuWorker,    ///< Records and submits the host GPU commands
+    GpuRecorder,  ///< Records render passes in parallel for the GPU worker
+    Audio,        ///< Renders and outputs audio
+    Service,      ///< Runs HLE services
+    Background,   ///< Shader compilation, texture transcoding, serialization...
+};
+
+/**
+ * Places the current thread on the host CPUs planned for its role, when host thread pinning is
+ * enabled. The plan is made once from the host topology: emulated cores get distinct physical
+ * performance cores, the GPU thread and its worker share a cache, render pass recorders spread
+ * over the free cores sharing the GPU's L3, and the other threads use the remaining CPUs.
+ * @param role Role of the current thread.
+ * @param index Index of the emulated core, for the EmulatedCore role.
+ */
+void SetCurrentThreadRole(ThreadRole role, std::size_t index = 0);
+
+/// Host CPU as seen by the thread placement.
+struct HostCpu {
+    u32 id;
+    u32 core;        ///< First logical CPU of the physical core
+    u32 l2;          ///< First logical CPU sharing the L2 cache
+    u32 l3;          ///< First logical CPU sharing the L3 cache
+    u64 performance; ///< Capacity or maximum frequency, higher on performance cores
+};
+
+/// Host CPUs planned for each thread role, threads of a role with no CPUs run on any allowed CPU.
+struct PlacementPlan {
+    static constexpr std::size_t NumEmulatedCores = 4;
+
+    std::array<std::vector<u32>, NumEmulatedCores> emulated_cores;
+    std::vector<u32> gpu;
+    std::vector<u32> gpu_worker;
+    std::vector<u32> gpu_recorders;
+    std::vector<u32> others;
+    std::vector<u32> allowed; ///< Every CPU the process may run on
+};
+
+/// Plans which of the given host CPUs each thread role runs on.
+[[nodiscard]] PlacementPlan MakePlacementPlan(const std::vector<HostCpu>& cpus);
+
+/**
+ * Gets the CPUs a thread of a role is placed on. Roles with no CPUs of their own get every
+ * allowed CPU, so that a thread taking such a role after another one is no longer held to the
+ * CPUs of the first.
+ * @param plan Plan made from the host topology.
+ * @param role Role of the thread.
+ * @param index Index of the emulated core, for the EmulatedCore role.
+ */
+[[nodiscard]] const std::vector<u32>& GetRoleCpus(const PlacementPlan& plan, ThreadRole role,
+                                                  std::size_t index = 0);
+
 } // namespace Common
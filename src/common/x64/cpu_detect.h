@@ -68,6 +68,7 @@ struct CPUCaps {
     bool pclmulqdq : 1;
     bool popcnt : 1;
     bool sha : 1;
+    bool vaes : 1;
     bool waitpkg : 1;
 };
 
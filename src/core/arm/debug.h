@@ -28,6 +28,14 @@ struct BacktraceEntry {
     std::string name;
 };
 
+/// Walks the frame records of a context, returning the pc followed by the return addresses.
+std::vector<u64> GetBacktraceAddresses(Kernel::KProcess* process,
+                                       const Kernel::Svc::ThreadContext& ctx,
+                                       size_t max_frames = 256);
+
+/// Fills in the module, offset and symbol name of entries whose original address is set.
+void SymbolicateBacktrace(Kernel::KProcess* process, std::vector<BacktraceEntry>& out);
+
 std::vector<BacktraceEntry> GetBacktraceFromContext(Kernel::KProcess* process,
                                                     const Kernel::Svc::ThreadContext& ctx);
 std::vector<BacktraceEntry> GetBacktrace(const Kernel::KThread* thread);
@@ -27,6 +27,7 @@
 #include "core/file_sys/vfs/vfs_concat.h"
 #include "core/file_sys/vfs/vfs_real.h"
 #include "core/gpu_dirty_memory_manager.h"
+#include "core/guest_profiler.h"
 #include "core/hle/kernel/k_memory_manager.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/k_resource_limit.h"
@@ -117,6 +118,7 @@ struct System::Impl {
 
     void Initialize(System& system) {
         device_memory = std::make_unique<Core::DeviceMemory>();
+        guest_profiler = std::make_unique<Core::GuestProfiler>(system);
 
         is_multicore = Settings::values.use_multi_core.GetValue();
         extended_memory_layout =
@@ -379,6 +381,10 @@ struct System::Impl {
         GetAndResetPerfStats();
         perf_stats->BeginSystemFrame();
 
+        if (Settings::values.enable_guest_profiler.GetValue()) {
+            guest_profiler->Start(params.program_id);
+        }
+
         std::string title_version;
         const FileSys::PatchManager pm(params.program_id, system.GetFileSystemController(),
                                        system.GetContentProvider());
@@ -428,6 +434,7 @@ struct System::Impl {
         core_timing.SyncPause(false);
         Network::CancelPendingSocketOperations();
         kernel.SuspendEmulation(true);
+        guest_profiler->Stop();
         kernel.CloseServices();
         kernel.ShutdownCores();
         services.reset();
@@ -547,6 +554,7 @@ struct System::Impl {
     std::string status_details = "";
 
     std::unique_ptr<Core::PerfStats> perf_stats;
+    std::unique_ptr<Core::GuestProfiler> guest_profiler;
     Core::SpeedLimiter speed_limiter;
 
     bool is_multicore{};
@@ -971,6 +979,10 @@ const Core::Debugger& System::GetDebugger() const {
     return *impl->debugger;
 }
 
+Core::GuestProfiler& System::GetGuestProfiler() {
+    return *impl->guest_profiler;
+}
+
 Network::RoomNetwork& System::GetRoomNetwork() {
     return impl->room_network;
 }
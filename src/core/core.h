@@ -119,6 +119,7 @@ class Debugger;
 class DeviceMemory;
 class ExclusiveMonitor;
 class GPUDirtyMemoryManager;
+class GuestProfiler;
 class PerfStats;
 class Reporter;
 class SpeedLimiter;
@@ -387,6 +388,9 @@ public:
     [[nodiscard]] Core::Debugger& GetDebugger();
     [[nodiscard]] const Core::Debugger& GetDebugger() const;
 
+    /// Gets a reference to the sampling profiler of the guest application.
+    [[nodiscard]] Core::GuestProfiler& GetGuestProfiler();
+
     /// Gets a mutable reference to the Room Network.
     [[nodiscard]] Network::RoomNetwork& GetRoomNetwork();
 
@@ -4,7 +4,6 @@
 #include <algorithm>
 #include <mutex>
 #include <string>
-#include <tuple>
 
 #ifdef _WIN32
 #include "common/windows/timer_resolution.h"
@@ -26,24 +25,6 @@ std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callbac
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
 
-struct CoreTiming::Event {
-    s64 time;
-    u64 fifo_order;
-    std::weak_ptr<EventType> type;
-    s64 reschedule_time;
-    heap_t::handle_type handle{};
-
-    // Sort by time, unless the times are the same, in which case sort by
-    // the order added to the queue
-    friend bool operator>(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) > std::tie(right.time, right.fifo_order);
-    }
-
-    friend bool operator<(const Event& left, const Event& right) {
-        return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
-    }
-};
-
 CoreTiming::CoreTiming() : clock{Common::CreateOptimalClock()} {}
 
 CoreTiming::~CoreTiming() {
@@ -73,7 +54,7 @@ void CoreTiming::Initialize(std::function<void()>&& on_thread_init_) {
 
 void CoreTiming::ClearPendingEvents() {
     std::scoped_lock lock{advance_lock, basic_lock};
-    event_queue.clear();
+    event_queue.Clear();
     event.Set();
 }
 
@@ -112,7 +93,7 @@ bool CoreTiming::IsRunning() const {
 
 bool CoreTiming::HasPendingEvents() const {
     std::scoped_lock lock{basic_lock};
-    return !(wait_set && event_queue.empty());
+    return !(wait_set && event_queue.Empty());
 }
 
 void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
@@ -121,8 +102,7 @@ void CoreTiming::ScheduleEvent(std::chrono::nanoseconds ns_into_future,
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? ns_into_future : GetGlobalTimeNs() + ns_into_future};
 
-        auto h{event_queue.emplace(Event{next_time.count(), event_fifo_id++, event_type, 0})};
-        (*h).handle = h;
+        event_queue.Insert(next_time.count(), event_fifo_id++, 0, event_type);
     }
 
     event.Set();
@@ -136,9 +116,7 @@ void CoreTiming::ScheduleLoopingEvent(std::chrono::nanoseconds start_time,
         std::scoped_lock scope{basic_lock};
         const auto next_time{absolute_time ? start_time : GetGlobalTimeNs() + start_time};
 
-        auto h{event_queue.emplace(
-            Event{next_time.count(), event_fifo_id++, event_type, resched_time.count()})};
-        (*h).handle = h;
+        event_queue.Insert(next_time.count(), event_fifo_id++, resched_time.count(), event_type);
     }
 
     event.Set();
@@ -149,17 +127,7 @@ void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type,
     {
         std::scoped_lock lk{basic_lock};
 
-        std::vector<heap_t::handle_type> to_remove;
-        for (auto itr = event_queue.begin(); itr != event_queue.end(); itr++) {
-            const Event& e = *itr;
-            if (e.type.lock().get() == event_type.get()) {
-                to_remove.push_back(itr->handle);
-            }
-        }
-
-        for (auto& h : to_remove) {
-            event_queue.erase(h);
-        }
+        event_queue.RemoveAll(*event_type);
 
         event_type->sequence_number++;
     }
@@ -201,15 +169,17 @@ std::optional<s64> CoreTiming::Advance() {
     std::scoped_lock lock{advance_lock, basic_lock};
     global_timer = GetGlobalTimeNs().count();
 
-    while (!event_queue.empty() && event_queue.top().time <= global_timer) {
-        const Event& evt = event_queue.top();
+    TimingWheel::Handle handle;
+    while ((handle = event_queue.PopDue(global_timer)) != TimingWheel::INVALID_HANDLE) {
+        const TimingWheel::Event& evt = event_queue.Get(handle);
+        const auto evt_time = evt.time;
+        const auto evt_reschedule_time = evt.reschedule_time;
 
         if (const auto event_type{evt.type.lock()}) {
-            const auto evt_time = evt.time;
             const auto evt_sequence_num = event_type->sequence_number;
 
-            if (evt.reschedule_time == 0) {
-                event_queue.pop();
+            if (evt_reschedule_time == 0) {
+                event_queue.Free(handle);
 
                 basic_lock.unlock();
 
@@ -218,6 +188,7 @@ std::optional<s64> CoreTiming::Advance() {
 
                 basic_lock.lock();
             } else {
+                // The event stays detached from the wheel while its callback runs
                 basic_lock.unlock();
 
                 const auto new_schedule_time{event_type->callback(
@@ -226,34 +197,32 @@ std::optional<s64> CoreTiming::Advance() {
                 basic_lock.lock();
 
                 if (evt_sequence_num != event_type->sequence_number) {
-                    // Heap handle is invalidated after external modification.
+                    // The event was unscheduled externally.
+                    event_queue.Free(handle);
                     continue;
                 }
 
                 const auto next_schedule_time{new_schedule_time.has_value()
                                                   ? new_schedule_time.value().count()
-                                                  : evt.reschedule_time};
+                                                  : evt_reschedule_time};
 
                 // If this event was scheduled into a pause, its time now is going to be way
                 // behind. Re-set this event to continue from the end of the pause.
-                auto next_time{evt.time + next_schedule_time};
-                if (evt.time < pause_end_time) {
+                auto next_time{evt_time + next_schedule_time};
+                if (evt_time < pause_end_time) {
                     next_time = pause_end_time + next_schedule_time;
                 }
 
-                event_queue.update(evt.handle, Event{next_time, event_fifo_id++, evt.type,
-                                                     next_schedule_time, evt.handle});
+                event_queue.Reinsert(handle, next_time, event_fifo_id++, next_schedule_time);
             }
+        } else {
+            event_queue.Free(handle);
         }
 
         global_timer = GetGlobalTimeNs().count();
     }
 
-    if (!event_queue.empty()) {
-        return event_queue.top().time;
-    } else {
-        return std::nullopt;
-    }
+    return event_queue.NextTime();
 }
 
 void CoreTiming::ThreadLoop() {
@@ -12,11 +12,10 @@
 #include <string>
 #include <thread>
 
-#include <boost/heap/fibonacci_heap.hpp>
-
 #include "common/common_types.h"
 #include "common/thread.h"
 #include "common/wall_clock.h"
+#include "core/core_timing_wheel.h"
 
 namespace Core::Timing {
 
@@ -36,6 +35,8 @@ struct EventType {
     /// A monotonic sequence number, incremented when this event is
     /// changed externally.
     size_t sequence_number;
+    /// First pending event of this type in the timing wheel, owned by CoreTiming.
+    TimingWheel::Handle first_pending = TimingWheel::INVALID_HANDLE;
 };
 
 enum class UnscheduleEventType {
@@ -139,8 +140,6 @@ public:
 #endif
 
 private:
-    struct Event;
-
     static void ThreadEntry(CoreTiming& instance);
     void ThreadLoop();
 
@@ -154,10 +153,7 @@ private:
     s64 timer_resolution_ns;
 #endif
 
-    using heap_t =
-        boost::heap::fibonacci_heap<CoreTiming::Event, boost::heap::compare<std::greater<>>>;
-
-    heap_t event_queue;
+    TimingWheel event_queue;
     u64 event_fifo_id = 0;
 
     Common::Event event{};
@@ -0,0 +1,322 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <tuple>
+
+#include "common/assert.h"
+#include "core/core_timing.h"
+#include "core/core_timing_wheel.h"
+
+namespace Core::Timing {
+
+TimingWheel::TimingWheel() {
+    heads.fill(INVALID_HANDLE);
+    nodes.reserve(INITIAL_CAPACITY);
+}
+
+TimingWheel::~TimingWheel() {
+    // Event types can outlive the wheel, leave them without pending events
+    Clear();
+}
+
+TimingWheel::Handle TimingWheel::Insert(s64 time, u64 fifo_order, s64 reschedule_time,
+                                        const std::shared_ptr<EventType>& type) {
+    const Handle handle = Allocate();
+    nodes[handle].event = Event{
+        .time = time,
+        .fifo_order = fifo_order,
+        .reschedule_time = reschedule_time,
+        .type = type,
+    };
+    Link(handle);
+    LinkType(handle, *type);
+    return handle;
+}
+
+void TimingWheel::Reinsert(Handle handle, s64 time, u64 fifo_order, s64 reschedule_time) {
+    ASSERT(nodes[handle].bucket == DETACHED_BUCKET);
+    const std::shared_ptr<EventType> type = nodes[handle].event.type.lock();
+    if (!type) {
+        Free(handle);
+        return;
+    }
+    Event& event = nodes[handle].event;
+    event.time = time;
+    event.fifo_order = fifo_order;
+    event.reschedule_time = reschedule_time;
+    Link(handle);
+    LinkType(handle, *type);
+}
+
+void TimingWheel::Free(Handle handle) {
+    Node& node = nodes[handle];
+    ASSERT(node.bucket == DETACHED_BUCKET);
+    node.event.type.reset();
+    node.bucket = DETACHED_BUCKET;
+    node.next = free_head;
+    free_head = handle;
+}
+
+void TimingWheel::RemoveAll(EventType& type) {
+    while (type.first_pending != INVALID_HANDLE) {
+        const Handle handle = type.first_pending;
+        Unlink(handle);
+        UnlinkType(handle, &type);
+        Free(handle);
+    }
+}
+
+TimingWheel::Handle TimingWheel::PopDue(s64 time) {
+    Cascade(ToTick(time));
+    const Handle handle = PeekMin();
+    if (handle == INVALID_HANDLE || nodes[handle].event.time > time) {
+        return INVALID_HANDLE;
+    }
+    Unlink(handle);
+    UnlinkType(handle, nodes[handle].event.type.lock().get());
+    return handle;
+}
+
+std::optional<s64> TimingWheel::NextTime() {
+    const Handle handle = PeekMin();
+    if (handle == INVALID_HANDLE) {
+        return std::nullopt;
+    }
+    return nodes[handle].event.time;
+}
+
+void TimingWheel::Clear() {
+    for (u32 bucket = 0; bucket < heads.size(); ++bucket) {
+        while (heads[bucket] != INVALID_HANDLE) {
+            const Handle handle = heads[bucket];
+            Unlink(handle);
+            UnlinkType(handle, nodes[handle].event.type.lock().get());
+            Free(handle);
+        }
+    }
+}
+
+TimingWheel::Handle TimingWheel::Allocate() {
+    if (free_head == INVALID_HANDLE) {
+        // Grow the storage geometrically and thread the new nodes into the free list
+        const size_t old_size = nodes.size();
+        const size_t new_size = std::max(INITIAL_CAPACITY, old_size * 2);
+        nodes.resize(new_size);
+        for (size_t index = new_size; index > old_size; --index) {
+            Node& node = nodes[index - 1];
+            node.bucket = DETACHED_BUCKET;
+            node.next = free_head;
+            free_head = static_cast<Handle>(index - 1);
+        }
+    }
+    const Handle handle = free_head;
+    free_head = nodes[handle].next;
+    return handle;
+}
+
+u32 TimingWheel::BucketOf(s64 time) const {
+    const u64 tick = ToTick(time);
+    if (tick <= current_tick) {
+        // Already due, keep it in the slot being processed
+        return static_cast<u32>(current_tick & SLOT_MASK);
+    }
+    // The level is given by the highest group of bits that differs from the current tick
+    const size_t highest_bit = 63 - static_cast<size_t>(std::countl_zero(tick ^ current_tick));
+    const size_t level = highest_bit / LEVEL_BITS;
+    if (level >= NUM_LEVELS) {
+        return OVERFLOW_BUCKET;
+    }
+    const u64 slot = (tick >> (level * LEVEL_BITS)) & SLOT_MASK;
+    return static_cast<u32>(level * NUM_SLOTS + slot);
+}
+
+void TimingWheel::Link(Handle handle) {
+    Node& node = nodes[handle];
+    const u32 bucket = BucketOf(node.event.time);
+    node.bucket = bucket;
+    node.prev = INVALID_HANDLE;
+    node.next = heads[bucket];
+    if (bucket < NUM_SLOTS && (sorted_slots & (u64{1} << bucket)) != 0) {
+        // Keep the slot in order, walking past the events that come first
+        const auto key = std::tie(node.event.time, node.event.fifo_order);
+        while (node.next != INVALID_HANDLE &&
+               std::tie(nodes[node.next].event.time, nodes[node.next].event.fifo_order) < key) {
+            node.prev = node.next;
+            node.next = nodes[node.next].next;
+        }
+    }
+    if (node.next != INVALID_HANDLE) {
+        nodes[node.next].prev = handle;
+    }
+    if (node.prev != INVALID_HANDLE) {
+        nodes[node.prev].next = handle;
+    } else {
+        heads[bucket] = handle;
+    }
+    if (bucket != OVERFLOW_BUCKET) {
+        occupied[bucket / NUM_SLOTS] |= u64{1} << (bucket % NUM_SLOTS);
+    }
+    ++num_events;
+}
+
+void TimingWheel::Unlink(Handle handle) {
+    Node& node = nodes[handle];
+    const u32 bucket = node.bucket;
+    ASSERT(bucket < DETACHED_BUCKET);
+    if (node.prev != INVALID_HANDLE) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[bucket] = node.next;
+    }
+    if (node.next != INVALID_HANDLE) {
+        nodes[node.next].prev = node.prev;
+    }
+    if (heads[bucket] == INVALID_HANDLE && bucket != OVERFLOW_BUCKET) {
+        occupied[bucket / NUM_SLOTS] &= ~(u64{1} << (bucket % NUM_SLOTS));
+        if (bucket < NUM_SLOTS) {
+            sorted_slots &= ~(u64{1} << bucket);
+        }
+    }
+    node.bucket = DETACHED_BUCKET;
+    --num_events;
+}
+
+void TimingWheel::LinkType(Handle handle, EventType& type) {
+    Node& node = nodes[handle];
+    node.type_prev = INVALID_HANDLE;
+    node.type_next = type.first_pending;
+    if (node.type_next != INVALID_HANDLE) {
+        nodes[node.type_next].type_prev = handle;
+    }
+    type.first_pending = handle;
+}
+
+void TimingWheel::UnlinkType(Handle handle, EventType* type) {
+    Node& node = nodes[handle];
+    if (node.type_prev != INVALID_HANDLE) {
+        nodes[node.type_prev].type_next = node.type_next;
+    } else if (type) {
+        // When the type has expired, its list head went away with it
+        type->first_pending = node.type_next;
+    }
+    if (node.type_next != INVALID_HANDLE) {
+        nodes[node.type_next].type_prev = node.type_prev;
+    }
+    node.type_prev = INVALID_HANDLE;
+    node.type_next = INVALID_HANDLE;
+}
+
+void TimingWheel::Cascade(u64 target_tick) {
+    while (true) {
+        const auto level_it =
+            std::ranges::find_if(occupied, [](u64 bitmap) { return bitmap != 0; });
+        if (level_it == occupied.end()) {
+            if (heads[OVERFLOW_BUCKET] == INVALID_HANDLE) {
+                current_tick = std::max(current_tick, target_tick);
+                return;
+            }
+            // Only far away events are left, bring the wheel closer to them
+            const u64 earliest_tick = ToTick(nodes[FindMin(OVERFLOW_BUCKET)].event.time);
+            const u64 new_tick = std::min(earliest_tick, target_tick);
+            if (new_tick <= current_tick) {
+                return;
+            }
+            current_tick = new_tick;
+            RelinkBucket(OVERFLOW_BUCKET);
+            continue;
+        }
+        const size_t level = static_cast<size_t>(std::distance(occupied.begin(), level_it));
+        const u64 slot = static_cast<u64>(std::countr_zero(*level_it));
+        const size_t shift = level * LEVEL_BITS;
+        const u64 slot_tick = ((current_tick >> (shift + LEVEL_BITS)) << (shift + LEVEL_BITS)) |
+                              (slot << shift);
+        if (slot_tick > target_tick || slot_tick <= current_tick) {
+            return;
+        }
+        current_tick = slot_tick;
+        if (level == 0) {
+            return;
+        }
+        // Spread the events of the slot over the lower levels
+        RelinkBucket(static_cast<u32>(level * NUM_SLOTS + slot));
+    }
+}
+
+void TimingWheel::RelinkBucket(u32 bucket) {
+    Handle handle = heads[bucket];
+    heads[bucket] = INVALID_HANDLE;
+    if (bucket != OVERFLOW_BUCKET) {
+        occupied[bucket / NUM_SLOTS] &= ~(u64{1} << (bucket % NUM_SLOTS));
+    }
+    while (handle != INVALID_HANDLE) {
+        const Handle next = nodes[handle].next;
+        --num_events;
+        Link(handle);
+        handle = next;
+    }
+}
+
+void TimingWheel::SortSlot(u32 slot) {
+    sort_scratch.clear();
+    for (Handle handle = heads[slot]; handle != INVALID_HANDLE; handle = nodes[handle].next) {
+        sort_scratch.push_back(handle);
+    }
+    std::ranges::sort(sort_scratch, [this](Handle lhs, Handle rhs) {
+        const Event& left = nodes[lhs].event;
+        const Event& right = nodes[rhs].event;
+        return std::tie(left.time, left.fifo_order) < std::tie(right.time, right.fifo_order);
+    });
+    Handle prev = INVALID_HANDLE;
+    for (const Handle handle : sort_scratch) {
+        nodes[handle].prev = prev;
+        if (prev != INVALID_HANDLE) {
+            nodes[prev].next = handle;
+        }
+        prev = handle;
+    }
+    nodes[prev].next = INVALID_HANDLE;
+    heads[slot] = sort_scratch.front();
+    sorted_slots |= u64{1} << slot;
+}
+
+TimingWheel::Handle TimingWheel::FindMin(u32 bucket) const {
+    Handle min_handle = heads[bucket];
+    if (min_handle == INVALID_HANDLE) {
+        return INVALID_HANDLE;
+    }
+    for (Handle handle = nodes[min_handle].next; handle != INVALID_HANDLE;
+         handle = nodes[handle].next) {
+        const Event& event = nodes[handle].event;
+        const Event& min_event = nodes[min_handle].event;
+        if (std::tie(event.time, event.fifo_order) <
+            std::tie(min_event.time, min_event.fifo_order)) {
+            min_handle = handle;
+        }
+    }
+    return min_handle;
+}
+
+TimingWheel::Handle TimingWheel::PeekMin() {
+    // Events of lower levels always come before the ones of higher levels, and the slots of a
+    // level are never behind the current tick
+    if (occupied[0] != 0) {
+        // Many events can share a slot of the first level, sort it once instead of scanning it
+        // on every pop
+        const u32 slot = static_cast<u32>(std::countr_zero(occupied[0]));
+        if ((sorted_slots & (u64{1} << slot)) == 0) {
+            SortSlot(slot);
+        }
+        return heads[slot];
+    }
+    for (size_t level = 1; level < NUM_LEVELS; ++level) {
+        if (occupied[level] != 0) {
+            const u64 slot = static_cast<u64>(std::countr_zero(occupied[level]));
+            return FindMin(static_cast<u32>(level * NUM_SLOTS + slot));
+        }
+    }
+    return FindMin(OVERFLOW_BUCKET);
+}
+
+} // namespace Core::Timing
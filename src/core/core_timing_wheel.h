@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Core::Timing {
+
+struct EventType;
+
+/**
+ * Hierarchical timing wheel holding the pending events of CoreTiming.
+ *
+ * Events are ordered by time, and by insertion order when their times are equal. Each level
+ * splits the range of the level above in 64 slots, the first level having a granularity of
+ * 1024ns; events further than the last level are kept in an overflow list. Events of the same
+ * EventType are linked together so they can be removed without searching the wheel, and nodes
+ * are recycled from preallocated storage.
+ *
+ * An EventType must only have events pending in a single wheel. The wheel is not thread-safe.
+ */
+class TimingWheel {
+public:
+    using Handle = u32;
+
+    static constexpr Handle INVALID_HANDLE = ~Handle{0};
+
+    struct Event {
+        s64 time;
+        u64 fifo_order;
+        s64 reschedule_time;
+        std::weak_ptr<EventType> type;
+    };
+
+    TimingWheel();
+    ~TimingWheel();
+
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    /// Returns true when there are no events in the wheel.
+    [[nodiscard]] bool Empty() const {
+        return num_events == 0;
+    }
+
+    /// Adds a new event to the wheel.
+    Handle Insert(s64 time, u64 fifo_order, s64 reschedule_time,
+                  const std::shared_ptr<EventType>& type);
+
+    /// Adds back an event detached by PopDue with a new time.
+    void Reinsert(Handle handle, s64 time, u64 fifo_order, s64 reschedule_time);
+
+    /// Returns the event of a handle.
+    [[nodiscard]] const Event& Get(Handle handle) const {
+        return nodes[handle].event;
+    }
+
+    /// Releases a detached event.
+    void Free(Handle handle);
+
+    /// Removes all pending events of an event type.
+    void RemoveAll(EventType& type);
+
+    /// Detaches the earliest event due at the given time, INVALID_HANDLE when there is none.
+    /// The event must be released with Free or added back with Reinsert.
+    Handle PopDue(s64 time);
+
+    /// Returns the time of the earliest event.
+    [[nodiscard]] std::optional<s64> NextTime();
+
+    /// Removes all events.
+    void Clear();
+
+private:
+    static constexpr size_t LEVEL_BITS = 6;
+    static constexpr size_t NUM_SLOTS = size_t{1} << LEVEL_BITS;
+    static constexpr u64 SLOT_MASK = NUM_SLOTS - 1;
+    static constexpr size_t NUM_LEVELS = 6;
+    static constexpr size_t TICK_SHIFT = 10;
+    static constexpr u32 OVERFLOW_BUCKET = static_cast<u32>(NUM_LEVELS * NUM_SLOTS);
+    static constexpr u32 DETACHED_BUCKET = OVERFLOW_BUCKET + 1;
+    static constexpr size_t INITIAL_CAPACITY = 1024;
+
+    struct Node {
+        Event event;
+        Handle prev;
+        Handle next;
+        Handle type_prev;
+        Handle type_next;
+        u32 bucket;
+    };
+
+    static u64 ToTick(s64 time) {
+        return time < 0 ? 0 : static_cast<u64>(time) >> TICK_SHIFT;
+    }
+
+    Handle Allocate();
+
+    u32 BucketOf(s64 time) const;
+
+    void Link(Handle handle);
+
+    void Unlink(Handle handle);
+
+    void LinkType(Handle handle, EventType& type);
+
+    void UnlinkType(Handle handle, EventType* type);
+
+    /// Moves the wheel towards the given tick, cascading the slots it reaches.
+    void Cascade(u64 target_tick);
+
+    /// Links again all the events of a bucket, relative to the current tick.
+    void RelinkBucket(u32 bucket);
+
+    /// Sorts a slot of the first level, which is then kept in order until it is emptied.
+    void SortSlot(u32 slot);
+
+    Handle FindMin(u32 bucket) const;
+
+    Handle PeekMin();
+
+    std::vector<Node> nodes;
+    Handle free_head = INVALID_HANDLE;
+    std::array<Handle, OVERFLOW_BUCKET + 1> heads;
+    std::array<u64, NUM_LEVELS> occupied{};
+    u64 sorted_slots = 0;
+    std::vector<Handle> sort_scratch;
+    u64 current_tick = 0;
+    size_t num_events = 0;
+};
+
+} // namespace Core::Timing
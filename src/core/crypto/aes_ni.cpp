@@ -0,0 +1,475 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+#endif
+
+#include "common/assert.h"
+#include "core/crypto/aes_ni.h"
+
+// Marks a function as using an instruction set the whole build doesn't target. MSVC allows the
+// intrinsics anywhere.
+#if defined(ARCHITECTURE_x86_64) && !(defined(_MSC_VER) && !defined(__clang__))
+#define AES_NI_TARGET(isa) __attribute__((target(isa)))
+#else
+#define AES_NI_TARGET(isa)
+#endif
+
+namespace Core::Crypto {
+
+#ifdef ARCHITECTURE_x86_64
+namespace {
+
+constexpr std::size_t BlockSize = AesNiCipher::BlockSize;
+constexpr std::size_t NumRounds = AesNiCipher::NumRounds;
+/// Number of blocks in flight at once, enough to hide the latency of each AES round
+constexpr std::size_t Parallelism = 8;
+/// Largest data unit mbedtls accepts in XTS mode
+constexpr std::size_t MaxXtsSize = std::size_t{1} << 24;
+
+template <int Rcon>
+AES_NI_TARGET("aes,sse4.1")
+__m128i ExpandKeyStep(__m128i key) {
+    const __m128i assist{_mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, Rcon), 0xFF)};
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, assist);
+}
+
+AES_NI_TARGET("aes,sse4.1")
+void ExpandKey(const u8* key, u8* encrypt_keys, u8* decrypt_keys) {
+    __m128i keys[NumRounds + 1];
+    keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    keys[1] = ExpandKeyStep<0x01>(keys[0]);
+    keys[2] = ExpandKeyStep<0x02>(keys[1]);
+    keys[3] = ExpandKeyStep<0x04>(keys[2]);
+    keys[4] = ExpandKeyStep<0x08>(keys[3]);
+    keys[5] = ExpandKeyStep<0x10>(keys[4]);
+    keys[6] = ExpandKeyStep<0x20>(keys[5]);
+    keys[7] = ExpandKeyStep<0x40>(keys[6]);
+    keys[8] = ExpandKeyStep<0x80>(keys[7]);
+    keys[9] = ExpandKeyStep<0x1B>(keys[8]);
+    keys[10] = ExpandKeyStep<0x36>(keys[9]);
+
+    // The equivalent inverse cipher uses the keys in reverse, mixed by InvMixColumns
+    auto* const encrypt{reinterpret_cast<__m128i*>(encrypt_keys)};
+    auto* const decrypt{reinterpret_cast<__m128i*>(decrypt_keys)};
+    for (std::size_t round = 0; round <= NumRounds; round++) {
+        _mm_store_si128(&encrypt[round], keys[round]);
+        const __m128i key_round{keys[NumRounds - round]};
+        _mm_store_si128(&decrypt[round], round == 0 || round == NumRounds
+                                             ? key_round
+                                             : _mm_aesimc_si128(key_round));
+    }
+}
+
+/// Run the rounds of the cipher over a group of independent blocks, interleaved.
+template <Op op, std::size_t N>
+AES_NI_TARGET("aes,sse4.1")
+void CipherBlocks(const __m128i* keys, __m128i* blocks) {
+    for (std::size_t i = 0; i < N; i++) {
+        blocks[i] = _mm_xor_si128(blocks[i], keys[0]);
+    }
+    for (std::size_t round = 1; round < NumRounds; round++) {
+        const __m128i key{_mm_load_si128(&keys[round])};
+        for (std::size_t i = 0; i < N; i++) {
+            blocks[i] = op == Op::Encrypt ? _mm_aesenc_si128(blocks[i], key)
+                                          : _mm_aesdec_si128(blocks[i], key);
+        }
+    }
+    for (std::size_t i = 0; i < N; i++) {
+        blocks[i] = op == Op::Encrypt ? _mm_aesenclast_si128(blocks[i], keys[NumRounds])
+                                      : _mm_aesdeclast_si128(blocks[i], keys[NumRounds]);
+    }
+}
+
+/// Run the rounds of the cipher over a group of independent pairs of blocks, interleaved.
+template <Op op, std::size_t N>
+AES_NI_TARGET("aes,vaes,avx2")
+void CipherBlocksVaes(const __m128i* keys, __m256i* blocks) {
+    const __m256i first_key{_mm256_broadcastsi128_si256(_mm_load_si128(&keys[0]))};
+    for (std::size_t i = 0; i < N; i++) {
+        blocks[i] = _mm256_xor_si256(blocks[i], first_key);
+    }
+    for (std::size_t round = 1; round < NumRounds; round++) {
+        const __m256i key{_mm256_broadcastsi128_si256(_mm_load_si128(&keys[round]))};
+        for (std::size_t i = 0; i < N; i++) {
+            blocks[i] = op == Op::Encrypt ? _mm256_aesenc_epi128(blocks[i], key)
+                                          : _mm256_aesdec_epi128(blocks[i], key);
+        }
+    }
+    const __m256i last_key{_mm256_broadcastsi128_si256(_mm_load_si128(&keys[NumRounds]))};
+    for (std::size_t i = 0; i < N; i++) {
+        blocks[i] = op == Op::Encrypt ? _mm256_aesenclast_epi128(blocks[i], last_key)
+                                      : _mm256_aesdeclast_epi128(blocks[i], last_key);
+    }
+}
+
+template <Op op>
+AES_NI_TARGET("aes,sse4.1")
+void TranscodeEcbSSE(const __m128i* keys, const u8* src, std::size_t blocks, u8* dest) {
+    std::size_t i = 0;
+    for (; i + Parallelism <= blocks; i += Parallelism) {
+        __m128i state[Parallelism];
+        for (std::size_t j = 0; j < Parallelism; j++) {
+            state[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + i + j);
+        }
+        CipherBlocks<op, Parallelism>(keys, state);
+        for (std::size_t j = 0; j < Parallelism; j++) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dest) + i + j, state[j]);
+        }
+    }
+    for (; i < blocks; i++) {
+        __m128i state{_mm_loadu_si128(reinterpret_cast<const __m128i*>(src) + i)};
+        CipherBlocks<op, 1>(keys, &state);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest) + i, state);
+    }
+}
+
+template <Op op>
+AES_NI_TARGET("aes,vaes,avx2")
+void TranscodeEcbVaes(const __m128i* keys, const u8* src, std::size_t blocks, u8* dest) {
+    std::size_t i = 0;
+    for (; i + Parallelism <= blocks; i += Parallelism) {
+        __m256i state[Parallelism / 2];
+        for (std::size_t j = 0; j < Parallelism / 2; j++) {
+            state[j] =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i * BlockSize) + j);
+        }
+        CipherBlocksVaes<op, Parallelism / 2>(keys, state);
+        for (std::size_t j = 0; j < Parallelism / 2; j++) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i * BlockSize) + j, state[j]);
+        }
+    }
+    TranscodeEcbSSE<op>(keys, src + i * BlockSize, blocks - i, dest + i * BlockSize);
+}
+
+/// A CTR counter as a 128-bit number, so it can be incremented with carries
+struct Counter {
+    u64 high;
+    u64 low;
+
+    void Advance(u64 blocks) {
+        const u64 old_low{low};
+        low += blocks;
+        high += low < old_low ? 1 : 0;
+    }
+};
+
+AES_NI_TARGET("aes,sse4.1")
+__m128i ByteSwapMask() {
+    return _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+}
+
+/// Make the big-endian counter blocks following a counter.
+template <std::size_t N>
+AES_NI_TARGET("aes,sse4.1")
+void MakeCounterBlocks(const Counter& counter, __m128i* blocks) {
+    const __m128i mask{ByteSwapMask()};
+    if (counter.low <= ~u64{0} - N) {
+        // The low half doesn't carry into the high half, so the counters are a vector add apart
+        const __m128i base{_mm_set_epi64x(static_cast<s64>(counter.high),
+                                          static_cast<s64>(counter.low))};
+        for (std::size_t i = 0; i < N; i++) {
+            blocks[i] = _mm_shuffle_epi8(_mm_add_epi64(base, _mm_set_epi64x(0, i)), mask);
+        }
+        return;
+    }
+    for (std::size_t i = 0; i < N; i++) {
+        Counter block_counter{counter};
+        block_counter.Advance(i);
+        blocks[i] = _mm_shuffle_epi8(_mm_set_epi64x(static_cast<s64>(block_counter.high),
+                                                    static_cast<s64>(block_counter.low)),
+                                     mask);
+    }
+}
+
+/// XOR the key stream with the last, partial block.
+AES_NI_TARGET("aes,sse4.1")
+void TranscodePartialBlock(const u8* src, std::size_t size, u8* dest, __m128i key_stream) {
+    alignas(16) std::array<u8, BlockSize> block{};
+    std::memcpy(block.data(), src, size);
+    _mm_store_si128(reinterpret_cast<__m128i*>(block.data()),
+                    _mm_xor_si128(_mm_load_si128(reinterpret_cast<__m128i*>(block.data())),
+                                  key_stream));
+    std::memcpy(dest, block.data(), size);
+}
+
+AES_NI_TARGET("aes,sse4.1")
+void TranscodeCtrSSE(const __m128i* keys, const u8* src, std::size_t size, u8* dest,
+                     Counter& counter) {
+    const auto* const in{reinterpret_cast<const __m128i*>(src)};
+    auto* const out{reinterpret_cast<__m128i*>(dest)};
+    const std::size_t blocks{size / BlockSize};
+
+    std::size_t i = 0;
+    for (; i + Parallelism <= blocks; i += Parallelism) {
+        __m128i key_stream[Parallelism];
+        MakeCounterBlocks<Parallelism>(counter, key_stream);
+        counter.Advance(Parallelism);
+        CipherBlocks<Op::Encrypt, Parallelism>(keys, key_stream);
+        for (std::size_t j = 0; j < Parallelism; j++) {
+            _mm_storeu_si128(&out[i + j],
+                             _mm_xor_si128(_mm_loadu_si128(&in[i + j]), key_stream[j]));
+        }
+    }
+    for (; i < blocks; i++) {
+        __m128i key_stream;
+        MakeCounterBlocks<1>(counter, &key_stream);
+        counter.Advance(1);
+        CipherBlocks<Op::Encrypt, 1>(keys, &key_stream);
+        _mm_storeu_si128(&out[i], _mm_xor_si128(_mm_loadu_si128(&in[i]), key_stream));
+    }
+
+    if (const std::size_t remaining = size % BlockSize; remaining != 0) {
+        __m128i key_stream;
+        MakeCounterBlocks<1>(counter, &key_stream);
+        counter.Advance(1);
+        CipherBlocks<Op::Encrypt, 1>(keys, &key_stream);
+        TranscodePartialBlock(src + blocks * BlockSize, remaining, dest + blocks * BlockSize,
+                              key_stream);
+    }
+}
+
+AES_NI_TARGET("aes,vaes,avx2")
+void TranscodeCtrVaes(const __m128i* keys, const u8* src, std::size_t size, u8* dest,
+                      Counter& counter) {
+    const auto* const in{reinterpret_cast<const __m256i*>(src)};
+    auto* const out{reinterpret_cast<__m256i*>(dest)};
+    const __m256i mask{_mm256_broadcastsi128_si256(ByteSwapMask())};
+    const std::size_t blocks{size / BlockSize};
+
+    std::size_t i = 0;
+    for (; i + Parallelism <= blocks && counter.low <= ~u64{0} - Parallelism;
+         i += Parallelism) {
+        // Each register holds a counter and the one after it
+        const __m256i base{_mm256_add_epi64(
+            _mm256_set_epi64x(static_cast<s64>(counter.high), static_cast<s64>(counter.low),
+                              static_cast<s64>(counter.high), static_cast<s64>(counter.low)),
+            _mm256_set_epi64x(0, 1, 0, 0))};
+        __m256i key_stream[Parallelism / 2];
+        for (std::size_t j = 0; j < Parallelism / 2; j++) {
+            key_stream[j] = _mm256_shuffle_epi8(
+                _mm256_add_epi64(base, _mm256_set_epi64x(0, 2 * j, 0, 2 * j)), mask);
+        }
+        counter.Advance(Parallelism);
+        CipherBlocksVaes<Op::Encrypt, Parallelism / 2>(keys, key_stream);
+        for (std::size_t j = 0; j < Parallelism / 2; j++) {
+            _mm256_storeu_si256(&out[i / 2 + j],
+                                _mm256_xor_si256(_mm256_loadu_si256(&in[i / 2 + j]),
+                                                 key_stream[j]));
+        }
+    }
+    // The rest, and any blocks where the counter carries, are left to the 128-bit version
+    TranscodeCtrSSE(keys, src + i * BlockSize, size - i * BlockSize, dest + i * BlockSize,
+                    counter);
+}
+
+/// Multiply an XTS tweak by x in GF(2^128), the tweak of the next block.
+AES_NI_TARGET("aes,sse4.1")
+__m128i NextTweak(__m128i tweak) {
+    // Bit 63 carries into bit 64, and bit 127 wraps around as the reduction polynomial
+    const __m128i carries{_mm_shuffle_epi32(_mm_srai_epi32(tweak, 31), _MM_SHUFFLE(2, 1, 0, 3))};
+    return _mm_xor_si128(_mm_slli_epi64(tweak, 1),
+                         _mm_and_si128(carries, _mm_set_epi32(0, 1, 0, 0x87)));
+}
+
+AES_NI_TARGET("aes,sse4.1")
+__m128i TranscodeXtsBlock(const __m128i* keys, Op op, __m128i block, __m128i tweak) {
+    block = _mm_xor_si128(block, tweak);
+    if (op == Op::Encrypt) {
+        CipherBlocks<Op::Encrypt, 1>(keys, &block);
+    } else {
+        CipherBlocks<Op::Decrypt, 1>(keys, &block);
+    }
+    return _mm_xor_si128(block, tweak);
+}
+
+template <Op op>
+AES_NI_TARGET("aes,sse4.1")
+std::size_t TranscodeXtsBlocksSSE(const __m128i* keys, const u8* src, std::size_t blocks,
+                                  u8* dest, __m128i& tweak) {
+    const auto* const in{reinterpret_cast<const __m128i*>(src)};
+    auto* const out{reinterpret_cast<__m128i*>(dest)};
+    std::size_t i = 0;
+    for (; i + Parallelism <= blocks; i += Parallelism) {
+        __m128i tweaks[Parallelism];
+        __m128i state[Parallelism];
+        for (std::size_t j = 0; j < Parallelism; j++) {
+            tweaks[j] = tweak;
+            tweak = NextTweak(tweak);
+            state[j] = _mm_xor_si128(_mm_loadu_si128(&in[i + j]), tweaks[j]);
+        }
+        CipherBlocks<op, Parallelism>(keys, state);
+        for (std::size_t j = 0; j < Parallelism; j++) {
+            _mm_storeu_si128(&out[i + j], _mm_xor_si128(state[j], tweaks[j]));
+        }
+    }
+    return i;
+}
+
+template <Op op>
+AES_NI_TARGET("aes,vaes,avx2")
+std::size_t TranscodeXtsBlocksVaes(const __m128i* keys, const u8* src, std::size_t blocks,
+                                   u8* dest, __m128i& tweak) {
+    const auto* const in{reinterpret_cast<const __m256i*>(src)};
+    auto* const out{reinterpret_cast<__m256i*>(dest)};
+    std::size_t i = 0;
+    for (; i + Parallelism <= blocks; i += Parallelism) {
+        __m256i tweaks[Parallelism / 2];
+        __m256i state[Parallelism / 2];
+        for (std::size_t j = 0; j < Parallelism / 2; j++) {
+            const __m128i next{NextTweak(tweak)};
+            tweaks[j] = _mm256_set_m128i(next, tweak);
+            tweak = NextTweak(next);
+            state[j] = _mm256_xor_si256(_mm256_loadu_si256(&in[i / 2 + j]), tweaks[j]);
+        }
+        CipherBlocksVaes<op, Parallelism / 2>(keys, state);
+        for (std::size_t j = 0; j < Parallelism / 2; j++) {
+            _mm256_storeu_si256(&out[i / 2 + j], _mm256_xor_si256(state[j], tweaks[j]));
+        }
+    }
+    return i;
+}
+
+AES_NI_TARGET("aes,sse4.1")
+void TranscodeXtsDataUnit(const __m128i* keys, const __m128i* tweak_keys, const u8* src,
+                          std::size_t size, u8* dest, const u8* data_unit, Op op, bool vaes) {
+    __m128i tweak{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data_unit))};
+    CipherBlocks<Op::Encrypt, 1>(tweak_keys, &tweak);
+
+    // With a partial last block, the last whole block is done along with it
+    const std::size_t remaining{size % BlockSize};
+    const std::size_t blocks{size / BlockSize - (remaining != 0 ? 1 : 0)};
+
+    std::size_t i = 0;
+    if (vaes) {
+        i = op == Op::Encrypt
+                ? TranscodeXtsBlocksVaes<Op::Encrypt>(keys, src, blocks, dest, tweak)
+                : TranscodeXtsBlocksVaes<Op::Decrypt>(keys, src, blocks, dest, tweak);
+    } else {
+        i = op == Op::Encrypt ? TranscodeXtsBlocksSSE<Op::Encrypt>(keys, src, blocks, dest, tweak)
+                              : TranscodeXtsBlocksSSE<Op::Decrypt>(keys, src, blocks, dest, tweak);
+    }
+    for (; i < blocks; i++) {
+        const auto* const in{reinterpret_cast<const __m128i*>(src) + i};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest) + i,
+                         TranscodeXtsBlock(keys, op, _mm_loadu_si128(in), tweak));
+        tweak = NextTweak(tweak);
+    }
+    if (remaining == 0) {
+        return;
+    }
+
+    // Ciphertext stealing, decryption uses the two tweaks in the opposite order
+    const __m128i next_tweak{NextTweak(tweak)};
+    const __m128i first_tweak{op == Op::Encrypt ? tweak : next_tweak};
+    const __m128i second_tweak{op == Op::Encrypt ? next_tweak : tweak};
+    const u8* const last_src{src + blocks * BlockSize};
+    u8* const last_dest{dest + blocks * BlockSize};
+
+    alignas(16) std::array<u8, BlockSize> first{};
+    _mm_store_si128(reinterpret_cast<__m128i*>(first.data()),
+                    TranscodeXtsBlock(keys, op,
+                                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(last_src)),
+                                      first_tweak));
+    alignas(16) std::array<u8, BlockSize> second{first};
+    std::memcpy(second.data(), last_src + BlockSize, remaining);
+    std::memcpy(last_dest + BlockSize, first.data(), remaining);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(last_dest),
+                     TranscodeXtsBlock(keys, op,
+                                       _mm_load_si128(reinterpret_cast<__m128i*>(second.data())),
+                                       second_tweak));
+}
+
+} // Anonymous namespace
+#endif
+
+bool AesNiCipher::IsSupported() {
+#ifdef ARCHITECTURE_x86_64
+    const auto& caps{Common::GetCPUCaps()};
+    return caps.aes && caps.sse4_1;
+#else
+    return false;
+#endif
+}
+
+bool AesNiCipher::IsVaesSupported() {
+#ifdef ARCHITECTURE_x86_64
+    const auto& caps{Common::GetCPUCaps()};
+    return IsSupported() && caps.vaes && caps.avx2;
+#else
+    return false;
+#endif
+}
+
+AesNiCipher::AesNiCipher(std::span<const u8, BlockSize> key, bool use_vaes) : vaes{use_vaes} {
+#ifdef ARCHITECTURE_x86_64
+    ASSERT(!vaes || IsVaesSupported());
+    ExpandKey(key.data(), encrypt_keys.data(), decrypt_keys.data());
+#else
+    UNREACHABLE_MSG("AES-NI is not supported on this host");
+#endif
+}
+
+void AesNiCipher::TranscodeEcb(const u8* src, std::size_t blocks, u8* dest, Op op) const {
+#ifdef ARCHITECTURE_x86_64
+    const auto* const keys{reinterpret_cast<const __m128i*>(
+        op == Op::Encrypt ? encrypt_keys.data() : decrypt_keys.data())};
+    if (op == Op::Encrypt) {
+        vaes ? TranscodeEcbVaes<Op::Encrypt>(keys, src, blocks, dest)
+             : TranscodeEcbSSE<Op::Encrypt>(keys, src, blocks, dest);
+    } else {
+        vaes ? TranscodeEcbVaes<Op::Decrypt>(keys, src, blocks, dest)
+             : TranscodeEcbSSE<Op::Decrypt>(keys, src, blocks, dest);
+    }
+#else
+    UNREACHABLE_MSG("AES-NI is not supported on this host");
+#endif
+}
+
+void AesNiCipher::TranscodeCtr(const u8* src, std::size_t size, u8* dest,
+                               std::array<u8, BlockSize>& counter) const {
+#ifdef ARCHITECTURE_x86_64
+    const auto* const keys{reinterpret_cast<const __m128i*>(encrypt_keys.data())};
+
+    Counter value{};
+    for (std::size_t i = 0; i < sizeof(u64); i++) {
+        value.high = value.high << 8 | counter[i];
+        value.low = value.low << 8 | counter[sizeof(u64) + i];
+    }
+    vaes ? TranscodeCtrVaes(keys, src, size, dest, value)
+         : TranscodeCtrSSE(keys, src, size, dest, value);
+    for (std::size_t i = 0; i < sizeof(u64); i++) {
+        counter[sizeof(u64) - 1 - i] = static_cast<u8>(value.high >> (i * 8));
+        counter[BlockSize - 1 - i] = static_cast<u8>(value.low >> (i * 8));
+    }
+#else
+    UNREACHABLE_MSG("AES-NI is not supported on this host");
+#endif
+}
+
+bool AesNiCipher::TranscodeXts(const u8* src, std::size_t size, u8* dest,
+                               const AesNiCipher& tweak_cipher,
+                               std::span<const u8, BlockSize> data_unit, Op op) const {
+#ifdef ARCHITECTURE_x86_64
+    if (size < BlockSize || size > MaxXtsSize) {
+        return false;
+    }
+    const auto* const keys{reinterpret_cast<const __m128i*>(
+        op == Op::Encrypt ? encrypt_keys.data() : decrypt_keys.data())};
+    const auto* const tweak_keys{
+        reinterpret_cast<const __m128i*>(tweak_cipher.encrypt_keys.data())};
+    TranscodeXtsDataUnit(keys, tweak_keys, src, size, dest, data_unit.data(), op, vaes);
+    return true;
+#else
+    UNREACHABLE_MSG("AES-NI is not supported on this host");
+#endif
+}
+
+} // namespace Core::Crypto
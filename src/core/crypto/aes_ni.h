@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+#include "common/common_types.h"
+#include "core/crypto/aes_util.h"
+
+namespace Core::Crypto {
+
+/**
+ * AES-128 using the AES-NI instructions of the host, for the modes game content is encrypted
+ * with. Blocks are processed eight at a time so the AES rounds of independent blocks overlap,
+ * two to a register when using VAES.
+ *
+ * Every mode gives the same results as mbedtls, including for partial blocks, so AESCipher can
+ * use either.
+ */
+class AesNiCipher {
+public:
+    static constexpr std::size_t BlockSize = 0x10;
+    static constexpr std::size_t NumRounds = 10;
+
+    /// Check if the host supports the instructions this needs.
+    static bool IsSupported();
+
+    /// Check if the host also supports VAES, to process two blocks to a register.
+    static bool IsVaesSupported();
+
+    /**
+     * Expand a key for the cipher.
+     *
+     * @param key      - The key.
+     * @param use_vaes - Whether to use VAES, must be supported by the host.
+     */
+    AesNiCipher(std::span<const u8, 0x10> key, bool use_vaes);
+
+    /**
+     * Encrypt or decrypt whole blocks in ECB mode.
+     *
+     * @param src    - Source blocks.
+     * @param blocks - Number of blocks.
+     * @param dest   - Destination blocks, may be the same as the source.
+     * @param op     - Whether to encrypt or decrypt.
+     */
+    void TranscodeEcb(const u8* src, std::size_t blocks, u8* dest, Op op) const;
+
+    /**
+     * Encrypt or decrypt in CTR mode.
+     *
+     * @param src     - Source data.
+     * @param size    - Size of the data in bytes, a partial last block uses a whole counter.
+     * @param dest    - Destination data, may be the same as the source.
+     * @param counter - Big-endian counter of the first block, advanced past the last block.
+     */
+    void TranscodeCtr(const u8* src, std::size_t size, u8* dest,
+                      std::array<u8, BlockSize>& counter) const;
+
+    /**
+     * Encrypt or decrypt a data unit in XTS mode, stealing ciphertext for a partial last block.
+     *
+     * @param src          - Source data.
+     * @param size         - Size of the data in bytes, at least one block and at most 16MiB.
+     * @param dest         - Destination data, may be the same as the source.
+     * @param tweak_cipher - Cipher keyed with the tweak key.
+     * @param data_unit    - Data unit the tweak is calculated from.
+     * @param op           - Whether to encrypt or decrypt.
+     * @return True if the data was transcoded, false if the size was invalid.
+     */
+    bool TranscodeXts(const u8* src, std::size_t size, u8* dest,
+                      const AesNiCipher& tweak_cipher, std::span<const u8, BlockSize> data_unit,
+                      Op op) const;
+
+private:
+    alignas(16) std::array<u8, (NumRounds + 1) * BlockSize> encrypt_keys{};
+    alignas(16) std::array<u8, (NumRounds + 1) * BlockSize> decrypt_keys{};
+    bool vaes{};
+};
+
+} // namespace Core::Crypto
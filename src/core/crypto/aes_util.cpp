@@ -2,9 +2,13 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <cstring>
+#include <optional>
+#include <vector>
 #include <mbedtls/cipher.h>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "core/crypto/aes_ni.h"
 #include "core/crypto/aes_util.h"
 #include "core/crypto/key_manager.h"
 
@@ -36,13 +40,55 @@ static_assert(static_cast<std::size_t>(Mode::XTS) ==
 struct CipherContext {
     mbedtls_cipher_context_t encryption_context;
     mbedtls_cipher_context_t decryption_context;
+
+    // Used instead of mbedtls when the host supports AES-NI, which then keeps its own IVs
+    std::optional<AesNiCipher> native_cipher;
+    std::optional<AesNiCipher> native_tweak_cipher;
+    Mode mode;
+    std::array<u8, AesNiCipher::BlockSize> encryption_iv{};
+    std::array<u8, AesNiCipher::BlockSize> decryption_iv{};
 };
 
+std::span<const AesBackend> GetSupportedAesBackends() {
+    static const std::vector<AesBackend> backends = [] {
+        std::vector<AesBackend> supported{AesBackend::Mbedtls};
+        if (AesNiCipher::IsSupported()) {
+            supported.push_back(AesBackend::AesNi);
+        }
+        if (AesNiCipher::IsVaesSupported()) {
+            supported.push_back(AesBackend::Vaes);
+        }
+        return supported;
+    }();
+    return backends;
+}
+
 template <typename Key, std::size_t KeySize>
 Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode)
+    : AESCipher(key, mode, GetSupportedAesBackends().back()) {}
+
+template <typename Key, std::size_t KeySize>
+Crypto::AESCipher<Key, KeySize>::AESCipher(Key key, Mode mode, AesBackend backend)
     : ctx(std::make_unique<CipherContext>()) {
     mbedtls_cipher_init(&ctx->encryption_context);
     mbedtls_cipher_init(&ctx->decryption_context);
+    ctx->mode = mode;
+
+    // mbedtls is only set up when AES-NI isn't used for the key
+    if (backend != AesBackend::Mbedtls) {
+        const std::span<const u8> key_data{key};
+        const bool use_vaes{backend == AesBackend::Vaes};
+        // XTS keys are the data key followed by the tweak key
+        if (mode == Mode::XTS && KeySize == 0x20) {
+            ctx->native_cipher.emplace(key_data.first<0x10>(), use_vaes);
+            ctx->native_tweak_cipher.emplace(key_data.last<0x10>(), use_vaes);
+            return;
+        }
+        if (mode != Mode::XTS && KeySize == 0x10) {
+            ctx->native_cipher.emplace(key_data.first<0x10>(), use_vaes);
+            return;
+        }
+    }
 
     ASSERT_MSG((mbedtls_cipher_setup(
                     &ctx->encryption_context,
@@ -67,6 +113,11 @@ AESCipher<Key, KeySize>::~AESCipher() {
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* dest, Op op) const {
+    if (ctx->native_cipher) {
+        TranscodeNative(src, size, dest, op);
+        return;
+    }
+
     auto* const context = op == Op::Encrypt ? &ctx->encryption_context : &ctx->decryption_context;
 
     mbedtls_cipher_reset(context);
@@ -106,6 +157,45 @@ void AESCipher<Key, KeySize>::Transcode(const u8* src, std::size_t size, u8* des
     }
 }
 
+template <typename Key, std::size_t KeySize>
+void AESCipher<Key, KeySize>::TranscodeNative(const u8* src, std::size_t size, u8* dest,
+                                              Op op) const {
+    auto& iv = op == Op::Encrypt ? ctx->encryption_iv : ctx->decryption_iv;
+
+    switch (ctx->mode) {
+    case Mode::CTR:
+        // As with mbedtls, a transcode uses at least one counter, even if it is empty
+        if (size == 0) {
+            std::array<u8, AesNiCipher::BlockSize> block{};
+            ctx->native_cipher->TranscodeCtr(block.data(), block.size(), block.data(), iv);
+            return;
+        }
+        ctx->native_cipher->TranscodeCtr(src, size, dest, iv);
+        break;
+    case Mode::ECB: {
+        // A partial last block is padded with zeroes, as with mbedtls
+        const std::size_t blocks = size / AesNiCipher::BlockSize;
+        const std::size_t remaining = size % AesNiCipher::BlockSize;
+        ctx->native_cipher->TranscodeEcb(src, blocks, dest, op);
+        if (remaining != 0) {
+            const std::size_t offset = blocks * AesNiCipher::BlockSize;
+            std::array<u8, AesNiCipher::BlockSize> block{};
+            std::memcpy(block.data(), src + offset, remaining);
+            ctx->native_cipher->TranscodeEcb(block.data(), 1, block.data(), op);
+            std::memcpy(dest + offset, block.data(), remaining);
+        }
+        break;
+    }
+    case Mode::XTS:
+        if (!ctx->native_cipher->TranscodeXts(src, size, dest, *ctx->native_tweak_cipher, iv,
+                                              op)) {
+            LOG_WARNING(Crypto, "Not all data was decrypted requested={:016X}, actual={:016X}.",
+                        size, 0);
+        }
+        break;
+    }
+}
+
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8* dest,
                                            std::size_t sector_id, std::size_t sector_size, Op op) {
@@ -119,6 +209,16 @@ void AESCipher<Key, KeySize>::XTSTranscode(const u8* src, std::size_t size, u8*
 
 template <typename Key, std::size_t KeySize>
 void AESCipher<Key, KeySize>::SetIV(std::span<const u8> data) {
+    if (ctx->native_cipher) {
+        // ECB has no IV, so it is ignored like mbedtls does
+        if (ctx->mode != Mode::ECB) {
+            ASSERT_MSG(data.size() == AesNiCipher::BlockSize, "Failed to set IV on AES-NI cipher.");
+            std::memcpy(ctx->encryption_iv.data(), data.data(), data.size());
+            std::memcpy(ctx->decryption_iv.data(), data.data(), data.size());
+        }
+        return;
+    }
+
     ASSERT_MSG((mbedtls_cipher_set_iv(&ctx->encryption_context, data.data(), data.size()) ||
                 mbedtls_cipher_set_iv(&ctx->decryption_context, data.data(), data.size())) == 0,
                "Failed to set IV on mbedtls ciphers.");
@@ -24,6 +24,22 @@ enum class Op {
     Decrypt,
 };
 
+/// Implementations the ciphers can run on.
+enum class AesBackend : u8 {
+    Mbedtls,
+    /// AES-NI, with SSE registers
+    AesNi,
+    /// AES-NI, with VAES processing two blocks to a register
+    Vaes,
+};
+
+/**
+ * Get the backends the host can run.
+ *
+ * @return The supported backends, mbedtls first and the fastest one last.
+ */
+std::span<const AesBackend> GetSupportedAesBackends();
+
 template <typename Key, std::size_t KeySize = sizeof(Key)>
 class AESCipher {
     static_assert(std::is_same_v<Key, std::array<u8, KeySize>>, "Key must be std::array of u8.");
@@ -31,6 +47,13 @@ class AESCipher {
 
 public:
     AESCipher(Key key, Mode mode);
+
+    /**
+     * Create a cipher running on a given backend, which must be supported by the host. Keys and
+     * modes AES-NI doesn't implement use mbedtls whatever the backend.
+     */
+    AESCipher(Key key, Mode mode, AesBackend backend);
+
     ~AESCipher();
 
     void SetIV(std::span<const u8> data);
@@ -57,6 +80,8 @@ public:
                       std::size_t sector_size, Op op);
 
 private:
+    void TranscodeNative(const u8* src, std::size_t size, u8* dest, Op op) const;
+
     std::unique_ptr<CipherContext> ctx;
 };
 } // namespace Core::Crypto
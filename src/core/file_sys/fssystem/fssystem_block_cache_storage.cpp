@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/alignment.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+
+namespace FileSys {
+
+BlockCache& BlockCache::GetInstance() {
+    static BlockCache instance;
+    return instance;
+}
+
+bool BlockCache::Read(u64 storage_id, s64 block_offset, size_t offset, std::span<u8> out) {
+    const Key key{storage_id, block_offset};
+    auto& shard = this->GetShard(key);
+    {
+        std::scoped_lock lk{shard.mutex};
+        const auto it = shard.map.find(key);
+        if (it != shard.map.end() && offset + out.size() <= it->second->data.size()) {
+            // Move the block to the front of the LRU list.
+            shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+            std::memcpy(out.data(), it->second->data.data() + offset, out.size());
+            if (it->second->prefetched) {
+                it->second->prefetched = false;
+                m_prefetch_used_blocks.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            m_bytes_saved.fetch_add(out.size(), std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+bool BlockCache::Contains(u64 storage_id, s64 block_offset) {
+    const Key key{storage_id, block_offset};
+    auto& shard = this->GetShard(key);
+    std::scoped_lock lk{shard.mutex};
+    return shard.map.contains(key);
+}
+
+void BlockCache::Insert(u64 storage_id, s64 block_offset, std::span<const u8> data,
+                        bool prefetched) {
+    ASSERT(Common::IsAligned(block_offset, BlockSize));
+    ASSERT(data.size() <= BlockSize);
+
+    const Key key{storage_id, block_offset};
+    auto& shard = this->GetShard(key);
+    std::scoped_lock lk{shard.mutex};
+
+    // Another thread may have read the block at the same time.
+    if (const auto it = shard.map.find(key); it != shard.map.end()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, it->second);
+        return;
+    }
+
+    shard.entries.push_front(Entry{key, std::vector<u8>(data.begin(), data.end()), prefetched});
+    shard.map.emplace(key, shard.entries.begin());
+    shard.size += data.size();
+    m_cached_bytes.fetch_add(data.size(), std::memory_order_relaxed);
+    if (prefetched) {
+        m_prefetched_blocks.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Evict the least recently used blocks.
+    while (shard.size > CapacityPerShard) {
+        this->Erase(shard, std::prev(shard.entries.end()));
+    }
+}
+
+void BlockCache::Invalidate(u64 storage_id) {
+    for (auto& shard : m_shards) {
+        std::scoped_lock lk{shard.mutex};
+        for (auto it = shard.entries.begin(); it != shard.entries.end();) {
+            const auto next = std::next(it);
+            if (it->key.storage_id == storage_id) {
+                this->Erase(shard, it);
+            }
+            it = next;
+        }
+    }
+}
+
+void BlockCache::Erase(Shard& shard, std::list<Entry>::iterator it) {
+    shard.size -= it->data.size();
+    m_cached_bytes.fetch_sub(it->data.size(), std::memory_order_relaxed);
+    if (it->prefetched) {
+        m_prefetch_wasted_bytes.fetch_add(it->data.size(), std::memory_order_relaxed);
+    }
+    shard.map.erase(it->key);
+    shard.entries.erase(it);
+}
+
+BlockCache::Statistics BlockCache::GetStatistics() const {
+    return {
+        .hits = m_hits.load(std::memory_order_relaxed),
+        .misses = m_misses.load(std::memory_order_relaxed),
+        .bytes_saved = m_bytes_saved.load(std::memory_order_relaxed),
+        .cached_bytes = m_cached_bytes.load(std::memory_order_relaxed),
+        .prefetched_blocks = m_prefetched_blocks.load(std::memory_order_relaxed),
+        .prefetch_used_blocks = m_prefetch_used_blocks.load(std::memory_order_relaxed),
+        .prefetch_wasted_bytes = m_prefetch_wasted_bytes.load(std::memory_order_relaxed),
+    };
+}
+
+BlockCacheStorage::BlockCacheStorage(VirtualFile base, BlockCache& cache)
+    : m_base_storage(std::move(base)), m_cache(cache), m_storage_id(cache.AllocateStorageId()),
+      m_size(m_base_storage->GetSize()) {}
+
+BlockCacheStorage::~BlockCacheStorage() {
+    m_cache.Invalidate(m_storage_id);
+}
+
+size_t BlockCacheStorage::Read(u8* buffer, size_t size, size_t offset) const {
+    // Allow zero-size reads.
+    if (size == 0 || offset >= m_size) {
+        return 0;
+    }
+
+    // Ensure buffer is valid.
+    ASSERT(buffer != nullptr);
+
+    // Large reads go straight to the base storage.
+    size = std::min(size, m_size - offset);
+    if (size > MaxCachedReadSize) {
+        std::scoped_lock lk{m_mutex};
+        return m_base_storage->Read(buffer, size, offset);
+    }
+
+    // Copy cached blocks, reading runs of blocks which aren't cached at once. A short read of
+    // the base storage ends the read there, so that only the bytes copied are reported.
+    const size_t end = offset + size;
+    size_t missing_offset = 0;
+    size_t missing_count = 0;
+    size_t copied = size;
+    const auto read_missing = [&] {
+        const size_t run_size =
+            std::min(missing_count * BlockCache::BlockSize, m_size - missing_offset);
+        const size_t read = this->ReadBlocks(buffer, size, offset,
+                                             static_cast<s64>(missing_offset), missing_count,
+                                             false);
+        missing_count = 0;
+        if (read < run_size) {
+            copied = std::max(offset, missing_offset + read) - offset;
+            return false;
+        }
+        return true;
+    };
+    for (size_t block = Common::AlignDown(offset, BlockCache::BlockSize); block < end;
+         block += BlockCache::BlockSize) {
+        const size_t cur_offset = std::max(offset, block);
+        const size_t cur_size = std::min(end, block + BlockCache::BlockSize) - cur_offset;
+        if (!m_cache.Read(m_storage_id, static_cast<s64>(block), cur_offset - block,
+                          std::span(buffer + (cur_offset - offset), cur_size))) {
+            if (missing_count++ == 0) {
+                missing_offset = block;
+            }
+            continue;
+        }
+
+        if (missing_count != 0 && !read_missing()) {
+            return copied;
+        }
+    }
+    if (missing_count != 0) {
+        read_missing();
+    }
+
+    return copied;
+}
+
+size_t BlockCacheStorage::GetSize() const {
+    return m_size;
+}
+
+void BlockCacheStorage::Prefetch(size_t offset, size_t size) const {
+    if (offset >= m_size) {
+        return;
+    }
+
+    // Read runs of blocks which aren't cached, without copying them anywhere.
+    constexpr size_t MaxRunBlocks = MaxCachedReadSize / BlockCache::BlockSize;
+    const size_t end = offset + std::min(size, m_size - offset);
+    s64 missing_offset = -1;
+    size_t missing_count = 0;
+    for (size_t block = Common::AlignDown(offset, BlockCache::BlockSize); block < end;
+         block += BlockCache::BlockSize) {
+        const bool cached = m_cache.Contains(m_storage_id, static_cast<s64>(block));
+        if (missing_count != 0 && (cached || missing_count == MaxRunBlocks)) {
+            this->ReadBlocks(nullptr, 0, 0, missing_offset, missing_count, true);
+            missing_count = 0;
+        }
+        if (!cached && missing_count++ == 0) {
+            missing_offset = static_cast<s64>(block);
+        }
+    }
+    if (missing_count != 0) {
+        this->ReadBlocks(nullptr, 0, 0, missing_offset, missing_count, true);
+    }
+}
+
+size_t BlockCacheStorage::ReadBlocks(u8* buffer, size_t size, size_t offset, s64 block_offset,
+                                     size_t block_count, bool prefetched) const {
+    const size_t read_offset = static_cast<size_t>(block_offset);
+    const size_t read_size =
+        std::min(block_count * BlockCache::BlockSize, m_size - read_offset);
+
+    // Read the blocks into a pooled buffer.
+    PooledBuffer pooled_buffer(read_size, read_size);
+    u8* const blocks = reinterpret_cast<u8*>(pooled_buffer.GetBuffer());
+    size_t read;
+    {
+        std::scoped_lock lk{m_mutex};
+        read = m_base_storage->Read(blocks, read_size, read_offset);
+    }
+
+    // Cache the blocks which were read whole.
+    for (size_t cur = 0; cur < read; cur += BlockCache::BlockSize) {
+        const size_t cur_size = std::min(BlockCache::BlockSize, read_size - cur);
+        if (cur + cur_size > read) {
+            break;
+        }
+        m_cache.Insert(m_storage_id, static_cast<s64>(read_offset + cur),
+                       std::span(blocks + cur, cur_size), prefetched);
+    }
+
+    // Copy the part of the request the blocks hold.
+    const size_t copy_begin = std::max(offset, read_offset);
+    const size_t copy_end = std::min(offset + size, read_offset + read);
+    if (copy_begin < copy_end) {
+        std::memcpy(buffer + (copy_begin - offset), blocks + (copy_begin - read_offset),
+                    copy_end - copy_begin);
+    }
+    return read;
+}
+
+} // namespace FileSys
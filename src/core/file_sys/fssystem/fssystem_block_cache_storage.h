@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "core/file_sys/fssystem/fs_i_storage.h"
+#include "core/file_sys/fssystem/fssystem_pooled_buffer.h"
+
+namespace FileSys {
+
+/**
+ * Blocks read from the storages of NCAs after they were decrypted and verified, shared by all of
+ * them and bounded in size. Blocks are keyed by the identity of their storage and their aligned
+ * offset in it, and spread over shards with their own lock and LRU list so that reads on
+ * different threads rarely wait on each other.
+ */
+class BlockCache {
+    CITRON_NON_COPYABLE(BlockCache);
+    CITRON_NON_MOVEABLE(BlockCache);
+
+public:
+    static constexpr size_t BlockSize = 16_KiB;
+    static constexpr size_t NumShards = 16;
+    static constexpr size_t CapacityPerShard = 4_MiB;
+
+    struct Statistics {
+        u64 hits;
+        u64 misses;
+        /// Bytes read from the cache instead of the storages below it
+        u64 bytes_saved;
+        u64 cached_bytes;
+        u64 prefetched_blocks;
+        /// Prefetched blocks which were read before being evicted
+        u64 prefetch_used_blocks;
+        /// Bytes of prefetched blocks evicted without being read
+        u64 prefetch_wasted_bytes;
+    };
+
+public:
+    BlockCache() = default;
+
+    static BlockCache& GetInstance();
+
+    /// Get an identity for a new storage, never reused.
+    u64 AllocateStorageId() {
+        return m_next_storage_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Copy part of a cached block.
+     *
+     * @param storage_id   - Identity of the storage of the block.
+     * @param block_offset - Offset of the block in the storage, aligned to BlockSize.
+     * @param offset       - Offset in the block to copy from.
+     * @param out          - Output buffer, the size of which is copied.
+     * @return True if the block was cached and holds the requested range.
+     */
+    bool Read(u64 storage_id, s64 block_offset, size_t offset, std::span<u8> out);
+
+    /// Check if a block is cached, without counting it as a read.
+    bool Contains(u64 storage_id, s64 block_offset);
+
+    /**
+     * Cache a block, evicting the least recently used blocks of its shard as needed.
+     *
+     * @param storage_id   - Identity of the storage of the block.
+     * @param block_offset - Offset of the block in the storage, aligned to BlockSize.
+     * @param data         - Data of the block, only shorter than BlockSize at the end of the
+     *                       storage.
+     * @param prefetched   - Whether the block was read ahead of the reads which need it.
+     */
+    void Insert(u64 storage_id, s64 block_offset, std::span<const u8> data,
+                bool prefetched = false);
+
+    /// Drop the blocks of a storage.
+    void Invalidate(u64 storage_id);
+
+    Statistics GetStatistics() const;
+
+private:
+    struct Key {
+        u64 storage_id;
+        s64 block_offset;
+
+        bool operator==(const Key&) const = default;
+    };
+
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            return std::hash<u64>{}(key.storage_id * 0x9E3779B97F4A7C15ULL ^
+                                    static_cast<u64>(key.block_offset));
+        }
+    };
+
+    struct Entry {
+        Key key;
+        std::vector<u8> data;
+        bool prefetched;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        /// Most recently used first
+        std::list<Entry> entries;
+        std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> map;
+        size_t size{};
+    };
+
+    Shard& GetShard(const Key& key) {
+        return m_shards[KeyHash{}(key) % NumShards];
+    }
+
+    void Erase(Shard& shard, std::list<Entry>::iterator it);
+
+private:
+    std::array<Shard, NumShards> m_shards;
+    std::atomic<u64> m_next_storage_id{1};
+    std::atomic<u64> m_hits{};
+    std::atomic<u64> m_misses{};
+    std::atomic<u64> m_bytes_saved{};
+    std::atomic<u64> m_cached_bytes{};
+    std::atomic<u64> m_prefetched_blocks{};
+    std::atomic<u64> m_prefetch_used_blocks{};
+    std::atomic<u64> m_prefetch_wasted_bytes{};
+};
+
+/**
+ * Storage reading its base storage through the block cache. Reads larger than MaxCachedReadSize
+ * are mostly streaming, so they bypass the cache rather than evict everything else from it.
+ *
+ * The storages below are not safe to read from several threads, so reads of the base storage
+ * are serialized, letting blocks be prefetched on other threads.
+ */
+class BlockCacheStorage : public IReadOnlyStorage {
+    CITRON_NON_COPYABLE(BlockCacheStorage);
+    CITRON_NON_MOVEABLE(BlockCacheStorage);
+
+public:
+    static constexpr size_t MaxCachedReadSize = 256_KiB;
+
+public:
+    explicit BlockCacheStorage(VirtualFile base, BlockCache& cache = BlockCache::GetInstance());
+    virtual ~BlockCacheStorage() override;
+
+    virtual size_t Read(u8* buffer, size_t size, size_t offset) const override;
+    virtual size_t GetSize() const override;
+
+    /// Read the blocks of a range which aren't cached into the cache.
+    void Prefetch(size_t offset, size_t size) const;
+
+private:
+    /// Read blocks which aren't cached from the base storage and cache them.
+    size_t ReadBlocks(u8* buffer, size_t size, size_t offset, s64 block_offset,
+                      size_t block_count, bool prefetched) const;
+
+private:
+    VirtualFile m_base_storage;
+    mutable std::mutex m_mutex;
+    BlockCache& m_cache;
+    const u64 m_storage_id;
+    const size_t m_size;
+};
+
+} // namespace FileSys
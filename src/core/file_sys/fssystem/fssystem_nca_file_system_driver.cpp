@@ -5,6 +5,7 @@
 #include "core/file_sys/fssystem/fssystem_aes_ctr_storage.h"
 #include "core/file_sys/fssystem/fssystem_aes_xts_storage.h"
 #include "core/file_sys/fssystem/fssystem_alignment_matching_storage.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
 #include "core/file_sys/fssystem/fssystem_compressed_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_integrity_verification_storage.h"
 #include "core/file_sys/fssystem/fssystem_hierarchical_sha256_storage.h"
@@ -311,6 +312,9 @@ Result NcaFileSystemDriver::CreateStorageByRawStorage(VirtualFile* out,
         R_THROW(ResultInvalidNcaFsHeaderHashType);
     }
 
+    // Cache the decrypted and verified blocks.
+    storage = std::make_shared<BlockCacheStorage>(std::move(storage));
+
     // Process compression layer.
     if (header_reader->ExistsCompressionLayer()) {
         R_TRY(this->CreateCompressedStorage(
@@ -0,0 +1,231 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+
+#include <fmt/format.h>
+
+#include "common/container_hash.h"
+#include "common/fs/file.h"
+#include "common/fs/path_util.h"
+#include "common/logging/log.h"
+#include "core/arm/debug.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/guest_profiler.h"
+#include "core/hle/kernel/k_process.h"
+#include "core/hle/kernel/k_thread.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/physical_core.h"
+
+namespace Core {
+
+namespace {
+
+// Slightly off 1 kHz, so the samples don't line up with work done at a fixed rate by the guest
+constexpr std::chrono::nanoseconds SAMPLE_INTERVAL{std::chrono::microseconds{997}};
+
+// Frames past this depth are dropped, deep stacks are mostly recursion
+constexpr std::size_t MAX_STACK_DEPTH = 64;
+
+// Number of entries listed in the log summary
+constexpr std::size_t NUM_TOP_SYMBOLS = 15;
+constexpr std::size_t NUM_TOP_MODULES = 5;
+
+std::string FrameName(const BacktraceEntry& entry) {
+    std::string name = entry.name.empty() ? fmt::format("{}+{:#x}", entry.module, entry.offset)
+                                          : fmt::format("{}!{}", entry.module, entry.name);
+    // Semicolons separate the frames of a collapsed stack
+    std::ranges::replace(name, ';', ':');
+    return name;
+}
+
+template <typename Map>
+std::vector<std::pair<std::string, u64>> TopEntries(const Map& counts, std::size_t count) {
+    std::vector<std::pair<std::string, u64>> entries(counts.begin(), counts.end());
+    std::ranges::sort(entries, [](const auto& lhs, const auto& rhs) {
+        return lhs.second > rhs.second;
+    });
+    entries.resize(std::min(entries.size(), count));
+    return entries;
+}
+
+} // Anonymous namespace
+
+std::size_t GuestProfiler::StackHash::operator()(const std::vector<u64>& stack) const {
+    std::size_t seed = stack.size();
+    for (const u64 address : stack) {
+        Common::HashCombine(seed, address);
+    }
+    return seed;
+}
+
+GuestProfiler::GuestProfiler(System& system_) : system{system_} {
+    sample_event = Timing::CreateEvent(
+        "GuestProfiler::Sample",
+        [this](s64 time,
+               std::chrono::nanoseconds ns_late) -> std::optional<std::chrono::nanoseconds> {
+            auto& kernel = system.Kernel();
+            for (std::size_t core = 0; core < Hardware::NUM_CPU_CORES; ++core) {
+                if (!kernel.PhysicalCore(core).RequestSample()) {
+                    idle_samples[core].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return std::nullopt;
+        });
+}
+
+GuestProfiler::~GuestProfiler() = default;
+
+void GuestProfiler::Start(u64 program_id_) {
+    if (is_running) {
+        return;
+    }
+    if (!system.Kernel().IsMulticore()) {
+        LOG_WARNING(Core, "The guest profiler needs multicore emulation, not starting it");
+        return;
+    }
+
+    program_id = program_id_;
+    for (std::size_t core = 0; core < Hardware::NUM_CPU_CORES; ++core) {
+        std::scoped_lock lock{cores[core].lock};
+        cores[core].stacks.clear();
+        cores[core].other_process = 0;
+        idle_samples[core] = 0;
+    }
+    is_running = true;
+    system.CoreTiming().ScheduleLoopingEvent(SAMPLE_INTERVAL, SAMPLE_INTERVAL, sample_event);
+    LOG_INFO(Core, "Guest profiler started for program {:016X}", program_id);
+}
+
+void GuestProfiler::Stop() {
+    if (!is_running) {
+        return;
+    }
+    system.CoreTiming().UnscheduleEvent(sample_event);
+    is_running = false;
+    WriteReport();
+}
+
+void GuestProfiler::RecordSample(std::size_t core_index, const Kernel::KThread& thread,
+                                 const Kernel::Svc::ThreadContext& ctx) {
+    if (!IsRunning()) {
+        return;
+    }
+
+    CoreSamples& samples = cores[core_index];
+    Kernel::KProcess* const process = thread.GetOwnerProcess();
+    if (process == nullptr || process != system.ApplicationProcess()) {
+        std::scoped_lock lock{samples.lock};
+        ++samples.other_process;
+        return;
+    }
+
+    std::vector<u64> stack = GetBacktraceAddresses(process, ctx, MAX_STACK_DEPTH);
+    if (stack.empty()) {
+        return;
+    }
+    // Past its prologue, the frame record of a function holds the same return address as lr
+    if (stack.size() > 2 && stack[1] == stack[2]) {
+        stack.erase(stack.begin() + 2);
+    }
+
+    std::scoped_lock lock{samples.lock};
+    ++samples.stacks[std::move(stack)];
+}
+
+void GuestProfiler::WriteReport() {
+    Kernel::KProcess* const process = system.ApplicationProcess();
+
+    std::unordered_map<std::vector<u64>, u64, StackHash> stacks;
+    u64 other_process = 0;
+    u64 idle = 0;
+    for (std::size_t core = 0; core < Hardware::NUM_CPU_CORES; ++core) {
+        std::scoped_lock lock{cores[core].lock};
+        for (auto& [stack, count] : cores[core].stacks) {
+            stacks[stack] += count;
+        }
+        cores[core].stacks.clear();
+        other_process += cores[core].other_process;
+        idle += idle_samples[core].load(std::memory_order_relaxed);
+    }
+    if (process == nullptr || stacks.empty()) {
+        LOG_INFO(Core, "Guest profiler stopped without application samples");
+        return;
+    }
+
+    // Symbolize every distinct frame once. Return addresses point past the call, look up the
+    // call instruction instead so tail positions don't land in the next function.
+    std::map<u64, std::size_t> frame_indices;
+    for (const auto& [stack, count] : stacks) {
+        for (std::size_t depth = 0; depth < stack.size(); ++depth) {
+            frame_indices.try_emplace(depth == 0 ? stack[depth] : stack[depth] - 4, 0);
+        }
+    }
+    std::vector<BacktraceEntry> entries;
+    entries.reserve(frame_indices.size());
+    for (auto& [address, index] : frame_indices) {
+        index = entries.size();
+        entries.push_back({"", 0, address, 0, ""});
+    }
+    SymbolicateBacktrace(process, entries);
+
+    std::vector<std::string> frame_names;
+    frame_names.reserve(entries.size());
+    for (const BacktraceEntry& entry : entries) {
+        frame_names.push_back(FrameName(entry));
+    }
+
+    // Stacks that only differ by their addresses within a function are merged
+    std::map<std::string, u64> folded;
+    std::unordered_map<std::string, u64> self_symbols;
+    std::unordered_map<std::string, u64> self_modules;
+    u64 total = 0;
+    for (const auto& [stack, count] : stacks) {
+        std::string line;
+        for (std::size_t depth = stack.size(); depth-- > 0;) {
+            const u64 address = depth == 0 ? stack[depth] : stack[depth] - 4;
+            if (!line.empty()) {
+                line += ';';
+            }
+            line += frame_names[frame_indices.at(address)];
+        }
+        folded[line] += count;
+
+        const std::size_t leaf = frame_indices.at(stack[0]);
+        self_symbols[frame_names[leaf]] += count;
+        self_modules[entries[leaf].module] += count;
+        total += count;
+    }
+
+    std::string report;
+    for (const auto& [line, count] : folded) {
+        report += fmt::format("{} {}\n", line, count);
+    }
+    const auto path = Common::FS::GetCitronPath(Common::FS::CitronPath::LogDir) /
+                      fmt::format("guest_profile_{:016X}.folded", program_id);
+    if (Common::FS::WriteStringToFile(path, Common::FS::FileType::TextFile, report) !=
+        report.size()) {
+        LOG_ERROR(Core, "Failed to write the guest profile to {}", path.string());
+        return;
+    }
+
+    LOG_INFO(Core,
+             "Guest profile written to {}: {} application samples, {} from other processes, "
+             "{} while idle",
+             path.string(), total, other_process, idle);
+    const auto percent = [total](u64 count) {
+        return 100.0 * static_cast<double>(count) / static_cast<double>(total);
+    };
+    for (const auto& [name, count] : TopEntries(self_modules, NUM_TOP_MODULES)) {
+        LOG_INFO(Core, "  {:6.2f}% {}", percent(count), name);
+    }
+    for (const auto& [name, count] : TopEntries(self_symbols, NUM_TOP_SYMBOLS)) {
+        LOG_INFO(Core, "  {:6.2f}% {}", percent(count), name);
+    }
+}
+
+} // namespace Core
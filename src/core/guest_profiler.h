@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/hardware_properties.h"
+
+namespace Core {
+class System;
+}
+
+namespace Core::Timing {
+struct EventType;
+}
+
+namespace Kernel {
+class KThread;
+}
+
+namespace Kernel::Svc {
+struct ThreadContext;
+}
+
+namespace Core {
+
+/**
+ * Statistical profiler of the guest application. While running, the emulated cores are halted at
+ * a fixed rate and the call stack of the thread each of them was running is recorded. When
+ * stopped, the stacks are symbolized and written to the log directory in the collapsed stack
+ * format, which flamegraph tools read directly.
+ */
+class GuestProfiler {
+public:
+    explicit GuestProfiler(System& system_);
+    ~GuestProfiler();
+
+    /// Starts sampling the cores, the report is named after the given program.
+    void Start(u64 program_id_);
+
+    /// Stops sampling and writes the report of the samples taken so far.
+    void Stop();
+
+    [[nodiscard]] bool IsRunning() const {
+        return is_running.load(std::memory_order_relaxed);
+    }
+
+    /// Records the context of the thread a core was halted in. Called from the core thread.
+    void RecordSample(std::size_t core_index, const Kernel::KThread& thread,
+                      const Kernel::Svc::ThreadContext& ctx);
+
+private:
+    struct StackHash {
+        std::size_t operator()(const std::vector<u64>& stack) const;
+    };
+
+    struct CoreSamples {
+        std::mutex lock;
+        /// Number of samples of each call stack, leaf first
+        std::unordered_map<std::vector<u64>, u64, StackHash> stacks;
+        /// Samples taken while the core ran another process than the application
+        u64 other_process{};
+    };
+
+    void WriteReport();
+
+    System& system;
+    std::shared_ptr<Timing::EventType> sample_event;
+    std::atomic<bool> is_running{};
+    u64 program_id{};
+
+    std::array<CoreSamples, Hardware::NUM_CPU_CORES> cores{};
+    /// Samples taken while the core was not running guest code
+    std::array<std::atomic<u64>, Hardware::NUM_CPU_CORES> idle_samples{};
+};
+
+} // namespace Core
@@ -0,0 +1,350 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <thread>
+#include <tuple>
+
+#include <nlohmann/json.hpp>
+
+#include "core/hle/kernel/call_statistics.h"
+#include "core/hle/kernel/svc.h"
+
+namespace Kernel {
+
+namespace {
+
+std::size_t BucketOf(u64 ns) {
+    return std::min<std::size_t>(std::bit_width(ns), CallStatistics::NUM_BUCKETS - 1);
+}
+
+nlohmann::json HistogramToJson(const CallStatistics::Histogram& histogram) {
+    return {
+        {"count", histogram.count},
+        {"total_ns", histogram.total_ns},
+        {"max_ns", histogram.max_ns},
+        {"p50_ns", histogram.Percentile(0.5)},
+        {"p99_ns", histogram.Percentile(0.99)},
+        {"buckets", histogram.buckets},
+    };
+}
+
+} // Anonymous namespace
+
+void CallStatistics::Histogram::Add(u64 ns) {
+    ++count;
+    total_ns += ns;
+    max_ns = std::max(max_ns, ns);
+    ++buckets[BucketOf(ns)];
+}
+
+void CallStatistics::Histogram::Merge(const Histogram& other) {
+    count += other.count;
+    total_ns += other.total_ns;
+    max_ns = std::max(max_ns, other.max_ns);
+    for (std::size_t i = 0; i < NUM_BUCKETS; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+}
+
+u64 CallStatistics::Histogram::Percentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    const u64 target =
+        std::max<u64>(1, static_cast<u64>(std::ceil(static_cast<double>(count) * fraction)));
+    u64 seen = 0;
+    for (std::size_t i = 0; i < NUM_BUCKETS - 1; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            return std::min(u64{1} << i, max_ns);
+        }
+    }
+    return max_ns;
+}
+
+void CallStatistics::AtomicHistogram::Add(u64 ns) {
+    // There is a single writer, plain stores are enough to keep readers from tearing values
+    const auto bump = [](std::atomic<u64>& value, u64 amount) {
+        value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    };
+    bump(count, 1);
+    bump(total_ns, ns);
+    if (ns > max_ns.load(std::memory_order_relaxed)) {
+        max_ns.store(ns, std::memory_order_relaxed);
+    }
+    bump(buckets[BucketOf(ns)], 1);
+}
+
+void CallStatistics::AtomicHistogram::Load(Histogram& out) const {
+    out.count = count.load(std::memory_order_relaxed);
+    out.total_ns = total_ns.load(std::memory_order_relaxed);
+    out.max_ns = max_ns.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < NUM_BUCKETS; ++i) {
+        out.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+}
+
+void CallStatistics::AtomicHistogram::Clear() {
+    count.store(0, std::memory_order_relaxed);
+    total_ns.store(0, std::memory_order_relaxed);
+    max_ns.store(0, std::memory_order_relaxed);
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+CallStatistics::CallStatistics() {
+    for (auto& buffer : svc_buffers) {
+        buffer = std::make_unique<SvcBuffer>();
+    }
+}
+
+CallStatistics::~CallStatistics() = default;
+
+u64 CallStatistics::Now() {
+    return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now().time_since_epoch())
+                                .count());
+}
+
+void CallStatistics::RecordSvc(std::size_t core_index, u32 svc_id, u64 begin_ns) {
+    if (begin_ns == 0 || svc_id >= NUM_SVC_IDS) {
+        return;
+    }
+    svc_buffers[core_index]->svcs[svc_id].Add(Now() - begin_ns);
+}
+
+void CallStatistics::RecordIpc(std::string_view service, u32 command, const char* function,
+                               u64 begin_ns) {
+    if (begin_ns == 0) {
+        return;
+    }
+    const u64 elapsed = Now() - begin_ns;
+    const std::size_t index =
+        std::hash<std::thread::id>{}(std::this_thread::get_id()) % NUM_IPC_BUFFERS;
+    IpcBuffer& buffer = ipc_buffers[index];
+
+    std::scoped_lock lk{buffer.lock};
+    auto service_it = buffer.services.find(service);
+    if (service_it == buffer.services.end()) {
+        service_it = buffer.services.try_emplace(std::string{service}).first;
+    }
+    IpcCommand& entry = service_it->second[command];
+    entry.function = function;
+    entry.latency.Add(elapsed);
+}
+
+CallStatistics::Snapshot CallStatistics::Collect() const {
+    Snapshot snapshot;
+    for (u32 id = 0; id < NUM_SVC_IDS; ++id) {
+        Histogram latency;
+        for (const auto& buffer : svc_buffers) {
+            Histogram core_latency;
+            buffer->svcs[id].Load(core_latency);
+            latency.Merge(core_latency);
+        }
+        if (latency.count != 0) {
+            snapshot.svcs.push_back({id, GetSvcName(id), latency});
+        }
+    }
+
+    std::map<std::pair<std::string, u32>, IpcCommand> commands;
+    for (const IpcBuffer& buffer : ipc_buffers) {
+        std::scoped_lock lk{buffer.lock};
+        for (const auto& [service, service_commands] : buffer.services) {
+            for (const auto& [command, entry] : service_commands) {
+                IpcCommand& merged = commands[{service, command}];
+                merged.function = entry.function;
+                merged.latency.Merge(entry.latency);
+            }
+        }
+    }
+    for (const auto& [key, entry] : commands) {
+        snapshot.commands.push_back({
+            .service = key.first,
+            .command = key.second,
+            .function = entry.function ? entry.function : "",
+            .latency = entry.latency,
+        });
+    }
+    return snapshot;
+}
+
+void CallStatistics::Reset() {
+    for (auto& buffer : svc_buffers) {
+        for (auto& svc : buffer->svcs) {
+            svc.Clear();
+        }
+    }
+    for (IpcBuffer& buffer : ipc_buffers) {
+        std::scoped_lock lk{buffer.lock};
+        buffer.services.clear();
+    }
+}
+
+std::string CallStatistics::ToJson(const Snapshot& snapshot) {
+    nlohmann::json svcs = nlohmann::json::array();
+    for (const SvcEntry& svc : snapshot.svcs) {
+        nlohmann::json entry = HistogramToJson(svc.latency);
+        entry["id"] = svc.id;
+        entry["name"] = svc.name;
+        svcs.push_back(std::move(entry));
+    }
+    nlohmann::json commands = nlohmann::json::array();
+    for (const IpcEntry& command : snapshot.commands) {
+        nlohmann::json entry = HistogramToJson(command.latency);
+        entry["service"] = command.service;
+        entry["command"] = command.command;
+        entry["function"] = command.function;
+        commands.push_back(std::move(entry));
+    }
+    const nlohmann::json json{
+        {"bucket_bounds", "bucket i holds latencies in [2^(i-1), 2^i) ns"},
+        {"svc", std::move(svcs)},
+        {"ipc", std::move(commands)},
+    };
+    return json.dump(4);
+}
+
+const char* CallStatistics::GetSvcName(u32 svc_id) {
+#define SVC_NAME(name)                                                                             \
+    case Svc::SvcId::name:                                                                         \
+        return #name;
+
+    switch (static_cast<Svc::SvcId>(svc_id)) {
+        SVC_NAME(SetHeapSize)
+        SVC_NAME(SetMemoryPermission)
+        SVC_NAME(SetMemoryAttribute)
+        SVC_NAME(MapMemory)
+        SVC_NAME(UnmapMemory)
+        SVC_NAME(QueryMemory)
+        SVC_NAME(ExitProcess)
+        SVC_NAME(CreateThread)
+        SVC_NAME(StartThread)
+        SVC_NAME(ExitThread)
+        SVC_NAME(SleepThread)
+        SVC_NAME(GetThreadPriority)
+        SVC_NAME(SetThreadPriority)
+        SVC_NAME(GetThreadCoreMask)
+        SVC_NAME(SetThreadCoreMask)
+        SVC_NAME(GetCurrentProcessorNumber)
+        SVC_NAME(SignalEvent)
+        SVC_NAME(ClearEvent)
+        SVC_NAME(MapSharedMemory)
+        SVC_NAME(UnmapSharedMemory)
+        SVC_NAME(CreateTransferMemory)
+        SVC_NAME(CloseHandle)
+        SVC_NAME(ResetSignal)
+        SVC_NAME(WaitSynchronization)
+        SVC_NAME(CancelSynchronization)
+        SVC_NAME(ArbitrateLock)
+        SVC_NAME(ArbitrateUnlock)
+        SVC_NAME(WaitProcessWideKeyAtomic)
+        SVC_NAME(SignalProcessWideKey)
+        SVC_NAME(GetSystemTick)
+        SVC_NAME(ConnectToNamedPort)
+        SVC_NAME(SendSyncRequestLight)
+        SVC_NAME(SendSyncRequest)
+        SVC_NAME(SendSyncRequestWithUserBuffer)
+        SVC_NAME(SendAsyncRequestWithUserBuffer)
+        SVC_NAME(GetProcessId)
+        SVC_NAME(GetThreadId)
+        SVC_NAME(Break)
+        SVC_NAME(OutputDebugString)
+        SVC_NAME(ReturnFromException)
+        SVC_NAME(GetInfo)
+        SVC_NAME(FlushEntireDataCache)
+        SVC_NAME(FlushDataCache)
+        SVC_NAME(MapPhysicalMemory)
+        SVC_NAME(UnmapPhysicalMemory)
+        SVC_NAME(GetDebugFutureThreadInfo)
+        SVC_NAME(GetLastThreadInfo)
+        SVC_NAME(GetResourceLimitLimitValue)
+        SVC_NAME(GetResourceLimitCurrentValue)
+        SVC_NAME(SetThreadActivity)
+        SVC_NAME(GetThreadContext3)
+        SVC_NAME(WaitForAddress)
+        SVC_NAME(SignalToAddress)
+        SVC_NAME(SynchronizePreemptionState)
+        SVC_NAME(GetResourceLimitPeakValue)
+        SVC_NAME(CreateIoPool)
+        SVC_NAME(CreateIoRegion)
+        SVC_NAME(KernelDebug)
+        SVC_NAME(ChangeKernelTraceState)
+        SVC_NAME(CreateSession)
+        SVC_NAME(AcceptSession)
+        SVC_NAME(ReplyAndReceiveLight)
+        SVC_NAME(ReplyAndReceive)
+        SVC_NAME(ReplyAndReceiveWithUserBuffer)
+        SVC_NAME(CreateEvent)
+        SVC_NAME(MapIoRegion)
+        SVC_NAME(UnmapIoRegion)
+        SVC_NAME(MapPhysicalMemoryUnsafe)
+        SVC_NAME(UnmapPhysicalMemoryUnsafe)
+        SVC_NAME(SetUnsafeLimit)
+        SVC_NAME(CreateCodeMemory)
+        SVC_NAME(ControlCodeMemory)
+        SVC_NAME(SleepSystem)
+        SVC_NAME(ReadWriteRegister)
+        SVC_NAME(SetProcessActivity)
+        SVC_NAME(CreateSharedMemory)
+        SVC_NAME(MapTransferMemory)
+        SVC_NAME(UnmapTransferMemory)
+        SVC_NAME(CreateInterruptEvent)
+        SVC_NAME(QueryPhysicalAddress)
+        SVC_NAME(QueryIoMapping)
+        SVC_NAME(CreateDeviceAddressSpace)
+        SVC_NAME(AttachDeviceAddressSpace)
+        SVC_NAME(DetachDeviceAddressSpace)
+        SVC_NAME(MapDeviceAddressSpaceByForce)
+        SVC_NAME(MapDeviceAddressSpaceAligned)
+        SVC_NAME(UnmapDeviceAddressSpace)
+        SVC_NAME(InvalidateProcessDataCache)
+        SVC_NAME(StoreProcessDataCache)
+        SVC_NAME(FlushProcessDataCache)
+        SVC_NAME(DebugActiveProcess)
+        SVC_NAME(BreakDebugProcess)
+        SVC_NAME(TerminateDebugProcess)
+        SVC_NAME(GetDebugEvent)
+        SVC_NAME(ContinueDebugEvent)
+        SVC_NAME(GetProcessList)
+        SVC_NAME(GetThreadList)
+        SVC_NAME(GetDebugThreadContext)
+        SVC_NAME(SetDebugThreadContext)
+        SVC_NAME(QueryDebugProcessMemory)
+        SVC_NAME(ReadDebugProcessMemory)
+        SVC_NAME(WriteDebugProcessMemory)
+        SVC_NAME(SetHardwareBreakPoint)
+        SVC_NAME(GetDebugThreadParam)
+        SVC_NAME(GetSystemInfo)
+        SVC_NAME(CreatePort)
+        SVC_NAME(ManageNamedPort)
+        SVC_NAME(ConnectToPort)
+        SVC_NAME(SetProcessMemoryPermission)
+        SVC_NAME(MapProcessMemory)
+        SVC_NAME(UnmapProcessMemory)
+        SVC_NAME(QueryProcessMemory)
+        SVC_NAME(MapProcessCodeMemory)
+        SVC_NAME(UnmapProcessCodeMemory)
+        SVC_NAME(CreateProcess)
+        SVC_NAME(StartProcess)
+        SVC_NAME(TerminateProcess)
+        SVC_NAME(GetProcessInfo)
+        SVC_NAME(CreateResourceLimit)
+        SVC_NAME(SetResourceLimitLimitValue)
+        SVC_NAME(CallSecureMonitor)
+        SVC_NAME(MapInsecureMemory)
+        SVC_NAME(UnmapInsecureMemory)
+    default:
+        return "Unknown";
+    }
+
+#undef SVC_NAME
+}
+
+} // namespace Kernel
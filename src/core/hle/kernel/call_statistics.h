@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/hardware_properties.h"
+
+namespace Kernel {
+
+/**
+ * Counts and times the supervisor calls made by the guest and the IPC commands handled by the HLE
+ * services. Latencies are kept in log2 histograms.
+ *
+ * Supervisor calls are recorded in per-core buffers, each written only by the host thread running
+ * that core. IPC commands are recorded in buffers picked by host thread, as they are handled from
+ * both host and guest service threads. The buffers are merged when a snapshot is taken.
+ */
+class CallStatistics {
+public:
+    /// Bucket i holds latencies in [2^(i-1), 2^i) ns, the last one everything above.
+    static constexpr std::size_t NUM_BUCKETS = 32;
+    static constexpr std::size_t NUM_SVC_IDS = 0x100;
+
+    struct Histogram {
+        u64 count{};
+        u64 total_ns{};
+        u64 max_ns{};
+        std::array<u64, NUM_BUCKETS> buckets{};
+
+        void Add(u64 ns);
+        void Merge(const Histogram& other);
+
+        /// Upper bound of the latency the given fraction of the calls stays under.
+        u64 Percentile(double fraction) const;
+    };
+
+    struct SvcEntry {
+        u32 id;
+        const char* name;
+        Histogram latency;
+    };
+
+    struct IpcEntry {
+        std::string service;
+        u32 command;
+        std::string function;
+        Histogram latency;
+    };
+
+    struct Snapshot {
+        std::vector<SvcEntry> svcs;
+        std::vector<IpcEntry> commands;
+    };
+
+    explicit CallStatistics();
+    ~CallStatistics();
+
+    void SetEnabled(bool enabled_) {
+        enabled.store(enabled_, std::memory_order_relaxed);
+    }
+
+    bool IsEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /// Returns the start time of a call, or zero when nothing is being recorded.
+    u64 BeginCall() const {
+        return IsEnabled() ? Now() : 0;
+    }
+
+    void RecordSvc(std::size_t core_index, u32 svc_id, u64 begin_ns);
+    void RecordIpc(std::string_view service, u32 command, const char* function, u64 begin_ns);
+
+    /// Merges the buffers of every core and thread.
+    Snapshot Collect() const;
+
+    void Reset();
+
+    /// Serializes a snapshot to JSON, the latencies are in nanoseconds.
+    static std::string ToJson(const Snapshot& snapshot);
+
+    static const char* GetSvcName(u32 svc_id);
+
+private:
+    static constexpr std::size_t NUM_IPC_BUFFERS = 16;
+
+    /// Histogram written by a single thread and read by any.
+    struct AtomicHistogram {
+        std::atomic<u64> count{};
+        std::atomic<u64> total_ns{};
+        std::atomic<u64> max_ns{};
+        std::array<std::atomic<u64>, NUM_BUCKETS> buckets{};
+
+        void Add(u64 ns);
+        void Load(Histogram& out) const;
+        void Clear();
+    };
+
+    struct SvcBuffer {
+        std::array<AtomicHistogram, NUM_SVC_IDS> svcs;
+    };
+
+    struct IpcCommand {
+        const char* function{};
+        Histogram latency;
+    };
+
+    struct StringHash {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view value) const {
+            return std::hash<std::string_view>{}(value);
+        }
+    };
+
+    struct alignas(64) IpcBuffer {
+        mutable std::mutex lock;
+        std::unordered_map<std::string, std::unordered_map<u32, IpcCommand>, StringHash,
+                           std::equal_to<>>
+            services;
+    };
+
+    static u64 Now();
+
+    std::atomic<bool> enabled{};
+    std::array<std::unique_ptr<SvcBuffer>, Core::Hardware::NUM_CPU_CORES> svc_buffers;
+    std::array<IpcBuffer, NUM_IPC_BUFFERS> ipc_buffers;
+};
+
+} // namespace Kernel
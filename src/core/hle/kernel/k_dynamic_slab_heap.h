@@ -55,7 +55,7 @@ public:
             ASSERT(allocated != nullptr);
 
             for (size_t i = 0; i < sizeof(PageBuffer) / sizeof(T); i++) {
-                KSlabHeapImpl::Free(allocated + i);
+                KSlabHeapImpl::Free(allocated + i, HostMagazine);
             }
 
             m_count += sizeof(PageBuffer) / sizeof(T);
@@ -63,7 +63,7 @@ public:
     }
 
     T* Allocate(KDynamicPageManager* page_allocator) {
-        T* allocated = static_cast<T*>(KSlabHeapImpl::Allocate());
+        T* allocated = static_cast<T*>(KSlabHeapImpl::Allocate(HostMagazine));
 
         // If we successfully allocated and we should clear the node, do so.
         if constexpr (ClearNode) {
@@ -79,7 +79,7 @@ public:
                 if (allocated != nullptr) {
                     // If we succeeded in getting a page, free the rest to our slab.
                     for (size_t i = 1; i < sizeof(PageBuffer) / sizeof(T); i++) {
-                        KSlabHeapImpl::Free(allocated + i);
+                        KSlabHeapImpl::Free(allocated + i, HostMagazine);
                     }
                     m_count += sizeof(PageBuffer) / sizeof(T);
                 }
@@ -104,7 +104,7 @@ public:
     }
 
     void Free(T* t) {
-        KSlabHeapImpl::Free(t);
+        KSlabHeapImpl::Free(t, HostMagazine);
         --m_used;
     }
 
@@ -3,13 +3,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <mutex>
 
 #include "common/assert.h"
 #include "common/atomic_ops.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/spin_lock.h"
+#include "core/hardware_properties.h"
 
 namespace Kernel {
 
@@ -17,6 +21,9 @@ class KernelCore;
 
 namespace impl {
 
+// Returns the emulated core the calling thread runs, or a value past the cores for other threads.
+size_t GetCurrentSlabHeapCore(KernelCore& kernel);
+
 class KSlabHeapImpl {
     CITRON_NON_COPYABLE(KSlabHeapImpl);
     CITRON_NON_MOVEABLE(KSlabHeapImpl);
@@ -26,6 +33,20 @@ public:
         Node* next{};
     };
 
+    struct Statistics {
+        u64 allocations{};
+        u64 frees{};
+        // Batches moved from the shared list to a magazine, and back.
+        u64 refills{};
+        u64 drains{};
+        // Times the shared list was found locked by another thread.
+        u64 contentions{};
+    };
+
+public:
+    // Magazine index of the host threads that don't run an emulated core.
+    static constexpr size_t HostMagazine = Core::Hardware::NUM_CPU_CORES;
+
 public:
     constexpr KSlabHeapImpl() = default;
 
@@ -33,39 +54,169 @@ public:
         ASSERT(m_head == nullptr);
     }
 
+    // Places magazines in front of the shared list, sized for a heap of the given object count.
+    // Heaps too small to spare objects for every magazine keep using the shared list alone.
+    void InitializeMagazines(size_t num_objects) {
+        m_batch_size = std::min(MaxBatchSize, num_objects / (NumMagazines * 4));
+    }
+
     Node* GetHead() const {
         return m_head;
     }
 
-    void* Allocate() {
+    void* Allocate(size_t core_id) {
+        // KScopedInterruptDisable di;
+
+        {
+            Magazine& magazine = this->GetMagazine(core_id);
+            std::scoped_lock lk{magazine.lock};
+            ++magazine.stats.allocations;
+
+            if (m_batch_size == 0) {
+                this->LockShared(magazine);
+                Node* ret = this->PopShared();
+                m_lock.unlock();
+                return ret;
+            }
+
+            if (magazine.count == 0) {
+                this->Refill(magazine);
+            }
+            if (magazine.count != 0) [[likely]] {
+                return magazine.objects[--magazine.count];
+            }
+        }
+
+        // The shared list is empty, but other magazines may still hold objects.
+        this->FlushMagazines();
+
+        std::scoped_lock lk{m_lock};
+        return this->PopShared();
+    }
+
+    void Free(void* obj, size_t core_id) {
         // KScopedInterruptDisable di;
 
-        m_lock.lock();
+        Node* node = static_cast<Node*>(obj);
+        Magazine& magazine = this->GetMagazine(core_id);
+        std::scoped_lock lk{magazine.lock};
+        ++magazine.stats.frees;
+
+        if (m_batch_size == 0) {
+            node->next = nullptr;
+            this->LockShared(magazine);
+            this->PushShared(node, node);
+            m_lock.unlock();
+            return;
+        }
+
+        if (magazine.count == m_batch_size * 2) {
+            this->Drain(magazine);
+        }
+        magazine.objects[magazine.count++] = node;
+    }
+
+    Statistics GetStatistics() const {
+        Statistics total{};
+        for (const Magazine& magazine : m_magazines) {
+            std::scoped_lock lk{magazine.lock};
+            total.allocations += magazine.stats.allocations;
+            total.frees += magazine.stats.frees;
+            total.refills += magazine.stats.refills;
+            total.drains += magazine.stats.drains;
+            total.contentions += magazine.stats.contentions;
+        }
+        return total;
+    }
+
+private:
+    static constexpr size_t NumMagazines = HostMagazine + 1;
+    static constexpr size_t MaxBatchSize = 16;
+
+    // Per-core cache of free objects. Each emulated core gets its own magazine, and only reaches
+    // the shared list once per batch. The host threads share the last one.
+    struct alignas(64) Magazine {
+        mutable Common::SpinLock lock;
+        size_t count{};
+        std::array<Node*, MaxBatchSize * 2> objects{};
+        Statistics stats{};
+    };
+
+    Magazine& GetMagazine(size_t core_id) {
+        return m_magazines[std::min(core_id, HostMagazine)];
+    }
+
+    void LockShared(Magazine& magazine) {
+        if (!m_lock.try_lock()) {
+            ++magazine.stats.contentions;
+            m_lock.lock();
+        }
+    }
 
+    Node* PopShared() {
         Node* ret = m_head;
         if (ret != nullptr) [[likely]] {
             m_head = ret->next;
         }
-
-        m_lock.unlock();
         return ret;
     }
 
-    void Free(void* obj) {
-        // KScopedInterruptDisable di;
+    void PushShared(Node* first, Node* last) {
+        last->next = m_head;
+        m_head = first;
+    }
 
-        m_lock.lock();
+    void Refill(Magazine& magazine) {
+        this->LockShared(magazine);
+        while (magazine.count < m_batch_size) {
+            Node* node = this->PopShared();
+            if (node == nullptr) {
+                break;
+            }
+            magazine.objects[magazine.count++] = node;
+        }
+        m_lock.unlock();
+        ++magazine.stats.refills;
+    }
 
-        Node* node = static_cast<Node*>(obj);
-        node->next = m_head;
-        m_head = node;
+    void Drain(Magazine& magazine) {
+        // Return the objects freed first, the last ones are the most likely to be in cache.
+        Node* const first = magazine.objects[0];
+        for (size_t i = 1; i < m_batch_size; ++i) {
+            magazine.objects[i - 1]->next = magazine.objects[i];
+        }
+        Node* const last = magazine.objects[m_batch_size - 1];
+        std::copy(magazine.objects.begin() + m_batch_size,
+                  magazine.objects.begin() + magazine.count, magazine.objects.begin());
+        magazine.count -= m_batch_size;
 
+        this->LockShared(magazine);
+        this->PushShared(first, last);
         m_lock.unlock();
+        ++magazine.stats.drains;
+    }
+
+    void FlushMagazines() {
+        for (Magazine& magazine : m_magazines) {
+            std::scoped_lock lk{magazine.lock};
+            if (magazine.count == 0) {
+                continue;
+            }
+            for (size_t i = 1; i < magazine.count; ++i) {
+                magazine.objects[i - 1]->next = magazine.objects[i];
+            }
+            this->LockShared(magazine);
+            this->PushShared(magazine.objects[0], magazine.objects[magazine.count - 1]);
+            m_lock.unlock();
+            magazine.count = 0;
+        }
     }
 
 private:
     std::atomic<Node*> m_head{};
     Common::SpinLock m_lock;
+    size_t m_batch_size{};
+    std::array<Magazine, NumMagazines> m_magazines{};
 };
 
 } // namespace impl
@@ -121,8 +272,11 @@ public:
 
         for (size_t i = 0; i < num_obj; i++) {
             cur -= obj_size;
-            KSlabHeapImpl::Free(cur);
+            KSlabHeapImpl::Free(cur, HostMagazine);
         }
+
+        // Start caching objects per thread once they are all in the shared list.
+        KSlabHeapImpl::InitializeMagazines(num_obj);
     }
 
     size_t GetSlabHeapSize() const {
@@ -133,17 +287,17 @@ public:
         return m_obj_size;
     }
 
-    void* Allocate() {
-        void* obj = KSlabHeapImpl::Allocate();
+    void* Allocate(size_t core_id) {
+        void* obj = KSlabHeapImpl::Allocate(core_id);
 
         return obj;
     }
 
-    void Free(void* obj) {
+    void Free(void* obj, size_t core_id) {
         // Don't allow freeing an object that wasn't allocated from this heap.
         const bool contained = this->Contains(reinterpret_cast<uintptr_t>(obj));
         ASSERT(contained);
-        KSlabHeapImpl::Free(obj);
+        KSlabHeapImpl::Free(obj, core_id);
     }
 
     size_t GetObjectIndex(const void* obj) const {
@@ -164,6 +318,10 @@ public:
         return m_start;
     }
 
+    Statistics GetStatistics() const {
+        return KSlabHeapImpl::GetStatistics();
+    }
+
     size_t GetNumRemaining() const {
         // Only calculate the number of remaining objects under debug configuration.
         return 0;
@@ -183,7 +341,7 @@ public:
     }
 
     T* Allocate() {
-        T* obj = static_cast<T*>(BaseHeap::Allocate());
+        T* obj = static_cast<T*>(BaseHeap::Allocate(HostMagazine));
 
         if (obj != nullptr) [[likely]] {
             std::construct_at(obj);
@@ -192,7 +350,7 @@ public:
     }
 
     T* Allocate(KernelCore& kernel) {
-        T* obj = static_cast<T*>(BaseHeap::Allocate());
+        T* obj = static_cast<T*>(BaseHeap::Allocate(impl::GetCurrentSlabHeapCore(kernel)));
 
         if (obj != nullptr) [[likely]] {
             std::construct_at(obj, kernel);
@@ -201,7 +359,11 @@ public:
     }
 
     void Free(T* obj) {
-        BaseHeap::Free(obj);
+        BaseHeap::Free(obj, HostMagazine);
+    }
+
+    void Free(KernelCore& kernel, T* obj) {
+        BaseHeap::Free(obj, impl::GetCurrentSlabHeapCore(kernel));
     }
 
     size_t GetObjectIndex(const T* obj) const {
@@ -22,6 +22,7 @@
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
 #include "core/hardware_properties.h"
+#include "core/hle/kernel/call_statistics.h"
 #include "core/hle/kernel/init/init_slab_setup.h"
 #include "core/hle/kernel/k_client_port.h"
 #include "core/hle/kernel/k_dynamic_resource_manager.h"
@@ -70,6 +71,7 @@ struct KernelCore::Impl {
         global_scheduler_context = std::make_unique<Kernel::GlobalSchedulerContext>(kernel);
 
         is_phantom_mode_for_singlecore = false;
+        are_services_closed = false;
 
         // Derive the initial memory layout from the emulated board
         Init::InitializeSlabResourceCounts(kernel);
@@ -186,6 +188,7 @@ struct KernelCore::Impl {
     void CloseServices() {
         // Ensures all servers gracefully shutdown.
         std::scoped_lock lk{server_lock};
+        are_services_closed = true;
         server_managers.clear();
     }
 
@@ -798,6 +801,8 @@ struct KernelCore::Impl {
     std::unordered_set<KAutoObject*> registered_in_use_objects;
 
     std::mutex server_lock;
+    /// Services still starting up after the servers were closed don't run
+    bool are_services_closed{};
     std::vector<std::unique_ptr<Service::ServerManager>> server_managers;
 
     std::array<std::unique_ptr<Kernel::PhysicalCore>, Core::Hardware::NUM_CPU_CORES> cores;
@@ -842,6 +847,8 @@ struct KernelCore::Impl {
 
     std::array<u64, Core::Hardware::NUM_CPU_CORES> svc_ticks{};
 
+    CallStatistics call_statistics;
+
     KWorkerTaskManager worker_task_manager;
 
     // System context
@@ -1003,7 +1010,7 @@ void KernelCore::RunServer(std::unique_ptr<Service::ServerManager>&& server_mana
 
     {
         std::scoped_lock lk{impl->server_lock};
-        if (impl->is_shutting_down) {
+        if (impl->is_shutting_down || impl->are_services_closed) {
             return;
         }
 
@@ -1061,6 +1068,7 @@ static std::jthread RunHostThreadFunc(KernelCore& kernel, KProcess* process,
         [&kernel, thread, thread_name_{std::move(thread_name)}, func_{std::move(func)}] {
             // Set the thread name.
             Common::SetCurrentThreadName(thread_name_.c_str());
+            Common::SetCurrentThreadRole(Common::ThreadRole::Service);
 
             // Set the thread as current.
             kernel.RegisterHostThread(thread);
@@ -1102,10 +1110,32 @@ std::jthread KernelCore::RunOnHostCoreThread(std::string&& thread_name,
     return RunHostThreadFunc(*this, process, std::move(thread_name), std::move(func));
 }
 
-void KernelCore::RunOnGuestCoreProcess(std::string&& process_name, std::function<void()> func) {
+static void RunGuestThreadFunc(KernelCore& kernel, KProcess* process,
+                               std::function<void()>&& func) {
     constexpr s32 ServiceThreadPriority = 16;
     constexpr s32 ServiceThreadCore = 3;
 
+    // Reserve a new thread from the process resource limit.
+    KScopedResourceReservation thread_reservation(process, LimitableResource::ThreadCountMax);
+    ASSERT(thread_reservation.Succeeded());
+
+    // Initialize the thread.
+    KThread* thread = KThread::Create(kernel);
+    ASSERT(R_SUCCEEDED(KThread::InitializeServiceThread(kernel.System(), thread, std::move(func),
+                                                        ServiceThreadPriority, ServiceThreadCore,
+                                                        process)));
+
+    // Commit the thread reservation.
+    thread_reservation.Commit();
+
+    // Register the new thread.
+    KThread::Register(kernel, thread);
+
+    // Begin running the thread.
+    ASSERT(R_SUCCEEDED(thread->Run()));
+}
+
+void KernelCore::RunOnGuestCoreProcess(std::string&& process_name, std::function<void()> func) {
     // Make a new process.
     KProcess* process = KProcess::Create(*this);
     ASSERT(R_SUCCEEDED(
@@ -1119,23 +1149,16 @@ void KernelCore::RunOnGuestCoreProcess(std::string&& process_name, std::function
     // Register the new process.
     KProcess::Register(*this, process);
 
-    // Reserve a new thread from the process resource limit.
-    KScopedResourceReservation thread_reservation(process, LimitableResource::ThreadCountMax);
-    ASSERT(thread_reservation.Succeeded());
-
-    // Initialize the thread.
-    KThread* thread = KThread::Create(*this);
-    ASSERT(R_SUCCEEDED(KThread::InitializeServiceThread(
-        System(), thread, std::move(func), ServiceThreadPriority, ServiceThreadCore, process)));
-
-    // Commit the thread reservation.
-    thread_reservation.Commit();
+    // Run the guest thread.
+    RunGuestThreadFunc(*this, process, std::move(func));
+}
 
-    // Register the new thread.
-    KThread::Register(*this, thread);
+void KernelCore::RunOnGuestCoreThread(std::function<void()> func) {
+    // Get the current process.
+    KProcess* process = GetCurrentProcessPointer(*this);
 
-    // Begin running the thread.
-    ASSERT(R_SUCCEEDED(thread->Run()));
+    // Run the guest thread.
+    RunGuestThreadFunc(*this, process, std::move(func));
 }
 
 u32 KernelCore::GetCurrentHostThreadID() const {
@@ -1286,6 +1309,10 @@ void KernelCore::ExitSVCProfile() {
     MicroProfileLeave(MICROPROFILE_TOKEN(Kernel_SVC), impl->svc_ticks[CurrentPhysicalCoreIndex()]);
 }
 
+CallStatistics& KernelCore::GetCallStatistics() {
+    return impl->call_statistics;
+}
+
 Init::KSlabResourceCounts& KernelCore::SlabResourceCounts() {
     return impl->slab_resource_counts;
 }
@@ -1346,6 +1373,10 @@ struct KernelCore::SlabHeapContainer {
     KSlabHeap<KDebug> debug;
 };
 
+size_t impl::GetCurrentSlabHeapCore(KernelCore& kernel) {
+    return kernel.GetCurrentHostThreadID();
+}
+
 template <typename T>
 KSlabHeap<T>& KernelCore::SlabHeap() {
     if constexpr (std::is_same_v<T, KClientSession>) {
@@ -1415,4 +1446,31 @@ template KSlabHeap<KThread::LockWithPriorityInheritanceInfo>& KernelCore::SlabHe
 template KSlabHeap<KEventInfo>& KernelCore::SlabHeap();
 template KSlabHeap<KDebug>& KernelCore::SlabHeap();
 
+std::vector<KernelCore::SlabHeapStatistics> KernelCore::GetSlabHeapStatistics() const {
+    const SlabHeapContainer& heaps = *slab_heap_container;
+    return {
+        {"KClientSession", heaps.client_session.GetStatistics()},
+        {"KEvent", heaps.event.GetStatistics()},
+        {"KPort", heaps.port.GetStatistics()},
+        {"KProcess", heaps.process.GetStatistics()},
+        {"KResourceLimit", heaps.resource_limit.GetStatistics()},
+        {"KSession", heaps.session.GetStatistics()},
+        {"KLightSession", heaps.light_session.GetStatistics()},
+        {"KSharedMemory", heaps.shared_memory.GetStatistics()},
+        {"KSharedMemoryInfo", heaps.shared_memory_info.GetStatistics()},
+        {"KThread", heaps.thread.GetStatistics()},
+        {"KTransferMemory", heaps.transfer_memory.GetStatistics()},
+        {"KCodeMemory", heaps.code_memory.GetStatistics()},
+        {"KDeviceAddressSpace", heaps.device_address_space.GetStatistics()},
+        {"KPageBuffer", heaps.page_buffer.GetStatistics()},
+        {"KThreadLocalPage", heaps.thread_local_page.GetStatistics()},
+        {"KObjectName", heaps.object_name.GetStatistics()},
+        {"KSessionRequest", heaps.session_request.GetStatistics()},
+        {"KSecureSystemResource", heaps.secure_system_resource.GetStatistics()},
+        {"LockWithPriorityInheritanceInfo", heaps.lock_info.GetStatistics()},
+        {"KEventInfo", heaps.event_info.GetStatistics()},
+        {"KDebug", heaps.debug.GetStatistics()},
+    };
+}
+
 } // namespace Kernel
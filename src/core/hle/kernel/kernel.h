@@ -8,6 +8,7 @@
 #include <list>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -38,6 +39,7 @@ class ServiceManager;
 
 namespace Kernel {
 
+class CallStatistics;
 class KClientPort;
 class GlobalSchedulerContext;
 class KAutoObjectWithListContainer;
@@ -209,6 +211,8 @@ public:
 
     void RunOnGuestCoreProcess(std::string&& process_name, std::function<void()> func);
 
+    void RunOnGuestCoreThread(std::function<void()> func);
+
     std::jthread RunOnHostCoreProcess(std::string&& process_name, std::function<void()> func);
 
     std::jthread RunOnHostCoreThread(std::string&& thread_name, std::function<void()> func);
@@ -275,6 +279,9 @@ public:
 
     void ExitSVCProfile();
 
+    /// Gets the counters and latencies of the supervisor calls and IPC commands.
+    CallStatistics& GetCallStatistics();
+
     /// Workaround for single-core mode when preempting threads while idle.
     bool IsPhantomModeForSingleCore() const;
     void SetIsPhantomModeForSingleCore(bool value);
@@ -286,6 +293,14 @@ public:
     template <typename T>
     KSlabHeap<T>& SlabHeap();
 
+    struct SlabHeapStatistics {
+        std::string_view name;
+        impl::KSlabHeapImpl::Statistics statistics;
+    };
+
+    /// Gets the allocation counters of the slab heap of each kernel object type.
+    std::vector<SlabHeapStatistics> GetSlabHeapStatistics() const;
+
     /// Gets the current slab resource counts.
     Init::KSlabResourceCounts& SlabResourceCounts();
 
@@ -5,6 +5,7 @@
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/debugger/debugger.h"
+#include "core/guest_profiler.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/k_thread.h"
 #include "core/hle/kernel/kernel.h"
@@ -97,6 +98,13 @@ void PhysicalCore::RunThread(Kernel::KThread* thread) {
             ExitContext();
         }
 
+        // Record the state of the thread if the guest profiler asked for it.
+        if (m_sample_requested.exchange(false)) {
+            Svc::ThreadContext ctx{};
+            interface->GetContext(ctx);
+            system.GetGuestProfiler().RecordSample(m_core_index, *thread, ctx);
+        }
+
         // Determine why we stopped.
         const bool supervisor_call = True(hr & Core::HaltReason::SupervisorCall);
         const bool prefetch_abort = True(hr & Core::HaltReason::PrefetchAbort);
@@ -235,6 +243,21 @@ void PhysicalCore::Interrupt() {
     arm_interface->SignalInterrupt(thread);
 }
 
+bool PhysicalCore::RequestSample() {
+    // Lock core context.
+    std::scoped_lock lk{m_guard};
+
+    // If there is no thread running, there is nothing to sample.
+    if (m_arm_interface == nullptr) {
+        return false;
+    }
+
+    // Halt the CPU, the sample is taken once it has left guest code.
+    m_sample_requested = true;
+    m_arm_interface->SignalInterrupt(m_current_thread);
+    return true;
+}
+
 void PhysicalCore::ClearInterrupt() {
     std::scoped_lock lk{m_guard};
     m_is_interrupted = false;
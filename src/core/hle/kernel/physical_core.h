@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
@@ -58,6 +59,10 @@ public:
     // Check if this core is interrupted.
     bool IsInterrupted() const;
 
+    // Halt the running thread so its state is sampled by the guest profiler.
+    // Returns false if the core is not running guest code.
+    bool RequestSample();
+
     std::size_t CoreIndex() const {
         return m_core_index;
     }
@@ -72,6 +77,7 @@ private:
     KThread* m_current_thread{};
     bool m_is_interrupted{};
     bool m_is_single_core{};
+    std::atomic<bool> m_sample_requested{};
 };
 
 } // namespace Kernel
@@ -28,7 +28,7 @@ public:
     }
 
     static void Free(KernelCore& kernel, Derived* obj) {
-        kernel.SlabHeap<Derived>().Free(obj);
+        kernel.SlabHeap<Derived>().Free(kernel, obj);
     }
 
     static size_t GetObjectSize(KernelCore& kernel) {
@@ -62,7 +62,7 @@ private:
     }
 
     static void Free(KernelCore& kernel, Derived* obj) {
-        kernel.SlabHeap<Derived>().Free(obj);
+        kernel.SlabHeap<Derived>().Free(kernel, obj);
     }
 
 public:
@@ -137,7 +137,7 @@ private:
     }
 
     static void Free(KernelCore& kernel, Derived* obj) {
-        kernel.SlabHeap<Derived>().Free(obj);
+        kernel.SlabHeap<Derived>().Free(kernel, obj);
     }
 
 public:
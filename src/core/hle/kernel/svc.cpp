@@ -7,6 +7,7 @@
 
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
+#include "core/hle/kernel/call_statistics.h"
 #include "core/hle/kernel/k_process.h"
 #include "core/hle/kernel/svc.h"
 
@@ -4429,6 +4430,7 @@ void Call(Core::System& system, u32 imm) {
     std::array<uint64_t, 8> args;
     kernel.CurrentPhysicalCore().SaveSvcArguments(process, args);
     kernel.EnterSVCProfile();
+    const u64 begin_ns = kernel.GetCallStatistics().BeginCall();
 
     if (process.Is64Bit()) {
         Call64(system, imm, args);
@@ -4436,6 +4438,8 @@ void Call(Core::System& system, u32 imm) {
         Call32(system, imm, args);
     }
 
+    // The thread may have been rescheduled to another core while it waited
+    kernel.GetCallStatistics().RecordSvc(kernel.CurrentPhysicalCoreIndex(), imm, begin_ns);
     kernel.ExitSVCProfile();
     kernel.CurrentPhysicalCore().LoadSvcArguments(process, args);
 }
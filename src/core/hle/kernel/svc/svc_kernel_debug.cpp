@@ -1,13 +1,25 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/logging/log.h"
+#include "core/core.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/svc.h"
 
 namespace Kernel::Svc {
 
 void KernelDebug(Core::System& system, KernelDebugType kernel_debug_type, u64 arg0, u64 arg1,
                  u64 arg2) {
-    // Intentionally do nothing, as this does nothing in released kernel binaries.
+    // Released kernel binaries do nothing here. Dumping the kernel objects reports the slab heap
+    // counters instead, to measure object churn.
+    if (kernel_debug_type != KernelDebugType::KernelObject) {
+        return;
+    }
+    for (const auto& [name, stats] : system.Kernel().GetSlabHeapStatistics()) {
+        LOG_INFO(Kernel_SVC,
+                 "{}: allocations={}, frees={}, refills={}, drains={}, contentions={}", name,
+                 stats.allocations, stats.frees, stats.refills, stats.drains, stats.contentions);
+    }
 }
 
 void ChangeKernelTraceState(Core::System& system, KernelTraceState trace_state) {
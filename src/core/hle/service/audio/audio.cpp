@@ -27,8 +27,16 @@ void LoopProcess(Core::System& system) {
                                          std::make_shared<IFinalOutputRecorderManager>(system));
     server_manager->RegisterNamedService("audren:u",
                                          std::make_shared<IAudioRendererManager>(system));
+    ServerManager::RunServer(std::move(server_manager));
+}
+
+void LoopProcessHardwareOpus(Core::System& system) {
+    auto server_manager = std::make_unique<ServerManager>(system);
+
+    // Served from several threads, so sessions decoding different streams don't queue on each other
     server_manager->RegisterNamedService("hwopus",
                                          std::make_shared<IHardwareOpusDecoderManager>(system));
+    server_manager->StartAdditionalHostThreads("hwopus", 2);
     ServerManager::RunServer(std::move(server_manager));
 }
 
@@ -14,5 +14,6 @@ class ServiceManager;
 namespace Service::Audio {
 
 void LoopProcess(Core::System& system);
+void LoopProcessHardwareOpus(Core::System& system);
 
 } // namespace Service::Audio
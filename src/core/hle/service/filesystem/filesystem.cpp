@@ -23,6 +23,7 @@
 #include "core/hle/service/filesystem/fsp/fsp_ldr.h"
 #include "core/hle/service/filesystem/fsp/fsp_pr.h"
 #include "core/hle/service/filesystem/fsp/fsp_srv.h"
+#include "core/hle/service/filesystem/read_ahead.h"
 #include "core/hle/service/filesystem/romfs_controller.h"
 #include "core/hle/service/filesystem/save_data_controller.h"
 #include "core/hle/service/server_manager.h"
@@ -291,7 +292,8 @@ Result VfsDirectoryServiceWrapper::GetFileTimeStampRaw(
     return ResultSuccess;
 }
 
-FileSystemController::FileSystemController(Core::System& system_) : system{system_} {}
+FileSystemController::FileSystemController(Core::System& system_)
+    : read_ahead_pool{std::make_shared<ReadAheadPool>()}, system{system_} {}
 
 FileSystemController::~FileSystemController() = default;
 
@@ -340,6 +342,10 @@ void FileSystemController::SetPackedUpdate(ProcessId process_id, FileSys::Virtua
     it->second.romfs_factory->SetPackedUpdate(std::move(update_raw));
 }
 
+std::shared_ptr<ReadAheadPool> FileSystemController::GetReadAheadPool() const {
+    return read_ahead_pool;
+}
+
 std::shared_ptr<SaveDataController> FileSystemController::OpenSaveDataController() {
     return std::make_shared<SaveDataController>(system, CreateSaveDataFactory(ProgramId{}));
 }
@@ -44,6 +44,7 @@ class ServiceManager;
 
 namespace FileSystem {
 
+class ReadAheadPool;
 class RomFsController;
 class SaveDataController;
 
@@ -74,6 +75,8 @@ public:
                        ProcessId process_id);
     void SetPackedUpdate(ProcessId process_id, FileSys::VirtualFile update_raw);
 
+    std::shared_ptr<ReadAheadPool> GetReadAheadPool() const;
+
     std::shared_ptr<SaveDataController> OpenSaveDataController();
 
     Result OpenSDMC(FileSys::VirtualDir* out_sdmc) const;
@@ -142,6 +145,8 @@ private:
     std::unique_ptr<FileSys::RegisteredCache> gamecard_registered;
     std::unique_ptr<FileSys::PlaceholderCache> gamecard_placeholder;
 
+    std::shared_ptr<ReadAheadPool> read_ahead_pool;
+
     Core::System& system;
 };
 
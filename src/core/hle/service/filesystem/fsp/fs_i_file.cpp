@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "core/core.h"
 #include "core/file_sys/errors.h"
 #include "core/hle/service/cmif_serialization.h"
 #include "core/hle/service/filesystem/fsp/fs_i_file.h"
@@ -8,7 +9,8 @@
 namespace Service::FileSystem {
 
 IFile::IFile(Core::System& system_, FileSys::VirtualFile file_)
-    : ServiceFramework{system_, "IFile"}, backend{std::make_unique<FileSys::Fsa::IFile>(file_)} {
+    : ServiceFramework{system_, "IFile"}, backend{std::make_unique<FileSys::Fsa::IFile>(file_)},
+      read_ahead{system_.GetFileSystemController().GetReadAheadPool(), file_} {
     // clang-format off
     static const FunctionInfo functions[] = {
         {0, D<&IFile::Read>, "Read"},
@@ -31,8 +33,13 @@ Result IFile::Read(
               size);
 
     // Read the data from the Storage backend
-    R_RETURN(
+    R_TRY(
         backend->Read(reinterpret_cast<size_t*>(out_size.Get()), offset, out_buffer.data(), size));
+
+    // Prefetch what follows if the file is being streamed
+    read_ahead.OnRead(static_cast<size_t>(offset), static_cast<size_t>(*out_size));
+
+    R_SUCCEED();
 }
 
 Result IFile::Write(
@@ -6,6 +6,7 @@
 #include "core/file_sys/fsa/fs_i_file.h"
 #include "core/hle/service/cmif_types.h"
 #include "core/hle/service/filesystem/filesystem.h"
+#include "core/hle/service/filesystem/read_ahead.h"
 #include "core/hle/service/service.h"
 
 namespace Service::FileSystem {
@@ -16,6 +17,7 @@ public:
 
 private:
     std::unique_ptr<FileSys::Fsa::IFile> backend;
+    ReadAheadDetector read_ahead;
 
     Result Read(FileSys::ReadOption option, Out<s64> out_size, s64 offset,
                 const OutBuffer<BufferAttr_HipcMapAlias | BufferAttr_HipcMapTransferAllowsNonSecure>
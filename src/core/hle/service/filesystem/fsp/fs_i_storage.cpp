@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2023 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "core/core.h"
 #include "core/file_sys/errors.h"
 #include "core/hle/service/cmif_serialization.h"
 #include "core/hle/service/filesystem/fsp/fs_i_storage.h"
@@ -8,7 +9,8 @@
 namespace Service::FileSystem {
 
 IStorage::IStorage(Core::System& system_, FileSys::VirtualFile backend_)
-    : ServiceFramework{system_, "IStorage"}, backend(std::move(backend_)) {
+    : ServiceFramework{system_, "IStorage"}, backend(std::move(backend_)),
+      read_ahead{system_.GetFileSystemController().GetReadAheadPool(), backend} {
     static const FunctionInfo functions[] = {
         {0, D<&IStorage::Read>, "Read"},
         {1, nullptr, "Write"},
@@ -29,7 +31,10 @@ Result IStorage::Read(
     R_UNLESS(offset >= 0, FileSys::ResultInvalidOffset);
 
     // Read the data from the Storage backend
-    backend->Read(out_bytes.data(), length, offset);
+    const size_t read = backend->Read(out_bytes.data(), length, offset);
+
+    // Prefetch what follows if the storage is being streamed
+    read_ahead.OnRead(static_cast<size_t>(offset), read);
 
     R_SUCCEED();
 }
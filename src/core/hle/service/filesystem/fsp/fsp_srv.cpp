@@ -19,6 +19,7 @@
 #include "core/file_sys/errors.h"
 #include "core/file_sys/fs_directory.h"
 #include "core/file_sys/fs_filesystem.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
 #include "core/file_sys/nca_metadata.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/romfs.h"
@@ -35,6 +36,7 @@
 #include "core/hle/service/filesystem/fsp/fs_i_storage.h"
 #include "core/hle/service/filesystem/fsp/fsp_srv.h"
 #include "core/hle/service/filesystem/fsp/save_data_transfer_prohibiter.h"
+#include "core/hle/service/filesystem/read_ahead.h"
 #include "core/hle/service/filesystem/romfs_controller.h"
 #include "core/hle/service/filesystem/save_data_controller.h"
 #include "core/hle/service/hle_ipc.h"
@@ -44,6 +46,13 @@
 
 namespace Service::FileSystem {
 
+namespace {
+
+// Guest access log messages between each line of block cache counters
+constexpr u32 BlockCacheStatisticsInterval = 256;
+
+} // Anonymous namespace
+
 FSP_SRV::FSP_SRV(Core::System& system_)
     : ServiceFramework{system_, "fsp-srv"}, fsc{system.GetFileSystemController()},
       content_provider{system.GetContentProvider()}, reporter{system.GetReporter()} {
@@ -503,6 +512,11 @@ Result FSP_SRV::OutputAccessLogToSdCard(InBuffer<BufferAttr_HipcMapAlias> log_me
         reinterpret_cast<const char*>(log_message_buffer.data()), log_message_buffer.size());
     reporter.SaveFSAccessLog(log);
 
+    // Interleave the block cache counters with the log of the guest every so often
+    if (++access_log_message_count % BlockCacheStatisticsInterval == 0) {
+        OutputBlockCacheStatisticsToSdCard();
+    }
+
     R_SUCCEED();
 }
 
@@ -519,9 +533,28 @@ Result FSP_SRV::GetProgramIndexForAccessLog(Out<AccessLogVersion> out_access_log
 Result FSP_SRV::FlushAccessLogOnSdCard() {
     LOG_DEBUG(Service_FS, "(STUBBED) called");
 
+    OutputBlockCacheStatisticsToSdCard();
+
     R_SUCCEED();
 }
 
+void FSP_SRV::OutputBlockCacheStatisticsToSdCard() const {
+    const auto stats = FileSys::BlockCache::GetInstance().GetStatistics();
+    const auto read_ahead_stats = fsc.GetReadAheadPool()->GetStatistics();
+    const auto ratio = [](u64 numerator, u64 denominator) {
+        return denominator != 0 ? static_cast<double>(numerator) / static_cast<double>(denominator)
+                                : 0.0;
+    };
+    reporter.SaveFSAccessLog(fmt::format(
+        "FS_BLOCK_CACHE: {{ hits: {}, misses: {}, hit_rate: {:.3f}, bytes_saved: {}, "
+        "cached_bytes: {}, prefetches: {}, dropped_prefetches: {}, prefetched_blocks: {}, "
+        "prefetch_accuracy: {:.3f}, prefetch_wasted_bytes: {} }}\n",
+        stats.hits, stats.misses, ratio(stats.hits, stats.hits + stats.misses), stats.bytes_saved,
+        stats.cached_bytes, read_ahead_stats.prefetches, read_ahead_stats.dropped_prefetches,
+        stats.prefetched_blocks, ratio(stats.prefetch_used_blocks, stats.prefetched_blocks),
+        stats.prefetch_wasted_bytes));
+}
+
 Result FSP_SRV::ExtendSaveDataFileSystem(FileSys::SaveDataSpaceId space_id, u64 save_data_id,
                                          s64 available_size, s64 journal_size) {
     // We don't have an index of save data ids, so we can't implement this.
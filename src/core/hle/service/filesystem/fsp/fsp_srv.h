@@ -107,6 +107,8 @@ private:
                                     s64 available_size, s64 journal_size);
     Result GetCacheStorageSize(s32 index, Out<s64> out_data_size, Out<s64> out_journal_size);
 
+    void OutputBlockCacheStatisticsToSdCard() const;
+
     FileSystemController& fsc;
     const FileSys::ContentProvider& content_provider;
     const Core::Reporter& reporter;
@@ -115,6 +117,7 @@ private:
     u64 current_process_id = 0;
     u32 access_log_program_index = 0;
     AccessLogMode access_log_mode = AccessLogMode::None;
+    u32 access_log_message_count = 0;
     u64 program_id = 0;
     std::shared_ptr<SaveDataController> save_data_controller;
     std::shared_ptr<RomFsController> romfs_controller;
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+
+#include "core/file_sys/vfs/vfs_offset.h"
+#include "core/hle/service/filesystem/read_ahead.h"
+
+namespace Service::FileSystem {
+
+ReadAheadPool::ReadAheadPool() : workers{NumWorkers, "FsReadAhead"} {}
+
+ReadAheadPool::~ReadAheadPool() = default;
+
+bool ReadAheadPool::Prefetch(std::shared_ptr<const FileSys::BlockCacheStorage> storage,
+                             size_t offset, size_t size) {
+    if (num_queued.fetch_add(1, std::memory_order_relaxed) >= MaxQueuedPrefetches) {
+        num_queued.fetch_sub(1, std::memory_order_relaxed);
+        num_dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    num_prefetches.fetch_add(1, std::memory_order_relaxed);
+    num_prefetched_bytes.fetch_add(size, std::memory_order_relaxed);
+    workers.QueueWork([this, storage = std::move(storage), offset, size] {
+        storage->Prefetch(offset, size);
+        num_queued.fetch_sub(1, std::memory_order_relaxed);
+    });
+    return true;
+}
+
+void ReadAheadPool::WaitForPrefetches() {
+    workers.WaitForRequests();
+}
+
+ReadAheadPool::Statistics ReadAheadPool::GetStatistics() const {
+    return {
+        .prefetches = num_prefetches.load(std::memory_order_relaxed),
+        .prefetched_bytes = num_prefetched_bytes.load(std::memory_order_relaxed),
+        .dropped_prefetches = num_dropped.load(std::memory_order_relaxed),
+    };
+}
+
+ReadAheadDetector::ReadAheadDetector(std::shared_ptr<ReadAheadPool> pool_,
+                                     const FileSys::VirtualFile& file)
+    : pool{std::move(pool_)} {
+    if (file == nullptr) {
+        return;
+    }
+    file_size = file->GetSize();
+
+    // Find the block cache storage under the offset files of the file, if there is one
+    auto current = file;
+    while (const auto offset_file = std::dynamic_pointer_cast<FileSys::OffsetVfsFile>(current)) {
+        storage_offset += offset_file->GetOffset();
+        current = offset_file->GetBaseFile();
+    }
+    storage = std::dynamic_pointer_cast<const FileSys::BlockCacheStorage>(current);
+}
+
+void ReadAheadDetector::OnRead(size_t offset, size_t size) {
+    // Reads larger than the cache takes aren't worth prefetching for
+    if (storage == nullptr || size == 0 ||
+        size > FileSys::BlockCacheStorage::MaxCachedReadSize) {
+        sequential_reads = 0;
+        return;
+    }
+
+    if (offset == next_offset) {
+        sequential_reads++;
+    } else {
+        sequential_reads = 0;
+        prefetched_end = 0;
+    }
+    next_offset = offset + size;
+    if (sequential_reads < SequentialReadsToPrefetch) {
+        return;
+    }
+
+    // Top up the prefetched range once the reads have used half of it
+    const size_t begin = std::max(next_offset, prefetched_end);
+    const size_t end = std::min(next_offset + PrefetchSize, file_size);
+    if (begin >= end || (end - begin < PrefetchSize / 2 && end != file_size)) {
+        return;
+    }
+    if (pool->Prefetch(storage, storage_offset + begin, end - begin)) {
+        prefetched_end = end;
+    }
+}
+
+} // namespace Service::FileSystem
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include "common/common_types.h"
+#include "common/thread_worker.h"
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+#include "core/file_sys/vfs/vfs_types.h"
+
+namespace Service::FileSystem {
+
+/**
+ * Background threads reading blocks of game content into the block cache, ahead of the reads of
+ * the guest which need them.
+ */
+class ReadAheadPool {
+public:
+    static constexpr size_t NumWorkers = 2;
+    /// Prefetches past this many waiting to run are dropped, as the guest would catch up to them
+    static constexpr size_t MaxQueuedPrefetches = 16;
+
+    struct Statistics {
+        u64 prefetches;
+        u64 prefetched_bytes;
+        u64 dropped_prefetches;
+    };
+
+    ReadAheadPool();
+    ~ReadAheadPool();
+
+    /**
+     * Queue a prefetch of a range of a storage.
+     *
+     * @param storage - Storage to prefetch from.
+     * @param offset  - Offset of the range in the storage.
+     * @param size    - Size of the range.
+     * @return True if the prefetch was queued, false if too many are waiting to run.
+     */
+    bool Prefetch(std::shared_ptr<const FileSys::BlockCacheStorage> storage, size_t offset,
+                  size_t size);
+
+    /// Wait for the queued prefetches to finish.
+    void WaitForPrefetches();
+
+    Statistics GetStatistics() const;
+
+private:
+    std::atomic<size_t> num_queued{};
+    std::atomic<u64> num_prefetches{};
+    std::atomic<u64> num_prefetched_bytes{};
+    std::atomic<u64> num_dropped{};
+    Common::ThreadWorker workers;
+};
+
+/**
+ * Access pattern of a file opened by the guest. Once reads follow on from each other, the range
+ * after them is prefetched so the next reads are served from the block cache.
+ *
+ * Only files which read a BlockCacheStorage at a fixed offset, such as the files and storages of
+ * RomFS, are prefetched. Reads are made by a single session, so no locking is needed.
+ */
+class ReadAheadDetector {
+public:
+    /// Reads following on from the previous one before prefetching starts
+    static constexpr u32 SequentialReadsToPrefetch = 2;
+    /// Distance kept prefetched ahead of the reads
+    static constexpr size_t PrefetchSize = 8 * FileSys::BlockCache::BlockSize;
+
+    ReadAheadDetector(std::shared_ptr<ReadAheadPool> pool_, const FileSys::VirtualFile& file);
+
+    /// Track a read of the file, prefetching past it if the file is read sequentially.
+    void OnRead(size_t offset, size_t size);
+
+private:
+    std::shared_ptr<ReadAheadPool> pool;
+    std::shared_ptr<const FileSys::BlockCacheStorage> storage;
+    size_t storage_offset{};
+    size_t file_size{};
+
+    size_t next_offset{};
+    u32 sequential_reads{};
+    size_t prefetched_end{};
+};
+
+} // namespace Service::FileSystem
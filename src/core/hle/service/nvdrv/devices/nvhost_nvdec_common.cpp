@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 #include "common/assert.h"
 #include "common/common_types.h"
@@ -106,12 +107,21 @@ NvResult nvhost_nvdec_common::Submit(IoctlSubmit& params, std::span<u8> data, De
                 syncpoint_manager.IncrementSyncpointMaxExt(syncpt_incr.id, syncpt_incr.increments);
         }
     }
+    // The command DMA pusher keeps its state between lists, so every command buffer of the
+    // submission is gathered into one list with a single read.
+    std::vector<Core::Memory::MemoryRange> ranges;
+    ranges.reserve(command_buffers.size());
+    std::size_t word_count = 0;
     for (const auto& cmd_buffer : command_buffers) {
         const auto object = nvmap.GetHandle(cmd_buffer.memory_id);
         ASSERT_OR_EXECUTE(object, return NvResult::InvalidState;);
-        Tegra::ChCommandHeaderList cmdlist(cmd_buffer.word_count);
-        session->process->GetMemory().ReadBlock(object->address + cmd_buffer.offset, cmdlist.data(),
-                                                cmdlist.size() * sizeof(u32));
+        const auto buffer_words = static_cast<std::size_t>(cmd_buffer.word_count);
+        ranges.push_back({object->address + cmd_buffer.offset, buffer_words * sizeof(u32)});
+        word_count += buffer_words;
+    }
+    if (word_count != 0) {
+        Tegra::ChCommandHeaderList cmdlist(word_count);
+        session->process->GetMemory().ReadBlock(ranges, cmdlist.data());
         gpu.PushCommandBuffer(core.Host1xDeviceFile().fd_to_id[fd], cmdlist);
     }
     // Some games expect command_buffers to be written back
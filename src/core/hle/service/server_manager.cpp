@@ -20,6 +20,10 @@
 
 namespace Service {
 
+namespace {
+thread_local ServerManager::StartupHandler startup_handler;
+} // Anonymous namespace
+
 enum class UserDataTag {
     Port,
     Session,
@@ -88,8 +92,10 @@ ServerManager::~ServerManager() {
     m_stop_source.request_stop();
     m_wakeup_event->Signal();
 
-    // Wait for processing to stop.
-    m_stopped.Wait();
+    // Wait for processing to stop, a server that was never run has nothing to wait for.
+    if (m_looping) {
+        m_stopped.Wait();
+    }
     m_threads.clear();
 
     // Clean up ports.
@@ -119,9 +125,18 @@ ServerManager::~ServerManager() {
 }
 
 void ServerManager::RunServer(std::unique_ptr<ServerManager>&& server_manager) {
+    if (startup_handler) {
+        const StartupHandler handler = std::exchange(startup_handler, nullptr);
+        handler(std::move(server_manager));
+        return;
+    }
     server_manager->m_system.RunServer(std::move(server_manager));
 }
 
+void ServerManager::SetStartupHandler(StartupHandler&& handler) {
+    startup_handler = std::move(handler);
+}
+
 Result ServerManager::RegisterSession(Kernel::KServerSession* server_session,
                                       std::shared_ptr<SessionRequestManager> manager) {
     // We are taking ownership of the server session, so don't open it.
@@ -243,6 +258,7 @@ void ServerManager::StartAdditionalHostThreads(const char* name, size_t num_thre
 }
 
 Result ServerManager::LoopProcess() {
+    m_looping = true;
     SCOPE_EXIT {
         m_stopped.Set();
     };
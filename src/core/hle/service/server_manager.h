@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <list>
 #include <mutex>
 #include <optional>
@@ -32,6 +34,8 @@ class Session;
 
 class ServerManager {
 public:
+    using StartupHandler = std::function<void(std::unique_ptr<ServerManager>&&)>;
+
     explicit ServerManager(Core::System& system);
     ~ServerManager();
 
@@ -52,6 +56,9 @@ public:
 
     static void RunServer(std::unique_ptr<ServerManager>&& server);
 
+    /// Hands the next server run on the calling thread to the handler instead of running it.
+    static void SetStartupHandler(StartupHandler&& handler);
+
 private:
     void LinkToDeferredList(MultiWaitHolder* holder);
     void LinkDeferred();
@@ -90,6 +97,7 @@ private:
 
     // Host state tracking
     Common::Event m_stopped{};
+    std::atomic<bool> m_looping{};
     std::vector<std::jthread> m_threads{};
     std::stop_source m_stop_source{};
 };
@@ -7,6 +7,7 @@
 #include "common/settings.h"
 #include "core/core.h"
 #include "core/hle/ipc.h"
+#include "core/hle/kernel/call_statistics.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/service/ipc_helpers.h"
 #include "core/hle/service/service.h"
@@ -91,7 +92,10 @@ void ServiceFrameworkBase::InvokeRequest(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
+    auto& call_statistics = system.Kernel().GetCallStatistics();
+    const u64 begin_ns = call_statistics.BeginCall();
     handler_invoker(this, info->handler_callback, ctx);
+    call_statistics.RecordIpc(service_name, ctx.GetCommand(), info->name, begin_ns);
 }
 
 void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
@@ -105,7 +109,10 @@ void ServiceFrameworkBase::InvokeRequestTipc(HLERequestContext& ctx) {
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
+    auto& call_statistics = system.Kernel().GetCallStatistics();
+    const u64 begin_ns = call_statistics.BeginCall();
     handler_invoker(this, info->handler_callback, ctx);
+    call_statistics.RecordIpc(service_name, ctx.GetCommand(), info->name, begin_ns);
 }
 
 Result ServiceFrameworkBase::HandleSyncRequest(Kernel::KServerSession& session,
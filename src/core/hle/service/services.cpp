@@ -1,6 +1,21 @@
 // SPDX-FileCopyrightText: Copyright 2024 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "common/assert.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/core.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/service/server_manager.h"
 #include "core/hle/service/services.h"
 
 #include "core/hle/service/acc/acc.h"
@@ -64,71 +79,245 @@
 
 namespace Service {
 
-Services::Services(std::shared_ptr<SM::ServiceManager>& sm, Core::System& system,
-                   std::stop_token token) {
-    auto& kernel = system.Kernel();
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// Services waiting for others while they start, or the application waiting for them through
+/// the applets they create. The services waited for are as critical as the ones waiting.
+constexpr std::array<std::pair<std::string_view, std::string_view>, 5> StartupDependencies{{
+    // The container of vi opens dispdrv and nvdrv:s
+    {"vi", "nvnflinger"},
+    {"vi", "nvservices"},
+    // The surface flinger behind dispdrv opens nvdrv:s
+    {"nvnflinger", "nvservices"},
+    // Applets register with hid and open vi:m for their layers
+    {"am", "hid"},
+    {"am", "vi"},
+}};
+
+/// Startup state of a service, shared by the threads starting and serving it.
+struct ServiceStartup {
+    std::string name;
+    Clock::time_point begin;
+    std::atomic<bool> is_started{};
+    Common::Event started;
+
+    /// Server of a guest core service, until its guest thread picks it up.
+    std::mutex server_lock;
+    std::unique_ptr<ServerManager> server;
+    bool abandoned{};
+    Common::Event finished;
+};
+
+void OnStarted(ServiceStartup& startup) {
+    if (startup.is_started.exchange(true)) {
+        return;
+    }
+    const std::chrono::duration<double, std::milli> elapsed = Clock::now() - startup.begin;
+    LOG_INFO(Service, "Started {} in {:.2f} ms", startup.name, elapsed.count());
+    startup.started.Set();
+}
+
+void ServeOnGuestCore(Kernel::KernelCore& kernel, std::stop_token token,
+                      const std::shared_ptr<ServiceStartup>& startup,
+                      std::unique_ptr<ServerManager>&& server) {
+    if (token.stop_requested()) {
+        return;
+    }
+    startup->server = std::move(server);
+    kernel.RunOnGuestCoreThread([&kernel, startup] {
+        std::unique_ptr<ServerManager> guest_server;
+        {
+            std::scoped_lock lk{startup->server_lock};
+            if (!startup->abandoned) {
+                guest_server = std::move(startup->server);
+            }
+        }
+        if (guest_server) {
+            kernel.RunServer(std::move(guest_server));
+        }
+        startup->finished.Set();
+    });
+    OnStarted(*startup);
+
+    {
+        // Emulation can stop before the guest thread ever runs
+        std::stop_callback abandon{token, [&] {
+                                       std::scoped_lock lk{startup->server_lock};
+                                       if (startup->server) {
+                                           startup->abandoned = true;
+                                           startup->finished.Set();
+                                       }
+                                   }};
+        startup->finished.Wait();
+    }
+
+    std::scoped_lock lk{startup->server_lock};
+    startup->server.reset();
+}
 
+} // Anonymous namespace
+
+/**
+ * Starts services concurrently, each one is constructed on its own host thread inside the
+ * process it belongs to. Servers of guest core services are then handed to a guest thread, while
+ * the host thread keeps the objects the service left on its stack alive. The threads are joined
+ * when the services are torn down.
+ */
+class ServiceLauncher {
+public:
+    explicit ServiceLauncher(Core::System& system_, std::stop_token token_)
+        : system{system_}, token{std::move(token_)}, boot_begin{Clock::now()} {}
+
+    ~ServiceLauncher() {
+        // The guest cores are shut down by now, release the host threads of guest servers that
+        // never returned
+        for (const auto& startup : guest_startups) {
+            startup->finished.Set();
+        }
+        threads.clear();
+    }
+
+    void RunOnHostCore(std::string name, std::function<void()> func, bool is_critical = false) {
+        auto startup = Begin(name, is_critical);
+        auto run = [&system = system, startup, func_{std::move(func)}] {
+            ServerManager::SetStartupHandler(
+                [&system, startup](std::unique_ptr<ServerManager>&& server) {
+                    OnStarted(*startup);
+                    system.RunServer(std::move(server));
+                });
+            func_();
+            OnStarted(*startup);
+        };
+        threads.push_back(system.Kernel().RunOnHostCoreProcess(std::move(name), std::move(run)));
+    }
+
+    void RunOnGuestCore(std::string name, std::function<void()> func, bool is_critical = false) {
+        auto startup = Begin(name, is_critical);
+        guest_startups.push_back(startup);
+        auto run = [&kernel = system.Kernel(), token_ = token, startup, func_{std::move(func)}] {
+            ServerManager::SetStartupHandler(
+                [&kernel, token_, startup](std::unique_ptr<ServerManager>&& server) {
+                    ServeOnGuestCore(kernel, token_, startup, std::move(server));
+                });
+            func_();
+            OnStarted(*startup);
+        };
+        threads.push_back(system.Kernel().RunOnHostCoreProcess(std::move(name), std::move(run)));
+    }
+
+    /// Waits for the services the application talks to first, and the services they depend on.
+    void WaitForCritical() {
+        std::vector<std::string_view> names{critical};
+        for (std::size_t index = 0; index < names.size(); ++index) {
+            for (const auto& [service, dependency] : StartupDependencies) {
+                if (service == names[index] &&
+                    std::ranges::find(names, dependency) == names.end()) {
+                    names.push_back(dependency);
+                }
+            }
+        }
+        for (const std::string_view name : names) {
+            const auto startup = startups.find(name);
+            ASSERT_MSG(startup != startups.end(), "Unknown service {}", name);
+            startup->second->started.Wait();
+        }
+        const std::chrono::duration<double, std::milli> elapsed = Clock::now() - boot_begin;
+        LOG_INFO(Service, "Critical services started in {:.2f} ms", elapsed.count());
+    }
+
+private:
+    std::shared_ptr<ServiceStartup> Begin(const std::string& name, bool is_critical) {
+        auto startup = std::make_shared<ServiceStartup>();
+        startup->name = name;
+        startup->begin = Clock::now();
+        startups.emplace(startup->name, startup);
+        if (is_critical) {
+            critical.push_back(startup->name);
+        }
+        return startup;
+    }
+
+    Core::System& system;
+    std::stop_token token;
+    Clock::time_point boot_begin;
+    /// Startups by service name, the names point into the startups
+    std::unordered_map<std::string_view, std::shared_ptr<ServiceStartup>> startups;
+    std::vector<std::string_view> critical;
+    std::vector<std::shared_ptr<ServiceStartup>> guest_startups;
+    std::vector<std::jthread> threads;
+};
+
+Services::Services(std::shared_ptr<SM::ServiceManager>& sm, Core::System& system,
+                   std::stop_token token)
+    : launcher{std::make_unique<ServiceLauncher>(system, token)} {
     system.GetFileSystemController().CreateFactories(*system.GetFilesystem(), false);
 
+    // Only the services the application talks to first are waited for, the others keep starting
+    // while it boots
     // clang-format off
-    kernel.RunOnHostCoreProcess("audio",      [&] { Audio::LoopProcess(system); }).detach();
-    kernel.RunOnHostCoreProcess("FS",         [&] { FileSystem::LoopProcess(system); }).detach();
-    kernel.RunOnHostCoreProcess("jit",        [&] { JIT::LoopProcess(system); }).detach();
-    kernel.RunOnHostCoreProcess("ldn",        [&] { LDN::LoopProcess(system); }).detach();
-    kernel.RunOnHostCoreProcess("Loader",     [&] { LDR::LoopProcess(system); }).detach();
-    kernel.RunOnHostCoreProcess("nvservices", [&] { Nvidia::LoopProcess(system); }).detach();
-    kernel.RunOnHostCoreProcess("bsdsocket",  [&] { Sockets::LoopProcess(system); }).detach();
-    kernel.RunOnHostCoreProcess("vi",         [&, token] { VI::LoopProcess(system, token); }).detach();
-
-    kernel.RunOnGuestCoreProcess("sm",         [&] { SM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("account",    [&] { Account::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("am",         [&] { AM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("aoc",        [&] { AOC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("apm",        [&] { APM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("bcat",       [&] { BCAT::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("bpc",        [&] { BPC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("btdrv",      [&] { BtDrv::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("btm",        [&] { BTM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("capsrv",     [&] { Capture::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("erpt",       [&] { ERPT::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("es",         [&] { ES::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("eupld",      [&] { EUPLD::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("fatal",      [&] { Fatal::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("fgm",        [&] { FGM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("friends",    [&] { Friend::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("settings",   [&] { Set::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("psc",        [&] { PSC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("glue",       [&] { Glue::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("grc",        [&] { GRC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("hid",        [&] { HID::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("lbl",        [&] { LBL::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("LogManager.Prod", [&] { LM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mig",        [&] { Migration::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mii",        [&] { Mii::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mm",         [&] { MM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("mnpp",       [&] { MNPP::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("nvnflinger", [&] { Nvnflinger::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("NCM",        [&] { NCM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("nfc",        [&] { NFC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("nfp",        [&] { NFP::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ngc",        [&] { NGC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("nifm",       [&] { NIFM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("nim",        [&] { NIM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("npns",       [&] { NPNS::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ns",         [&] { NS::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("olsc",       [&] { OLSC::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("omm",        [&] { OMM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("pcie",       [&] { PCIe::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("pctl",       [&] { PCTL::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("pcv",        [&] { PCV::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("prepo",      [&] { PlayReport::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ProcessManager", [&] { PM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ptm",        [&] { PTM::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ro",         [&] { RO::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("spl",        [&] { SPL::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("ssl",        [&] { SSL::LoopProcess(system); });
-    kernel.RunOnGuestCoreProcess("usb",        [&] { USB::LoopProcess(system); });
+    launcher->RunOnHostCore("audio",      [&] { Audio::LoopProcess(system); });
+    launcher->RunOnHostCore("hwopus",     [&] { Audio::LoopProcessHardwareOpus(system); });
+    launcher->RunOnHostCore("FS",         [&] { FileSystem::LoopProcess(system); }, true);
+    launcher->RunOnHostCore("jit",        [&] { JIT::LoopProcess(system); });
+    launcher->RunOnHostCore("ldn",        [&] { LDN::LoopProcess(system); });
+    launcher->RunOnHostCore("Loader",     [&] { LDR::LoopProcess(system); });
+    launcher->RunOnHostCore("nvservices", [&] { Nvidia::LoopProcess(system); });
+    launcher->RunOnHostCore("bsdsocket",  [&] { Sockets::LoopProcess(system); });
+    launcher->RunOnHostCore("vi",         [&, token] { VI::LoopProcess(system, token); }, true);
+
+    launcher->RunOnGuestCore("sm",         [&] { SM::LoopProcess(system); }, true);
+    launcher->RunOnGuestCore("account",    [&] { Account::LoopProcess(system); });
+    launcher->RunOnGuestCore("am",         [&] { AM::LoopProcess(system); }, true);
+    launcher->RunOnGuestCore("aoc",        [&] { AOC::LoopProcess(system); });
+    launcher->RunOnGuestCore("apm",        [&] { APM::LoopProcess(system); });
+    launcher->RunOnGuestCore("bcat",       [&] { BCAT::LoopProcess(system); });
+    launcher->RunOnGuestCore("bpc",        [&] { BPC::LoopProcess(system); });
+    launcher->RunOnGuestCore("btdrv",      [&] { BtDrv::LoopProcess(system); });
+    launcher->RunOnGuestCore("btm",        [&] { BTM::LoopProcess(system); });
+    launcher->RunOnGuestCore("capsrv",     [&] { Capture::LoopProcess(system); });
+    launcher->RunOnGuestCore("erpt",       [&] { ERPT::LoopProcess(system); });
+    launcher->RunOnGuestCore("es",         [&] { ES::LoopProcess(system); });
+    launcher->RunOnGuestCore("eupld",      [&] { EUPLD::LoopProcess(system); });
+    launcher->RunOnGuestCore("fatal",      [&] { Fatal::LoopProcess(system); });
+    launcher->RunOnGuestCore("fgm",        [&] { FGM::LoopProcess(system); });
+    launcher->RunOnGuestCore("friends",    [&] { Friend::LoopProcess(system); });
+    launcher->RunOnGuestCore("settings",   [&] { Set::LoopProcess(system); });
+    launcher->RunOnGuestCore("psc",        [&] { PSC::LoopProcess(system); });
+    launcher->RunOnGuestCore("glue",       [&] { Glue::LoopProcess(system); });
+    launcher->RunOnGuestCore("grc",        [&] { GRC::LoopProcess(system); });
+    launcher->RunOnGuestCore("hid",        [&] { HID::LoopProcess(system); });
+    launcher->RunOnGuestCore("lbl",        [&] { LBL::LoopProcess(system); });
+    launcher->RunOnGuestCore("LogManager.Prod", [&] { LM::LoopProcess(system); });
+    launcher->RunOnGuestCore("mig",        [&] { Migration::LoopProcess(system); });
+    launcher->RunOnGuestCore("mii",        [&] { Mii::LoopProcess(system); });
+    launcher->RunOnGuestCore("mm",         [&] { MM::LoopProcess(system); });
+    launcher->RunOnGuestCore("mnpp",       [&] { MNPP::LoopProcess(system); });
+    launcher->RunOnGuestCore("nvnflinger", [&] { Nvnflinger::LoopProcess(system); });
+    launcher->RunOnGuestCore("NCM",        [&] { NCM::LoopProcess(system); });
+    launcher->RunOnGuestCore("nfc",        [&] { NFC::LoopProcess(system); });
+    launcher->RunOnGuestCore("nfp",        [&] { NFP::LoopProcess(system); });
+    launcher->RunOnGuestCore("ngc",        [&] { NGC::LoopProcess(system); });
+    launcher->RunOnGuestCore("nifm",       [&] { NIFM::LoopProcess(system); });
+    launcher->RunOnGuestCore("nim",        [&] { NIM::LoopProcess(system); });
+    launcher->RunOnGuestCore("npns",       [&] { NPNS::LoopProcess(system); });
+    launcher->RunOnGuestCore("ns",         [&] { NS::LoopProcess(system); });
+    launcher->RunOnGuestCore("olsc",       [&] { OLSC::LoopProcess(system); });
+    launcher->RunOnGuestCore("omm",        [&] { OMM::LoopProcess(system); });
+    launcher->RunOnGuestCore("pcie",       [&] { PCIe::LoopProcess(system); });
+    launcher->RunOnGuestCore("pctl",       [&] { PCTL::LoopProcess(system); });
+    launcher->RunOnGuestCore("pcv",        [&] { PCV::LoopProcess(system); });
+    launcher->RunOnGuestCore("prepo",      [&] { PlayReport::LoopProcess(system); });
+    launcher->RunOnGuestCore("ProcessManager", [&] { PM::LoopProcess(system); });
+    launcher->RunOnGuestCore("ptm",        [&] { PTM::LoopProcess(system); });
+    launcher->RunOnGuestCore("ro",         [&] { RO::LoopProcess(system); });
+    launcher->RunOnGuestCore("spl",        [&] { SPL::LoopProcess(system); });
+    launcher->RunOnGuestCore("ssl",        [&] { SSL::LoopProcess(system); });
+    launcher->RunOnGuestCore("usb",        [&] { USB::LoopProcess(system); });
     // clang-format on
+
+    launcher->WaitForCritical();
 }
 
 Services::~Services() = default;
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -67,21 +68,26 @@ public:
 
     template <Common::DerivedFrom<SessionRequestHandler> T>
     std::shared_ptr<T> GetService(const std::string& service_name, bool block = false) const {
-        auto service = registered_services.find(service_name);
-        if (service == registered_services.end() && !block) {
+        SessionRequestHandlerFactory factory;
+        {
+            // Services register concurrently while they start up, wait for the registration
+            std::unique_lock lk{lock};
+            const auto find_service = [&] {
+                if (const auto service = registered_services.find(service_name);
+                    service != registered_services.end()) {
+                    factory = service->second;
+                }
+                return static_cast<bool>(factory);
+            };
+            if (!find_service() && block) {
+                registration_event.wait(lk, find_service);
+            }
+        }
+        if (!factory) {
             LOG_DEBUG(Service, "Can't find service: {}", service_name);
             return nullptr;
-        } else if (block) {
-            using namespace std::literals::chrono_literals;
-            while (service == registered_services.end()) {
-                Kernel::Svc::SleepThread(
-                    kernel.System(),
-                    std::chrono::duration_cast<std::chrono::nanoseconds>(100ms).count());
-                service = registered_services.find(service_name);
-            }
         }
-
-        return std::static_pointer_cast<T>(service->second());
+        return std::static_pointer_cast<T>(factory());
     }
 
     void InvokeControlRequest(HLERequestContext& context);
@@ -95,7 +101,9 @@ private:
     std::unique_ptr<Controller> controller_interface;
 
     /// Map of registered services, retrieved using GetServicePort.
-    std::mutex lock;
+    mutable std::mutex lock;
+    /// Signaled when a service is registered, for the lookups waiting for it
+    mutable std::condition_variable registration_event;
     std::unordered_map<std::string, SessionRequestHandlerFactory> registered_services;
     std::unordered_map<std::string, Kernel::KClientPort*> service_ports;
 
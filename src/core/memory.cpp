@@ -63,6 +63,11 @@ struct Memory::Impl {
 #endif
     }
 
+    void SetCurrentPageTable(Common::PageTable& page_table) {
+        current_page_table = &page_table;
+        current_page_table->fastmem_arena = nullptr;
+    }
+
     void MapMemoryRegion(Common::PageTable& page_table, Common::ProcessAddress base, u64 size,
                          Common::PhysicalAddress target, Common::MemoryPermission perms,
                          bool separate_heap) {
@@ -246,9 +251,6 @@ struct Memory::Impl {
     bool WalkBlock(const Common::ProcessAddress addr, const std::size_t size, auto on_unmapped,
                    auto on_memory, auto on_rasterizer, auto increment) {
         const auto& page_table = *current_page_table;
-        std::size_t remaining_size = size;
-        std::size_t page_index = addr >> CITRON_PAGEBITS;
-        std::size_t page_offset = addr & CITRON_PAGEMASK;
         bool user_accessible = true;
 
         if (!AddressSpaceContains(page_table, addr, size)) [[unlikely]] {
@@ -256,44 +258,34 @@ struct Memory::Impl {
             return false;
         }
 
-        while (remaining_size) {
-            const std::size_t copy_amount =
-                std::min(static_cast<std::size_t>(CITRON_PAGESIZE) - page_offset, remaining_size);
-            const auto current_vaddr =
-                static_cast<u64>((page_index << CITRON_PAGEBITS) + page_offset);
-
-            const auto [pointer, type] = page_table.pointers[page_index].PointerType();
-            switch (type) {
-            case Common::PageType::Unmapped: {
-                user_accessible = false;
-                on_unmapped(copy_amount, current_vaddr);
-                break;
-            }
-            case Common::PageType::Memory: {
-                u8* mem_ptr =
-                    reinterpret_cast<u8*>(pointer + page_offset + (page_index << CITRON_PAGEBITS));
-                on_memory(copy_amount, mem_ptr);
-                break;
-            }
-            case Common::PageType::DebugMemory: {
-                u8* const mem_ptr{GetPointerFromDebugMemory(current_vaddr)};
+        page_table.WalkBlock(
+            GetInteger(addr), size,
+            [&](u64, std::size_t copy_amount, u8* mem_ptr) {
                 on_memory(copy_amount, mem_ptr);
-                break;
-            }
-            case Common::PageType::RasterizerCachedMemory: {
-                u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
-                on_rasterizer(current_vaddr, copy_amount, host_ptr);
-                break;
-            }
-            default:
-                UNREACHABLE();
-            }
-
-            page_index++;
-            page_offset = 0;
-            increment(copy_amount);
-            remaining_size -= copy_amount;
-        }
+                increment(copy_amount);
+            },
+            [&](Common::PageType type, u64 current_vaddr, std::size_t copy_amount) {
+                switch (type) {
+                case Common::PageType::Unmapped: {
+                    user_accessible = false;
+                    on_unmapped(copy_amount, current_vaddr);
+                    break;
+                }
+                case Common::PageType::DebugMemory: {
+                    u8* const mem_ptr{GetPointerFromDebugMemory(current_vaddr)};
+                    on_memory(copy_amount, mem_ptr);
+                    break;
+                }
+                case Common::PageType::RasterizerCachedMemory: {
+                    u8* const host_ptr{GetPointerFromRasterizerCachedMemory(current_vaddr)};
+                    on_rasterizer(current_vaddr, copy_amount, host_ptr);
+                    break;
+                }
+                default:
+                    UNREACHABLE();
+                }
+                increment(copy_amount);
+            });
 
         return user_accessible;
     }
@@ -335,6 +327,29 @@ struct Memory::Impl {
         return ReadBlockImpl<true>(src_addr, dest_buffer, size);
     }
 
+    /// Calls func once per group of ranges that follow each other in the address space.
+    static void ForEachCoalescedRange(std::span<const MemoryRange> ranges, auto func) {
+        std::size_t buffer_offset = 0;
+        for (std::size_t i = 0; i < ranges.size();) {
+            const Common::ProcessAddress address = ranges[i].address;
+            std::size_t size = ranges[i].size;
+            for (++i; i < ranges.size() && ranges[i].address == address + size; ++i) {
+                size += ranges[i].size;
+            }
+            func(address, buffer_offset, size);
+            buffer_offset += size;
+        }
+    }
+
+    bool ReadBlock(std::span<const MemoryRange> src_ranges, void* dest_buffer) {
+        bool result = true;
+        ForEachCoalescedRange(src_ranges, [&](const Common::ProcessAddress src_addr,
+                                              const std::size_t offset, const std::size_t size) {
+            result &= ReadBlockImpl<false>(src_addr, static_cast<u8*>(dest_buffer) + offset, size);
+        });
+        return result;
+    }
+
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const {
         if (current_page_table->blocks[src_addr >> CITRON_PAGEBITS] ==
             current_page_table->blocks[(src_addr + size) >> CITRON_PAGEBITS]) {
@@ -387,6 +402,16 @@ struct Memory::Impl {
         return WriteBlockImpl<true>(dest_addr, src_buffer, size);
     }
 
+    bool WriteBlock(std::span<const MemoryRange> dest_ranges, const void* src_buffer) {
+        bool result = true;
+        ForEachCoalescedRange(dest_ranges, [&](const Common::ProcessAddress dest_addr,
+                                               const std::size_t offset, const std::size_t size) {
+            result &=
+                WriteBlockImpl<false>(dest_addr, static_cast<const u8*>(src_buffer) + offset, size);
+        });
+        return result;
+    }
+
     bool ZeroBlock(const Common::ProcessAddress dest_addr, const std::size_t size) {
         return WalkBlock(
             dest_addr, size,
@@ -923,6 +948,10 @@ void Memory::SetCurrentPageTable(Kernel::KProcess& process) {
     impl->SetCurrentPageTable(process);
 }
 
+void Memory::SetCurrentPageTable(Common::PageTable& page_table) {
+    impl->SetCurrentPageTable(page_table);
+}
+
 void Memory::MapMemoryRegion(Common::PageTable& page_table, Common::ProcessAddress base, u64 size,
                              Common::PhysicalAddress target, Common::MemoryPermission perms,
                              bool separate_heap) {
@@ -1041,6 +1070,10 @@ bool Memory::ReadBlockUnsafe(const Common::ProcessAddress src_addr, void* dest_b
     return impl->ReadBlockUnsafe(src_addr, dest_buffer, size);
 }
 
+bool Memory::ReadBlock(std::span<const MemoryRange> src_ranges, void* dest_buffer) {
+    return impl->ReadBlock(src_ranges, dest_buffer);
+}
+
 const u8* Memory::GetSpan(const VAddr src_addr, const std::size_t size) const {
     return impl->GetSpan(src_addr, size);
 }
@@ -1059,6 +1092,10 @@ bool Memory::WriteBlockUnsafe(const Common::ProcessAddress dest_addr, const void
     return impl->WriteBlockUnsafe(dest_addr, src_buffer, size);
 }
 
+bool Memory::WriteBlock(std::span<const MemoryRange> dest_ranges, const void* src_buffer) {
+    return impl->WriteBlock(dest_ranges, src_buffer);
+}
+
 bool Memory::CopyBlock(Common::ProcessAddress dest_addr, Common::ProcessAddress src_addr,
                        const std::size_t size) {
     return impl->CopyBlock(dest_addr, src_addr, size);
@@ -52,6 +52,12 @@ enum : u64 {
     DEFAULT_STACK_SIZE = 0x100000,
 };
 
+/// A range of guest virtual memory, one piece of a scattered block.
+struct MemoryRange {
+    Common::ProcessAddress address;
+    std::size_t size;
+};
+
 /// Central class that handles all memory operations and state.
 class Memory {
 public:
@@ -76,6 +82,14 @@ public:
      */
     void SetCurrentPageTable(Kernel::KProcess& process);
 
+    /**
+     * Changes the currently active page table to one not owned by a process, such as a page
+     * table mapping host buffers in offline tools. Fastmem is not used with it.
+     *
+     * @param page_table The page table to use.
+     */
+    void SetCurrentPageTable(Common::PageTable& page_table);
+
     /**
      * Maps an allocated buffer onto a region of the emulated process address space.
      *
@@ -366,6 +380,19 @@ public:
      */
     bool ReadBlockUnsafe(Common::ProcessAddress src_addr, void* dest_buffer, std::size_t size);
 
+    /**
+     * Reads a list of ranges from the current process' address space, one after another into
+     * a single buffer. Ranges that follow each other in the address space are read together.
+     *
+     * @param src_ranges  The virtual ranges to read, in order.
+     * @param dest_buffer The buffer to place the read bytes into.
+     *
+     * @pre dest_buffer must be at least as long as the sum of the range sizes.
+     *
+     * @returns false if any of the ranges is not fully mapped.
+     */
+    bool ReadBlock(std::span<const MemoryRange> src_ranges, void* dest_buffer);
+
     const u8* GetSpan(const VAddr src_addr, const std::size_t size) const;
     u8* GetSpan(const VAddr src_addr, const std::size_t size);
 
@@ -409,6 +436,17 @@ public:
     bool WriteBlockUnsafe(Common::ProcessAddress dest_addr, const void* src_buffer,
                           std::size_t size);
 
+    /**
+     * Writes consecutive pieces of a buffer to a list of ranges of the current process' address
+     * space. Ranges that follow each other in the address space are written together.
+     *
+     * @param dest_ranges The virtual ranges to write, in order.
+     * @param src_buffer  The data to write, as long as the sum of the range sizes.
+     *
+     * @returns false if any of the ranges is not fully mapped.
+     */
+    bool WriteBlock(std::span<const MemoryRange> dest_ranges, const void* src_buffer);
+
     /**
      * Copies data within a process' address space to another location within the
      * same address space.
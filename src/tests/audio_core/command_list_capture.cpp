@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/command_list_capture.h"
+#include "audio_core/renderer/command/command_list_header.h"
+#include "audio_core/renderer/command/commands.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/memory.h"
+
+namespace {
+
+using namespace AudioCore::Renderer;
+using AudioCore::CpuAddr;
+using AudioCore::ADSP::AudioRenderer::CommandListProcessor;
+
+constexpr u32 SAMPLE_COUNT = AudioCore::TargetSampleCount;
+constexpr s16 BUFFER_COUNT = 2;
+constexpr s32 PREVIOUS_SAMPLE = 0x1234;
+constexpr s16 WAVE_SAMPLE = 0x100;
+constexpr u64 GUEST_PAGE_SIZE = Core::Memory::CITRON_PAGESIZE;
+constexpr CpuAddr WAVE_BUFFER_ADDRESS = 0x10000;
+
+/// Renderer workbuffer holding a command list and the state its commands point to.
+struct Workbuffer {
+    alignas(16) std::array<u8, 0x800> command_list;
+    std::array<s32, BUFFER_COUNT * SAMPLE_COUNT> samples;
+    s32 previous_sample;
+    alignas(16) EffectInfoBase::State delay_state;
+    VoiceState voice_state;
+};
+
+/// Guest memory holding a wave buffer, mapped in a page table of its own.
+struct GuestMemory {
+    GuestMemory() {
+        page_table.Resize(20, Core::Memory::CITRON_PAGEBITS);
+        const auto page{WAVE_BUFFER_ADDRESS / GUEST_PAGE_SIZE};
+        page_table.pointers[page].Store(
+            reinterpret_cast<uintptr_t>(wave_buffer.data()) - WAVE_BUFFER_ADDRESS,
+            Common::PageType::Memory);
+        page_table.blocks[page] = WAVE_BUFFER_ADDRESS;
+        wave_buffer.fill(WAVE_SAMPLE);
+    }
+
+    Common::PageTable page_table;
+    alignas(GUEST_PAGE_SIZE) std::array<s16, GUEST_PAGE_SIZE / sizeof(s16)> wave_buffer;
+};
+
+class CommandListBuilder {
+public:
+    explicit CommandListBuilder(Workbuffer& workbuffer_) : workbuffer{workbuffer_} {
+        header = std::construct_at(
+            reinterpret_cast<CommandListHeader*>(workbuffer.command_list.data()));
+        header->buffer_count = BUFFER_COUNT;
+        header->sample_count = SAMPLE_COUNT;
+        header->sample_rate = AudioCore::TargetSampleRate;
+        header->samples_buffer = workbuffer.samples;
+    }
+
+    template <typename T>
+    T& Add(CommandId type) {
+        auto* command{
+            std::construct_at(reinterpret_cast<T*>(workbuffer.command_list.data() + size))};
+        command->magic = CommandMagic;
+        command->enabled = true;
+        command->type = type;
+        command->size = sizeof(T);
+        size += sizeof(T);
+        header->command_count++;
+        return *command;
+    }
+
+    std::span<const u8> GetCommandList() const {
+        return {workbuffer.command_list.data(), size};
+    }
+
+private:
+    Workbuffer& workbuffer;
+    CommandListHeader* header{};
+    u64 size{sizeof(CommandListHeader)};
+};
+
+template <typename T>
+CpuAddr ToAddress(T* pointer) {
+    return reinterpret_cast<CpuAddr>(pointer);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("CommandListCapture[Replay]", "[audio_core]") {
+    const auto path{std::filesystem::temp_directory_path() / "citron_command_list_capture.bin"};
+    Core::System system;
+    {
+        GuestMemory guest;
+        Core::Memory::Memory memory{system};
+        memory.SetCurrentPageTable(guest.page_table);
+
+        auto workbuffer{std::make_unique<Workbuffer>()};
+        workbuffer->samples.fill(1000);
+        workbuffer->previous_sample = PREVIOUS_SAMPLE;
+        workbuffer->voice_state.wave_buffer_valid[0] = true;
+
+        CommandListBuilder builder{*workbuffer};
+        auto& data_source{builder.Add<PcmInt16DataSourceVersion1Command>(
+            CommandId::DataSourcePcmInt16Version1)};
+        data_source.src_quality = AudioCore::SrcQuality::Medium;
+        data_source.output_index = 0;
+        data_source.sample_rate = AudioCore::TargetSampleRate;
+        data_source.pitch = 1.0f;
+        data_source.channel_count = 1;
+        data_source.wave_buffers[0].buffer = WAVE_BUFFER_ADDRESS;
+        data_source.wave_buffers[0].buffer_size = GUEST_PAGE_SIZE;
+        data_source.wave_buffers[0].end_offset = GUEST_PAGE_SIZE / sizeof(s16);
+        data_source.voice_state = ToAddress(&workbuffer->voice_state);
+
+        auto& mix_ramp{builder.Add<MixRampCommand>(CommandId::MixRamp)};
+        mix_ramp.precision = 15;
+        mix_ramp.input_index = 0;
+        mix_ramp.output_index = 1;
+        mix_ramp.prev_volume = 0.5f;
+        mix_ramp.volume = 1.0f;
+        mix_ramp.previous_sample = ToAddress(&workbuffer->previous_sample);
+
+        auto& delay{builder.Add<DelayCommand>(CommandId::Delay)};
+        delay.parameter.state = EffectInfoBase::ParameterState::Updated;
+        delay.state = ToAddress(&workbuffer->delay_state);
+
+        REQUIRE(CommandListCapture::Write(
+            path, {}, {reinterpret_cast<const u8*>(workbuffer.get()), sizeof(Workbuffer)},
+            builder.GetCommandList(), memory));
+    }
+
+    auto capture{CommandListCapture::Read(path)};
+    std::filesystem::remove(path);
+    REQUIRE(capture.has_value());
+    REQUIRE(capture->PrepareReplay());
+
+    // Addresses point into the loaded workbuffer
+    const CpuAddr base{capture->GetCommandList() - offsetof(Workbuffer, command_list)};
+    const auto& header{*reinterpret_cast<const CommandListHeader*>(capture->GetCommandList())};
+    REQUIRE(ToAddress(header.samples_buffer.data()) == base + offsetof(Workbuffer, samples));
+    REQUIRE(header.samples_buffer.size() == BUFFER_COUNT * SAMPLE_COUNT);
+
+    const auto commands{capture->GetCommands()};
+    REQUIRE(commands.size() == 3);
+    auto& data_source{static_cast<PcmInt16DataSourceVersion1Command&>(*commands[0])};
+    REQUIRE(data_source.voice_state == base + offsetof(Workbuffer, voice_state));
+    REQUIRE(data_source.wave_buffers[0].buffer == WAVE_BUFFER_ADDRESS);
+    auto& mix_ramp{static_cast<MixRampCommand&>(*commands[1])};
+    REQUIRE(mix_ramp.previous_sample == base + offsetof(Workbuffer, previous_sample));
+    REQUIRE(mix_ramp.prev_volume == 0.5f);
+    auto& delay{static_cast<DelayCommand&>(*commands[2])};
+    REQUIRE(delay.state == base + offsetof(Workbuffer, delay_state));
+
+    // Guest memory is captured, so every command runs
+    REQUIRE(std::ranges::all_of(commands, [](const auto* command) { return command->enabled; }));
+    REQUIRE(capture->GetDisabledCommandCount() == 0);
+
+    // Effects are set up again by the first run
+    REQUIRE(delay.parameter.state == EffectInfoBase::ParameterState::Initialized);
+    capture->MarkEffectsInitialized();
+    REQUIRE(delay.parameter.state == EffectInfoBase::ParameterState::Updated);
+
+    // Commands run with the vtables of this process, and the captured guest memory
+    Core::Memory::Memory memory{system};
+    memory.SetCurrentPageTable(capture->GetGuestPageTable());
+    REQUIRE(memory.Read16(WAVE_BUFFER_ADDRESS) == static_cast<u16>(WAVE_SAMPLE));
+
+    CommandListProcessor processor{};
+    processor.memory = &memory;
+    processor.sample_count = header.sample_count;
+    processor.target_sample_rate = header.sample_rate;
+    processor.buffer_count = header.buffer_count;
+    processor.mix_buffers = header.samples_buffer;
+    REQUIRE(mix_ramp.Verify(processor));
+    mix_ramp.Process(processor);
+    REQUIRE(*reinterpret_cast<s32*>(mix_ramp.previous_sample) != PREVIOUS_SAMPLE);
+    REQUIRE(processor.mix_buffers[SAMPLE_COUNT] > 1000);
+
+    auto& voice_state{*reinterpret_cast<VoiceState*>(data_source.voice_state)};
+    REQUIRE(data_source.Verify(processor));
+    data_source.Process(processor);
+    REQUIRE(voice_state.played_sample_count > 0);
+    REQUIRE(std::ranges::any_of(processor.mix_buffers.first(SAMPLE_COUNT),
+                                [](s32 sample) { return sample != 0; }));
+
+    // Voices are rewound for the next run
+    capture->ResetVoices();
+    REQUIRE(voice_state.played_sample_count == 0);
+    REQUIRE(voice_state.wave_buffer_valid[0]);
+}
+
+TEST_CASE("CommandListCapture[Invalid]", "[audio_core]") {
+    const auto path{std::filesystem::temp_directory_path() / "citron_command_list_invalid.bin"};
+    Core::System system;
+    GuestMemory guest;
+    Core::Memory::Memory memory{system};
+    memory.SetCurrentPageTable(guest.page_table);
+
+    auto workbuffer{std::make_unique<Workbuffer>()};
+    CommandListBuilder builder{*workbuffer};
+    auto& mix_ramp{builder.Add<MixRampCommand>(CommandId::MixRamp)};
+    mix_ramp.previous_sample = ToAddress(&workbuffer->previous_sample);
+    const std::span<const u8> workbuffer_bytes{reinterpret_cast<const u8*>(workbuffer.get()),
+                                               sizeof(Workbuffer)};
+
+    SECTION("Invalid command") {
+        mix_ramp.magic = 0;
+        REQUIRE(CommandListCapture::Write(path, {}, workbuffer_bytes, builder.GetCommandList(),
+                                          memory));
+        auto capture{CommandListCapture::Read(path)};
+        std::filesystem::remove(path);
+        REQUIRE(capture.has_value());
+        REQUIRE(!capture->PrepareReplay());
+    }
+
+    SECTION("Other command layouts") {
+        REQUIRE(CommandListCapture::Write(path, {}, workbuffer_bytes, builder.GetCommandList(),
+                                          memory));
+        {
+            std::fstream file{path, std::ios::binary | std::ios::in | std::ios::out};
+            const auto layout_hash{CommandListCapture::LayoutHash + 1};
+            file.seekp(offsetof(CommandListCapture::Header, layout_hash));
+            file.write(reinterpret_cast<const char*>(&layout_hash), sizeof(layout_hash));
+        }
+        REQUIRE(!CommandListCapture::Read(path).has_value());
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Command list outside of the workbuffer") {
+        const std::array<u8, sizeof(CommandListHeader)> command_list{};
+        REQUIRE(!CommandListCapture::Write(path, {}, workbuffer_bytes, command_list, memory));
+        REQUIRE(!CommandListCapture::Read(path).has_value());
+    }
+}
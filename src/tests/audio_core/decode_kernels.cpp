@@ -0,0 +1,257 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "audio_core/renderer/command/data_source/adpcm_lookahead.h"
+#include "audio_core/renderer/command/data_source/decode_kernels.h"
+
+namespace {
+
+using AudioCore::CpuAddr;
+using AudioCore::Renderer::AdpcmFrameSize;
+using AudioCore::Renderer::AdpcmLookahead;
+using AudioCore::Renderer::AdpcmLookaheadCache;
+using AudioCore::Renderer::AdpcmSamplesPerFrame;
+using AudioCore::Renderer::MixKernel;
+using AudioCore::Renderer::VoiceState;
+
+constexpr std::size_t MAX_FRAME_COUNT = 40;
+constexpr std::size_t MAX_SAMPLE_COUNT = 70;
+constexpr std::size_t NUM_ITERATIONS = 500;
+
+std::vector<u8> RandomFrames(std::mt19937_64& rng, std::size_t frame_count) {
+    std::vector<u8> frames(frame_count * AdpcmFrameSize);
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        // Headers use all 8 coefficient pairs and every scale, including the unusual ones
+        frames[i] =
+            static_cast<u8>(i % AdpcmFrameSize == 0 ? (rng() % 8) << 4 | rng() % 16 : rng());
+    }
+    return frames;
+}
+
+std::array<s16, 16> RandomCoefficients(std::mt19937_64& rng) {
+    std::array<s16, 16> coefficients{};
+    for (auto& coefficient : coefficients) {
+        // Kept small enough that the predictions cannot overflow, as with real coefficients
+        coefficient = static_cast<s16>(static_cast<s16>(rng()) / 4);
+    }
+    return coefficients;
+}
+
+// The decoder as it was before the kernels, a sample at a time
+void ReferenceDecode(std::vector<s16>& output, const std::vector<u8>& frames,
+                     const std::array<s16, 16>& coefficients, VoiceState::AdpcmContext& context) {
+    static constexpr std::array<s32, 16> Steps{
+        0, 1, 2, 3, 4, 5, 6, 7, -8, -7, -6, -5, -4, -3, -2, -1,
+    };
+    s32 yn0{context.yn0};
+    s32 yn1{context.yn1};
+    for (std::size_t frame = 0; frame < frames.size() / AdpcmFrameSize; ++frame) {
+        const u8 header{frames[frame * AdpcmFrameSize]};
+        const s32 scale{header & 0xF};
+        const s32 coeff0{coefficients[((header >> 4) & 0xF) * 2 + 0]};
+        const s32 coeff1{coefficients[((header >> 4) & 0xF) * 2 + 1]};
+        for (u32 i = 0; i < AdpcmSamplesPerFrame; ++i) {
+            const u8 byte{frames[frame * AdpcmFrameSize + 1 + i / 2]};
+            const s32 code{Steps[i % 2 ? byte & 0xF : byte >> 4]};
+            const s32 prediction{coeff0 * yn0 + coeff1 * yn1};
+            const s32 sample{((code * (1 << scale)) << 11) + 0x400 + prediction};
+            yn1 = yn0;
+            yn0 = std::clamp<s32>(sample >> 11, -0x8000, 0x7FFF);
+            output.push_back(static_cast<s16>(yn0));
+        }
+        context.header = header;
+    }
+    context.yn0 = static_cast<s16>(yn0);
+    context.yn1 = static_cast<s16>(yn1);
+}
+
+bool ContextsMatch(const VoiceState::AdpcmContext& a, const VoiceState::AdpcmContext& b) {
+    return a.header == b.header && a.yn0 == b.yn0 && a.yn1 == b.yn1;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DecodeKernels[AdpcmMatchReference]", "[audio_core]") {
+    std::mt19937_64 rng{0x41445031};
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        for (std::size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+            const auto frames{RandomFrames(rng, rng() % (MAX_FRAME_COUNT + 1))};
+            const auto coefficients{RandomCoefficients(rng)};
+            const VoiceState::AdpcmContext start{
+                .header{0},
+                .yn0{static_cast<s16>(rng())},
+                .yn1{static_cast<s16>(rng())},
+            };
+
+            std::vector<s16> expected;
+            auto expected_context{start};
+            ReferenceDecode(expected, frames, coefficients, expected_context);
+
+            std::vector<s16> output(expected.size());
+            auto context{start};
+            AudioCore::Renderer::DecodeAdpcmFrames(kernel, output, frames, coefficients, context);
+            REQUIRE(output == expected);
+            REQUIRE(ContextsMatch(context, expected_context));
+        }
+    }
+}
+
+TEST_CASE("DecodeKernels[PcmInt16MatchReference]", "[audio_core]") {
+    std::mt19937_64 rng{0x41445032};
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        for (std::size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+            const u32 channel_count{static_cast<u32>(1 + rng() % 6)};
+            const u32 channel{static_cast<u32>(rng() % channel_count)};
+            const std::size_t sample_count = rng() % (MAX_SAMPLE_COUNT + 1);
+            std::vector<s16> input(sample_count * channel_count);
+            for (auto& sample : input) {
+                sample = static_cast<s16>(rng());
+            }
+
+            std::vector<s16> output(sample_count);
+            AudioCore::Renderer::ConvertPcmInt16(kernel, output, input, channel_count, channel);
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                REQUIRE(output[i] == input[i * channel_count + channel]);
+            }
+        }
+    }
+}
+
+TEST_CASE("DecodeKernels[PcmFloatMatchReference]", "[audio_core]") {
+    constexpr s32 min{std::numeric_limits<s16>::min()};
+    constexpr s32 max{std::numeric_limits<s16>::max()};
+    std::mt19937_64 rng{0x41445033};
+    std::uniform_real_distribution<f32> distribution{-1.5f, 1.5f};
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        for (std::size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+            const u32 channel_count{static_cast<u32>(1 + rng() % 6)};
+            const u32 channel{static_cast<u32>(rng() % channel_count)};
+            const std::size_t sample_count = rng() % (MAX_SAMPLE_COUNT + 1);
+            std::vector<f32> input(sample_count * channel_count);
+            for (auto& sample : input) {
+                sample = distribution(rng);
+            }
+
+            std::vector<s16> output(sample_count);
+            AudioCore::Renderer::ConvertPcmFloat(kernel, output, input, channel_count, channel);
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                const auto sample{static_cast<s32>(input[i * channel_count + channel] * max)};
+                REQUIRE(output[i] == std::clamp(sample, min, max));
+            }
+        }
+    }
+}
+
+TEST_CASE("AdpcmLookahead[ReadMatchesDecode]", "[audio_core]") {
+    constexpr CpuAddr buffer = 0x1000;
+    std::mt19937_64 rng{0x41445034};
+    const auto frames{RandomFrames(rng, AdpcmLookahead::WindowFrames)};
+    const auto coefficients{RandomCoefficients(rng)};
+    const VoiceState::AdpcmContext start{.header{0}, .yn0{123}, .yn1{-456}};
+
+    std::vector<s16> expected;
+    auto expected_context{start};
+    ReferenceDecode(expected, frames, coefficients, expected_context);
+
+    AdpcmLookahead lookahead;
+    lookahead.Decode(buffer, 0, coefficients, start, frames);
+    REQUIRE(lookahead.Contains(buffer, 0, coefficients, start));
+
+    // Read in uneven steps, continuing from the middle of frames
+    auto context{start};
+    u32 position{0};
+    while (position < expected.size()) {
+        const auto first_frame{position / AdpcmSamplesPerFrame};
+        std::vector<s16> output(std::min<std::size_t>(1 + rng() % 40, expected.size() - position));
+        const auto read{lookahead.Read(buffer, position, coefficients, context,
+                                       std::span(frames).subspan(first_frame * AdpcmFrameSize),
+                                       output)};
+        REQUIRE(read == output.size());
+        REQUIRE(std::equal(output.begin(), output.end(), expected.begin() + position));
+        position += read;
+    }
+    REQUIRE(ContextsMatch(context, expected_context));
+}
+
+TEST_CASE("AdpcmLookahead[Invalidation]", "[audio_core]") {
+    constexpr CpuAddr buffer = 0x1000;
+    std::mt19937_64 rng{0x41445035};
+    auto frames{RandomFrames(rng, 8)};
+    const auto coefficients{RandomCoefficients(rng)};
+    const VoiceState::AdpcmContext start{.header{0}, .yn0{0}, .yn1{0}};
+    std::vector<s16> output(AdpcmSamplesPerFrame * 8);
+
+    AdpcmLookahead lookahead;
+    lookahead.Decode(buffer, 0, coefficients, start, frames);
+
+    SECTION("Other wave buffer") {
+        auto context{start};
+        REQUIRE(lookahead.Read(buffer + 0x100, 0, coefficients, context, frames, output) == 0);
+    }
+
+    SECTION("Other context") {
+        auto context{start};
+        context.yn0 = 1;
+        REQUIRE(lookahead.Read(buffer, 0, coefficients, context, frames, output) == 0);
+    }
+
+    SECTION("Other coefficients") {
+        auto other_coefficients{coefficients};
+        other_coefficients[3]++;
+        auto context{start};
+        REQUIRE(lookahead.Read(buffer, 0, other_coefficients, context, frames, output) == 0);
+    }
+
+    SECTION("Rewritten frames") {
+        frames[3 * AdpcmFrameSize + 2] ^= 0x10;
+        auto context{start};
+        REQUIRE(lookahead.Read(buffer, 0, coefficients, context, frames, output) == 0);
+        REQUIRE(!lookahead.Contains(buffer, 0, coefficients, start));
+    }
+
+    SECTION("Fewer frames in guest memory") {
+        auto context{start};
+        const auto read{lookahead.Read(buffer, 0, coefficients, context,
+                                       std::span(frames).first(2 * AdpcmFrameSize), output)};
+        REQUIRE(read == 2 * AdpcmSamplesPerFrame);
+    }
+}
+
+TEST_CASE("AdpcmLookaheadCache[ReopenSession]", "[audio_core]") {
+    constexpr CpuAddr buffer = 0x1000;
+    std::mt19937_64 rng{0x41445036};
+    const auto frames{RandomFrames(rng, 8)};
+    const auto coefficients{RandomCoefficients(rng)};
+    const VoiceState::AdpcmContext start{.header{0}, .yn0{0}, .yn1{0}};
+
+    AdpcmLookaheadCache cache;
+    const auto open_session{[&](CpuAddr voice_states) {
+        for (CpuAddr voice = 0; voice < AdpcmLookaheadCache::MaxVoices; voice++) {
+            REQUIRE(cache.Get(voice_states + voice * 0x100) != nullptr);
+        }
+        REQUIRE(cache.Get(voice_states + AdpcmLookaheadCache::MaxVoices * 0x100) == nullptr);
+    }};
+
+    open_session(0x100000);
+    auto* const lookahead{cache.Get(0x100000)};
+    REQUIRE(cache.Get(0x100000) == lookahead);
+    lookahead->Decode(buffer, 0, coefficients, start, frames);
+    REQUIRE(lookahead->Contains(buffer, 0, coefficients, start));
+
+    // The session is initialized again, with its voice states in another workbuffer
+    cache.Clear();
+    open_session(0x200000);
+
+    // And once more where the first one was, without the samples of the old voices
+    cache.Clear();
+    open_session(0x100000);
+    REQUIRE(!cache.Get(0x100000)->Contains(buffer, 0, coefficients, start));
+}
@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "audio_core/adsp/apps/opus/decode_streams.h"
+#include "common/thread.h"
+
+using AudioCore::ADSP::OpusDecoder::DecodeStreams;
+
+TEST_CASE("DecodeStreams[Inline]", "[audio_core]") {
+    DecodeStreams streams;
+    constexpr std::array<u64, 6> stream_ids{0x1000, 0x2000, 0x3000, 0x4000, 0x5000, 0x6000};
+
+    // Each stream is decoded from its own thread, like sessions of the service
+    std::array<std::thread::id, stream_ids.size()> session_threads;
+    std::array<std::vector<std::thread::id>, stream_ids.size()> job_threads;
+    std::array<std::vector<u32>, stream_ids.size()> job_order;
+    std::vector<std::jthread> sessions;
+    for (size_t stream = 0; stream < stream_ids.size(); stream++) {
+        sessions.emplace_back([&, stream] {
+            session_threads[stream] = std::this_thread::get_id();
+            for (u32 packet = 0; packet < 50; packet++) {
+                streams.Run(stream_ids[stream], [&, stream, packet] {
+                    job_threads[stream].push_back(std::this_thread::get_id());
+                    job_order[stream].push_back(packet);
+                });
+            }
+        });
+    }
+    sessions.clear();
+
+    for (size_t stream = 0; stream < stream_ids.size(); stream++) {
+        REQUIRE(job_order[stream].size() == 50);
+        for (u32 packet = 0; packet < 50; packet++) {
+            REQUIRE(job_order[stream][packet] == packet);
+            REQUIRE(job_threads[stream][packet] == session_threads[stream]);
+        }
+
+        const auto metrics{streams.GetStreamMetrics(stream_ids[stream])};
+        REQUIRE(metrics.has_value());
+        REQUIRE(metrics->jobs == 50);
+        REQUIRE(metrics->max_wait_us <= metrics->total_wait_us);
+        REQUIRE(metrics->max_run_us <= metrics->total_run_us);
+    }
+
+    REQUIRE(streams.RemoveStream(stream_ids[0])->jobs == 50);
+    REQUIRE(!streams.GetStreamMetrics(stream_ids[0]).has_value());
+    REQUIRE(!streams.RemoveStream(stream_ids[0]).has_value());
+}
+
+TEST_CASE("DecodeStreams[Concurrent]", "[audio_core]") {
+    DecodeStreams streams;
+
+    // The packet of the first stream waits for the packet of the second, which only runs if
+    // different streams are decoded at the same time
+    Common::Event first_started;
+    std::atomic<bool> second_ran{};
+    std::jthread first{[&] {
+        streams.Run(0x1000, [&] {
+            first_started.Set();
+            while (!second_ran) {
+                std::this_thread::yield();
+            }
+        });
+    }};
+    first_started.Wait();
+    streams.Run(0x2000, [&] { second_ran = true; });
+    first.join();
+
+    REQUIRE(streams.GetStreamMetrics(0x1000)->jobs == 1);
+    REQUIRE(streams.GetStreamMetrics(0x2000)->jobs == 1);
+}
+
+TEST_CASE("DecodeStreams[SameStream]", "[audio_core]") {
+    DecodeStreams streams;
+
+    // Two sessions decoding one stream never run its packets at the same time
+    std::atomic<u32> running{};
+    std::atomic<bool> overlapped{};
+    const auto session{[&] {
+        for (u32 packet = 0; packet < 200; packet++) {
+            streams.Run(0x1000, [&] {
+                if (running.fetch_add(1) != 0) {
+                    overlapped = true;
+                }
+                std::this_thread::yield();
+                running.fetch_sub(1);
+            });
+        }
+    }};
+    {
+        std::jthread first{session};
+        std::jthread second{session};
+    }
+
+    REQUIRE(!overlapped);
+    REQUIRE(streams.GetStreamMetrics(0x1000)->jobs == 400);
+}
+
+TEST_CASE("DecodeStreams[RemoveWhileRunning]", "[audio_core]") {
+    DecodeStreams streams;
+
+    // A stream removed while its packet runs is only removed once the packet has finished
+    Common::Event started;
+    std::atomic<bool> finished{};
+    std::jthread session{[&] {
+        streams.Run(0x1000, [&] {
+            started.Set();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            finished = true;
+        });
+    }};
+    started.Wait();
+    const auto metrics{streams.RemoveStream(0x1000)};
+    REQUIRE(finished);
+    REQUIRE(metrics.has_value());
+    REQUIRE(metrics->jobs == 1);
+    REQUIRE(!streams.GetStreamMetrics(0x1000).has_value());
+}
@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "audio_core/sink/latency_controller.h"
+
+namespace {
+
+using AudioCore::Sink::LatencyController;
+
+constexpr u64 CALLBACK_FRAMES = 480;
+
+// Run one window of callbacks, producing frames at the given percentage of the playback speed
+void RunWindow(LatencyController& latency, u64 speed_percent, u64 missing_per_callback) {
+    for (u64 frames = 0; frames < LatencyController::WindowFrames; frames += CALLBACK_FRAMES) {
+        latency.AddProducedFrames(CALLBACK_FRAMES * speed_percent / 100);
+        latency.Update(CALLBACK_FRAMES, missing_per_callback);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("LatencyController[GrowOnUnderrun]", "[audio_core]") {
+    LatencyController latency;
+    RunWindow(latency, 100, 0);
+    REQUIRE(latency.GetExtraBuffers() == 0);
+
+    RunWindow(latency, 100, 10);
+    REQUIRE(latency.GetExtraBuffers() == 1);
+    RunWindow(latency, 100, 10);
+    REQUIRE(latency.GetExtraBuffers() == 2);
+
+    for (u32 i = 0; i < LatencyController::MaxExtraBuffers * 2; i++) {
+        RunWindow(latency, 100, 10);
+    }
+    REQUIRE(latency.GetExtraBuffers() == LatencyController::MaxExtraBuffers);
+}
+
+TEST_CASE("LatencyController[ShrinkWhenStable]", "[audio_core]") {
+    LatencyController latency;
+    RunWindow(latency, 100, 10);
+    RunWindow(latency, 100, 10);
+    REQUIRE(latency.GetExtraBuffers() == 2);
+
+    for (u32 i = 0; i < LatencyController::StableWindows - 1; i++) {
+        RunWindow(latency, 100, 0);
+    }
+    REQUIRE(latency.GetExtraBuffers() == 2);
+    RunWindow(latency, 100, 0);
+    REQUIRE(latency.GetExtraBuffers() == 1);
+
+    // An underrun restarts the count
+    for (u32 i = 0; i < LatencyController::StableWindows - 1; i++) {
+        RunWindow(latency, 100, 0);
+    }
+    RunWindow(latency, 100, 10);
+    REQUIRE(latency.GetExtraBuffers() == 2);
+    for (u32 i = 0; i < LatencyController::StableWindows * 2; i++) {
+        RunWindow(latency, 100, 0);
+    }
+    REQUIRE(latency.GetExtraBuffers() == 0);
+}
+
+TEST_CASE("LatencyController[RunningSlowly]", "[audio_core]") {
+    LatencyController latency;
+    // Queueing more can't help when samples are produced slower than they are played
+    for (u32 i = 0; i < 4; i++) {
+        RunWindow(latency, 80, 100);
+    }
+    REQUIRE(latency.GetExtraBuffers() == 0);
+
+    // Back at full speed, underruns are down to the host again
+    RunWindow(latency, 100, 10);
+    REQUIRE(latency.GetExtraBuffers() == 1);
+}
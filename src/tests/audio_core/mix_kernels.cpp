@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "audio_core/renderer/command/mix/mix_kernels.h"
+#include "audio_core/renderer/command/mix/mix_ramp.h"
+#include "common/fixed_point.h"
+
+namespace {
+
+using AudioCore::Renderer::MixKernel;
+
+constexpr u32 MAX_SAMPLE_COUNT = 300;
+constexpr std::size_t NUM_ITERATIONS = 2000;
+
+// The fixed point loops the mix and volume commands used before the kernels
+template <size_t Q>
+void ReferenceGainRamp(std::vector<s32>& output, const std::vector<s32>& input, f32 volume_,
+                       f32 ramp_, u32 sample_count, bool accumulate) {
+    Common::FixedPoint<64 - Q, Q> volume{volume_};
+    const Common::FixedPoint<64 - Q, Q> ramp{ramp_};
+    for (u32 i = 0; i < sample_count; i++) {
+        if (accumulate) {
+            output[i] = (output[i] + input[i] * volume).to_int();
+        } else {
+            output[i] = (input[i] * volume).to_int();
+        }
+        volume += ramp;
+    }
+}
+
+template <size_t Q>
+void CompareWithReference(MixKernel kernel, std::mt19937& rng) {
+    std::uniform_int_distribution<s32> sample_dist{std::numeric_limits<s32>::min(),
+                                                   std::numeric_limits<s32>::max()};
+    std::uniform_int_distribution<u32> count_dist{0, MAX_SAMPLE_COUNT};
+    std::uniform_real_distribution<f32> volume_dist{-4.0f, 4.0f};
+    std::uniform_real_distribution<f32> ramp_dist{-0.01f, 0.01f};
+
+    std::vector<s32> input(MAX_SAMPLE_COUNT);
+    std::vector<s32> expected(MAX_SAMPLE_COUNT);
+    std::vector<s32> output(MAX_SAMPLE_COUNT);
+    for (std::size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+        for (std::size_t i = 0; i < MAX_SAMPLE_COUNT; ++i) {
+            input[i] = sample_dist(rng);
+            expected[i] = sample_dist(rng);
+        }
+        // Small samples keep the sums in range of the real mixes, large ones test wrapping
+        if (iteration % 2 == 0) {
+            for (std::size_t i = 0; i < MAX_SAMPLE_COUNT; ++i) {
+                input[i] >>= 12;
+                expected[i] >>= 12;
+            }
+        }
+        output = expected;
+
+        const u32 sample_count = count_dist(rng);
+        const f32 volume = volume_dist(rng);
+        const f32 ramp = iteration % 3 == 0 ? 0.0f : ramp_dist(rng);
+        const bool accumulate = iteration % 5 != 0;
+        ReferenceGainRamp<Q>(expected, input, volume, ramp, sample_count, accumulate);
+        AudioCore::Renderer::ApplyGainRamp<Q>(
+            kernel, output, input, Common::FixedPoint<64 - Q, Q>{volume}.to_raw(),
+            Common::FixedPoint<64 - Q, Q>{ramp}.to_raw(), sample_count, accumulate);
+        REQUIRE(output == expected);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MixKernels[MatchFixedPoint]", "[audio_core]") {
+    std::mt19937 rng{0x4D495831};
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        CompareWithReference<15>(kernel, rng);
+        CompareWithReference<23>(kernel, rng);
+    }
+}
+
+TEST_CASE("MixKernels[InPlace]", "[audio_core]") {
+    std::mt19937 rng{0x4D495832};
+    std::uniform_int_distribution<s32> sample_dist{-0x100000, 0x100000};
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        std::vector<s32> expected(MAX_SAMPLE_COUNT);
+        for (s32& sample : expected) {
+            sample = sample_dist(rng);
+        }
+        std::vector<s32> output = expected;
+        ReferenceGainRamp<15>(expected, expected, 0.75f, 0.001f, MAX_SAMPLE_COUNT, false);
+        AudioCore::Renderer::ApplyGainRamp<15>(
+            kernel, output, output, Common::FixedPoint<49, 15>{0.75f}.to_raw(),
+            Common::FixedPoint<49, 15>{0.001f}.to_raw(), MAX_SAMPLE_COUNT, false);
+        REQUIRE(output == expected);
+    }
+}
+
+TEST_CASE("MixKernels[LoudVolume]", "[audio_core]") {
+    // Gains past 32 bits fall back to the scalar loop
+    std::vector<s32> input(MAX_SAMPLE_COUNT);
+    for (std::size_t i = 0; i < MAX_SAMPLE_COUNT; ++i) {
+        input[i] = static_cast<s32>(i) - 150;
+    }
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        std::vector<s32> expected(MAX_SAMPLE_COUNT, 7);
+        std::vector<s32> output = expected;
+        ReferenceGainRamp<23>(expected, input, 250.0f, 0.5f, MAX_SAMPLE_COUNT, true);
+        AudioCore::Renderer::ApplyGainRamp<23>(
+            kernel, output, input, Common::FixedPoint<41, 23>{250.0f}.to_raw(),
+            Common::FixedPoint<41, 23>{0.5f}.to_raw(), MAX_SAMPLE_COUNT, true);
+        REQUIRE(output == expected);
+    }
+}
+
+TEST_CASE("MixKernels[MixRampLastSample]", "[audio_core]") {
+    std::vector<s32> input(MAX_SAMPLE_COUNT);
+    for (std::size_t i = 0; i < MAX_SAMPLE_COUNT; ++i) {
+        input[i] = static_cast<s32>(i * 977) - 0x10000;
+    }
+    std::vector<s32> output(MAX_SAMPLE_COUNT);
+    const s32 last = AudioCore::Renderer::ApplyMixRamp<15>(output, input, 0.5f, 0.002f,
+                                                           MAX_SAMPLE_COUNT);
+    Common::FixedPoint<49, 15> volume{0.5f};
+    const Common::FixedPoint<49, 15> ramp{0.002f};
+    for (u32 i = 0; i < MAX_SAMPLE_COUNT - 1; i++) {
+        volume += ramp;
+    }
+    REQUIRE(last == (input.back() * volume).to_int());
+    REQUIRE(AudioCore::Renderer::ApplyMixRamp<15>(output, input, 0.5f, 0.002f, 0) == 0);
+}
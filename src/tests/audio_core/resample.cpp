@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "audio_core/renderer/command/resample/resample.h"
+
+namespace {
+
+using AudioCore::Renderer::MixKernel;
+using AudioCore::SrcQuality;
+using AudioCore::Renderer::Resample;
+using Ratio = Common::FixedPoint<49, 15>;
+
+constexpr u32 TARGET_SAMPLE_RATE = 48000;
+constexpr u32 SAMPLES_PER_CALL = 240;
+
+constexpr std::array<SrcQuality, 2> FILTERED_QUALITIES{SrcQuality::Medium, SrcQuality::High};
+
+std::vector<s16> RandomInput(std::mt19937& rng, std::size_t size) {
+    std::uniform_int_distribution<int> dist{-32768, 32767};
+    std::vector<s16> input(size);
+    for (s16& sample : input) {
+        sample = static_cast<s16>(dist(rng));
+    }
+    return input;
+}
+
+// Input samples read for a call, with room for the filter taps past the last read position
+std::size_t InputSize(f32 ratio, u32 sample_count) {
+    return static_cast<std::size_t>(ratio * static_cast<f32>(sample_count)) + 16;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("Resample[MatchScalar]", "[audio_core]") {
+    static constexpr std::array<f32, 6> ratios{32000.0f / 48000.0f, 22050.0f / 48000.0f,
+                                               44100.0f / 48000.0f, 1.0f, 1.2f, 1.7f};
+    std::mt19937 rng{0x52455331};
+    for (const f32 ratio_value : ratios) {
+        const Ratio ratio{ratio_value};
+        for (const SrcQuality quality : FILTERED_QUALITIES) {
+            // Odd sample counts leave a tail for the scalar loop, and several calls carry the
+            // fraction over
+            for (const u32 sample_count : {1U, 7U, SAMPLES_PER_CALL, 243U}) {
+                const std::vector<s16> input = RandomInput(rng, InputSize(ratio_value, 243));
+                std::vector<s32> expected(sample_count);
+                Ratio expected_fraction{0.25f};
+                Resample(MixKernel::Scalar, expected, input, ratio, expected_fraction,
+                         sample_count, quality);
+                Resample(MixKernel::Scalar, expected, input, ratio, expected_fraction,
+                         sample_count, quality);
+
+                for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+                    std::vector<s32> output(sample_count);
+                    Ratio fraction{0.25f};
+                    Resample(kernel, output, input, ratio, fraction, sample_count, quality);
+                    Resample(kernel, output, input, ratio, fraction, sample_count, quality);
+                    REQUIRE(output == expected);
+                    REQUIRE(fraction.to_raw() == expected_fraction.to_raw());
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Resample[Benchmark]", "[.benchmark][audio_core]") {
+    static constexpr std::size_t NUM_CALLS = 20000;
+    std::mt19937 rng{0x52455332};
+    for (const u32 sample_rate : {32000U, 22050U}) {
+        const f32 ratio_value =
+            static_cast<f32>(sample_rate) / static_cast<f32>(TARGET_SAMPLE_RATE);
+        const Ratio ratio{ratio_value};
+        const std::vector<s16> input = RandomInput(rng, InputSize(ratio_value, SAMPLES_PER_CALL));
+        std::vector<s32> output(SAMPLES_PER_CALL);
+        for (const SrcQuality quality : FILTERED_QUALITIES) {
+            for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+                const auto begin = std::chrono::steady_clock::now();
+                for (std::size_t call = 0; call < NUM_CALLS; ++call) {
+                    Ratio fraction{0};
+                    Resample(kernel, output, input, ratio, fraction, SAMPLES_PER_CALL, quality);
+                }
+                const auto end = std::chrono::steady_clock::now();
+                const double ns = std::chrono::duration<double, std::nano>(end - begin).count();
+                printf("Resample %u Hz, %s quality, kernel %u: %.2f ns/sample\n", sample_rate,
+                       quality == SrcQuality::High ? "high" : "medium",
+                       static_cast<unsigned>(kernel),
+                       ns / static_cast<double>(NUM_CALLS * SAMPLES_PER_CALL));
+            }
+        }
+    }
+}
@@ -0,0 +1,454 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/renderer/command/effect/i3dl2_reverb.h"
+#include "audio_core/renderer/command/effect/reverb.h"
+#include "common/fixed_point.h"
+
+namespace {
+
+using namespace AudioCore::Renderer;
+using AudioCore::ADSP::AudioRenderer::CommandListProcessor;
+using AudioCore::Channels;
+using ReverbFixed = Common::FixedPoint<50, 14>;
+
+constexpr u32 BUFFER_COUNT = 12;
+constexpr u32 NUM_CONFIGURATIONS = 24;
+constexpr u32 NUM_FRAMES = 12;
+
+// The per-sample loops the effects ran before they were processed in blocks, kept as the
+// reference for the block versions
+
+ReverbFixed ReferenceAllPassTick(ReverbInfo::ReverbDelayLine& decay,
+                                 ReverbInfo::ReverbDelayLine& fdn, const ReverbFixed mix) {
+    const auto val{decay.Read()};
+    const auto mixed{mix - (val * decay.decay)};
+    const auto out{decay.Tick(mixed) + (mixed * decay.decay)};
+
+    fdn.Tick(out);
+    return out;
+}
+
+template <size_t NumChannels>
+void ReferenceReverb(const ReverbInfo::ParameterVersion2& params, ReverbInfo::State& state,
+                     std::span<std::span<const s32>> inputs, std::span<std::span<s32>> outputs,
+                     const u32 sample_count) {
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes1Ch{
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes2Ch{
+        0, 0, 1, 1, 0, 1, 0, 0, 1, 1,
+    };
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes4Ch{
+        0, 0, 1, 1, 0, 1, 2, 2, 3, 3,
+    };
+    static constexpr std::array<u8, ReverbInfo::MaxDelayTaps> OutTapIndexes6Ch{
+        0, 0, 1, 1, 2, 2, 4, 4, 5, 5,
+    };
+
+    std::span<const u8> tap_indexes{};
+    if constexpr (NumChannels == 1) {
+        tap_indexes = OutTapIndexes1Ch;
+    } else if constexpr (NumChannels == 2) {
+        tap_indexes = OutTapIndexes2Ch;
+    } else if constexpr (NumChannels == 4) {
+        tap_indexes = OutTapIndexes4Ch;
+    } else if constexpr (NumChannels == 6) {
+        tap_indexes = OutTapIndexes6Ch;
+    }
+
+    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
+        std::array<ReverbFixed, NumChannels> output_samples{};
+
+        for (u32 early_tap = 0; early_tap < ReverbInfo::MaxDelayTaps; early_tap++) {
+            const auto sample{state.pre_delay_line.TapOut(state.early_delay_times[early_tap]) *
+                              state.early_gains[early_tap]};
+            output_samples[tap_indexes[early_tap]] += sample;
+            if constexpr (NumChannels == 6) {
+                output_samples[static_cast<u32>(Channels::LFE)] += sample;
+            }
+        }
+
+        if constexpr (NumChannels == 6) {
+            output_samples[static_cast<u32>(Channels::LFE)] *= 0.2f;
+        }
+
+        ReverbFixed input_sample{};
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            input_sample += inputs[channel][sample_index];
+        }
+
+        input_sample *= 64;
+        input_sample *= ReverbFixed::from_base(params.base_gain);
+        state.pre_delay_line.Write(input_sample);
+
+        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
+            state.prev_feedback_output[i] =
+                state.prev_feedback_output[i] * state.hf_decay_prev_gain[i] +
+                state.fdn_delay_lines[i].Read() * state.hf_decay_gain[i];
+        }
+
+        ReverbFixed pre_delay_sample{state.pre_delay_line.TapOut(state.pre_delay_time) *
+                                     ReverbFixed::from_base(params.late_gain)};
+
+        std::array<ReverbFixed, ReverbInfo::MaxDelayLines> mix_matrix{
+            state.prev_feedback_output[2] + state.prev_feedback_output[1] + pre_delay_sample,
+            -state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+            state.prev_feedback_output[0] - state.prev_feedback_output[3] + pre_delay_sample,
+            state.prev_feedback_output[1] - state.prev_feedback_output[2] + pre_delay_sample,
+        };
+
+        std::array<ReverbFixed, ReverbInfo::MaxDelayLines> allpass_samples{};
+        for (u32 i = 0; i < ReverbInfo::MaxDelayLines; i++) {
+            allpass_samples[i] = ReferenceAllPassTick(state.decay_delay_lines[i],
+                                                      state.fdn_delay_lines[i], mix_matrix[i]);
+        }
+
+        const auto dry_gain{ReverbFixed::from_base(params.dry_gain)};
+        const auto wet_gain{ReverbFixed::from_base(params.wet_gain)};
+
+        if constexpr (NumChannels == 6) {
+            const std::array<ReverbFixed, AudioCore::MaxChannels> allpass_outputs{
+                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
+                allpass_samples[3], allpass_samples[2], allpass_samples[3],
+            };
+
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                auto in_sample{inputs[channel][sample_index] * dry_gain};
+
+                ReverbFixed allpass{};
+                if (channel == static_cast<u32>(Channels::Center)) {
+                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
+                } else {
+                    allpass = allpass_outputs[channel];
+                }
+
+                auto out_sample{((output_samples[channel] + allpass) * wet_gain) / 64};
+                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+            }
+        } else {
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                auto in_sample{inputs[channel][sample_index] * dry_gain};
+                auto out_sample{((output_samples[channel] + allpass_samples[channel]) * wet_gain) /
+                                64};
+                outputs[channel][sample_index] = (in_sample + out_sample).to_int();
+            }
+        }
+    }
+}
+
+constexpr std::array<f32, I3dl2ReverbInfo::MaxDelayTaps> ReferenceEarlyGains{
+    0.67096f, 0.61027f, 1.0f,     0.3568f,  0.68361f, 0.65978f, 0.51939f,
+    0.24712f, 0.45945f, 0.45021f, 0.64196f, 0.54879f, 0.92925f, 0.3827f,
+    0.72867f, 0.69794f, 0.5464f,  0.24563f, 0.45214f, 0.44042f};
+
+ReverbFixed ReferenceAllPassTick(I3dl2ReverbInfo::I3dl2DelayLine& decay0,
+                                 I3dl2ReverbInfo::I3dl2DelayLine& decay1,
+                                 I3dl2ReverbInfo::I3dl2DelayLine& fdn, const ReverbFixed mix) {
+    auto val{decay0.Read()};
+    auto mixed{mix - (val * decay0.wet_gain)};
+    auto out{decay0.Tick(mixed) + (mixed * decay0.wet_gain)};
+
+    val = decay1.Read();
+    mixed = out - (val * decay1.wet_gain);
+    out = decay1.Tick(mixed) + (mixed * decay1.wet_gain);
+
+    fdn.Tick(out);
+    return out;
+}
+
+template <size_t NumChannels>
+void ReferenceI3dl2Reverb(I3dl2ReverbInfo::State& state, std::span<std::span<const s32>> inputs,
+                          std::span<std::span<s32>> outputs, const u32 sample_count) {
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes1Ch{
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    };
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes2Ch{
+        0, 0, 0, 1, 1, 1, 1, 0, 0, 0, 1, 1, 1, 0, 0, 0, 0, 1, 1, 1,
+    };
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes4Ch{
+        0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 0, 0, 0, 0, 3, 3, 3,
+    };
+    static constexpr std::array<u8, I3dl2ReverbInfo::MaxDelayTaps> OutTapIndexes6Ch{
+        2, 0, 0, 1, 1, 1, 1, 4, 4, 4, 1, 1, 1, 0, 0, 0, 0, 5, 5, 5,
+    };
+
+    std::span<const u8> tap_indexes{};
+    if constexpr (NumChannels == 1) {
+        tap_indexes = OutTapIndexes1Ch;
+    } else if constexpr (NumChannels == 2) {
+        tap_indexes = OutTapIndexes2Ch;
+    } else if constexpr (NumChannels == 4) {
+        tap_indexes = OutTapIndexes4Ch;
+    } else if constexpr (NumChannels == 6) {
+        tap_indexes = OutTapIndexes6Ch;
+    }
+
+    for (u32 sample_index = 0; sample_index < sample_count; sample_index++) {
+        ReverbFixed early_to_late_tap{state.early_delay_line.TapOut(state.early_to_late_taps)};
+        std::array<ReverbFixed, NumChannels> output_samples{};
+
+        for (u32 early_tap = 0; early_tap < I3dl2ReverbInfo::MaxDelayTaps; early_tap++) {
+            output_samples[tap_indexes[early_tap]] +=
+                state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
+                ReferenceEarlyGains[early_tap];
+            if constexpr (NumChannels == 6) {
+                output_samples[static_cast<u32>(Channels::LFE)] +=
+                    state.early_delay_line.TapOut(state.early_tap_steps[early_tap]) *
+                    ReferenceEarlyGains[early_tap];
+            }
+        }
+
+        ReverbFixed current_sample{};
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            current_sample += inputs[channel][sample_index];
+        }
+
+        state.lowpass_0 =
+            (current_sample * state.lowpass_2 + state.lowpass_0 * state.lowpass_1).to_float();
+        state.early_delay_line.Tick(state.lowpass_0);
+
+        for (u32 channel = 0; channel < NumChannels; channel++) {
+            output_samples[channel] *= state.early_gain;
+        }
+
+        std::array<ReverbFixed, I3dl2ReverbInfo::MaxDelayLines> filtered_samples{};
+        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+            filtered_samples[delay_line] =
+                state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][0] +
+                state.shelf_filter[delay_line];
+            state.shelf_filter[delay_line] =
+                (filtered_samples[delay_line] * state.lowpass_coeff[delay_line][2] +
+                 state.fdn_delay_lines[delay_line].Read() * state.lowpass_coeff[delay_line][1])
+                    .to_float();
+        }
+
+        const std::array<ReverbFixed, I3dl2ReverbInfo::MaxDelayLines> mix_matrix{
+            filtered_samples[1] + filtered_samples[2] + early_to_late_tap * state.late_gain,
+            -filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
+            filtered_samples[0] - filtered_samples[3] + early_to_late_tap * state.late_gain,
+            filtered_samples[1] - filtered_samples[2] + early_to_late_tap * state.late_gain,
+        };
+
+        std::array<ReverbFixed, I3dl2ReverbInfo::MaxDelayLines> allpass_samples{};
+        for (u32 delay_line = 0; delay_line < I3dl2ReverbInfo::MaxDelayLines; delay_line++) {
+            allpass_samples[delay_line] = ReferenceAllPassTick(
+                state.decay_delay_lines0[delay_line], state.decay_delay_lines1[delay_line],
+                state.fdn_delay_lines[delay_line], mix_matrix[delay_line]);
+        }
+
+        if constexpr (NumChannels == 6) {
+            const std::array<ReverbFixed, AudioCore::MaxChannels> allpass_outputs{
+                allpass_samples[0], allpass_samples[1], allpass_samples[2] - allpass_samples[3],
+                allpass_samples[3], allpass_samples[2], allpass_samples[3],
+            };
+
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                ReverbFixed allpass{};
+
+                if (channel == static_cast<u32>(Channels::Center)) {
+                    allpass = state.center_delay_line.Tick(allpass_outputs[channel] * 0.5f);
+                } else {
+                    allpass = allpass_outputs[channel];
+                }
+
+                auto out_sample{output_samples[channel] + allpass +
+                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+
+                outputs[channel][sample_index] =
+                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+            }
+        } else {
+            for (u32 channel = 0; channel < NumChannels; channel++) {
+                auto out_sample{output_samples[channel] + allpass_samples[channel] +
+                                state.dry_gain * static_cast<f32>(inputs[channel][sample_index])};
+                outputs[channel][sample_index] =
+                    static_cast<s32>(std::clamp(out_sample.to_float(), -8388600.0f, 8388600.0f));
+            }
+        }
+    }
+}
+
+s32 RandomQ14(std::mt19937& rng, f32 min, f32 max) {
+    return static_cast<s32>(std::uniform_real_distribution<f32>{min, max}(rng) * 16384.0f);
+}
+
+void RandomizeParameter(std::mt19937& rng, ReverbInfo::ParameterVersion2& params) {
+    params.early_mode = rng() % ReverbInfo::NumEarlyModes;
+    params.early_gain = RandomQ14(rng, 0.0f, 1.0f);
+    params.pre_delay = RandomQ14(rng, 0.0f, 300.0f);
+    params.late_mode = rng() % ReverbInfo::NumLateModes;
+    params.late_gain = RandomQ14(rng, 0.0f, 1.0f);
+    params.decay_time = RandomQ14(rng, 0.1f, 20.0f);
+    params.high_freq_decay_ratio = RandomQ14(rng, 0.1f, 1.0f);
+    params.colouration = RandomQ14(rng, 0.0f, 1.0f);
+    params.base_gain = RandomQ14(rng, 0.0f, 1.0f);
+    params.wet_gain = RandomQ14(rng, 0.0f, 1.0f);
+    params.dry_gain = RandomQ14(rng, 0.0f, 1.0f);
+}
+
+void RandomizeParameter(std::mt19937& rng, I3dl2ReverbInfo::ParameterVersion1& params) {
+    std::uniform_real_distribution<f32> dist{0.0f, 1.0f};
+    params.room_HF_gain = -2000.0f * dist(rng);
+    params.reference_HF = 20.0f + 19980.0f * dist(rng);
+    params.late_reverb_decay_time = 0.1f + 19.9f * dist(rng);
+    params.late_reverb_HF_decay_ratio = 0.1f + 1.9f * dist(rng);
+    params.room_gain = -2000.0f * dist(rng);
+    params.reflection_gain = -2000.0f + 3000.0f * dist(rng);
+    params.reverb_gain = -2000.0f + 4000.0f * dist(rng);
+    params.late_reverb_diffusion = 100.0f * dist(rng);
+    params.reflection_delay = 0.2f * dist(rng);
+    params.late_reverb_delay_time = 0.1f * dist(rng);
+    params.late_reverb_density = 100.0f * dist(rng);
+    params.dry_gain = dist(rng);
+}
+
+/**
+ * Run an effect command over a number of frames against the reference loop, from the same input.
+ * Both sides initialize and update their state with the command itself, the reference by
+ * processing it over no samples, so only the sample loops are compared.
+ */
+template <typename Command, typename State, typename Reference>
+void MatchReference(Command& command, u32 channel_count, u32 sample_count, std::mt19937& rng,
+                    Reference&& reference) {
+    std::vector<s32> buffers(BUFFER_COUNT * sample_count);
+    std::vector<s32> reference_buffers(BUFFER_COUNT * sample_count);
+    State state{};
+    State reference_state{};
+
+    CommandListProcessor processor{};
+    processor.sample_count = sample_count;
+    processor.buffer_count = BUFFER_COUNT;
+    processor.mix_buffers = buffers;
+    CommandListProcessor reference_processor{};
+    reference_processor.buffer_count = BUFFER_COUNT;
+    reference_processor.mix_buffers = reference_buffers;
+
+    // Loud frames now and then, to reach the top of the fixed point range
+    std::uniform_int_distribution<s32> quiet{-0x8000, 0x7FFF};
+    std::uniform_int_distribution<s32> loud{-0x7FFFFF, 0x7FFFFF};
+
+    for (u32 frame = 0; frame < NUM_FRAMES; frame++) {
+        const bool is_loud{frame % 4 == 3};
+        for (s32& sample : buffers) {
+            sample = is_loud ? loud(rng) : quiet(rng);
+        }
+        reference_buffers = buffers;
+
+        if (frame == 0) {
+            command.parameter.state = EffectInfoBase::ParameterState::Initialized;
+        } else if (rng() % 4 == 0) {
+            RandomizeParameter(rng, command.parameter);
+            command.parameter.state = EffectInfoBase::ParameterState::Updating;
+        } else {
+            command.parameter.state = EffectInfoBase::ParameterState::Updated;
+        }
+
+        command.state = reinterpret_cast<AudioCore::CpuAddr>(&state);
+        command.Process(processor);
+
+        command.state = reinterpret_cast<AudioCore::CpuAddr>(&reference_state);
+        command.Process(reference_processor);
+        std::array<std::span<const s32>, AudioCore::MaxChannels> inputs{};
+        std::array<std::span<s32>, AudioCore::MaxChannels> outputs{};
+        for (u32 channel = 0; channel < channel_count; channel++) {
+            inputs[channel] = std::span<const s32>(reference_buffers)
+                                  .subspan(command.inputs[channel] * sample_count, sample_count);
+            outputs[channel] = std::span(reference_buffers)
+                                   .subspan(command.outputs[channel] * sample_count, sample_count);
+        }
+        reference(command.parameter, reference_state, inputs, outputs);
+
+        REQUIRE(buffers == reference_buffers);
+    }
+}
+
+template <typename Command>
+void SetupCommand(Command& command, std::mt19937& rng, u32 channel_count) {
+    // Processed in place, or into separate buffers
+    const bool in_place{rng() % 2 == 0};
+    for (u32 channel = 0; channel < channel_count; channel++) {
+        command.inputs[channel] = static_cast<s16>(channel);
+        command.outputs[channel] =
+            static_cast<s16>(in_place ? channel : AudioCore::MaxChannels + channel);
+    }
+    command.parameter.channel_count_max = static_cast<u16>(AudioCore::MaxChannels);
+    command.parameter.channel_count = static_cast<u16>(channel_count);
+    command.effect_enabled = true;
+    RandomizeParameter(rng, command.parameter);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ReverbCommand[MatchPerSample]", "[audio_core]") {
+    std::mt19937 rng{0x52455642};
+    for (const u32 channel_count : {1U, 2U, 4U, 6U}) {
+        for (u32 configuration = 0; configuration < NUM_CONFIGURATIONS; configuration++) {
+            ReverbCommand command{};
+            SetupCommand(command, rng, channel_count);
+            command.parameter.sample_rate = 48 << 14;
+            command.long_size_pre_delay_supported = rng() % 2 == 0;
+
+            // 240 samples a frame at 48kHz, and a count which isn't a multiple of the block
+            const u32 sample_count{configuration % 2 == 0 ? 240U : 97U};
+            MatchReference<ReverbCommand, ReverbInfo::State>(
+                command, channel_count, sample_count, rng,
+                [&](const auto& params, auto& state, auto inputs, auto outputs) {
+                    switch (channel_count) {
+                    case 1:
+                        ReferenceReverb<1>(params, state, inputs, outputs, sample_count);
+                        break;
+                    case 2:
+                        ReferenceReverb<2>(params, state, inputs, outputs, sample_count);
+                        break;
+                    case 4:
+                        ReferenceReverb<4>(params, state, inputs, outputs, sample_count);
+                        break;
+                    case 6:
+                        ReferenceReverb<6>(params, state, inputs, outputs, sample_count);
+                        break;
+                    }
+                });
+        }
+    }
+}
+
+TEST_CASE("I3dl2ReverbCommand[MatchPerSample]", "[audio_core]") {
+    std::mt19937 rng{0x49334432};
+    for (const u32 channel_count : {1U, 2U, 4U, 6U}) {
+        for (u32 configuration = 0; configuration < NUM_CONFIGURATIONS; configuration++) {
+            I3dl2ReverbCommand command{};
+            SetupCommand(command, rng, channel_count);
+            command.parameter.sample_rate = 48000;
+
+            const u32 sample_count{configuration % 2 == 0 ? 240U : 97U};
+            MatchReference<I3dl2ReverbCommand, I3dl2ReverbInfo::State>(
+                command, channel_count, sample_count, rng,
+                [&](const auto&, auto& state, auto inputs, auto outputs) {
+                    switch (channel_count) {
+                    case 1:
+                        ReferenceI3dl2Reverb<1>(state, inputs, outputs, sample_count);
+                        break;
+                    case 2:
+                        ReferenceI3dl2Reverb<2>(state, inputs, outputs, sample_count);
+                        break;
+                    case 4:
+                        ReferenceI3dl2Reverb<4>(state, inputs, outputs, sample_count);
+                        break;
+                    case 6:
+                        ReferenceI3dl2Reverb<6>(state, inputs, outputs, sample_count);
+                        break;
+                    }
+                });
+        }
+    }
+}
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "audio_core/renderer/command/effect/reverb_kernels.h"
+#include "common/fixed_point.h"
+
+namespace {
+
+using AudioCore::Renderer::MixKernel;
+using ReverbFixed = Common::FixedPoint<50, 14>;
+
+constexpr std::size_t MAX_SAMPLE_COUNT = 70;
+constexpr std::size_t NUM_ITERATIONS = 2000;
+
+// A delay line sample, anywhere from silence up to far louder than any real mix
+s64 RandomSample(std::mt19937_64& rng) {
+    return static_cast<s64>(rng()) >> (24 + rng() % 40);
+}
+
+s64 RandomGain(std::mt19937_64& rng) {
+    return static_cast<s32>(rng()) >> (rng() % 32);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("ReverbKernels[MultiplyMatchFixedPoint]", "[audio_core]") {
+    std::mt19937_64 rng{0x52565231};
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        for (std::size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+            const std::size_t sample_count = rng() % (MAX_SAMPLE_COUNT + 1);
+            std::vector<s64> input(sample_count);
+            std::vector<s64> expected(sample_count);
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                input[i] = RandomSample(rng);
+                expected[i] = RandomSample(rng);
+            }
+            std::vector<s64> output = expected;
+
+            const s64 gain = RandomGain(rng);
+            const bool accumulate = iteration % 2 == 0;
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                const auto product{ReverbFixed::from_base(input[i]) * ReverbFixed::from_base(gain)};
+                expected[i] = accumulate ? (ReverbFixed::from_base(expected[i]) + product).to_raw()
+                                         : product.to_raw();
+            }
+            AudioCore::Renderer::MultiplyReverbSamples(kernel, output, input, gain, accumulate);
+            REQUIRE(output == expected);
+
+            // In place, as the effects scale their taps
+            output = input;
+            AudioCore::Renderer::MultiplyReverbSamples(kernel, output, output, gain, false);
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                REQUIRE(output[i] ==
+                        (ReverbFixed::from_base(input[i]) * ReverbFixed::from_base(gain)).to_raw());
+            }
+        }
+    }
+}
+
+TEST_CASE("ReverbKernels[MixOutputMatchFixedPoint]", "[audio_core]") {
+    std::mt19937_64 rng{0x52565232};
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        for (std::size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+            const std::size_t sample_count = rng() % (MAX_SAMPLE_COUNT + 1);
+            std::vector<s32> input(sample_count);
+            std::vector<s64> wet(sample_count);
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                input[i] = static_cast<s32>(rng()) >> (rng() % 32);
+                wet[i] = RandomSample(rng);
+            }
+
+            const s64 dry_gain = RandomGain(rng);
+            const s64 wet_gain = RandomGain(rng);
+            std::vector<s32> expected(sample_count);
+            for (std::size_t i = 0; i < sample_count; ++i) {
+                const auto in_sample{input[i] * ReverbFixed::from_base(dry_gain)};
+                const auto out_sample{
+                    (ReverbFixed::from_base(wet[i]) * ReverbFixed::from_base(wet_gain)) / 64};
+                expected[i] = (in_sample + out_sample).to_int();
+            }
+            std::vector<s32> output(sample_count);
+            AudioCore::Renderer::MixReverbOutput(kernel, output, input, wet, dry_gain, wet_gain);
+            REQUIRE(output == expected);
+        }
+    }
+}
+
+TEST_CASE("ReverbKernels[LoudGain]", "[audio_core]") {
+    // Gains past 32 bits fall back to the scalar loop
+    constexpr s64 gain = s64{std::numeric_limits<s32>::max()} * 3;
+    std::vector<s64> input(MAX_SAMPLE_COUNT);
+    for (std::size_t i = 0; i < MAX_SAMPLE_COUNT; ++i) {
+        input[i] = (static_cast<s64>(i) - 35) << 20;
+    }
+    for (const MixKernel kernel : AudioCore::Renderer::GetSupportedMixKernels()) {
+        std::vector<s64> output(MAX_SAMPLE_COUNT, 7);
+        AudioCore::Renderer::MultiplyReverbSamples(kernel, output, input, gain, true);
+        for (std::size_t i = 0; i < MAX_SAMPLE_COUNT; ++i) {
+            REQUIRE(output[i] == 7 + ((input[i] >> 14) * gain));
+        }
+    }
+}
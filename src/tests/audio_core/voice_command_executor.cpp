@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "audio_core/adsp/apps/audio_renderer/command_list_processor.h"
+#include "audio_core/adsp/apps/audio_renderer/voice_command_executor.h"
+#include "audio_core/renderer/command/commands.h"
+
+namespace {
+
+using namespace AudioCore::Renderer;
+using AudioCore::ADSP::AudioRenderer::CommandListProcessor;
+using AudioCore::ADSP::AudioRenderer::VoiceCommandExecutor;
+
+constexpr u32 SAMPLE_COUNT = 240;
+constexpr u32 MIX_BUFFER_COUNT = 6;
+// Voices decode into the buffers after the mix buffers, one per channel, shared by every voice
+constexpr u32 CHANNEL_COUNT = 2;
+constexpr u32 BUFFER_COUNT = MIX_BUFFER_COUNT + CHANNEL_COUNT;
+
+// Stands in for decoding a wavebuffer, without needing guest memory
+struct TestDataSourceCommand : PcmInt16DataSourceVersion2Command {
+    void Process(const CommandListProcessor& processor) override {
+        auto output{processor.mix_buffers.subspan(output_index * processor.sample_count,
+                                                  processor.sample_count)};
+        std::mt19937 rng{seed};
+        std::uniform_int_distribution<int> dist{-32768, 32767};
+        for (s32& sample : output) {
+            sample = dist(rng);
+        }
+    }
+
+    u32 seed{};
+};
+
+class TestCommandList {
+public:
+    explicit TestCommandList(u32 voice_count) {
+        std::mt19937 rng{0x564F4943};
+        std::uniform_real_distribution<f32> volume{0.0f, 2.0f};
+        for (u32 voice = 0; voice < voice_count; voice++) {
+            const u32 node_id{(1U << 28) | (voice << 16)};
+            for (u32 channel = 0; channel < CHANNEL_COUNT; channel++) {
+                const auto scratch{static_cast<s16>(MIX_BUFFER_COUNT + channel)};
+
+                auto source{std::make_unique<TestDataSourceCommand>()};
+                source->output_index = scratch;
+                source->seed = node_id | channel;
+                Add(std::move(source), CommandId::DataSourcePcmInt16Version2, node_id, true);
+
+                auto volume_ramp{std::make_unique<VolumeRampCommand>()};
+                volume_ramp->precision = 15;
+                volume_ramp->input_index = scratch;
+                volume_ramp->output_index = scratch;
+                volume_ramp->prev_volume = volume(rng);
+                volume_ramp->volume = volume(rng);
+                Add(std::move(volume_ramp), CommandId::VolumeRamp, node_id, true);
+
+                for (u32 mix = 0; mix < 2; mix++) {
+                    auto mix_ramp{std::make_unique<MixRampCommand>()};
+                    mix_ramp->precision = 15;
+                    mix_ramp->input_index = scratch;
+                    mix_ramp->output_index =
+                        static_cast<s16>((voice + channel + mix * 3) % MIX_BUFFER_COUNT);
+                    mix_ramp->prev_volume = volume(rng);
+                    mix_ramp->volume = volume(rng);
+                    mix_ramp->previous_sample =
+                        reinterpret_cast<AudioCore::CpuAddr>(&previous_samples.emplace_back());
+                    // Dropped voices stay in the list, disabled
+                    Add(std::move(mix_ramp), CommandId::MixRamp, node_id, voice % 5 != 4);
+                }
+            }
+        }
+    }
+
+    CommandListProcessor MakeProcessor(std::vector<s32>& mix_buffers) const {
+        mix_buffers.assign(BUFFER_COUNT * SAMPLE_COUNT, 0);
+        for (u32 i = 0; i < MIX_BUFFER_COUNT * SAMPLE_COUNT; i++) {
+            mix_buffers[i] = static_cast<s32>(i * 7919);
+        }
+        CommandListProcessor processor{};
+        processor.sample_count = SAMPLE_COUNT;
+        processor.buffer_count = BUFFER_COUNT;
+        processor.mix_buffers = mix_buffers;
+        return processor;
+    }
+
+    void RunSequentially(const CommandListProcessor& processor) const {
+        for (ICommand* const command : pointers) {
+            if (command->enabled) {
+                command->Process(processor);
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<ICommand>> commands;
+    std::vector<ICommand*> pointers;
+    // Stable addresses for the depop samples written by the mix commands
+    std::deque<s32> previous_samples;
+
+private:
+    void Add(std::unique_ptr<ICommand> command, CommandId type, u32 node_id, bool enabled) {
+        command->magic = CommandMagic;
+        command->enabled = enabled;
+        command->type = type;
+        command->node_id = node_id;
+        pointers.push_back(command.get());
+        commands.push_back(std::move(command));
+    }
+};
+
+} // Anonymous namespace
+
+TEST_CASE("VoiceCommandExecutor[MatchSequential]", "[audio_core]") {
+    VoiceCommandExecutor executor{3};
+    for (const u32 voice_count : {2U, 3U, 16U, 64U}) {
+        TestCommandList list{voice_count};
+
+        std::vector<s32> expected_buffers;
+        list.RunSequentially(list.MakeProcessor(expected_buffers));
+        const std::deque<s32> expected_previous_samples{list.previous_samples};
+
+        // Run twice, so the slots are reused
+        for (u32 run = 0; run < 2; run++) {
+            std::vector<s32> buffers;
+            std::ranges::fill(list.previous_samples, 0);
+            REQUIRE(executor.Execute(list.MakeProcessor(buffers), list.pointers));
+            for (u32 i = 0; i < MIX_BUFFER_COUNT * SAMPLE_COUNT; i++) {
+                REQUIRE(buffers[i] == expected_buffers[i]);
+            }
+            REQUIRE(list.previous_samples == expected_previous_samples);
+        }
+    }
+}
+
+TEST_CASE("VoiceCommandExecutor[Rejected]", "[audio_core]") {
+    VoiceCommandExecutor executor{2};
+    std::vector<s32> buffers;
+
+    // A single voice has nothing to run alongside
+    TestCommandList single{1};
+    REQUIRE(!executor.Execute(single.MakeProcessor(buffers), single.pointers));
+
+    // A voice mixing into the buffer other voices decode into
+    TestCommandList shared_scratch{4};
+    static_cast<MixRampCommand&>(*shared_scratch.pointers[2]).output_index = MIX_BUFFER_COUNT;
+    REQUIRE(!executor.Execute(shared_scratch.MakeProcessor(buffers), shared_scratch.pointers));
+
+    // Commands which can't run apart from the other voices
+    TestCommandList unknown{4};
+    unknown.pointers[5]->type = CommandId::ClearMixBuffer;
+    REQUIRE(!executor.Execute(unknown.MakeProcessor(buffers), unknown.pointers));
+}
@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/page_table.h"
+
+using Common::PageTable;
+using Common::PageType;
+
+namespace {
+
+constexpr std::size_t PageBits = 12;
+constexpr std::size_t PageSize = std::size_t{1} << PageBits;
+
+struct Run {
+    PageType type;
+    u64 vaddr;
+    std::size_t size;
+    u8* host_ptr;
+
+    bool operator==(const Run&) const = default;
+};
+
+/// Maps a guest page to host memory the way Memory::MapPages does: the stored pointer is the host
+/// pointer minus the guest address, so pages backed by consecutive host memory store the same one.
+void MapPage(PageTable& table, std::size_t page, u8* host_ptr, PageType type = PageType::Memory) {
+    const uintptr_t pointer = reinterpret_cast<uintptr_t>(host_ptr) - (page << PageBits);
+    table.pointers[page].Store(pointer, type);
+}
+
+std::vector<Run> Walk(const PageTable& table, u64 addr, std::size_t size) {
+    std::vector<Run> runs;
+    table.WalkBlock(
+        addr, size,
+        [&](u64 vaddr, std::size_t amount, u8* host_ptr) {
+            runs.push_back({PageType::Memory, vaddr, amount, host_ptr});
+        },
+        [&](PageType type, u64 vaddr, std::size_t amount) {
+            runs.push_back({type, vaddr, amount, nullptr});
+        });
+    return runs;
+}
+
+} // Anonymous namespace
+
+TEST_CASE("PageTable[WalkBlock]", "[common]") {
+    alignas(PageSize) static std::array<u8, PageSize * 4> first{};
+    alignas(PageSize) static std::array<u8, PageSize * 4> second{};
+    alignas(PageSize) static std::array<u8, PageSize * 4> third{};
+
+    PageTable table;
+    table.Resize(24, PageBits);
+
+    // Pages 0-1 are contiguous, page 2 goes through the rasterizer, pages 3-4 are contiguous
+    // again, page 5 is backed by an unrelated allocation and page 6 is unmapped.
+    MapPage(table, 0, first.data());
+    MapPage(table, 1, first.data() + PageSize);
+    MapPage(table, 2, first.data() + PageSize * 2, PageType::RasterizerCachedMemory);
+    MapPage(table, 3, second.data());
+    MapPage(table, 4, second.data() + PageSize);
+    MapPage(table, 5, third.data());
+
+    SECTION("Runs split at page type and backing boundaries") {
+        const std::vector<Run> expected{
+            {PageType::Memory, 0x100, PageSize * 2 - 0x100, first.data() + 0x100},
+            {PageType::RasterizerCachedMemory, PageSize * 2, PageSize, nullptr},
+            {PageType::Memory, PageSize * 3, PageSize * 2, second.data()},
+            {PageType::Memory, PageSize * 5, PageSize, third.data()},
+            {PageType::Unmapped, PageSize * 6, 0x80, nullptr},
+        };
+        REQUIRE(Walk(table, 0x100, PageSize * 6 + 0x80 - 0x100) == expected);
+    }
+
+    SECTION("Runs start and end inside a page") {
+        const std::vector<Run> expected{
+            {PageType::Memory, PageSize * 3 + 0x10, PageSize + 0x20, second.data() + 0x10},
+        };
+        REQUIRE(Walk(table, PageSize * 3 + 0x10, PageSize + 0x20) == expected);
+    }
+
+    SECTION("Contiguous host memory in another page type is not merged") {
+        // Page 2 is backed right after page 1, but must still take the rasterizer path.
+        const std::vector<Run> expected{
+            {PageType::Memory, PageSize, PageSize, first.data() + PageSize},
+            {PageType::RasterizerCachedMemory, PageSize * 2, 0x40, nullptr},
+        };
+        REQUIRE(Walk(table, PageSize, PageSize + 0x40) == expected);
+    }
+}
@@ -0,0 +1,105 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "common/thread.h"
+
+using Common::GetRoleCpus;
+using Common::HostCpu;
+using Common::MakePlacementPlan;
+using Common::PlacementPlan;
+using Common::ThreadRole;
+
+namespace {
+
+/// Makes a host of physical cores with the given number of threads each, numbered like Linux does:
+/// the first thread of every core, then the second thread of every core. Cores are grouped in L3
+/// domains of cores_per_l3 cores.
+std::vector<HostCpu> MakeHost(u32 num_cores, u32 threads_per_core, u32 cores_per_l3) {
+    std::vector<HostCpu> cpus;
+    for (u32 thread = 0; thread < threads_per_core; ++thread) {
+        for (u32 core = 0; core < num_cores; ++core) {
+            cpus.push_back({
+                .id = thread * num_cores + core,
+                .core = core,
+                .l2 = core,
+                .l3 = core / cores_per_l3 * cores_per_l3,
+                .performance = 1000,
+            });
+        }
+    }
+    return cpus;
+}
+
+bool Contains(const std::vector<u32>& cpus, u32 cpu) {
+    return std::ranges::find(cpus, cpu) != cpus.end();
+}
+
+/// Checks that no recorder shares a CPU with an emulated core, the GPU thread or its worker.
+void RequireRecordersOnFreeCpus(const PlacementPlan& plan) {
+    for (const u32 cpu : plan.gpu_recorders) {
+        for (const auto& core : plan.emulated_cores) {
+            REQUIRE(!Contains(core, cpu));
+        }
+        REQUIRE(!Contains(plan.gpu, cpu));
+        REQUIRE(!Contains(plan.gpu_worker, cpu));
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("MakePlacementPlan[RecordersSpreadOverSpareCores]", "[common]") {
+    // Eight cores with two threads each, the GPU worker takes the sibling of the GPU thread
+    const PlacementPlan plan = MakePlacementPlan(MakeHost(8, 2, 8));
+    REQUIRE(plan.gpu == std::vector<u32>{4});
+    REQUIRE(plan.gpu_worker == std::vector<u32>{12});
+    REQUIRE(plan.gpu_recorders.size() > 1);
+    REQUIRE(plan.gpu_recorders.size() == 6);
+    RequireRecordersOnFreeCpus(plan);
+}
+
+TEST_CASE("MakePlacementPlan[RecordersShareGpuL3]", "[common]") {
+    // Two L3 domains of six cores, the GPU thread lands on the first one
+    const PlacementPlan plan = MakePlacementPlan(MakeHost(12, 1, 6));
+    REQUIRE(plan.gpu == std::vector<u32>{4});
+    REQUIRE(plan.gpu_worker == std::vector<u32>{5});
+    // The first domain is full, so the recorders fall back to every spare CPU
+    REQUIRE(plan.gpu_recorders == std::vector<u32>{6, 7, 8, 9, 10, 11});
+    RequireRecordersOnFreeCpus(plan);
+
+    const PlacementPlan shared = MakePlacementPlan(MakeHost(16, 1, 8));
+    REQUIRE(shared.gpu_recorders == std::vector<u32>{6, 7});
+    RequireRecordersOnFreeCpus(shared);
+}
+
+TEST_CASE("MakePlacementPlan[RecordersUnpinnedWithoutSpareCores]", "[common]") {
+    // Every core is taken, a single CPU would serialize the recorders
+    const PlacementPlan six = MakePlacementPlan(MakeHost(6, 1, 6));
+    REQUIRE(six.gpu_worker == std::vector<u32>{5});
+    REQUIRE(six.gpu_recorders.empty());
+
+    const PlacementPlan seven = MakePlacementPlan(MakeHost(7, 1, 7));
+    REQUIRE(seven.others == std::vector<u32>{6});
+    REQUIRE(seven.gpu_recorders.empty());
+}
+
+TEST_CASE("GetRoleCpus[RecordersNotHeldToBackgroundCpus]", "[common]") {
+    // Recorders are pool threads pinned as background threads before they take their role, with
+    // no spare cores they must go back to every CPU rather than share the single background one
+    const PlacementPlan seven = MakePlacementPlan(MakeHost(7, 1, 7));
+    REQUIRE(seven.allowed == std::vector<u32>{0, 1, 2, 3, 4, 5, 6});
+    REQUIRE(GetRoleCpus(seven, ThreadRole::Background) == std::vector<u32>{6});
+    REQUIRE(GetRoleCpus(seven, ThreadRole::GpuRecorder) == seven.allowed);
+
+    // Roles with CPUs of their own keep them
+    const PlacementPlan plan = MakePlacementPlan(MakeHost(8, 2, 8));
+    REQUIRE(GetRoleCpus(plan, ThreadRole::GpuRecorder) == plan.gpu_recorders);
+    REQUIRE(GetRoleCpus(plan, ThreadRole::EmulatedCore, 5) == plan.emulated_cores[1]);
+
+    // Without a topology nothing is pinned
+    REQUIRE(GetRoleCpus(MakePlacementPlan({}), ThreadRole::GpuRecorder).empty());
+}
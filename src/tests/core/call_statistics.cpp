@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/hle/kernel/call_statistics.h"
+#include "core/hle/kernel/svc.h"
+
+namespace {
+
+constexpr u32 SVC_SLEEP_THREAD = static_cast<u32>(Kernel::Svc::SvcId::SleepThread);
+
+} // Anonymous namespace
+
+TEST_CASE("CallStatistics[Histogram]", "[core]") {
+    Kernel::CallStatistics::Histogram histogram;
+    histogram.Add(0);
+    histogram.Add(1);
+    histogram.Add(1000);
+    histogram.Add(1023);
+    histogram.Add(1024);
+    REQUIRE(histogram.count == 5);
+    REQUIRE(histogram.total_ns == 3048);
+    REQUIRE(histogram.max_ns == 1024);
+    REQUIRE(histogram.buckets[0] == 1);
+    REQUIRE(histogram.buckets[1] == 1);
+    REQUIRE(histogram.buckets[10] == 2);
+    REQUIRE(histogram.buckets[11] == 1);
+    REQUIRE(histogram.Percentile(0.5) == 1024);
+    REQUIRE(histogram.Percentile(1.0) == 1024);
+
+    // Latencies past the last bucket land in it
+    histogram.Add(u64{1} << 40);
+    REQUIRE(histogram.buckets.back() == 1);
+    REQUIRE(histogram.Percentile(1.0) == u64{1} << 40);
+}
+
+TEST_CASE("CallStatistics[Recording]", "[core]") {
+    Kernel::CallStatistics stats;
+
+    // Nothing is recorded until enabled
+    stats.RecordSvc(0, SVC_SLEEP_THREAD, stats.BeginCall());
+    REQUIRE(stats.Collect().svcs.empty());
+
+    stats.SetEnabled(true);
+    std::vector<std::jthread> threads;
+    for (std::size_t core = 0; core < 4; ++core) {
+        threads.emplace_back([&stats, core] {
+            for (int i = 0; i < 1000; ++i) {
+                stats.RecordSvc(core, SVC_SLEEP_THREAD, stats.BeginCall());
+                stats.RecordIpc("fsp-srv", 1, "OpenFileSystem", stats.BeginCall());
+            }
+        });
+    }
+    threads.clear();
+    stats.RecordIpc("hid", 100, "ActivateDebugPad", stats.BeginCall());
+
+    const auto snapshot = stats.Collect();
+    REQUIRE(snapshot.svcs.size() == 1);
+    REQUIRE(snapshot.svcs[0].id == SVC_SLEEP_THREAD);
+    REQUIRE(std::string{snapshot.svcs[0].name} == "SleepThread");
+    REQUIRE(snapshot.svcs[0].latency.count == 4000);
+
+    REQUIRE(snapshot.commands.size() == 2);
+    REQUIRE(snapshot.commands[0].service == "fsp-srv");
+    REQUIRE(snapshot.commands[0].command == 1);
+    REQUIRE(snapshot.commands[0].function == "OpenFileSystem");
+    REQUIRE(snapshot.commands[0].latency.count == 4000);
+    REQUIRE(snapshot.commands[1].service == "hid");
+
+    const std::string json = Kernel::CallStatistics::ToJson(snapshot);
+    REQUIRE(json.find("\"SleepThread\"") != std::string::npos);
+    REQUIRE(json.find("\"ActivateDebugPad\"") != std::string::npos);
+
+    stats.Reset();
+    const auto empty = stats.Collect();
+    REQUIRE(empty.svcs.empty());
+    REQUIRE(empty.commands.empty());
+}
+
+TEST_CASE("CallStatistics[Overhead]", "[.benchmark][core]") {
+    static constexpr int CALLS = 1'000'000;
+
+    Kernel::CallStatistics stats;
+    for (const bool enabled : {false, true}) {
+        stats.SetEnabled(enabled);
+        const auto begin = std::chrono::steady_clock::now();
+        for (int i = 0; i < CALLS; ++i) {
+            stats.RecordSvc(0, SVC_SLEEP_THREAD, stats.BeginCall());
+        }
+        const auto end = std::chrono::steady_clock::now();
+        const double ns = std::chrono::duration<double, std::nano>(end - begin).count() / CALLS;
+        std::printf("CallStatistics %s: %.1f ns per supervisor call\n",
+                    enabled ? "enabled" : "disabled", ns);
+    }
+    REQUIRE(stats.Collect().svcs[0].latency.count == CALLS);
+}
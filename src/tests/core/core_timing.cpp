@@ -3,13 +3,19 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <chrono>
 #include <cstdlib>
 #include <memory>
 #include <optional>
+#include <random>
+#include <set>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -40,6 +46,40 @@ struct ScopeInit final {
     Core::Timing::CoreTiming core_timing;
 };
 
+struct SingleCoreScopeInit final {
+    SingleCoreScopeInit() {
+        core_timing.SetMulticore(false);
+        core_timing.Initialize([]() {});
+    }
+
+    Core::Timing::CoreTiming core_timing;
+};
+
+/// Runs every pending event of a single core CoreTiming, jumping to the next event each time.
+void RunAllEvents(Core::Timing::CoreTiming& core_timing) {
+    while (const auto next_time = core_timing.Advance()) {
+        const s64 now = core_timing.GetGlobalTimeNs().count();
+        // CPU ticks are slightly shorter than nanoseconds, so this never skips past an event
+        core_timing.AddTicks(static_cast<u64>(std::max<s64>(*next_time - now, 0)) + 1000);
+    }
+}
+
+/// Returns a random event time, mixing near, far and duplicated times.
+s64 RandomEventTime(std::mt19937& rng) {
+    switch (rng() % 5) {
+    case 0:
+        return static_cast<s64>(rng() % 64) * 1000;
+    case 1:
+        return static_cast<s64>(rng() % 100'000);
+    case 2:
+        return static_cast<s64>(rng() % 100'000'000);
+    case 3:
+        return static_cast<s64>(rng() % 60) * 1'000'000'000;
+    default:
+        return (s64{1} << 46) + static_cast<s64>(rng() % 1'000'000);
+    }
+}
+
 u64 TestTimerSpeed(Core::Timing::CoreTiming& core_timing) {
     const u64 start = core_timing.GetGlobalTimeNs().count();
     volatile u64 placebo = 0;
@@ -139,3 +179,145 @@ TEST_CASE("CoreTiming[BasicOrderNoPausing]", "[core]") {
     printf("HostTimer No Pausing Timer Time: %.3f %.6f\n", timer_time / 1000.f,
            timer_time / 1000000.f);
 }
+
+TEST_CASE("CoreTiming[EventQueueOrdering]", "[core]") {
+    SingleCoreScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    constexpr size_t num_types = 16;
+    constexpr size_t num_events = 4000;
+    constexpr size_t looping_type = 0;
+    constexpr size_t cancelling_type = 1;
+    constexpr size_t cancelled_type = 2;
+    constexpr s64 loop_period = 7'000'000;
+    constexpr s64 loop_end = 3'000'000'000;
+
+    std::mt19937 rng{12345};
+    std::vector<std::pair<s64, size_t>> fired;
+    std::vector<std::shared_ptr<Core::Timing::EventType>> types;
+    size_t cancelling_calls = 0;
+
+    for (size_t type = 0; type < num_types; ++type) {
+        types.push_back(Core::Timing::CreateEvent(
+            "event" + std::to_string(type),
+            [&, type](s64 time,
+                      std::chrono::nanoseconds) -> std::optional<std::chrono::nanoseconds> {
+                fired.emplace_back(time, type);
+                // Callbacks run under the advance lock, they can't wait for it
+                if (type == looping_type && time + loop_period > loop_end) {
+                    core_timing.UnscheduleEvent(types[looping_type],
+                                                Core::Timing::UnscheduleEventType::NoWait);
+                }
+                if (type == cancelling_type && ++cancelling_calls == 3) {
+                    core_timing.UnscheduleEvent(types[cancelled_type],
+                                                Core::Timing::UnscheduleEventType::NoWait);
+                }
+                return std::nullopt;
+            }));
+    }
+
+    // Reference model: events ordered by time, then by the order they were scheduled
+    std::set<std::tuple<s64, u64, size_t>> reference;
+    u64 fifo = 0;
+
+    core_timing.ScheduleLoopingEvent(std::chrono::nanoseconds{loop_period},
+                                     std::chrono::nanoseconds{loop_period}, types[looping_type],
+                                     true);
+    reference.emplace(loop_period, fifo++, looping_type);
+
+    for (size_t i = 0; i < num_events; ++i) {
+        const size_t type = 1 + rng() % (num_types - 1);
+        const s64 time = RandomEventTime(rng);
+        core_timing.ScheduleEvent(std::chrono::nanoseconds{time}, types[type], true);
+        reference.emplace(time, fifo++, type);
+
+        // Cancel a type now and then, and keep scheduling it afterwards
+        if (i % 1000 == 999) {
+            const size_t cancelled = 3 + rng() % (num_types - 3);
+            core_timing.UnscheduleEvent(types[cancelled]);
+            std::erase_if(reference, [&](const auto& event) {
+                return std::get<2>(event) == cancelled;
+            });
+        }
+    }
+
+    std::vector<std::pair<s64, size_t>> expected;
+    size_t expected_cancelling_calls = 0;
+    while (!reference.empty()) {
+        const auto [time, order, type] = *reference.begin();
+        reference.erase(reference.begin());
+        expected.emplace_back(time, type);
+        if (type == looping_type) {
+            if (time + loop_period > loop_end) {
+                continue;
+            }
+            reference.emplace(time + loop_period, fifo++, looping_type);
+        }
+        if (type == cancelling_type && ++expected_cancelling_calls == 3) {
+            std::erase_if(reference, [](const auto& event) {
+                return std::get<2>(event) == cancelled_type;
+            });
+        }
+    }
+
+    RunAllEvents(core_timing);
+
+    REQUIRE(!core_timing.Advance().has_value());
+    REQUIRE(fired.size() == expected.size());
+    REQUIRE(fired == expected);
+}
+
+TEST_CASE("CoreTiming[EventQueueThroughput]", "[.benchmark][core]") {
+    SingleCoreScopeInit guard;
+    auto& core_timing = guard.core_timing;
+
+    constexpr size_t num_types = 64;
+    constexpr size_t num_events = 200'000;
+
+    size_t num_fired = 0;
+    std::vector<std::shared_ptr<Core::Timing::EventType>> types;
+    for (size_t type = 0; type < num_types; ++type) {
+        types.push_back(Core::Timing::CreateEvent(
+            "event" + std::to_string(type),
+            [&](s64, std::chrono::nanoseconds) -> std::optional<std::chrono::nanoseconds> {
+                ++num_fired;
+                return std::nullopt;
+            }));
+    }
+
+    std::mt19937 rng{54321};
+    std::vector<s64> times(num_events);
+    std::ranges::generate(times, [&] { return RandomEventTime(rng); });
+
+    const auto measure = [](auto&& func) {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+        return static_cast<double>(
+                   std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+               static_cast<double>(num_events);
+    };
+
+    const double schedule_time = measure([&] {
+        for (size_t i = 0; i < num_events; ++i) {
+            core_timing.ScheduleEvent(std::chrono::nanoseconds{times[i]}, types[i % num_types],
+                                      true);
+        }
+    });
+    const double cancel_time = measure([&] {
+        for (const auto& type : types) {
+            core_timing.UnscheduleEvent(type);
+        }
+    });
+    REQUIRE(!core_timing.Advance().has_value());
+
+    for (size_t i = 0; i < num_events; ++i) {
+        core_timing.ScheduleEvent(std::chrono::nanoseconds{times[i]}, types[i % num_types], true);
+    }
+    const double dispatch_time = measure([&] { RunAllEvents(core_timing); });
+    REQUIRE(num_fired == num_events);
+
+    printf("CoreTiming Event Queue Schedule: %.1f ns/event\n", schedule_time);
+    printf("CoreTiming Event Queue Cancel: %.1f ns/event\n", cancel_time);
+    printf("CoreTiming Event Queue Dispatch: %.1f ns/event\n", dispatch_time);
+}
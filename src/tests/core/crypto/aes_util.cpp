@@ -0,0 +1,367 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "common/hex_util.h"
+#include "core/crypto/aes_util.h"
+#include "core/crypto/key_manager.h"
+
+namespace {
+
+using Core::Crypto::AESCipher;
+using Core::Crypto::AesBackend;
+using Core::Crypto::Key128;
+using Core::Crypto::Key256;
+using Core::Crypto::Mode;
+using Core::Crypto::Op;
+
+constexpr std::size_t BENCHMARK_SIZE = 0x400000;
+constexpr u32 NUM_ITERATIONS = 16;
+constexpr u32 NUM_RANDOM_ITERATIONS = 300;
+// Enough blocks for a few groups of eight, and the blocks left over
+constexpr std::size_t MAX_RANDOM_BLOCKS = 40;
+
+std::vector<u8> FromHex(std::string_view hex) {
+    return Common::HexStringToVector(hex, false);
+}
+
+template <typename Key>
+Key KeyFromHex(std::string_view hex) {
+    Key key{};
+    const auto bytes{FromHex(hex)};
+    std::copy(bytes.begin(), bytes.end(), key.begin());
+    return key;
+}
+
+template <typename Key>
+Key SequentialKey() {
+    Key key{};
+    for (std::size_t i = 0; i < key.size(); ++i) {
+        key[i] = static_cast<u8>(i);
+    }
+    return key;
+}
+
+// Sector indices are big-endian
+std::vector<u8> SectorTweak(std::size_t sector) {
+    std::vector<u8> tweak(0x10);
+    for (std::size_t i = tweak.size(); i-- > 0; sector >>= 8) {
+        tweak[i] = static_cast<u8>(sector);
+    }
+    return tweak;
+}
+
+template <typename Key>
+Key RandomKey(std::mt19937& rng) {
+    Key key{};
+    for (auto& byte : key) {
+        byte = static_cast<u8>(rng());
+    }
+    return key;
+}
+
+std::vector<u8> RandomBytes(std::mt19937& rng, std::size_t size) {
+    std::vector<u8> bytes(size);
+    for (auto& byte : bytes) {
+        byte = static_cast<u8>(rng());
+    }
+    return bytes;
+}
+
+const char* BackendName(AesBackend backend) {
+    switch (backend) {
+    case AesBackend::Mbedtls:
+        return "mbedtls";
+    case AesBackend::AesNi:
+        return "AES-NI";
+    case AesBackend::Vaes:
+        return "VAES";
+    }
+    return "";
+}
+
+/// Transcode with a cipher, from and to any alignment, in place or between separate buffers.
+template <typename Cipher>
+std::vector<u8> TranscodeAt(Cipher& cipher, const std::vector<u8>& input, std::size_t src_offset,
+                            std::size_t dest_offset, bool in_place, Op op) {
+    std::vector<u8> src(src_offset + input.size());
+    std::copy(input.begin(), input.end(), src.begin() + src_offset);
+    if (in_place) {
+        cipher.Transcode(src.data() + src_offset, input.size(), src.data() + src_offset, op);
+        return {src.begin() + src_offset, src.end()};
+    }
+    std::vector<u8> dest(dest_offset + input.size());
+    cipher.Transcode(src.data() + src_offset, input.size(), dest.data() + dest_offset, op);
+    return {dest.begin() + dest_offset, dest.end()};
+}
+
+// SP 800-38A F.5.1
+constexpr std::string_view CTR_KEY = "2b7e151628aed2a6abf7158809cf4f3c";
+constexpr std::string_view CTR_COUNTER = "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+constexpr std::string_view CTR_PLAINTEXT =
+    "6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710";
+constexpr std::string_view CTR_CIPHERTEXT =
+    "874d6191b620e3261bef6864990db6ce9806f66b7970fdff8617187bb9fffdff"
+    "5ae4df3edbd5d35e5b4f09020db03eab1e031dda2fbe03d1792170a0f3009cee";
+
+void Benchmark(const char* name, auto&& transcode) {
+    std::vector<u8> buffer(BENCHMARK_SIZE);
+    transcode(buffer);
+    const auto begin{std::chrono::steady_clock::now()};
+    for (u32 iteration = 0; iteration < NUM_ITERATIONS; iteration++) {
+        transcode(buffer);
+    }
+    const auto end{std::chrono::steady_clock::now()};
+    const f64 seconds{std::chrono::duration<f64>(end - begin).count()};
+    printf("%-8s %10.1f MB/s\n", name,
+           static_cast<f64>(BENCHMARK_SIZE) * NUM_ITERATIONS / seconds / 1e6);
+}
+
+} // Anonymous namespace
+
+TEST_CASE("AESCipher[ECB]", "[core]") {
+    // FIPS-197 C.1
+    const auto plaintext{FromHex("00112233445566778899aabbccddeeff")};
+    const auto ciphertext{FromHex("69c4e0d86a7b0430d8cdb78070b4c55a")};
+
+    for (const AesBackend backend : Core::Crypto::GetSupportedAesBackends()) {
+        INFO(BackendName(backend));
+        AESCipher<Key128> cipher{SequentialKey<Key128>(), Mode::ECB, backend};
+        std::vector<u8> output(plaintext.size());
+        cipher.Transcode(plaintext.data(), plaintext.size(), output.data(), Op::Encrypt);
+        REQUIRE(output == ciphertext);
+        cipher.Transcode(output.data(), output.size(), output.data(), Op::Decrypt);
+        REQUIRE(output == plaintext);
+    }
+}
+
+TEST_CASE("AESCipher[CTR]", "[core]") {
+    const auto plaintext{FromHex(CTR_PLAINTEXT)};
+    const auto ciphertext{FromHex(CTR_CIPHERTEXT)};
+    const auto counter{FromHex(CTR_COUNTER)};
+
+    for (const AesBackend backend : Core::Crypto::GetSupportedAesBackends()) {
+        INFO(BackendName(backend));
+        AESCipher<Key128> cipher{KeyFromHex<Key128>(CTR_KEY), Mode::CTR, backend};
+
+        std::vector<u8> output(plaintext.size());
+        cipher.SetIV(counter);
+        cipher.Transcode(plaintext.data(), plaintext.size(), output.data(), Op::Encrypt);
+        REQUIRE(output == ciphertext);
+        cipher.SetIV(counter);
+        cipher.Transcode(output.data(), output.size(), output.data(), Op::Decrypt);
+        REQUIRE(output == plaintext);
+
+        // The counter continues between whole blocks
+        output = ciphertext;
+        cipher.SetIV(counter);
+        cipher.Transcode(output.data(), 0x10, output.data(), Op::Decrypt);
+        cipher.Transcode(output.data() + 0x10, 0x30, output.data() + 0x10, Op::Decrypt);
+        REQUIRE(output == plaintext);
+
+        // Partial block
+        output.assign(ciphertext.begin(), ciphertext.begin() + 0x25);
+        cipher.SetIV(counter);
+        cipher.Transcode(output.data(), output.size(), output.data(), Op::Decrypt);
+        REQUIRE(std::equal(output.begin(), output.end(), plaintext.begin()));
+    }
+}
+
+TEST_CASE("AESCipher[CTRCarry]", "[core]") {
+    // Counters from just before the low 64 bits carry into the high 64 bits, so the carry lands
+    // on every block of a group of eight, and the last counter, which wraps around to zero
+    std::mt19937 rng{0x43545231};
+    const auto key{RandomKey<Key128>(rng)};
+    AESCipher<Key128> ecb_cipher{key, Mode::ECB, AesBackend::Mbedtls};
+    constexpr std::size_t blocks = 20;
+    const auto plaintext{RandomBytes(rng, blocks * 0x10 + 7)};
+
+    for (u32 high = 0; high < 2; high++) {
+        for (u32 before_carry = 0; before_carry < 10; before_carry++) {
+            std::vector<u8> counter(0x10, 0xFF);
+            std::fill_n(counter.begin(), 8, high == 0 ? 0x00 : 0xFF);
+            counter[0xF] = static_cast<u8>(0xFF - before_carry);
+
+            // The key stream is the counters, incremented as a 128-bit big-endian number, up to
+            // the counter after the partial block
+            std::vector<u8> expected((blocks + 2) * 0x10);
+            auto block{counter};
+            for (std::size_t offset = 0; offset < expected.size(); offset += 0x10) {
+                ecb_cipher.Transcode(block.data(), 0x10, expected.data() + offset, Op::Encrypt);
+                for (std::size_t i = block.size(); i-- > 0 && ++block[i] == 0;) {
+                }
+            }
+            for (std::size_t i = 0; i < plaintext.size(); ++i) {
+                expected[i] ^= plaintext[i];
+            }
+
+            for (const AesBackend backend : Core::Crypto::GetSupportedAesBackends()) {
+                INFO(BackendName(backend) << " high " << high << " before carry "
+                                          << before_carry);
+                AESCipher<Key128> cipher{key, Mode::CTR, backend};
+                std::vector<u8> output(plaintext.size());
+                cipher.SetIV(counter);
+                cipher.Transcode(plaintext.data(), plaintext.size(), output.data(), Op::Encrypt);
+                REQUIRE(std::equal(output.begin(), output.end(), expected.begin()));
+
+                // The partial block used a whole counter, and the next one follows it
+                std::vector<u8> next(0x10);
+                cipher.Transcode(next.data(), next.size(), next.data(), Op::Encrypt);
+                REQUIRE(std::equal(next.begin(), next.end(), expected.end() - 0x10));
+            }
+        }
+    }
+}
+
+TEST_CASE("AESCipher[XTS]", "[core]") {
+    for (const AesBackend backend : Core::Crypto::GetSupportedAesBackends()) {
+        INFO(BackendName(backend));
+
+        // IEEE 1619-2007 B.1 vector 1
+        AESCipher<Key256> zero_cipher{Key256{}, Mode::XTS, backend};
+        std::vector<u8> output(0x20);
+        zero_cipher.SetIV(std::vector<u8>(0x10));
+        zero_cipher.Transcode(output.data(), output.size(), output.data(), Op::Encrypt);
+        REQUIRE(output == FromHex("917cf69ebd68b2ec9b9fe9a3eadda692"
+                                  "cd43d2f59598ed858c02c2652fbf922e"));
+
+        // IEEE 1619-2007 B.1 vectors 15 and 18, ciphertext stealing with 1 and 4 bytes left over.
+        // The data unit 0x123456789a is little-endian in the tweak.
+        AESCipher<Key256> cipher{KeyFromHex<Key256>("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+                                                    "bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0"),
+                                 Mode::XTS, backend};
+        const auto tweak{FromHex("9a785634120000000000000000000000")};
+        for (const auto& [plaintext, ciphertext] : {
+                 std::pair{FromHex("000102030405060708090a0b0c0d0e0f10"),
+                           FromHex("6c1625db4671522d3d7599601de7ca09ed")},
+                 std::pair{FromHex("000102030405060708090a0b0c0d0e0f10111213"),
+                           FromHex("9d84c813f719aa2c7be3f66171c7c5c2edbf9dac")},
+             }) {
+            output.resize(plaintext.size());
+            cipher.SetIV(tweak);
+            cipher.Transcode(plaintext.data(), plaintext.size(), output.data(), Op::Encrypt);
+            REQUIRE(output == ciphertext);
+            cipher.SetIV(tweak);
+            cipher.Transcode(output.data(), output.size(), output.data(), Op::Decrypt);
+            REQUIRE(output == plaintext);
+        }
+
+        // Each sector is a data unit, tweaked by its index
+        AESCipher<Key256> sector_cipher{SequentialKey<Key256>(), Mode::XTS, backend};
+        std::vector<u8> plaintext(0x800);
+        for (std::size_t i = 0; i < plaintext.size(); ++i) {
+            plaintext[i] = static_cast<u8>(i);
+        }
+        output.resize(plaintext.size());
+        sector_cipher.XTSTranscode(plaintext.data(), plaintext.size(), output.data(), 3, 0x200,
+                                   Op::Encrypt);
+        for (std::size_t sector = 0; sector < 4; ++sector) {
+            std::vector<u8> expected(0x200);
+            sector_cipher.SetIV(SectorTweak(3 + sector));
+            sector_cipher.Transcode(plaintext.data() + sector * 0x200, 0x200, expected.data(),
+                                    Op::Encrypt);
+            REQUIRE(std::equal(expected.begin(), expected.end(), output.begin() + sector * 0x200));
+        }
+        sector_cipher.XTSTranscode(output.data(), output.size(), output.data(), 3, 0x200,
+                                   Op::Decrypt);
+        REQUIRE(output == plaintext);
+    }
+}
+
+TEST_CASE("AESCipher[MatchMbedtls]", "[core]") {
+    std::mt19937 rng{0x41455331};
+    for (const AesBackend backend : Core::Crypto::GetSupportedAesBackends()) {
+        if (backend == AesBackend::Mbedtls) {
+            continue;
+        }
+        INFO(BackendName(backend));
+
+        for (u32 iteration = 0; iteration < NUM_RANDOM_ITERATIONS; iteration++) {
+            const std::size_t src_offset{rng() % 0x10};
+            const std::size_t dest_offset{rng() % 0x10};
+            const bool in_place{rng() % 4 == 0};
+            const Op op{rng() % 2 == 0 ? Op::Encrypt : Op::Decrypt};
+            const std::size_t blocks{rng() % (MAX_RANDOM_BLOCKS + 1)};
+            INFO("iteration " << iteration);
+
+            // CTR, split in two at any byte, so the counter continues from a partial block
+            {
+                const auto key{RandomKey<Key128>(rng)};
+                const auto counter{RandomBytes(rng, 0x10)};
+                const auto input{RandomBytes(rng, blocks * 0x10 + rng() % 0x10)};
+                const std::size_t split{input.empty() ? 0 : rng() % input.size()};
+                const std::vector<u8> first(input.begin(), input.begin() + split);
+                const std::vector<u8> second(input.begin() + split, input.end());
+
+                AESCipher<Key128> expected_cipher{key, Mode::CTR, AesBackend::Mbedtls};
+                AESCipher<Key128> cipher{key, Mode::CTR, backend};
+                expected_cipher.SetIV(counter);
+                cipher.SetIV(counter);
+                REQUIRE(TranscodeAt(cipher, first, src_offset, dest_offset, in_place, op) ==
+                        TranscodeAt(expected_cipher, first, 0, 0, false, op));
+                REQUIRE(TranscodeAt(cipher, second, src_offset, dest_offset, in_place, op) ==
+                        TranscodeAt(expected_cipher, second, 0, 0, false, op));
+            }
+
+            // ECB, where a partial last block is padded
+            {
+                const auto key{RandomKey<Key128>(rng)};
+                const std::size_t partial{rng() % 4 == 0 ? rng() % 0x10 : 0};
+                const auto input{RandomBytes(rng, blocks * 0x10 + partial)};
+                AESCipher<Key128> expected_cipher{key, Mode::ECB, AesBackend::Mbedtls};
+                AESCipher<Key128> cipher{key, Mode::ECB, backend};
+                REQUIRE(TranscodeAt(cipher, input, src_offset, dest_offset, in_place, op) ==
+                        TranscodeAt(expected_cipher, input, 0, 0, false, op));
+            }
+
+            // XTS, stealing ciphertext for a partial last block
+            {
+                const auto key{RandomKey<Key256>(rng)};
+                const auto tweak{RandomBytes(rng, 0x10)};
+                const auto input{RandomBytes(rng, (blocks + 1) * 0x10 + rng() % 0x10)};
+                AESCipher<Key256> expected_cipher{key, Mode::XTS, AesBackend::Mbedtls};
+                AESCipher<Key256> cipher{key, Mode::XTS, backend};
+                expected_cipher.SetIV(tweak);
+                cipher.SetIV(tweak);
+                REQUIRE(TranscodeAt(cipher, input, src_offset, dest_offset, in_place, op) ==
+                        TranscodeAt(expected_cipher, input, 0, 0, false, op));
+            }
+        }
+    }
+}
+
+TEST_CASE("AESCipher[Throughput]", "[.benchmark][core]") {
+    const auto counter{FromHex(CTR_COUNTER)};
+
+    for (const AesBackend backend : Core::Crypto::GetSupportedAesBackends()) {
+        printf("%s\n", BackendName(backend));
+
+        AESCipher<Key128> ctr_cipher{KeyFromHex<Key128>(CTR_KEY), Mode::CTR, backend};
+        Benchmark("AES-CTR", [&](std::vector<u8>& buffer) {
+            ctr_cipher.SetIV(counter);
+            ctr_cipher.Transcode(buffer.data(), buffer.size(), buffer.data(), Op::Decrypt);
+        });
+
+        // NCA headers and NAX files use 0x200 and 0x4000 byte sectors
+        AESCipher<Key256> xts_cipher{SequentialKey<Key256>(), Mode::XTS, backend};
+        Benchmark("AES-XTS", [&](std::vector<u8>& buffer) {
+            xts_cipher.XTSTranscode(buffer.data(), buffer.size(), buffer.data(), 0, 0x4000,
+                                    Op::Decrypt);
+        });
+
+        AESCipher<Key128> ecb_cipher{SequentialKey<Key128>(), Mode::ECB, backend};
+        Benchmark("AES-ECB", [&](std::vector<u8>& buffer) {
+            ecb_cipher.Transcode(buffer.data(), buffer.size(), buffer.data(), Op::Decrypt);
+        });
+    }
+}
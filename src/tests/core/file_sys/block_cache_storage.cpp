@@ -0,0 +1,189 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+
+namespace {
+
+using FileSys::BlockCache;
+using FileSys::BlockCacheStorage;
+
+constexpr size_t STORAGE_SIZE = 0x100000 + 0x1234;
+constexpr size_t NUM_ITERATIONS = 2000;
+
+// Storage of generated data which counts the reads it serves
+class CountingStorage : public FileSys::IReadOnlyStorage {
+public:
+    explicit CountingStorage(size_t size) : data(size) {
+        std::mt19937 rng{0x46534243};
+        std::ranges::generate(data, [&] { return static_cast<u8>(rng()); });
+    }
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        reads++;
+        bytes_read += size;
+        const size_t end = std::min(data.size(), readable_end);
+        size = std::min(size, end - std::min(offset, end));
+        std::copy_n(data.begin() + offset, size, buffer);
+        return size;
+    }
+
+    size_t GetSize() const override {
+        return data.size();
+    }
+
+    std::vector<u8> data;
+    /// Reads stop short at this offset, like a storage failing to read
+    size_t readable_end = std::numeric_limits<size_t>::max();
+    mutable std::atomic<size_t> reads{};
+    mutable std::atomic<size_t> bytes_read{};
+};
+
+} // Anonymous namespace
+
+TEST_CASE("BlockCacheStorage[ReadsMatchBase]", "[core]") {
+    BlockCache cache;
+    const auto base = std::make_shared<CountingStorage>(STORAGE_SIZE);
+    BlockCacheStorage storage{base, cache};
+    REQUIRE(storage.GetSize() == STORAGE_SIZE);
+
+    std::mt19937_64 rng{0x46534244};
+    for (size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+        // Mostly small reads, some of them past the end or larger than cached reads
+        const size_t offset = rng() % (STORAGE_SIZE + 0x100);
+        const size_t max_size =
+            iteration % 16 == 0 ? BlockCacheStorage::MaxCachedReadSize * 2 : 0x9000;
+        const size_t size = rng() % max_size;
+        std::vector<u8> output(size);
+        const size_t read = storage.Read(output.data(), size, offset);
+
+        const size_t expected = offset < STORAGE_SIZE ? std::min(size, STORAGE_SIZE - offset) : 0;
+        REQUIRE(read == expected);
+        REQUIRE(std::equal(output.begin(), output.begin() + read, base->data.begin() + offset));
+    }
+}
+
+TEST_CASE("BlockCacheStorage[Hits]", "[core]") {
+    BlockCache cache;
+    const auto base = std::make_shared<CountingStorage>(STORAGE_SIZE);
+    BlockCacheStorage storage{base, cache};
+    std::vector<u8> output(0x100);
+
+    // A read within a block caches the whole block
+    storage.Read(output.data(), output.size(), 0x4100);
+    REQUIRE(base->reads == 1);
+    REQUIRE(base->bytes_read == BlockCache::BlockSize);
+
+    storage.Read(output.data(), output.size(), 0x7F00);
+    REQUIRE(base->reads == 1);
+    REQUIRE(std::equal(output.begin(), output.end(), base->data.begin() + 0x7F00));
+
+    // Only the blocks which aren't cached are read, in one read
+    output.resize(BlockCache::BlockSize * 3);
+    storage.Read(output.data(), output.size(), 0x6000);
+    REQUIRE(base->reads == 2);
+    REQUIRE(base->bytes_read == BlockCache::BlockSize * 4);
+    REQUIRE(std::equal(output.begin(), output.end(), base->data.begin() + 0x6000));
+
+    const auto stats = cache.GetStatistics();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 4);
+    REQUIRE(stats.bytes_saved == 0x100 + 0x2000);
+    REQUIRE(stats.cached_bytes == BlockCache::BlockSize * 4);
+}
+
+TEST_CASE("BlockCacheStorage[Bounded]", "[core]") {
+    BlockCache cache;
+    const auto base = std::make_shared<CountingStorage>(BlockCache::CapacityPerShard *
+                                                        BlockCache::NumShards * 2);
+    {
+        BlockCacheStorage storage{base, cache};
+        std::vector<u8> output(BlockCacheStorage::MaxCachedReadSize);
+        for (size_t offset = 0; offset < base->GetSize(); offset += output.size()) {
+            storage.Read(output.data(), output.size(), offset);
+        }
+        REQUIRE(cache.GetStatistics().cached_bytes <=
+                BlockCache::CapacityPerShard * BlockCache::NumShards);
+        REQUIRE(cache.GetStatistics().cached_bytes > 0);
+    }
+
+    // Blocks of a storage are dropped along with it
+    REQUIRE(cache.GetStatistics().cached_bytes == 0);
+}
+
+TEST_CASE("BlockCacheStorage[SeparateStorages]", "[core]") {
+    BlockCache cache;
+    const auto base_a = std::make_shared<CountingStorage>(STORAGE_SIZE);
+    auto base_b = std::make_shared<CountingStorage>(STORAGE_SIZE);
+    std::ranges::reverse(base_b->data);
+    BlockCacheStorage storage_a{base_a, cache};
+    BlockCacheStorage storage_b{base_b, cache};
+
+    std::vector<u8> output(0x200);
+    storage_a.Read(output.data(), output.size(), 0x1000);
+    storage_b.Read(output.data(), output.size(), 0x1000);
+    REQUIRE(std::equal(output.begin(), output.end(), base_b->data.begin() + 0x1000));
+    REQUIRE(base_b->reads == 1);
+}
+
+TEST_CASE("BlockCacheStorage[Prefetch]", "[core]") {
+    BlockCache cache;
+    const auto base = std::make_shared<CountingStorage>(STORAGE_SIZE);
+    {
+        BlockCacheStorage storage{base, cache};
+        std::vector<u8> output(0x100);
+        storage.Read(output.data(), output.size(), BlockCache::BlockSize);
+
+        // Cached blocks are skipped, the ones around them are read
+        storage.Prefetch(0, BlockCache::BlockSize * 4);
+        REQUIRE(base->reads == 3);
+        REQUIRE(base->bytes_read == BlockCache::BlockSize * 4);
+
+        storage.Read(output.data(), output.size(), BlockCache::BlockSize * 2 + 0x80);
+        REQUIRE(base->reads == 3);
+        REQUIRE(std::equal(output.begin(), output.end(),
+                           base->data.begin() + BlockCache::BlockSize * 2 + 0x80));
+
+        const auto stats = cache.GetStatistics();
+        REQUIRE(stats.prefetched_blocks == 3);
+        REQUIRE(stats.prefetch_used_blocks == 1);
+        REQUIRE(stats.prefetch_wasted_bytes == 0);
+    }
+
+    // Prefetched blocks which were never read are wasted
+    REQUIRE(cache.GetStatistics().prefetch_wasted_bytes == BlockCache::BlockSize * 2);
+}
+
+TEST_CASE("BlockCacheStorage[ShortReads]", "[core]") {
+    constexpr size_t block_size = BlockCache::BlockSize;
+    BlockCache cache;
+    const auto base = std::make_shared<CountingStorage>(STORAGE_SIZE);
+    BlockCacheStorage storage{base, cache};
+    std::vector<u8> output(block_size * 4);
+
+    // Cache the first and third blocks before the base storage stops short in the second one
+    storage.Read(output.data(), 0x100, 0);
+    storage.Read(output.data(), 0x100, block_size * 2);
+    base->readable_end = block_size + 0x1000;
+
+    // Only the bytes read before the short read are reported
+    REQUIRE(storage.Read(output.data(), 0x100, block_size + 0xF80) == 0x80);
+    REQUIRE(storage.Read(output.data(), 0x100, block_size + 0x1800) == 0);
+    REQUIRE(storage.Read(output.data(), block_size * 2, 0x3000) == block_size + 0x1000 - 0x3000);
+    REQUIRE(storage.Read(output.data(), block_size * 4, 0) == block_size + 0x1000);
+    REQUIRE(std::equal(output.begin(), output.begin() + block_size + 0x1000, base->data.begin()));
+
+    // The partly read block isn't cached
+    base->readable_end = std::numeric_limits<size_t>::max();
+    REQUIRE(storage.Read(output.data(), output.size(), 0) == output.size());
+    REQUIRE(std::equal(output.begin(), output.end(), base->data.begin()));
+}
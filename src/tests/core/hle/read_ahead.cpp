@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "core/file_sys/fssystem/fssystem_block_cache_storage.h"
+#include "core/file_sys/vfs/vfs_offset.h"
+#include "core/hle/service/filesystem/read_ahead.h"
+
+namespace {
+
+using FileSys::BlockCache;
+using FileSys::BlockCacheStorage;
+using Service::FileSystem::ReadAheadDetector;
+using Service::FileSystem::ReadAheadPool;
+
+constexpr size_t STORAGE_SIZE = 0x100000 + 0x1234;
+constexpr size_t NUM_ITERATIONS = 200;
+
+// Storage of generated data which counts the reads it serves and checks that they never overlap,
+// as the storages below the block cache aren't safe to read from several threads
+class CountingStorage : public FileSys::IReadOnlyStorage {
+public:
+    explicit CountingStorage(size_t size) : data(size) {
+        std::mt19937 rng{0x52414844};
+        std::ranges::generate(data, [&] { return static_cast<u8>(rng()); });
+    }
+
+    size_t Read(u8* buffer, size_t size, size_t offset) const override {
+        if (reading.exchange(true)) {
+            overlapped = true;
+        }
+        reads++;
+
+        // Hold the read long enough for the other thread to catch up to it
+        std::this_thread::sleep_for(std::chrono::microseconds(20));
+        size = std::min(size, data.size() - std::min(offset, data.size()));
+        std::copy_n(data.begin() + offset, size, buffer);
+        reading = false;
+        return size;
+    }
+
+    size_t GetSize() const override {
+        return data.size();
+    }
+
+    std::vector<u8> data;
+    mutable std::atomic<size_t> reads{};
+    mutable std::atomic<bool> reading{};
+    mutable std::atomic<bool> overlapped{};
+};
+
+} // Anonymous namespace
+
+TEST_CASE("ReadAheadDetector[SequentialReads]", "[core]") {
+    constexpr size_t file_offset = 0x1000;
+    constexpr size_t read_size = 0x2000;
+    const auto pool = std::make_shared<ReadAheadPool>();
+    const auto base = std::make_shared<CountingStorage>(STORAGE_SIZE);
+    const auto storage = std::make_shared<BlockCacheStorage>(base);
+    const auto file =
+        std::make_shared<FileSys::OffsetVfsFile>(storage, STORAGE_SIZE - file_offset, file_offset);
+    ReadAheadDetector detector{pool, file};
+
+    std::vector<u8> output(read_size);
+    const auto read = [&](size_t offset) {
+        file->Read(output.data(), output.size(), offset);
+        detector.OnRead(offset, output.size());
+        pool->WaitForPrefetches();
+    };
+
+    SECTION("Random reads aren't prefetched") {
+        for (const size_t offset : {0x40000, 0x8000, 0x90000, 0x20000}) {
+            read(offset);
+        }
+        REQUIRE(pool->GetStatistics().prefetches == 0);
+    }
+
+    SECTION("Sequential reads are prefetched") {
+        constexpr size_t first_prefetch =
+            read_size * (ReadAheadDetector::SequentialReadsToPrefetch - 1);
+        for (size_t offset = 0; offset < first_prefetch; offset += read_size) {
+            read(offset);
+        }
+        REQUIRE(pool->GetStatistics().prefetches == 0);
+
+        // Reads past the first prefetch are served from the cache
+        read(first_prefetch);
+        REQUIRE(pool->GetStatistics().prefetches == 1);
+        const size_t base_reads = base->reads;
+        for (size_t offset = first_prefetch + read_size;
+             offset < read_size * 32; offset += read_size) {
+            read(offset);
+            REQUIRE(std::equal(output.begin(), output.end(),
+                               base->data.begin() + file_offset + offset));
+        }
+        REQUIRE(pool->GetStatistics().prefetches > 1);
+        REQUIRE(base->reads - base_reads == pool->GetStatistics().prefetches - 1);
+    }
+}
+
+TEST_CASE("ReadAheadPool[PrefetchDuringRead]", "[core]") {
+    constexpr size_t prefetch_size = ReadAheadDetector::PrefetchSize;
+    constexpr size_t read_size = 0x2000;
+    BlockCache cache;
+    const auto pool = std::make_shared<ReadAheadPool>();
+    const auto base = std::make_shared<CountingStorage>(STORAGE_SIZE);
+
+    std::vector<u8> output(read_size);
+    for (size_t iteration = 0; iteration < NUM_ITERATIONS; ++iteration) {
+        // Read the blocks being prefetched, each iteration from a storage with nothing cached
+        const auto storage = std::make_shared<BlockCacheStorage>(base, cache);
+        const size_t offset = iteration * read_size % (STORAGE_SIZE - prefetch_size);
+        REQUIRE(pool->Prefetch(storage, offset, prefetch_size));
+        for (size_t cur = offset; cur < offset + prefetch_size; cur += read_size) {
+            REQUIRE(storage->Read(output.data(), output.size(), cur) == output.size());
+            REQUIRE(std::equal(output.begin(), output.end(), base->data.begin() + cur));
+        }
+        pool->WaitForPrefetches();
+
+        // Both threads cached what they read, so the blocks are all cached
+        const size_t base_reads = base->reads;
+        for (size_t cur = offset; cur < offset + prefetch_size; cur += read_size) {
+            storage->Read(output.data(), output.size(), cur);
+        }
+        REQUIRE(base->reads == base_reads);
+    }
+    REQUIRE(!base->overlapped);
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "core/hle/kernel/k_slab_heap.h"
+
+namespace {
+
+struct Object {
+    u64 value[4];
+};
+
+constexpr std::size_t NUM_OBJECTS = 4096;
+// One thread per emulated core, plus a host thread
+constexpr std::size_t NUM_THREADS = Core::Hardware::NUM_CPU_CORES + 1;
+
+struct TestHeap {
+    TestHeap() : memory(NUM_OBJECTS * sizeof(Object)) {
+        heap.Initialize(sizeof(Object), memory.data(), memory.size());
+    }
+
+    Object* Allocate(std::size_t core_id) {
+        return static_cast<Object*>(heap.Allocate(core_id));
+    }
+
+    std::vector<u8> memory;
+    Kernel::KSlabHeapBase<false> heap;
+};
+
+} // Anonymous namespace
+
+TEST_CASE("KSlabHeap[AllocateAll]", "[core]") {
+    TestHeap test;
+    auto& heap = test.heap;
+
+    // Every object is handed out exactly once, even those cached by other cores
+    heap.Free(test.Allocate(1), 1);
+    std::set<Object*> objects;
+    while (Object* obj = test.Allocate(0)) {
+        REQUIRE(heap.Contains(reinterpret_cast<uintptr_t>(obj)));
+        REQUIRE(objects.insert(obj).second);
+    }
+    REQUIRE(objects.size() == NUM_OBJECTS);
+
+    for (Object* obj : objects) {
+        heap.Free(obj, 0);
+    }
+    const auto stats = heap.GetStatistics();
+    REQUIRE(stats.allocations == NUM_OBJECTS + 2);
+    // Initialization frees every object into the heap
+    REQUIRE(stats.frees == NUM_OBJECTS * 2 + 1);
+    REQUIRE(stats.drains > 0);
+}
+
+TEST_CASE("KSlabHeap[ConcurrentChurn]", "[core]") {
+    static constexpr std::size_t ITERATIONS = 100'000;
+    static constexpr std::size_t HELD = 8;
+
+    TestHeap test;
+    auto& heap = test.heap;
+    std::atomic<bool> failed{};
+    {
+        std::vector<std::jthread> threads;
+        for (std::size_t thread = 0; thread < NUM_THREADS; ++thread) {
+            // The last thread stands for the host threads, which don't run an emulated core
+            const std::size_t core_id = thread < Core::Hardware::NUM_CPU_CORES ? thread : 0xFF;
+            threads.emplace_back([&, thread, core_id] {
+                std::array<Object*, HELD> held{};
+                for (std::size_t i = 0; i < ITERATIONS; ++i) {
+                    Object*& slot = held[i % HELD];
+                    if (slot != nullptr) {
+                        if (slot->value[0] != thread) {
+                            failed = true;
+                        }
+                        heap.Free(slot, core_id);
+                    }
+                    slot = test.Allocate(core_id);
+                    slot->value[0] = thread;
+                }
+                for (Object* obj : held) {
+                    heap.Free(obj, core_id);
+                }
+            });
+        }
+    }
+    REQUIRE(!failed);
+
+    // Nothing was lost or handed out twice
+    std::set<Object*> objects;
+    while (Object* obj = test.Allocate(0)) {
+        REQUIRE(objects.insert(obj).second);
+    }
+    REQUIRE(objects.size() == NUM_OBJECTS);
+    REQUIRE(heap.GetStatistics().refills > 0);
+}
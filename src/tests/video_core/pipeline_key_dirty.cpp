@@ -0,0 +1,147 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/core.h"
+#include "core/device_memory.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/host1x/gpu_device_memory_manager.h"
+#include "video_core/macro/macro.h"
+#include "video_core/macro/macro_hle.h"
+#include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
+#include "video_core/renderer_null/null_rasterizer.h"
+#include "video_core/renderer_vulkan/fixed_pipeline_state.h"
+#include "video_core/renderer_vulkan/vk_state_tracker.h"
+
+using Tegra::Engines::Maxwell3D;
+
+namespace {
+
+/// Hash of the transform feedback setup macro replaced by HLE_TransformFeedbackSetup
+constexpr u64 TRANSFORM_FEEDBACK_SETUP_HASH = 0xFC0CF27F5FFAA661ULL;
+
+/// Rasterizer doing nothing, for macros which call into it
+class NopRasterizer final : public VideoCore::RasterizerInterface {
+public:
+    void Draw(bool, u32) override {}
+    void DrawTexture() override {}
+    void Clear(u32) override {}
+    void DispatchCompute() override {}
+    void ResetCounter(VideoCommon::QueryType) override {}
+    void Query(GPUVAddr, VideoCommon::QueryType, VideoCommon::QueryPropertiesFlags, u32,
+               u32) override {}
+    void BindGraphicsUniformBuffer(size_t, u32, GPUVAddr, u32) override {}
+    void DisableGraphicsUniformBuffer(size_t, u32) override {}
+    void SignalFence(std::function<void()>&& func) override {
+        func();
+    }
+    void SyncOperation(std::function<void()>&& func) override {
+        func();
+    }
+    void SignalSyncPoint(u32) override {}
+    void SignalReference() override {}
+    void ReleaseFences(bool) override {}
+    void FlushAll() override {}
+    void FlushRegion(DAddr, u64, VideoCommon::CacheType) override {}
+    bool MustFlushRegion(DAddr, u64, VideoCommon::CacheType) override {
+        return false;
+    }
+    VideoCore::RasterizerDownloadArea GetFlushArea(DAddr addr, u64 size) override {
+        return {addr, addr + size, false};
+    }
+    void InvalidateRegion(DAddr, u64, VideoCommon::CacheType) override {}
+    void OnCacheInvalidation(PAddr, u64) override {}
+    bool OnCPUWrite(PAddr, u64) override {
+        return false;
+    }
+    void InvalidateGPUCache() override {}
+    void UnmapMemory(DAddr, u64) override {}
+    void ModifyGPUMemory(size_t, GPUVAddr, u64) override {}
+    void FlushAndInvalidateRegion(DAddr, u64, VideoCommon::CacheType) override {}
+    void WaitForIdle() override {}
+    void FragmentBarrier() override {}
+    void TiledCacheBarrier() override {}
+    void FlushCommands() override {}
+    void TickFrame() override {}
+    Tegra::Engines::AccelerateDMAInterface& AccessAccelerateDMA() override {
+        return accelerate_dma;
+    }
+    void AccelerateInlineToMemory(GPUVAddr, size_t, std::span<const u8>) override {}
+
+private:
+    Null::AccelerateDMA accelerate_dma;
+};
+
+/// The pipeline cache reuses its previous lookup only while none of these flags is raised.
+bool IsPipelineKeyDirty(const Maxwell3D::DirtyState& dirty) {
+    return dirty.flags[Vulkan::Dirty::PipelineFixed] ||
+           dirty.flags[Vulkan::Dirty::PipelineDynamic] || dirty.flags[Vulkan::Dirty::PipelineXfb];
+}
+
+} // Anonymous namespace
+
+TEST_CASE("PipelineKeyDirty[RegisterWriteInvalidatesLookup]", "[video_core]") {
+    auto dirty = std::make_unique<Maxwell3D::DirtyState>();
+    Vulkan::SetupPipelineKeyTable(*dirty);
+    REQUIRE(dirty->num_tables == 3);
+
+    // Registers outside of the key keep the previous lookup
+    dirty->Touch(MAXWELL3D_REG_INDEX(blend_color));
+    REQUIRE(!IsPipelineKeyDirty(*dirty));
+
+    dirty->Touch(MAXWELL3D_REG_INDEX(depth_test_func));
+    REQUIRE(dirty->flags[Vulkan::Dirty::PipelineDynamic]);
+    dirty->flags.reset();
+
+    dirty->Touch(MAXWELL3D_REG_INDEX(zeta.format));
+    REQUIRE(dirty->flags[Vulkan::Dirty::PipelineFixed]);
+    dirty->flags.reset();
+
+    dirty->Touch(MAXWELL3D_REG_INDEX(transform_feedback));
+    REQUIRE(dirty->flags[Vulkan::Dirty::PipelineXfb]);
+}
+
+TEST_CASE("PipelineKeyDirty[TableUnusedByDefault]", "[video_core]") {
+    auto dirty = std::make_unique<Maxwell3D::DirtyState>();
+    REQUIRE(dirty->num_tables == 2);
+
+    // Without the pipeline cache registering it, the third table is never read
+    dirty->tables[2][MAXWELL3D_REG_INDEX(depth_test_func)] = Vulkan::Dirty::PipelineDynamic;
+    dirty->Touch(MAXWELL3D_REG_INDEX(depth_test_func));
+    REQUIRE(!IsPipelineKeyDirty(*dirty));
+}
+
+TEST_CASE("PipelineKeyDirty[TransformFeedbackMacro]", "[video_core]") {
+    Core::System system;
+    Core::DeviceMemory device_memory;
+    Tegra::MaxwellDeviceMemoryManager device_memory_manager{device_memory};
+    Tegra::MemoryManager memory_manager{system, device_memory_manager};
+    NopRasterizer rasterizer;
+    auto maxwell3d = std::make_unique<Maxwell3D>(system, memory_manager);
+    maxwell3d->BindRasterizer(&rasterizer);
+    Vulkan::SetupPipelineKeyTable(maxwell3d->dirty);
+
+    Vulkan::DynamicFeatures features{};
+    Vulkan::FixedPipelineState key{};
+    key.Refresh(*maxwell3d, features);
+    REQUIRE(key.xfb_enabled == 0);
+    // As after a draw, which consumes the flags of the state it uploaded
+    maxwell3d->dirty.flags.reset();
+    REQUIRE(!key.RefreshDirty(*maxwell3d, features));
+    const Vulkan::FixedPipelineState previous_key{key};
+
+    // The macro enables transform feedback by writing the register directly
+    const Tegra::HLEMacro hle_macro{*maxwell3d};
+    const auto macro = hle_macro.GetHLEProgram(TRANSFORM_FEEDBACK_SETUP_HASH);
+    REQUIRE(macro != nullptr);
+    macro->Execute({0, 0x10000}, 0);
+    REQUIRE(maxwell3d->regs.transform_feedback_enabled == 1);
+
+    REQUIRE(key.RefreshDirty(*maxwell3d, features));
+    REQUIRE(key.xfb_enabled == 1);
+    REQUIRE(key != previous_key);
+}
@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "video_core/texture_cache/readback_predictor.h"
+
+using VideoCommon::ReadbackPredictor;
+using VideoCommon::ReadbackState;
+
+TEST_CASE("ReadbackPredictor[PredictConsecutiveFrames]", "[video_core]") {
+    ReadbackPredictor predictor;
+    ReadbackState state;
+
+    // Several reads within a frame count once
+    REQUIRE(!predictor.Read(state, false, 1, 10));
+    REQUIRE(!predictor.Read(state, false, 1, 10));
+    REQUIRE(!ReadbackPredictor::ShouldPredict(state));
+
+    // Skipping a frame starts over
+    REQUIRE(!predictor.Read(state, false, 1, 12));
+    REQUIRE(!ReadbackPredictor::ShouldPredict(state));
+
+    REQUIRE(!predictor.Read(state, false, 1, 13));
+    REQUIRE(ReadbackPredictor::ShouldPredict(state));
+}
+
+TEST_CASE("ReadbackPredictor[HitMissAccounting]", "[video_core]") {
+    ReadbackPredictor predictor;
+    ReadbackState state;
+
+    // Images not downloaded ahead of time always miss
+    predictor.Read(state, false, 1, 0);
+    predictor.Read(state, false, 1, 1);
+
+    // A predicted image hits only once its latest contents have been downloaded
+    REQUIRE(!predictor.Read(state, true, 2, 2));
+    ReadbackPredictor::NotifyDownloaded(state, 2);
+    REQUIRE(predictor.Read(state, true, 2, 3));
+
+    // The image was modified after the download
+    REQUIRE(!predictor.Read(state, true, 3, 4));
+
+    // Downloads landing out of order keep the newest copy
+    ReadbackPredictor::NotifyDownloaded(state, 3);
+    ReadbackPredictor::NotifyDownloaded(state, 2);
+    REQUIRE(predictor.Read(state, true, 3, 5));
+
+    predictor.NotifySyncDownload(std::chrono::microseconds{300});
+    predictor.NotifySyncDownload(std::chrono::microseconds{100});
+
+    const auto stats = predictor.GetStats();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 4);
+    REQUIRE(stats.stall_time_saved_ns == 2 * 200'000);
+}
+
+TEST_CASE("ReadbackPredictor[Decay]", "[video_core]") {
+    ReadbackPredictor predictor;
+    ReadbackState state;
+
+    // Images which were never read back by the CPU are not forgotten
+    REQUIRE(!ReadbackPredictor::HasStoppedReading(state, 100));
+
+    predictor.Read(state, false, 1, 0);
+    predictor.Read(state, false, 1, 1);
+    REQUIRE(!ReadbackPredictor::HasStoppedReading(state, 1 + ReadbackPredictor::DECAY_FRAMES));
+    REQUIRE(ReadbackPredictor::HasStoppedReading(state, 2 + ReadbackPredictor::DECAY_FRAMES));
+
+    ReadbackPredictor::Forget(state);
+    REQUIRE(!ReadbackPredictor::ShouldPredict(state));
+    REQUIRE(!ReadbackPredictor::HasStoppedReading(state, 2 + ReadbackPredictor::DECAY_FRAMES));
+}
@@ -321,9 +321,7 @@ void Maxwell3D::ProcessDirtyRegisters(u32 method, u32 argument) {
     }
     regs.reg_array[method] = argument;
 
-    for (const auto& table : dirty.tables) {
-        dirty.flags[table[method]] = true;
-    }
+    dirty.Touch(method);
 }
 
 void Maxwell3D::ProcessMethodCall(u32 method, u32 argument, u32 nonshadow_argument,
@@ -3093,10 +3093,19 @@ public:
     struct DirtyState {
         using Flags = std::bitset<std::numeric_limits<u8>::max()>;
         using Table = std::array<u8, Regs::NUM_REGS>;
-        using Tables = std::array<Table, 2>;
+        using Tables = std::array<Table, 3>;
 
         Flags flags;
         Tables tables{};
+        /// Number of tables in use, the last table is only set up by renderers that read it
+        size_t num_tables{2};
+
+        /// Raises the flags of a written register in the tables in use.
+        void Touch(u32 method) {
+            for (size_t i = 0; i < num_tables; ++i) {
+                flags[tables[i][method]] = true;
+            }
+        }
     } dirty;
 
     std::unique_ptr<DrawManager> draw_manager;
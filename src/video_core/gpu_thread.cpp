@@ -28,6 +28,7 @@ static void RunThread(std::stop_token stop_token, Core::System& system,
 
     Common::SetCurrentThreadName(name.c_str());
     Common::SetCurrentThreadPriority(Common::ThreadPriority::Critical);
+    Common::SetCurrentThreadRole(Common::ThreadRole::Gpu);
     system.RegisterHostThread();
 
     auto current_context = context.Acquire();
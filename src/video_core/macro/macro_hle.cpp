@@ -497,6 +497,16 @@ public:
         regs.transform_feedback.buffers[2].start_offset = 0;
         regs.transform_feedback.buffers[3].start_offset = 0;
 
+        // The registers are written without method calls, so raise their dirty flags here
+        using Buffer = Maxwell3D::Regs::TransformFeedback::Buffer;
+        constexpr u32 buffer_words = sizeof(Buffer) / sizeof(u32);
+        constexpr u32 start_offset_word = offsetof(Buffer, start_offset) / sizeof(u32);
+        maxwell3d.dirty.Touch(MAXWELL3D_REG_INDEX(transform_feedback_enabled));
+        for (u32 i = 0; i < Maxwell3D::Regs::NumTransformFeedbackBuffers; ++i) {
+            maxwell3d.dirty.Touch(MAXWELL3D_REG_INDEX(transform_feedback.buffers) +
+                                  i * buffer_words + start_offset_word);
+        }
+
         regs.upload.line_length_in = 4;
         regs.upload.line_count = 1;
         regs.upload.dest.address_high = parameters[0];
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <unordered_map>
 #include <utility>
 
@@ -157,6 +159,26 @@ struct QueryCacheBase<Traits>::QueryCacheBaseImpl {
         return streamer->GetQuery(location.query_id.Value());
     }
 
+    void RememberResolvedValue(VAddr address) {
+        std::scoped_lock lk(resolved_guard);
+        if (resolved_addresses.size() >= MAX_RESOLVED_ADDRESSES) [[unlikely]] {
+            // Forgetting values only costs stalls, keep the set bounded
+            resolved_addresses.clear();
+        }
+        resolved_addresses.insert(address);
+    }
+
+    void ForgetResolvedValues(VAddr address, size_t size) {
+        // Resolved values span up to 16 bytes when a timestamp is written along with them
+        const VAddr begin = address > RESOLVED_VALUE_SIZE ? address - RESOLVED_VALUE_SIZE + 1 : 0;
+        std::scoped_lock lk(resolved_guard);
+        resolved_addresses.erase(resolved_addresses.lower_bound(begin),
+                                 resolved_addresses.lower_bound(address + size));
+    }
+
+    static constexpr size_t MAX_RESOLVED_ADDRESSES = 0x10000;
+    static constexpr VAddr RESOLVED_VALUE_SIZE = 16;
+
     QueryCacheBase<Traits>* owner;
     VideoCore::RasterizerInterface& rasterizer;
     Tegra::MaxwellDeviceMemoryManager& device_memory;
@@ -167,6 +189,14 @@ struct QueryCacheBase<Traits>::QueryCacheBaseImpl {
     std::mutex flush_guard;
     std::deque<u64> flushes_pending;
     std::vector<QueryCacheBase<Traits>::QueryLocation> pending_unregister;
+
+    // Guest addresses holding the resolved value of a query, kept after the query is unregistered
+    // so that the next frame's query at the same address can be answered with it
+    std::mutex resolved_guard;
+    std::set<VAddr> resolved_addresses;
+    const bool use_accurate_resolution{Settings::values.use_accurate_query_resolution.GetValue()};
+    std::atomic<u64> stalls_avoided{};
+    std::atomic<u64> guest_host_syncs{};
 };
 
 template <typename Traits>
@@ -180,7 +210,11 @@ QueryCacheBase<Traits>::QueryCacheBase(Tegra::GPU& gpu_,
 }
 
 template <typename Traits>
-QueryCacheBase<Traits>::~QueryCacheBase() = default;
+QueryCacheBase<Traits>::~QueryCacheBase() {
+    const QueryResolveStats stats = GetResolveStats();
+    LOG_DEBUG(HW_GPU, "Query resolves: {} stalls avoided, {} guest host syncs",
+              stats.stalls_avoided, stats.guest_host_syncs);
+}
 
 template <typename Traits>
 void QueryCacheBase<Traits>::CounterEnable(QueryType counter_type, bool is_enabled) {
@@ -280,6 +314,7 @@ void QueryCacheBase<Traits>::CounterReport(GPUVAddr addr, QueryType counter_type
             u32 value = static_cast<u32>(query_base->value);
             std::memcpy(pointer, &value, sizeof(value));
         }
+        impl->RememberResolvedValue(query_base->guest_address);
         if (!is_synced) [[likely]] {
             impl->pending_unregister.push_back(query_location);
         }
@@ -540,6 +575,8 @@ void QueryCacheBase<Traits>::InvalidateQuery(QueryCacheBase<Traits>::QueryLocati
         return;
     }
     query_base->flags |= QueryFlagBits::IsInvalidated;
+    // The guest wrote over the resolved value
+    impl->ForgetResolvedValues(query_base->guest_address, 1);
 }
 
 template <typename Traits>
@@ -573,9 +610,43 @@ bool QueryCacheBase<Traits>::SemiFlushQueryDirty(QueryCacheBase<Traits>::QueryLo
            False(query_base->flags & QueryFlagBits::IsGuestSynced);
 }
 
+template <typename Traits>
+bool QueryCacheBase<Traits>::HasResolvedValue(QueryCacheBase<Traits>::QueryLocation location) {
+    auto* query_base = impl->ObtainQuery(location);
+    if (!query_base) {
+        return false;
+    }
+    std::scoped_lock lk(impl->resolved_guard);
+    return impl->resolved_addresses.contains(query_base->guest_address);
+}
+
+template <typename Traits>
+void QueryCacheBase<Traits>::ForgetResolvedValues(VAddr addr, std::size_t size) {
+    impl->ForgetResolvedValues(addr, size);
+}
+
+template <typename Traits>
+bool QueryCacheBase<Traits>::CanUseResolvedValues() const {
+    return !impl->use_accurate_resolution && !Settings::IsGPULevelHigh();
+}
+
+template <typename Traits>
+void QueryCacheBase<Traits>::NotifyStallAvoided() {
+    impl->stalls_avoided.fetch_add(1, std::memory_order_relaxed);
+}
+
 template <typename Traits>
 void QueryCacheBase<Traits>::RequestGuestHostSync() {
+    impl->guest_host_syncs.fetch_add(1, std::memory_order_relaxed);
     impl->rasterizer.ReleaseFences();
 }
 
+template <typename Traits>
+QueryResolveStats QueryCacheBase<Traits>::GetResolveStats() const {
+    return QueryResolveStats{
+        .stalls_avoided = impl->stalls_avoided.load(std::memory_order_relaxed),
+        .guest_host_syncs = impl->guest_host_syncs.load(std::memory_order_relaxed),
+    };
+}
+
 } // namespace VideoCommon
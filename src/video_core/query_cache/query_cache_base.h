@@ -33,6 +33,11 @@ struct LookupData {
     QueryBase* found_query;
 };
 
+struct QueryResolveStats {
+    u64 stalls_avoided;   ///< Guest reads answered with the last resolved value
+    u64 guest_host_syncs; ///< Guest reads that waited for the host to resolve the query
+};
+
 template <typename Traits>
 class QueryCacheBase : public VideoCommon::ChannelSetupCaches<VideoCommon::ChannelInfo> {
     using RuntimeType = typename Traits::RuntimeType;
@@ -57,17 +62,27 @@ public:
     void InvalidateRegion(VAddr addr, std::size_t size) {
         IterateCache<true>(addr, size,
                            [this](QueryLocation location) { InvalidateQuery(location); });
+        ForgetResolvedValues(addr, size);
     }
 
     void FlushRegion(VAddr addr, std::size_t size) {
         bool result = false;
-        IterateCache<false>(addr, size, [this, &result](QueryLocation location) {
-            result |= SemiFlushQueryDirty(location);
-            return result;
+        bool has_resolved_values = true;
+        IterateCache<false>(addr, size, [&](QueryLocation location) {
+            if (SemiFlushQueryDirty(location)) {
+                result = true;
+                has_resolved_values &= HasResolvedValue(location);
+            }
         });
-        if (result) {
-            RequestGuestHostSync();
+        if (!result) {
+            return;
+        }
+        if (has_resolved_values && CanUseResolvedValues()) {
+            // Guest memory still holds the value of the last completed resolve
+            NotifyStallAvoided();
+            return;
         }
+        RequestGuestHostSync();
     }
 
     static u64 BuildMask(std::span<const QueryType> types) {
@@ -114,6 +129,8 @@ public:
 
     void BindToChannel(s32 id) override;
 
+    [[nodiscard]] QueryResolveStats GetResolveStats() const;
+
 protected:
     template <bool remove_from_cache, typename Func>
     void IterateCache(VAddr addr, std::size_t size, Func&& func) {
@@ -162,6 +179,10 @@ protected:
     void InvalidateQuery(QueryLocation location);
     bool IsQueryDirty(QueryLocation location);
     bool SemiFlushQueryDirty(QueryLocation location);
+    bool HasResolvedValue(QueryLocation location);
+    void ForgetResolvedValues(VAddr addr, std::size_t size);
+    bool CanUseResolvedValues() const;
+    void NotifyStallAvoided();
     void RequestGuestHostSync();
     void UnregisterPending();
 
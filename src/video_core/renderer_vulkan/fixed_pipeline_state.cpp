@@ -49,50 +49,87 @@ void RefreshXfbState(VideoCommon::TransformFeedbackState& state, const Maxwell&
 } // Anonymous namespace
 
 void FixedPipelineState::Refresh(Tegra::Engines::Maxwell3D& maxwell3d, DynamicFeatures& features) {
+    auto& flags = maxwell3d.dirty.flags;
+    flags[Dirty::PipelineFixed] = true;
+    flags[Dirty::PipelineDynamic] = true;
+    flags[Dirty::PipelineXfb] = true;
+    RefreshDirty(maxwell3d, features);
+}
+
+bool FixedPipelineState::RefreshDirty(Tegra::Engines::Maxwell3D& maxwell3d,
+                                      DynamicFeatures& features) {
     const Maxwell& regs = maxwell3d.regs;
     const auto topology_ = maxwell3d.draw_manager->GetDrawState().topology;
+    auto& flags = maxwell3d.dirty.flags;
+    const auto exchange = [&flags](size_t id) {
+        const bool is_dirty = flags[id];
+        flags[id] = false;
+        return is_dirty;
+    };
 
-    raw1 = 0;
-    extended_dynamic_state.Assign(features.has_extended_dynamic_state ? 1 : 0);
-    extended_dynamic_state_2.Assign(features.has_extended_dynamic_state_2 ? 1 : 0);
-    extended_dynamic_state_2_extra.Assign(features.has_extended_dynamic_state_2_extra ? 1 : 0);
-    extended_dynamic_state_3_blend.Assign(features.has_extended_dynamic_state_3_blend ? 1 : 0);
-    extended_dynamic_state_3_enables.Assign(features.has_extended_dynamic_state_3_enables ? 1 : 0);
-    dynamic_vertex_input.Assign(features.has_dynamic_vertex_input ? 1 : 0);
-    xfb_enabled.Assign(regs.transform_feedback_enabled != 0);
-    ndc_minus_one_to_one.Assign(regs.depth_mode == Maxwell::DepthMode::MinusOneToOne ? 1 : 0);
-    polygon_mode.Assign(PackPolygonMode(regs.polygon_mode_front));
-    tessellation_primitive.Assign(static_cast<u32>(regs.tessellation.params.domain_type.Value()));
-    tessellation_spacing.Assign(static_cast<u32>(regs.tessellation.params.spacing.Value()));
-    tessellation_clockwise.Assign(regs.tessellation.params.output_primitives.Value() ==
-                                  Maxwell::Tessellation::OutputPrimitives::Triangles_CW);
-    patch_control_points_minus_one.Assign(regs.patch_vertices - 1);
-    topology.Assign(topology_);
-    msaa_mode.Assign(regs.anti_alias_samples_mode);
-
-    raw2 = 0;
-
-    const auto test_func =
-        regs.alpha_test_enabled != 0 ? regs.alpha_test_func : Maxwell::ComparisonOp::Always_GL;
-    alpha_test_func.Assign(PackComparisonOp(test_func));
-    early_z.Assign(regs.mandated_early_z != 0 ? 1 : 0);
-    depth_enabled.Assign(regs.zeta_enable != 0 ? 1 : 0);
-    depth_format.Assign(static_cast<u32>(regs.zeta.format));
-    y_negate.Assign(regs.window_origin.mode != Maxwell::WindowOrigin::Mode::UpperLeft ? 1 : 0);
-    provoking_vertex_last.Assign(regs.provoking_vertex == Maxwell::ProvokingVertex::Last ? 1 : 0);
-    conservative_raster_enable.Assign(regs.conservative_raster_enable != 0 ? 1 : 0);
-    smooth_lines.Assign(regs.line_anti_alias_enable != 0 ? 1 : 0);
-    alpha_to_coverage_enabled.Assign(regs.anti_alias_alpha_control.alpha_to_coverage != 0 ? 1 : 0);
-    alpha_to_one_enabled.Assign(regs.anti_alias_alpha_control.alpha_to_one != 0 ? 1 : 0);
-    app_stage.Assign(maxwell3d.engine_state);
-
-    for (size_t i = 0; i < regs.rt.size(); ++i) {
-        color_formats[i] = static_cast<u8>(regs.rt[i].format);
+    // The topology and the engine hint are not registers, compare them against the encoded key
+    const bool fixed_dirty = exchange(Dirty::PipelineFixed) || topology.Value() != topology_ ||
+                             app_stage.Value() != maxwell3d.engine_state;
+    // The window origin and the topology are shared with the dynamic state, and transform
+    // feedback depends on the enable bit stored in the fixed region
+    const bool dynamic_dirty = exchange(Dirty::PipelineDynamic) || fixed_dirty;
+    const bool xfb_dirty = exchange(Dirty::PipelineXfb) || fixed_dirty;
+    const bool vertex_input_dirty = flags[Dirty::VertexInput];
+    const bool swizzles_dirty = flags[Dirty::ViewportSwizzles];
+    const bool blending_dirty =
+        !features.has_extended_dynamic_state_3_blend && flags[Dirty::Blending];
+    if (!fixed_dirty && !dynamic_dirty && !xfb_dirty && !vertex_input_dirty && !swizzles_dirty &&
+        !blending_dirty) {
+        return false;
     }
-    alpha_test_ref = Common::BitCast<u32>(regs.alpha_test_ref);
-    point_size = Common::BitCast<u32>(regs.point_size);
 
-    if (maxwell3d.dirty.flags[Dirty::VertexInput]) {
+    if (fixed_dirty) {
+        raw1 = 0;
+        extended_dynamic_state.Assign(features.has_extended_dynamic_state ? 1 : 0);
+        extended_dynamic_state_2.Assign(features.has_extended_dynamic_state_2 ? 1 : 0);
+        extended_dynamic_state_2_extra.Assign(features.has_extended_dynamic_state_2_extra ? 1 : 0);
+        extended_dynamic_state_3_blend.Assign(features.has_extended_dynamic_state_3_blend ? 1 : 0);
+        extended_dynamic_state_3_enables.Assign(features.has_extended_dynamic_state_3_enables ? 1
+                                                                                              : 0);
+        dynamic_vertex_input.Assign(features.has_dynamic_vertex_input ? 1 : 0);
+        xfb_enabled.Assign(regs.transform_feedback_enabled != 0);
+        ndc_minus_one_to_one.Assign(regs.depth_mode == Maxwell::DepthMode::MinusOneToOne ? 1 : 0);
+        polygon_mode.Assign(PackPolygonMode(regs.polygon_mode_front));
+        tessellation_primitive.Assign(
+            static_cast<u32>(regs.tessellation.params.domain_type.Value()));
+        tessellation_spacing.Assign(static_cast<u32>(regs.tessellation.params.spacing.Value()));
+        tessellation_clockwise.Assign(regs.tessellation.params.output_primitives.Value() ==
+                                      Maxwell::Tessellation::OutputPrimitives::Triangles_CW);
+        patch_control_points_minus_one.Assign(regs.patch_vertices - 1);
+        topology.Assign(topology_);
+        msaa_mode.Assign(regs.anti_alias_samples_mode);
+
+        raw2 = 0;
+
+        const auto test_func =
+            regs.alpha_test_enabled != 0 ? regs.alpha_test_func : Maxwell::ComparisonOp::Always_GL;
+        alpha_test_func.Assign(PackComparisonOp(test_func));
+        early_z.Assign(regs.mandated_early_z != 0 ? 1 : 0);
+        depth_enabled.Assign(regs.zeta_enable != 0 ? 1 : 0);
+        depth_format.Assign(static_cast<u32>(regs.zeta.format));
+        y_negate.Assign(regs.window_origin.mode != Maxwell::WindowOrigin::Mode::UpperLeft ? 1 : 0);
+        provoking_vertex_last.Assign(regs.provoking_vertex == Maxwell::ProvokingVertex::Last ? 1
+                                                                                             : 0);
+        conservative_raster_enable.Assign(regs.conservative_raster_enable != 0 ? 1 : 0);
+        smooth_lines.Assign(regs.line_anti_alias_enable != 0 ? 1 : 0);
+        alpha_to_coverage_enabled.Assign(
+            regs.anti_alias_alpha_control.alpha_to_coverage != 0 ? 1 : 0);
+        alpha_to_one_enabled.Assign(regs.anti_alias_alpha_control.alpha_to_one != 0 ? 1 : 0);
+        app_stage.Assign(maxwell3d.engine_state);
+
+        for (size_t i = 0; i < regs.rt.size(); ++i) {
+            color_formats[i] = static_cast<u8>(regs.rt[i].format);
+        }
+        alpha_test_ref = Common::BitCast<u32>(regs.alpha_test_ref);
+        point_size = Common::BitCast<u32>(regs.point_size);
+    }
+
+    if (vertex_input_dirty) {
         if (features.has_dynamic_vertex_input) {
             // Dirty flag will be reset by the command buffer update
             static constexpr std::array LUT{
@@ -132,38 +169,40 @@ void FixedPipelineState::Refresh(Tegra::Engines::Maxwell3D& maxwell3d, DynamicFe
             }
         }
     }
-    if (maxwell3d.dirty.flags[Dirty::ViewportSwizzles]) {
+    if (swizzles_dirty) {
         maxwell3d.dirty.flags[Dirty::ViewportSwizzles] = false;
         const auto& transform = regs.viewport_transform;
         std::ranges::transform(transform, viewport_swizzles.begin(), [](const auto& viewport) {
             return static_cast<u16>(viewport.swizzle.raw);
         });
     }
-    dynamic_state.raw1 = 0;
-    dynamic_state.raw2 = 0;
-    if (!extended_dynamic_state) {
-        dynamic_state.Refresh(regs);
-        std::ranges::transform(regs.vertex_streams, vertex_strides.begin(), [](const auto& array) {
-            return static_cast<u16>(array.stride.Value());
-        });
-    }
-    if (!extended_dynamic_state_2_extra) {
-        dynamic_state.Refresh2(regs, topology_, extended_dynamic_state_2);
-    }
-    if (!extended_dynamic_state_3_blend) {
-        if (maxwell3d.dirty.flags[Dirty::Blending]) {
-            maxwell3d.dirty.flags[Dirty::Blending] = false;
-            for (size_t index = 0; index < attachments.size(); ++index) {
-                attachments[index].Refresh(regs, index);
-            }
+    if (dynamic_dirty) {
+        dynamic_state.raw1 = 0;
+        dynamic_state.raw2 = 0;
+        if (!extended_dynamic_state) {
+            dynamic_state.Refresh(regs);
+            std::ranges::transform(regs.vertex_streams, vertex_strides.begin(),
+                                   [](const auto& array) {
+                                       return static_cast<u16>(array.stride.Value());
+                                   });
+        }
+        if (!extended_dynamic_state_2_extra) {
+            dynamic_state.Refresh2(regs, topology_, extended_dynamic_state_2);
+        }
+        if (!extended_dynamic_state_3_enables) {
+            dynamic_state.Refresh3(regs);
         }
     }
-    if (!extended_dynamic_state_3_enables) {
-        dynamic_state.Refresh3(regs);
+    if (blending_dirty) {
+        maxwell3d.dirty.flags[Dirty::Blending] = false;
+        for (size_t index = 0; index < attachments.size(); ++index) {
+            attachments[index].Refresh(regs, index);
+        }
     }
-    if (xfb_enabled) {
+    if (xfb_dirty && xfb_enabled) {
         RefreshXfbState(xfb_state, regs);
     }
+    return true;
 }
 
 void FixedPipelineState::BlendingAttachment::Refresh(const Maxwell& regs, size_t index) {
@@ -235,6 +235,10 @@ struct FixedPipelineState {
 
     void Refresh(Tegra::Engines::Maxwell3D& maxwell3d, DynamicFeatures& features);
 
+    /// Re-encodes only the regions whose registers were written since the last refresh.
+    /// Returns true when any region was re-encoded and the key may have changed.
+    bool RefreshDirty(Tegra::Engines::Maxwell3D& maxwell3d, DynamicFeatures& features);
+
     size_t Hash() const noexcept;
 
     bool operator==(const FixedPipelineState& rhs) const noexcept;
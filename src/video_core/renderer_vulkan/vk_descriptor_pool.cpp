@@ -6,6 +6,7 @@
 #include <span>
 #include <vector>
 
+#include "common/assert.h"
 #include "common/common_types.h"
 #include "common/polyfill_ranges.h"
 #include "video_core/renderer_vulkan/vk_descriptor_pool.h"
@@ -90,6 +91,9 @@ DescriptorAllocator::DescriptorAllocator(const Device& device_, MasterSemaphore&
       layout{layout_} {}
 
 VkDescriptorSet DescriptorAllocator::Commit() {
+    // Allocators are shared by the commands of a render pass, which may be recorded in parallel
+    ASSERT_MSG(!Scheduler::IsRecordingThread(),
+               "Descriptor sets must be committed when preparing commands");
     const size_t index = CommitResource();
     return sets[index / SETS_GROW_RATE][index % SETS_GROW_RATE];
 }
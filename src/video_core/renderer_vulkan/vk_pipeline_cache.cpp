@@ -20,6 +20,7 @@
 #include "shader_recompiler/frontend/maxwell/control_flow.h"
 #include "shader_recompiler/frontend/maxwell/translate_program.h"
 #include "shader_recompiler/program_header.h"
+#include "video_core/dirty_flags.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/memory_manager.h"
@@ -412,6 +413,8 @@ PipelineCache::PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_,
 }
 
 PipelineCache::~PipelineCache() {
+    LOG_DEBUG(Render_Vulkan, "Graphics pipeline lookups: {} reused, {} transitions, {} slow path",
+              lookup_stats.reused, lookup_stats.transitions, lookup_stats.slow_path);
     if (use_vulkan_pipeline_cache && !vulkan_pipeline_cache_filename.empty()) {
         SerializeVulkanPipelineCache(vulkan_pipeline_cache_filename, vulkan_pipeline_cache,
                                      CACHE_VERSION);
@@ -421,16 +424,29 @@ PipelineCache::~PipelineCache() {
 GraphicsPipeline* PipelineCache::CurrentGraphicsPipeline() {
     MICROPROFILE_SCOPE(Vulkan_PipelineCache);
 
+    const bool shaders_dirty{maxwell3d->dirty.flags[VideoCommon::Dirty::Shaders]};
     if (!RefreshStages(graphics_key.unique_hashes)) {
         current_pipeline = nullptr;
+        current_pipeline_matches_key = false;
         return nullptr;
     }
-    graphics_key.state.Refresh(*maxwell3d, dynamic_features);
-
+    bool state_dirty{true};
+    if (graphics_key_engine != maxwell3d) {
+        graphics_key_engine = maxwell3d;
+        graphics_key.state.Refresh(*maxwell3d, dynamic_features);
+    } else {
+        state_dirty = graphics_key.state.RefreshDirty(*maxwell3d, dynamic_features);
+    }
+    if (current_pipeline && current_pipeline_matches_key && !shaders_dirty && !state_dirty) {
+        ++lookup_stats.reused;
+        return BuiltPipeline(current_pipeline);
+    }
     if (current_pipeline) {
         GraphicsPipeline* const next{current_pipeline->Next(graphics_key)};
         if (next) {
+            ++lookup_stats.transitions;
             current_pipeline = next;
+            current_pipeline_matches_key = true;
             return BuiltPipeline(current_pipeline);
         }
     }
@@ -567,18 +583,21 @@ void PipelineCache::LoadDiskResources(u64 title_id, std::stop_token stop_loading
 }
 
 GraphicsPipeline* PipelineCache::CurrentGraphicsPipelineSlowPath() {
+    ++lookup_stats.slow_path;
     const auto [pair, is_new]{graphics_cache.try_emplace(graphics_key)};
     auto& pipeline{pair->second};
     if (is_new) {
         pipeline = CreateGraphicsPipeline();
     }
     if (!pipeline) {
+        current_pipeline_matches_key = false;
         return nullptr;
     }
     if (current_pipeline) {
         current_pipeline->AddTransition(pipeline.get());
     }
     current_pipeline = pipeline.get();
+    current_pipeline_matches_key = true;
     return BuiltPipeline(current_pipeline);
 }
 
@@ -97,6 +97,13 @@ struct ShaderPools {
     Shader::ObjectPool<Shader::Maxwell::Flow::Block> flow_block{32};
 };
 
+/// Counters describing how graphics pipeline lookups were resolved
+struct GraphicsPipelineLookupStats {
+    u64 reused{};      ///< No pipeline-relevant state changed, previous lookup returned
+    u64 transitions{}; ///< Resolved through the transition list of the previous pipeline
+    u64 slow_path{};   ///< Resolved through the pipeline hash map
+};
+
 class PipelineCache : public VideoCommon::ShaderCache {
 public:
     explicit PipelineCache(Tegra::MaxwellDeviceMemoryManager& device_memory_, const Device& device,
@@ -110,6 +117,10 @@ public:
 
     [[nodiscard]] ComputePipeline* CurrentComputePipeline();
 
+    [[nodiscard]] const GraphicsPipelineLookupStats& GetGraphicsLookupStats() const noexcept {
+        return lookup_stats;
+    }
+
     void LoadDiskResources(u64 title_id, std::stop_token stop_loading,
                            const VideoCore::DiskResourceLoadCallback& callback);
 
@@ -153,6 +164,11 @@ private:
 
     GraphicsPipelineCacheKey graphics_key{};
     GraphicsPipeline* current_pipeline{};
+    /// Engine the graphics key was last encoded from, a channel change forces a full refresh
+    Tegra::Engines::Maxwell3D* graphics_key_engine{};
+    /// True when current_pipeline was built from the current contents of graphics_key
+    bool current_pipeline_matches_key{};
+    GraphicsPipelineLookupStats lookup_stats;
 
     std::unordered_map<ComputePipelineCacheKey, std::unique_ptr<ComputePipeline>> compute_cache;
     std::unordered_map<GraphicsPipelineCacheKey, std::unique_ptr<GraphicsPipeline>> graphics_cache;
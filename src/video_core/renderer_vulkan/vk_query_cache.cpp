@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include <cstddef>
+#include <cstring>
 #include <limits>
 #include <map>
 #include <memory>
@@ -118,7 +119,8 @@ public:
                              ComputePassDescriptorQueue& compute_pass_descriptor_queue,
                              DescriptorPool& descriptor_pool)
         : BaseStreamer(id_), runtime{runtime_}, rasterizer{rasterizer_}, device{device_},
-          scheduler{scheduler_}, memory_allocator{memory_allocator_} {
+          scheduler{scheduler_}, memory_allocator{memory_allocator_},
+          use_accurate_resolution{Settings::values.use_accurate_query_resolution.GetValue()} {
         current_bank = nullptr;
         current_query = nullptr;
         amend_value = 0;
@@ -151,6 +153,7 @@ public:
             return;
         }
         ReserveHostQuery();
+        scheduler.RequestInlineRecording();
         scheduler.Record([query_pool = current_query_pool,
                           query_index = current_bank_slot](vk::CommandBuffer cmdbuf) {
             const bool use_precise = Settings::IsGPULevelHigh();
@@ -352,37 +355,154 @@ public:
     void PushUnsyncedQueries() override {
         PauseCounter();
         current_bank->Close();
+        FlushSet flush_set{
+            .queries = std::move(pending_flush_queries),
+        };
+        if (!use_accurate_resolution && !flush_set.queries.empty()) {
+            RecordBatchedResolve(flush_set);
+        }
         {
             std::scoped_lock lk(flush_guard);
-            pending_flush_sets.emplace_back(std::move(pending_flush_queries));
+            pending_flush_sets.emplace_back(std::move(flush_set));
         }
     }
 
     void PopUnsyncedQueries() override {
-        std::vector<size_t> current_flush_queries;
+        FlushSet flush_set;
         {
             std::scoped_lock lk(flush_guard);
-            current_flush_queries = std::move(pending_flush_sets.front());
+            flush_set = std::move(pending_flush_sets.front());
             pending_flush_sets.pop_front();
         }
-        ApplyBanksWideOp<false>(
-            current_flush_queries,
-            [](SamplesQueryBank* bank, size_t start, size_t amount) { bank->Sync(start, amount); });
-        for (auto q : current_flush_queries) {
+        if (!flush_set.readback) {
+            ApplyBanksWideOp<false>(flush_set.queries,
+                                    [](SamplesQueryBank* bank, size_t start, size_t amount) {
+                                        bank->Sync(start, amount);
+                                    });
+            for (auto q : flush_set.queries) {
+                auto* query = GetQuery(q);
+                u64 total = 0;
+                ApplyBankOp(query, [&total](SamplesQueryBank* bank, size_t start, size_t amount) {
+                    const auto& results = bank->GetResults();
+                    for (size_t i = 0; i < amount; i++) {
+                        total += results[start + i];
+                    }
+                });
+                query->value = total;
+                query->flags |= VideoCommon::QueryFlagBits::IsFinalValueSynced;
+            }
+            return;
+        }
+        // The fence of this set has been signaled, the batched copy has already landed
+        ReadbackBuffer& readback = *flush_set.readback;
+        readback.buffer.Invalidate();
+        const u8* const data = readback.buffer.Mapped().data();
+        for (auto q : flush_set.queries) {
             auto* query = GetQuery(q);
             u64 total = 0;
-            ApplyBankOp(query, [&total](SamplesQueryBank* bank, size_t start, size_t amount) {
-                const auto& results = bank->GetResults();
+            ApplyBankOp(query, [&](SamplesQueryBank* bank, size_t start, size_t amount) {
+                const auto [bank_start, base_offset] = flush_set.offsets.at(bank->GetIndex());
                 for (size_t i = 0; i < amount; i++) {
-                    total += results[start + i];
+                    u64 result;
+                    std::memcpy(&result,
+                                data + base_offset +
+                                    (start - bank_start + i) * SamplesQueryBank::QUERY_SIZE,
+                                sizeof(result));
+                    total += result;
                 }
             });
             query->value = total;
             query->flags |= VideoCommon::QueryFlagBits::IsFinalValueSynced;
         }
+        std::scoped_lock lk(flush_guard);
+        readback.in_use = false;
     }
 
 private:
+    struct ReadbackBuffer {
+        vk::Buffer buffer;
+        size_t size;
+        bool in_use;
+    };
+
+    /// Queries resolved together when their fence is signaled
+    struct FlushSet {
+        std::vector<size_t> queries;
+        /// Readback buffer holding the batched results, null for the accurate path
+        ReadbackBuffer* readback = nullptr;
+        /// Bank index to the first resolved slot and its offset in the readback buffer
+        std::unordered_map<size_t, std::pair<size_t, size_t>> offsets;
+    };
+
+    void RecordBatchedResolve(FlushSet& flush_set) {
+        struct Copy {
+            VkQueryPool query_pool;
+            u32 start;
+            u32 amount;
+            VkDeviceSize offset;
+        };
+        std::vector<Copy> copies;
+        size_t total_size = 0;
+        ApplyBanksWideOp<true>(flush_set.queries,
+                               [&](SamplesQueryBank* bank, size_t start, size_t amount) {
+                                   flush_set.offsets[bank->GetIndex()] = {start, total_size};
+                                   copies.push_back(Copy{
+                                       .query_pool = bank->GetInnerPool(),
+                                       .start = static_cast<u32>(start),
+                                       .amount = static_cast<u32>(amount),
+                                       .offset = total_size,
+                                   });
+                                   total_size += amount * SamplesQueryBank::QUERY_SIZE;
+                               });
+        if (copies.empty()) {
+            return;
+        }
+        flush_set.readback = ObtainReadbackBuffer(total_size);
+        const VkBuffer buffer = *flush_set.readback->buffer;
+        scheduler.RequestOutsideRenderPassOperationContext();
+        scheduler.Record([buffer, copies = std::move(copies)](vk::CommandBuffer cmdbuf) {
+            static constexpr VkMemoryBarrier READBACK_BARRIER{
+                .sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                .pNext = nullptr,
+                .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                .dstAccessMask = VK_ACCESS_HOST_READ_BIT,
+            };
+            for (const Copy& copy : copies) {
+                cmdbuf.CopyQueryPoolResults(copy.query_pool, copy.start, copy.amount, buffer,
+                                            copy.offset, SamplesQueryBank::QUERY_SIZE,
+                                            VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_64_BIT);
+            }
+            cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0,
+                                   READBACK_BARRIER);
+        });
+    }
+
+    ReadbackBuffer* ObtainReadbackBuffer(size_t size) {
+        std::scoped_lock lk(flush_guard);
+        for (ReadbackBuffer& readback : readback_buffers) {
+            if (!readback.in_use && readback.size >= size) {
+                readback.in_use = true;
+                return &readback;
+            }
+        }
+        const size_t log_2 = std::max<size_t>(11U, Common::Log2Ceil64(size));
+        const VkBufferCreateInfo buffer_ci = {
+            .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+            .pNext = nullptr,
+            .flags = 0,
+            .size = 1ULL << log_2,
+            .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            .sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+            .queueFamilyIndexCount = 0,
+            .pQueueFamilyIndices = nullptr,
+        };
+        return &readback_buffers.emplace_back(ReadbackBuffer{
+            .buffer = memory_allocator.CreateBuffer(buffer_ci, MemoryUsage::Download),
+            .size = 1ULL << log_2,
+            .in_use = true,
+        });
+    }
+
     template <typename Func>
     void ApplyBankOp(VideoCommon::HostQueryBase* query, Func&& func) {
         size_t size_slots = query->size_slots;
@@ -570,7 +690,12 @@ private:
 
     // flush levels
     std::vector<size_t> pending_flush_queries;
-    std::deque<std::vector<size_t>> pending_flush_sets;
+    std::deque<FlushSet> pending_flush_sets;
+
+    // batched resolution
+    const bool use_accurate_resolution;
+    // Only accessed under flush_guard, flush sets hold pointers which stay valid as it grows
+    std::deque<ReadbackBuffer> readback_buffers;
 
     // State Machine
     size_t current_bank_slot;
@@ -852,6 +977,7 @@ private:
             return;
         }
         has_flushed_end_pending = true;
+        scheduler.RequestInlineRecording();
         if (!has_started || buffers_count == 0) {
             scheduler.Record([](vk::CommandBuffer cmdbuf) {
                 cmdbuf.BeginTransformFeedbackEXT(0, 0, nullptr, nullptr);
@@ -1279,6 +1405,7 @@ void QueryCacheRuntime::ResumeHostConditionalRendering() {
         return;
     }
     if (!impl->is_hcr_running) {
+        impl->scheduler.RequestInlineRecording();
         impl->scheduler.Record([hcr_setup = impl->hcr_setup](vk::CommandBuffer cmdbuf) {
             cmdbuf.BeginConditionalRenderingEXT(hcr_setup);
         });
@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <thread>
@@ -9,7 +10,9 @@
 
 #include "video_core/renderer_vulkan/vk_query_cache.h"
 
+#include "common/logging/log.h"
 #include "common/microprofile.h"
+#include "common/settings.h"
 #include "common/thread.h"
 #include "video_core/renderer_vulkan/vk_command_pool.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
@@ -23,6 +26,49 @@ namespace Vulkan {
 
 MICROPROFILE_DECLARE(Vulkan_WaitForWorker);
 
+namespace {
+/// Upper bound of chunks held back by a parallel render pass before it is recorded inline
+constexpr size_t MAX_PARALLEL_PASS_CHUNKS = 256;
+
+thread_local bool is_recording_thread = false;
+
+size_t NumRecordingThreads() {
+    const size_t num_threads = std::thread::hardware_concurrency();
+    return std::clamp<size_t>(num_threads / 4, 2, 4);
+}
+
+void EndRenderPassWithBarriers(vk::CommandBuffer cmdbuf, size_t num_images,
+                               const std::array<VkImage, 9>& images,
+                               const std::array<VkImageSubresourceRange, 9>& ranges) {
+    std::array<VkImageMemoryBarrier, 9> barriers;
+    for (size_t i = 0; i < num_images; ++i) {
+        barriers[i] = VkImageMemoryBarrier{
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .pNext = nullptr,
+            .srcAccessMask =
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                             VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
+                             VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
+                             VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+            .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .newLayout = VK_IMAGE_LAYOUT_GENERAL,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = images[i],
+            .subresourceRange = ranges[i],
+        };
+    }
+    cmdbuf.EndRenderPass();
+    cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                               VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+                               VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                           VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
+                           vk::Span(barriers.data(), num_images));
+}
+} // Anonymous namespace
+
 void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
                                          vk::CommandBuffer upload_cmdbuf) {
     auto command = first;
@@ -33,15 +79,36 @@ void Scheduler::CommandChunk::ExecuteAll(vk::CommandBuffer cmdbuf,
         command = next;
     }
     submit = false;
+    uses_upload = false;
     command_offset = 0;
     first = nullptr;
     last = nullptr;
 }
 
+void Scheduler::CommandChunk::PrepareAll() const {
+    for (const Command* command = first; command != nullptr; command = command->GetNext()) {
+        command->Prepare();
+    }
+}
+
 Scheduler::Scheduler(const Device& device_, StateTracker& state_tracker_)
     : device{device_}, state_tracker{state_tracker_},
       master_semaphore{std::make_unique<MasterSemaphore>(device)},
-      command_pool{std::make_unique<CommandPool>(*master_semaphore, device)} {
+      command_pool{std::make_unique<CommandPool>(*master_semaphore, device)},
+      use_parallel_recording{Settings::values.use_parallel_command_recording.GetValue()} {
+    if (use_parallel_recording) {
+        const size_t num_threads = NumRecordingThreads();
+        LOG_INFO(Render_Vulkan, "Recording render passes in parallel with {} threads",
+                 num_threads);
+        recording_workers =
+            std::make_unique<Common::StatefulThreadWorker<std::unique_ptr<CommandPool>>>(
+                num_threads, "VulkanRecorder", [this] {
+                    Common::SetCurrentThreadRole(Common::ThreadRole::GpuRecorder);
+                    is_recording_thread = true;
+                    return std::make_unique<CommandPool>(*master_semaphore, device,
+                                                         VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+                });
+    }
     AcquireNewChunk();
     AllocateWorkerCommandBuffer();
     worker_thread = std::jthread([this](std::stop_token token) { WorkerThread(token); });
@@ -66,6 +133,11 @@ void Scheduler::Finish(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore)
 
 void Scheduler::WaitWorker() {
     MICROPROFILE_SCOPE(Vulkan_WaitForWorker);
+    if (parallel_pass) {
+        // Callers expect every recorded command to have been executed, the rest of the render
+        // pass is recorded inline
+        CommitParallelPass(false);
+    }
     DispatchWork();
 
     // Ensure the queue is drained.
@@ -82,6 +154,10 @@ void Scheduler::DispatchWork() {
     if (chunk->Empty()) {
         return;
     }
+    if (parallel_pass) {
+        SplitParallelPass();
+        return;
+    }
     {
         std::scoped_lock ql{queue_mutex};
         work_queue.push(std::move(chunk));
@@ -104,25 +180,15 @@ void Scheduler::RequestRenderpass(const Framebuffer* framebuffer) {
     state.framebuffer = framebuffer_handle;
     state.render_area = render_area;
 
-    Record([renderpass, framebuffer_handle, render_area](vk::CommandBuffer cmdbuf) {
-        const VkRenderPassBeginInfo renderpass_bi{
-            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            .pNext = nullptr,
-            .renderPass = renderpass,
-            .framebuffer = framebuffer_handle,
-            .renderArea =
-                {
-                    .offset = {.x = 0, .y = 0},
-                    .extent = render_area,
-                },
-            .clearValueCount = 0,
-            .pClearValues = nullptr,
-        };
-        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
-    });
     num_renderpass_images = framebuffer->NumImages();
     renderpass_images = framebuffer->Images();
     renderpass_image_ranges = framebuffer->ImageRanges();
+
+    if (use_parallel_recording && !inline_until_submit) {
+        BeginParallelPass();
+    } else {
+        RecordBeginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+    }
 }
 
 void Scheduler::RequestOutsideRenderPassOperationContext() {
@@ -148,6 +214,7 @@ bool Scheduler::UpdateRescaling(bool is_rescaling) {
 
 void Scheduler::WorkerThread(std::stop_token stop_token) {
     Common::SetCurrentThreadName("VulkanWorker");
+    Common::SetCurrentThreadRole(Common::ThreadRole::GpuWorker);
 
     const auto TryPopQueue{[this](auto& work) -> bool {
         if (work_queue.empty()) {
@@ -219,6 +286,7 @@ void Scheduler::AllocateWorkerCommandBuffer() {
 u64 Scheduler::SubmitExecution(VkSemaphore signal_semaphore, VkSemaphore wait_semaphore) {
     EndPendingOperations();
     InvalidateState();
+    inline_until_submit = false;
 
     const u64 signal_value = master_semaphore->NextTick();
     RecordWithUploadBuffer([signal_semaphore, wait_semaphore, signal_value,
@@ -276,6 +344,20 @@ void Scheduler::InvalidateState() {
     state_tracker.InvalidateCommandBufferState();
 }
 
+bool Scheduler::IsRecordingThread() noexcept {
+    return is_recording_thread;
+}
+
+void Scheduler::RequestInlineRecording() {
+    if (!use_parallel_recording) {
+        return;
+    }
+    inline_until_submit = true;
+    if (parallel_pass) {
+        CommitParallelPass(false);
+    }
+}
+
 void Scheduler::EndPendingOperations() {
 #if ANDROID
     if (Settings::IsGPULevelHigh()) {
@@ -311,34 +393,12 @@ void Scheduler::EndRenderPass() {
     if (!state.renderpass) {
         return;
     }
+    if (parallel_pass) {
+        CommitParallelPass(true);
+    }
     Record([num_images = num_renderpass_images, images = renderpass_images,
             ranges = renderpass_image_ranges](vk::CommandBuffer cmdbuf) {
-        std::array<VkImageMemoryBarrier, 9> barriers;
-        for (size_t i = 0; i < num_images; ++i) {
-            barriers[i] = VkImageMemoryBarrier{
-                .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-                .pNext = nullptr,
-                .srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT |
-                                 VK_ACCESS_COLOR_ATTACHMENT_READ_BIT |
-                                 VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT |
-                                 VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
-                .oldLayout = VK_IMAGE_LAYOUT_GENERAL,
-                .newLayout = VK_IMAGE_LAYOUT_GENERAL,
-                .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-                .image = images[i],
-                .subresourceRange = ranges[i],
-            };
-        }
-        cmdbuf.EndRenderPass();
-        cmdbuf.PipelineBarrier(VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
-                                   VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
-                                   VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
-                               VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, nullptr, nullptr,
-                               vk::Span(barriers.data(), num_images));
+        EndRenderPassWithBarriers(cmdbuf, num_images, images, ranges);
     });
     state.renderpass = nullptr;
     num_renderpass_images = 0;
@@ -357,4 +417,208 @@ void Scheduler::AcquireNewChunk() {
     }
 }
 
+void Scheduler::AdvanceChunk() {
+    if (!parallel_pass) {
+        DispatchWork();
+        return;
+    }
+    // The chunk filled up in the middle of a draw, keep recording into the same task
+    parallel_pass->tasks.back().push_back(std::move(chunk));
+    AcquireNewChunk();
+    if (++parallel_pass->num_chunks >= MAX_PARALLEL_PASS_CHUNKS) {
+        CommitParallelPass(false);
+    }
+}
+
+void Scheduler::RecordBeginRenderPass(VkSubpassContents contents) {
+    Record([renderpass = state.renderpass, framebuffer_handle = state.framebuffer,
+            render_area = state.render_area, contents](vk::CommandBuffer cmdbuf) {
+        const VkRenderPassBeginInfo renderpass_bi{
+            .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            .pNext = nullptr,
+            .renderPass = renderpass,
+            .framebuffer = framebuffer_handle,
+            .renderArea =
+                {
+                    .offset = {.x = 0, .y = 0},
+                    .extent = render_area,
+                },
+            .clearValueCount = 0,
+            .pClearValues = nullptr,
+        };
+        cmdbuf.BeginRenderPass(renderpass_bi, contents);
+    });
+}
+
+void Scheduler::BeginParallelPass() {
+    // Everything recorded before the render pass stays in the primary command buffer
+    DispatchWork();
+
+    parallel_pass = std::make_unique<ParallelPass>();
+    parallel_pass->renderpass = state.renderpass;
+    parallel_pass->framebuffer = state.framebuffer;
+    parallel_pass->render_area = state.render_area;
+    parallel_pass->num_images = num_renderpass_images;
+    parallel_pass->images = renderpass_images;
+    parallel_pass->image_ranges = renderpass_image_ranges;
+    // The first task continues the draw that requested the render pass and depends on the state
+    // bound before it, it is recorded inline on the worker thread
+    parallel_pass->tasks.emplace_back();
+}
+
+void Scheduler::SplitParallelPass() {
+    // Called on draw boundaries, the next draw starts a new secondary command buffer which does
+    // not inherit any bound state
+    parallel_pass->tasks.back().push_back(std::move(chunk));
+    parallel_pass->tasks.emplace_back();
+    AcquireNewChunk();
+    InvalidateState();
+    if (++parallel_pass->num_chunks >= MAX_PARALLEL_PASS_CHUNKS) {
+        CommitParallelPass(false);
+    }
+}
+
+void Scheduler::CommitParallelPass(bool record_in_parallel) {
+    std::unique_ptr<ParallelPass> pass = std::move(parallel_pass);
+    if (!chunk->Empty()) {
+        pass->tasks.back().push_back(std::move(chunk));
+        AcquireNewChunk();
+    }
+    std::erase_if(pass->tasks, [](const auto& task) { return task.empty(); });
+
+    if (record_in_parallel) {
+        RecordWithUploadBuffer([this, pass = std::move(pass)](vk::CommandBuffer cmdbuf,
+                                                              vk::CommandBuffer upload_cmdbuf) {
+            ExecuteParallelPass(*pass, cmdbuf, upload_cmdbuf);
+        });
+        return;
+    }
+    // Replay the held back chunks inline, in recording order, after beginning the render pass
+    RecordBeginRenderPass(VK_SUBPASS_CONTENTS_INLINE);
+    DispatchWork();
+    {
+        std::scoped_lock ql{queue_mutex};
+        for (auto& task : pass->tasks) {
+            for (auto& task_chunk : task) {
+                work_queue.push(std::move(task_chunk));
+            }
+        }
+    }
+    event_cv.notify_all();
+}
+
+void Scheduler::ExecuteParallelPass(ParallelPass& pass, vk::CommandBuffer cmdbuf,
+                                    vk::CommandBuffer upload_cmdbuf) {
+    // Recording threads only record commands, the state they share is updated here beforehand
+    for (const auto& task : pass.tasks) {
+        for (const auto& task_chunk : task) {
+            task_chunk->PrepareAll();
+        }
+    }
+
+    const size_t num_tasks = pass.tasks.size();
+    pass.cmdbufs.assign(num_tasks, VkCommandBuffer{});
+    pass.upload_cmdbufs.assign(num_tasks, VkCommandBuffer{});
+    for (size_t index = 1; index < num_tasks; ++index) {
+        recording_workers->QueueWork([this, &pass, index](std::unique_ptr<CommandPool>* pool) {
+            RecordParallelTask(pass, index, **pool);
+        });
+    }
+    const VkRenderPassBeginInfo renderpass_bi{
+        .sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+        .pNext = nullptr,
+        .renderPass = pass.renderpass,
+        .framebuffer = pass.framebuffer,
+        .renderArea =
+            {
+                .offset = {.x = 0, .y = 0},
+                .extent = pass.render_area,
+            },
+        .clearValueCount = 0,
+        .pClearValues = nullptr,
+    };
+    // Record the first task inline while the others are being recorded
+    cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_INLINE);
+    if (num_tasks > 0) {
+        for (const auto& task_chunk : pass.tasks.front()) {
+            task_chunk->ExecuteAll(cmdbuf, upload_cmdbuf);
+        }
+    }
+    recording_workers->WaitForRequests();
+
+    if (num_tasks > 1) {
+        // Restart the render pass to execute the secondary command buffers. Attachments are
+        // loaded and stored, so this is only a split of the render pass instance.
+        EndRenderPassWithBarriers(cmdbuf, pass.num_images, pass.images, pass.image_ranges);
+        cmdbuf.BeginRenderPass(renderpass_bi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        cmdbuf.ExecuteCommands(vk::Span(pass.cmdbufs.data() + 1, num_tasks - 1));
+
+        // Upload commands are executed in recording order, after the ones of the first task
+        std::erase(pass.upload_cmdbufs, VkCommandBuffer{});
+        if (!pass.upload_cmdbufs.empty()) {
+            upload_cmdbuf.ExecuteCommands(pass.upload_cmdbufs);
+        }
+    }
+
+    std::scoped_lock rl{reserve_mutex};
+    for (auto& task : pass.tasks) {
+        for (auto& task_chunk : task) {
+            chunk_reserve.emplace_back(std::move(task_chunk));
+        }
+    }
+}
+
+void Scheduler::RecordParallelTask(ParallelPass& pass, size_t index, CommandPool& pool) {
+    const auto& task = pass.tasks[index];
+    const VkCommandBufferInheritanceInfo renderpass_inheritance{
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+        .pNext = nullptr,
+        .renderPass = pass.renderpass,
+        .subpass = 0,
+        .framebuffer = pass.framebuffer,
+        .occlusionQueryEnable = VK_FALSE,
+        .queryFlags = 0,
+        .pipelineStatistics = 0,
+    };
+    const vk::CommandBuffer cmdbuf(pool.Commit(), device.GetDispatchLoader());
+    cmdbuf.Begin({
+        .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+        .pNext = nullptr,
+        .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+                 VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+        .pInheritanceInfo = &renderpass_inheritance,
+    });
+    const bool uses_upload = std::ranges::any_of(
+        task, [](const auto& task_chunk) { return task_chunk->UsesUpload(); });
+    vk::CommandBuffer upload_cmdbuf;
+    if (uses_upload) {
+        static constexpr VkCommandBufferInheritanceInfo upload_inheritance{
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+            .pNext = nullptr,
+            .renderPass = VK_NULL_HANDLE,
+            .subpass = 0,
+            .framebuffer = VK_NULL_HANDLE,
+            .occlusionQueryEnable = VK_FALSE,
+            .queryFlags = 0,
+            .pipelineStatistics = 0,
+        };
+        upload_cmdbuf = vk::CommandBuffer(pool.Commit(), device.GetDispatchLoader());
+        upload_cmdbuf.Begin({
+            .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .pNext = nullptr,
+            .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,
+            .pInheritanceInfo = &upload_inheritance,
+        });
+    }
+    for (const auto& task_chunk : task) {
+        task_chunk->ExecuteAll(cmdbuf, upload_cmdbuf);
+    }
+    cmdbuf.End();
+    pass.cmdbufs[index] = *cmdbuf;
+    if (uses_upload) {
+        upload_cmdbuf.End();
+        pass.upload_cmdbufs[index] = *upload_cmdbuf;
+    }
+}
+
 } // namespace Vulkan
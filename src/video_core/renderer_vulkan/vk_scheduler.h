@@ -8,12 +8,15 @@
 #include <functional>
 #include <memory>
 #include <thread>
+#include <type_traits>
 #include <utility>
 #include <queue>
+#include <vector>
 
 #include "common/alignment.h"
 #include "common/common_types.h"
 #include "common/polyfill_thread.h"
+#include "common/thread_worker.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/vulkan_common/vulkan_wrapper.h"
 
@@ -68,6 +71,10 @@ public:
     /// Invalidates current command buffer state except for render passes
     void InvalidateState();
 
+    /// Forces render passes to be recorded inline until the next submission. Queries, transform
+    /// feedback and conditional rendering scopes can not span secondary command buffers.
+    void RequestInlineRecording();
+
     /// Assigns the query cache.
     void SetQueryCache(VideoCommon::QueryCacheBase<QueryCacheParams>& query_cache_) {
         query_cache = &query_cache_;
@@ -82,22 +89,35 @@ public:
     template <typename T>
         requires std::is_invocable_v<T, vk::CommandBuffer, vk::CommandBuffer>
     void RecordWithUploadBuffer(T&& command) {
-        if (chunk->Record(command)) {
-            return;
-        }
-        DispatchWork();
-        (void)chunk->Record(command);
+        RecordCommand(command);
+        chunk->MarkUpload();
     }
 
     template <typename T>
         requires std::is_invocable_v<T, vk::CommandBuffer>
     void Record(T&& c) {
-        this->RecordWithUploadBuffer(
-            [command = std::move(c)](vk::CommandBuffer cmdbuf, vk::CommandBuffer) {
-                command(cmdbuf);
-            });
+        auto command = [command = std::move(c)](vk::CommandBuffer cmdbuf, vk::CommandBuffer) {
+            command(cmdbuf);
+        };
+        RecordCommand(command);
+    }
+
+    /// Send work to a separate thread. Host work shared with other commands, such as committing
+    /// and writing descriptor sets, is done by prepare before the command is recorded. Commands
+    /// of a render pass may be recorded on several threads at once, but they are always prepared
+    /// on the worker thread in recording order.
+    template <typename P, typename T>
+        requires std::is_invocable_v<T, vk::CommandBuffer, std::invoke_result_t<P&>>
+    void RecordWithPrepare(P&& prepare, T&& c) {
+        auto command = PreparedCommand<std::decay_t<P>, std::decay_t<T>>(std::forward<P>(prepare),
+                                                                         std::forward<T>(c));
+        RecordCommand(command);
     }
 
+    /// Returns true when called from a thread recording the contents of a render pass in
+    /// parallel.
+    [[nodiscard]] static bool IsRecordingThread() noexcept;
+
     /// Returns the current command buffer tick.
     [[nodiscard]] u64 CurrentTick() const noexcept {
         return master_semaphore->CurrentTick();
@@ -129,6 +149,8 @@ private:
     public:
         virtual ~Command() = default;
 
+        virtual void Prepare() const {}
+
         virtual void Execute(vk::CommandBuffer cmdbuf, vk::CommandBuffer upload_cmdbuf) const = 0;
 
         Command* GetNext() const {
@@ -152,6 +174,12 @@ private:
         TypedCommand(TypedCommand&&) = delete;
         TypedCommand& operator=(TypedCommand&&) = delete;
 
+        void Prepare() const override {
+            if constexpr (requires { command.Prepare(); }) {
+                command.Prepare();
+            }
+        }
+
         void Execute(vk::CommandBuffer cmdbuf, vk::CommandBuffer upload_cmdbuf) const override {
             command(cmdbuf, upload_cmdbuf);
         }
@@ -160,10 +188,38 @@ private:
         T command;
     };
 
+    template <typename P, typename T>
+    class PreparedCommand {
+    public:
+        explicit PreparedCommand(P prepare_, T command_)
+            : prepare{std::move(prepare_)}, command{std::move(command_)} {}
+
+        void Prepare() const {
+            if (!prepared) {
+                result = prepare();
+                prepared = true;
+            }
+        }
+
+        void operator()(vk::CommandBuffer cmdbuf, vk::CommandBuffer) const {
+            Prepare();
+            command(cmdbuf, result);
+        }
+
+    private:
+        P prepare;
+        T command;
+        mutable std::invoke_result_t<P&> result{};
+        mutable bool prepared = false;
+    };
+
     class CommandChunk final {
     public:
         void ExecuteAll(vk::CommandBuffer cmdbuf, vk::CommandBuffer upload_cmdbuf);
 
+        /// Does the host work of the recorded commands ahead of executing them.
+        void PrepareAll() const;
+
         template <typename T>
         bool Record(T& command) {
             using FuncType = TypedCommand<T>;
@@ -189,6 +245,10 @@ private:
             submit = true;
         }
 
+        void MarkUpload() {
+            uses_upload = true;
+        }
+
         bool Empty() const {
             return command_offset == 0;
         }
@@ -197,15 +257,36 @@ private:
             return submit;
         }
 
+        bool UsesUpload() const {
+            return uses_upload;
+        }
+
     private:
         Command* first = nullptr;
         Command* last = nullptr;
 
         size_t command_offset = 0;
         bool submit = false;
+        bool uses_upload = false;
         alignas(std::max_align_t) std::array<u8, 0x8000> data{};
     };
 
+    /// Render pass whose contents are held back until it ends, so they can be recorded into
+    /// secondary command buffers in parallel. Tasks are split at draw boundaries; every task but
+    /// the first one is recorded into its own secondary command buffer.
+    struct ParallelPass {
+        VkRenderPass renderpass = nullptr;
+        VkFramebuffer framebuffer = nullptr;
+        VkExtent2D render_area = {0, 0};
+        u32 num_images = 0;
+        std::array<VkImage, 9> images{};
+        std::array<VkImageSubresourceRange, 9> image_ranges{};
+        std::vector<std::vector<std::unique_ptr<CommandChunk>>> tasks;
+        std::vector<VkCommandBuffer> cmdbufs;
+        std::vector<VkCommandBuffer> upload_cmdbufs;
+        size_t num_chunks = 0;
+    };
+
     struct State {
         VkRenderPass renderpass = nullptr;
         VkFramebuffer framebuffer = nullptr;
@@ -215,6 +296,15 @@ private:
         bool rescaling_defined = false;
     };
 
+    template <typename T>
+    void RecordCommand(T& command) {
+        if (chunk->Record(command)) {
+            return;
+        }
+        AdvanceChunk();
+        (void)chunk->Record(command);
+    }
+
     void WorkerThread(std::stop_token stop_token);
 
     void AllocateWorkerCommandBuffer();
@@ -229,6 +319,22 @@ private:
 
     void AcquireNewChunk();
 
+    /// Moves to a new chunk after the current one has been filled.
+    void AdvanceChunk();
+
+    void RecordBeginRenderPass(VkSubpassContents contents);
+
+    void BeginParallelPass();
+
+    void SplitParallelPass();
+
+    void CommitParallelPass(bool record_in_parallel);
+
+    void ExecuteParallelPass(ParallelPass& pass, vk::CommandBuffer cmdbuf,
+                             vk::CommandBuffer upload_cmdbuf);
+
+    void RecordParallelTask(ParallelPass& pass, size_t index, CommandPool& pool);
+
     const Device& device;
     StateTracker& state_tracker;
 
@@ -243,6 +349,11 @@ private:
     std::unique_ptr<CommandChunk> chunk;
     std::function<void()> on_submit;
 
+    std::unique_ptr<ParallelPass> parallel_pass;
+    std::unique_ptr<Common::StatefulThreadWorker<std::unique_ptr<CommandPool>>> recording_workers;
+    bool use_parallel_recording = false;
+    bool inline_until_submit = false;
+
     State state;
 
     u32 num_renderpass_images = 0;
@@ -216,6 +216,55 @@ void SetupDirtyVertexBindings(Tables& tables) {
 }
 } // Anonymous namespace
 
+void SetupPipelineKeyTable(Maxwell3D::DirtyState& dirty) {
+    // The last table is reserved for the pipeline key regions refreshed by FixedPipelineState,
+    // only register writes of renderers using it pay for the extra lookup
+    dirty.num_tables = 3;
+    auto& table = dirty.tables[2];
+    table[OFF(transform_feedback_enabled)] = PipelineFixed;
+    table[OFF(depth_mode)] = PipelineFixed;
+    table[OFF(polygon_mode_front)] = PipelineFixed;
+    FillBlock(table, OFF(tessellation), NUM(tessellation), PipelineFixed);
+    table[OFF(patch_vertices)] = PipelineFixed;
+    table[OFF(anti_alias_samples_mode)] = PipelineFixed;
+    table[OFF(alpha_test_enabled)] = PipelineFixed;
+    table[OFF(alpha_test_func)] = PipelineFixed;
+    table[OFF(alpha_test_ref)] = PipelineFixed;
+    table[OFF(mandated_early_z)] = PipelineFixed;
+    table[OFF(zeta_enable)] = PipelineFixed;
+    FillBlock(table, OFF(zeta), NUM(zeta), PipelineFixed);
+    table[OFF(window_origin)] = PipelineFixed;
+    table[OFF(provoking_vertex)] = PipelineFixed;
+    table[OFF(conservative_raster_enable)] = PipelineFixed;
+    table[OFF(line_anti_alias_enable)] = PipelineFixed;
+    table[OFF(anti_alias_alpha_control)] = PipelineFixed;
+    table[OFF(point_size)] = PipelineFixed;
+    FillBlock(table, OFF(rt), NUM(rt), PipelineFixed);
+
+    FillBlock(table, OFF(stencil_front_op), NUM(stencil_front_op), PipelineDynamic);
+    FillBlock(table, OFF(stencil_back_op), NUM(stencil_back_op), PipelineDynamic);
+    table[OFF(stencil_two_side_enable)] = PipelineDynamic;
+    table[OFF(stencil_enable)] = PipelineDynamic;
+    table[OFF(depth_write_enabled)] = PipelineDynamic;
+    table[OFF(depth_bounds_enable)] = PipelineDynamic;
+    table[OFF(depth_test_enable)] = PipelineDynamic;
+    table[OFF(depth_test_func)] = PipelineDynamic;
+    table[OFF(gl_front_face)] = PipelineDynamic;
+    table[OFF(gl_cull_face)] = PipelineDynamic;
+    table[OFF(gl_cull_test_enabled)] = PipelineDynamic;
+    FillBlock(table, OFF(vertex_streams), NUM(vertex_streams), PipelineDynamic);
+    FillBlock(table, OFF(logic_op), NUM(logic_op), PipelineDynamic);
+    table[OFF(polygon_offset_point_enable)] = PipelineDynamic;
+    table[OFF(polygon_offset_line_enable)] = PipelineDynamic;
+    table[OFF(polygon_offset_fill_enable)] = PipelineDynamic;
+    table[OFF(rasterize_enable)] = PipelineDynamic;
+    table[OFF(primitive_restart.enabled)] = PipelineDynamic;
+    table[OFF(viewport_clip_control)] = PipelineDynamic;
+
+    FillBlock(table, OFF(transform_feedback), NUM(transform_feedback), PipelineXfb);
+    FillBlock(table, OFF(stream_out_layout), NUM(stream_out_layout), PipelineXfb);
+}
+
 void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     auto& tables{channel_state.maxwell_3d->dirty.tables};
     SetupDirtyFlags(tables);
@@ -236,6 +285,7 @@ void StateTracker::SetupTables(Tegra::Control::ChannelState& channel_state) {
     SetupDirtyVertexAttributes(tables);
     SetupDirtyVertexBindings(tables);
     SetupDirtySpecialOps(tables);
+    SetupPipelineKeyTable(channel_state.maxwell_3d->dirty);
 }
 
 void StateTracker::ChangeChannel(Tegra::Control::ChannelState& channel_state) {
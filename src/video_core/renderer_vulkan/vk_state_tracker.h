@@ -62,12 +62,20 @@ enum : u8 {
     ColorMask,
     ViewportSwizzles,
 
+    // Pipeline key regions, tracked through the third dirty table set up for the pipeline cache
+    PipelineFixed,
+    PipelineDynamic,
+    PipelineXfb,
+
     Last,
 };
 static_assert(Last <= std::numeric_limits<u8>::max());
 
 } // namespace Dirty
 
+/// Maps the registers of the pipeline key to the Pipeline* flags through the third dirty table.
+void SetupPipelineKeyTable(Tegra::Engines::Maxwell3D::DirtyState& dirty);
+
 class StateTracker {
     using Maxwell = Tegra::Engines::Maxwell3D::Regs;
 
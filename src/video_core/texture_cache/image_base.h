@@ -12,6 +12,7 @@
 #include "common/common_types.h"
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_info.h"
+#include "video_core/texture_cache/readback_predictor.h"
 #include "video_core/texture_cache/types.h"
 
 namespace VideoCommon {
@@ -104,6 +105,8 @@ struct ImageBase {
     u64 modification_tick = 0;
     size_t lru_index = SIZE_MAX;
 
+    ReadbackState readback;
+
     std::array<u32, MAX_MIP_LEVELS> mip_level_offsets{};
 
     std::vector<ImageViewInfo> image_view_infos;
@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright 2025 citron Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+
+#include "common/common_types.h"
+
+namespace VideoCommon {
+
+struct ReadbackStats {
+    u64 hits;                ///< CPU reads served from an asynchronously downloaded copy
+    u64 misses;              ///< CPU reads that had to wait for a download
+    u64 stall_time_saved_ns; ///< Hits times the average synchronous download time
+};
+
+/// CPU readback state of an image
+struct ReadbackState {
+    /// Modification tick of the contents last downloaded asynchronously to guest memory
+    u64 downloaded_tick = 0;
+    /// Frame of the last CPU read and number of consecutive frames reading the image
+    u64 last_read_frame = 0;
+    u32 read_streak = 0;
+};
+
+/// Learns which images the CPU reads back every frame, so they can be downloaded ahead of time
+class ReadbackPredictor {
+public:
+    /// Consecutive frames reading an image before it is downloaded ahead of time
+    static constexpr u32 PREDICT_FRAMES = 2;
+    /// Frames without CPU reads before an image stops being downloaded ahead of time
+    static constexpr u64 DECAY_FRAMES = 16;
+
+    /**
+     * Account a CPU read of an image.
+     *
+     * @param state             Readback state of the image
+     * @param is_predicted      Whether the image is downloaded ahead of time
+     * @param modification_tick Current modification tick of the image
+     * @param frame             Current frame
+     * @return True when the read can be served from the downloaded copy in guest memory
+     */
+    bool Read(ReadbackState& state, bool is_predicted, u64 modification_tick, u64 frame) noexcept {
+        const bool is_hit = is_predicted && state.downloaded_tick == modification_tick;
+        if (is_hit) {
+            ++hits;
+        } else {
+            ++misses;
+        }
+        if (state.read_streak == 0 || state.last_read_frame != frame) {
+            const bool is_consecutive =
+                state.read_streak != 0 && state.last_read_frame + 1 == frame;
+            state.read_streak = is_consecutive ? state.read_streak + 1 : 1;
+            state.last_read_frame = frame;
+        }
+        return is_hit;
+    }
+
+    /// Return true when an image is read often enough to be downloaded ahead of time
+    [[nodiscard]] static bool ShouldPredict(const ReadbackState& state) noexcept {
+        return state.read_streak >= PREDICT_FRAMES;
+    }
+
+    /// Return true when a predicted image has not been read back for too long
+    [[nodiscard]] static bool HasStoppedReading(const ReadbackState& state, u64 frame) noexcept {
+        return state.read_streak != 0 && state.last_read_frame + DECAY_FRAMES < frame;
+    }
+
+    /// Stop predicting reads of an image
+    static void Forget(ReadbackState& state) noexcept {
+        state.read_streak = 0;
+    }
+
+    /// Record that the contents of an image at the given modification tick reached guest memory
+    static void NotifyDownloaded(ReadbackState& state, u64 modification_tick) noexcept {
+        state.downloaded_tick = std::max(state.downloaded_tick, modification_tick);
+    }
+
+    /// Record the time spent in a synchronous download
+    void NotifySyncDownload(std::chrono::nanoseconds time) noexcept {
+        ++sync_downloads;
+        sync_download_time += time;
+    }
+
+    [[nodiscard]] ReadbackStats GetStats() const noexcept {
+        const u64 average_ns =
+            sync_downloads == 0 ? 0 : static_cast<u64>(sync_download_time.count()) / sync_downloads;
+        return ReadbackStats{
+            .hits = hits,
+            .misses = misses,
+            .stall_time_saved_ns = hits * average_ns,
+        };
+    }
+
+private:
+    u64 hits = 0;
+    u64 misses = 0;
+    u64 sync_downloads = 0;
+    std::chrono::nanoseconds sync_download_time{};
+};
+
+} // namespace VideoCommon
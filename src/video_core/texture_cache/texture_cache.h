@@ -159,6 +159,14 @@ void TextureCache<P>::TickFrame() {
     runtime.TickFrame();
     ++frame_tick;
 
+    if (frame_tick % READBACK_STATS_LOG_FRAMES == 0) {
+        const ReadbackStats stats = GetReadbackStats();
+        if (stats.hits + stats.misses != 0) {
+            LOG_DEBUG(HW_GPU, "Readbacks: {} hits, {} misses, {} ms of stalls saved", stats.hits,
+                      stats.misses, stats.stall_time_saved_ns / 1'000'000);
+        }
+    }
+
     if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
         for (auto& buffer : async_buffers_death_ring) {
             runtime.FreeDeferredStagingBuffer(buffer);
@@ -555,6 +563,7 @@ void TextureCache<P>::DownloadMemory(DAddr cpu_addr, size_t size) {
     if (images.empty()) {
         return;
     }
+    const auto start_time = std::chrono::steady_clock::now();
     std::ranges::sort(images, [this](ImageId lhs, ImageId rhs) {
         return slot_images[lhs].modification_tick < slot_images[rhs].modification_tick;
     });
@@ -567,6 +576,7 @@ void TextureCache<P>::DownloadMemory(DAddr cpu_addr, size_t size) {
         SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, map.mapped_span,
                      swizzle_data_buffer);
     }
+    readback_predictor.NotifySyncDownload(std::chrono::steady_clock::now() - start_time);
 }
 
 template <class P>
@@ -585,16 +595,41 @@ std::optional<VideoCore::RasterizerDownloadArea> TextureCache<P>::GetFlushArea(D
         }
         area->start_address = std::min(area->start_address, image.cpu_addr);
         area->end_address = std::max(area->end_address, image.cpu_addr_end);
-        for (auto image_view_id : image.image_view_ids) {
-            auto& image_view = slot_image_views[image_view_id];
-            image_view.flags |= ImageViewFlagBits::PreemtiveDownload;
-        }
-        area->preemtive &= image.info.forced_flushed;
-        image.info.forced_flushed = true;
+        // Serve the read from guest memory only when the asynchronous download of the latest
+        // contents has already landed
+        area->preemtive &= TrackReadback(image);
     });
     return area;
 }
 
+template <class P>
+bool TextureCache<P>::TrackReadback(ImageBase& image) {
+    const bool is_copy_valid = readback_predictor.Read(image.readback, image.info.forced_flushed,
+                                                       image.modification_tick, frame_tick);
+    if (image.info.forced_flushed || !ReadbackPredictor::ShouldPredict(image.readback)) {
+        return is_copy_valid;
+    }
+    image.info.forced_flushed = true;
+    for (const ImageViewId image_view_id : image.image_view_ids) {
+        slot_image_views[image_view_id].flags |= ImageViewFlagBits::PreemtiveDownload;
+    }
+    return is_copy_valid;
+}
+
+template <class P>
+void TextureCache<P>::ForgetReadback(ImageBase& image) {
+    image.info.forced_flushed = false;
+    ReadbackPredictor::Forget(image.readback);
+    for (const ImageViewId image_view_id : image.image_view_ids) {
+        slot_image_views[image_view_id].flags &= ~ImageViewFlagBits::PreemtiveDownload;
+    }
+}
+
+template <class P>
+ReadbackStats TextureCache<P>::GetReadbackStats() const noexcept {
+    return readback_predictor.GetStats();
+}
+
 template <class P>
 void TextureCache<P>::UnmapMemory(DAddr cpu_addr, size_t size) {
     boost::container::small_vector<ImageId, 16> deleted_images;
@@ -814,10 +849,11 @@ void TextureCache<P>::CommitAsyncFlushes() {
         bool any_none_dma = false;
         for (PendingDownload& download_info : download_ids) {
             if (download_info.is_swizzle) {
-                total_size_bytes +=
-                    Common::AlignUp(slot_images[download_info.object_id].unswizzled_size_bytes, 64);
+                const Image& image = slot_images[download_info.object_id];
+                total_size_bytes += Common::AlignUp(image.unswizzled_size_bytes, 64);
                 any_none_dma = true;
                 download_info.async_buffer_id = last_async_buffer_id;
+                download_info.modification_tick = image.modification_tick;
             }
         }
 
@@ -858,13 +894,15 @@ void TextureCache<P>::PopAsyncFlushes() {
             auto& download_info = download_ids[i - 1];
             auto& download_buffer = download_map[download_info.async_buffer_id];
             if (download_info.is_swizzle) {
-                const ImageBase& image = slot_images[download_info.object_id];
+                ImageBase& image = slot_images[download_info.object_id];
                 const auto copies = FullDownloadCopies(image.info);
                 download_buffer.offset -= Common::AlignUp(image.unswizzled_size_bytes, 64);
                 std::span<u8> download_span =
                     download_buffer.mapped_span.subspan(download_buffer.offset);
                 SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, download_span,
                              swizzle_data_buffer);
+                ReadbackPredictor::NotifyDownloaded(image.readback,
+                                                    download_info.modification_tick);
             } else {
                 const BufferDownload& buffer_info = slot_buffer_downloads[download_info.object_id];
                 std::span<u8> download_span =
@@ -910,10 +948,11 @@ void TextureCache<P>::PopAsyncFlushes() {
             if (!download_info.is_swizzle) {
                 continue;
             }
-            const ImageBase& image = slot_images[download_info.object_id];
+            ImageBase& image = slot_images[download_info.object_id];
             const auto copies = FullDownloadCopies(image.info);
             SwizzleImage(*gpu_memory, image.gpu_addr, image.info, copies, download_span,
                          swizzle_data_buffer);
+            ReadbackPredictor::NotifyDownloaded(image.readback, image.modification_tick);
             download_map.offset += image.unswizzled_size_bytes;
             download_span = download_span.subspan(image.unswizzled_size_bytes);
         }
@@ -1028,7 +1067,7 @@ void TextureCache<P>::DownloadImageIntoBuffer(typename TextureCache<P>::Image* i
     if constexpr (IMPLEMENTS_ASYNC_DOWNLOADS) {
         const BufferDownload new_buffer_download{address, size};
         auto slot = slot_buffer_downloads.insert(new_buffer_download);
-        const PendingDownload new_download{false, uncommitted_async_buffers.size(), slot};
+        const PendingDownload new_download{false, uncommitted_async_buffers.size(), slot, 0};
         uncommitted_downloads.emplace_back(new_download);
         auto download_map = runtime.DownloadStagingBuffer(size, true);
         uncommitted_async_buffers.emplace_back(download_map);
@@ -2469,8 +2508,14 @@ void TextureCache<P>::BindRenderTarget(ImageViewId* old_id, ImageViewId new_id)
     if (new_id) {
         const ImageViewBase& old_view = slot_image_views[new_id];
         if (True(old_view.flags & ImageViewFlagBits::PreemtiveDownload)) {
-            const PendingDownload new_download{true, 0, old_view.image_id};
-            uncommitted_downloads.emplace_back(new_download);
+            ImageBase& image = slot_images[old_view.image_id];
+            if (ReadbackPredictor::HasStoppedReading(image.readback, frame_tick)) {
+                // The CPU stopped reading this image back
+                ForgetReadback(image);
+            } else {
+                const PendingDownload new_download{true, 0, old_view.image_id, 0};
+                uncommitted_downloads.emplace_back(new_download);
+            }
         }
     }
     *old_id = new_id;
@@ -32,6 +32,7 @@
 #include "video_core/texture_cache/image_base.h"
 #include "video_core/texture_cache/image_info.h"
 #include "video_core/texture_cache/image_view_base.h"
+#include "video_core/texture_cache/readback_predictor.h"
 #include "video_core/texture_cache/render_targets.h"
 #include "video_core/texture_cache/types.h"
 #include "video_core/textures/texture.h"
@@ -227,6 +228,9 @@ public:
     /// Pop asynchronous downloads
     void PopAsyncFlushes();
 
+    /// Return statistics of the CPU readback predictor
+    [[nodiscard]] ReadbackStats GetReadbackStats() const noexcept;
+
     [[nodiscard]] ImageId DmaImageId(const Tegra::DMA::ImageOperand& operand, bool is_upload);
 
     [[nodiscard]] std::pair<Image*, BufferImageCopy> DmaBufferImageCopy(
@@ -403,6 +407,12 @@ private:
     /// Bind an image view as render target, downloading resources preemtively if needed
     void BindRenderTarget(ImageViewId* old_id, ImageViewId new_id);
 
+    /// Learn a CPU read of an image, returns true when it can be served from guest memory
+    bool TrackReadback(ImageBase& image);
+
+    /// Stop downloading an image ahead of time
+    void ForgetReadback(ImageBase& image);
+
     /// Create a render target from a given image and image view parameters
     [[nodiscard]] std::pair<FramebufferId, ImageViewId> RenderTargetFromImage(
         ImageId, const ImageViewInfo& view_info);
@@ -452,6 +462,7 @@ private:
         bool is_swizzle;
         size_t async_buffer_id;
         Common::SlotId object_id;
+        u64 modification_tick;
     };
 
     Common::SlotVector<Image> slot_images;
@@ -489,6 +500,10 @@ private:
     u64 modification_tick = 0;
     u64 frame_tick = 0;
 
+    /// Frames between logs of the readback statistics
+    static constexpr u64 READBACK_STATS_LOG_FRAMES = 3600;
+    ReadbackPredictor readback_predictor;
+
     Common::ThreadWorker texture_decode_worker{1, "TextureDecoder"};
     std::vector<std::unique_ptr<AsyncDecodeContext>> async_decodes;
 
@@ -218,6 +218,7 @@ struct DeviceDispatch : InstanceDispatch {
     PFN_vkCmdEndQuery vkCmdEndQuery{};
     PFN_vkCmdEndRenderPass vkCmdEndRenderPass{};
     PFN_vkCmdEndTransformFeedbackEXT vkCmdEndTransformFeedbackEXT{};
+    PFN_vkCmdExecuteCommands vkCmdExecuteCommands{};
     PFN_vkCmdFillBuffer vkCmdFillBuffer{};
     PFN_vkCmdPipelineBarrier vkCmdPipelineBarrier{};
     PFN_vkCmdPushConstants vkCmdPushConstants{};
@@ -1119,6 +1120,10 @@ public:
         dld->vkCmdEndRenderPass(handle);
     }
 
+    void ExecuteCommands(Span<VkCommandBuffer> command_buffers) const noexcept {
+        dld->vkCmdExecuteCommands(handle, command_buffers.size(), command_buffers.data());
+    }
+
     void BeginQuery(VkQueryPool query_pool, u32 query, VkQueryControlFlags flags) const noexcept {
         dld->vkCmdBeginQuery(handle, query_pool, query, flags);
     }